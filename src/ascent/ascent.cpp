@@ -57,8 +57,18 @@
 #include <ascent_flow_runtime.hpp>
 #include <runtimes/ascent_main_runtime.hpp>
 #include <utils/ascent_string_utils.hpp>
+#include <ascent_actions_utils.hpp>
 #include <flow.hpp>
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
 #if defined(ASCENT_VTKH_ENABLED)
     #include <vtkh/vtkh.hpp>
 #endif
@@ -82,12 +92,346 @@ quiet_handler(const std::string &,
 {
 }
 
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::detail --
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+//-----------------------------------------------------------------------------
+// copies src into dest, reusing dest's memory where the layout matches
+//-----------------------------------------------------------------------------
+void
+snapshot_copy(const Node &src, Node &dest)
+{
+    if(src.dtype().is_object())
+    {
+        if(!dest.dtype().is_object())
+        {
+            dest.reset();
+        }
+
+        std::vector<std::string> dest_names = dest.child_names();
+        for(size_t i = 0; i < dest_names.size(); ++i)
+        {
+            if(!src.has_child(dest_names[i]))
+            {
+                dest.remove(dest_names[i]);
+            }
+        }
+
+        NodeConstIterator itr = src.children();
+        while(itr.has_next())
+        {
+            const Node &child = itr.next();
+            snapshot_copy(child, dest[itr.name()]);
+        }
+    }
+    else if(src.dtype().is_list())
+    {
+        const int num_children = src.number_of_children();
+        if(!dest.dtype().is_list() ||
+           dest.number_of_children() != num_children)
+        {
+            dest.reset();
+            for(int i = 0; i < num_children; ++i)
+            {
+                dest.append();
+            }
+        }
+
+        for(int i = 0; i < num_children; ++i)
+        {
+            snapshot_copy(src.child(i), dest.child(i));
+        }
+    }
+    else
+    {
+        // leaves keep their allocation when the dtype is compatible
+        dest.set(src);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// snapshot of one domain that only keeps the listed fields
+//-----------------------------------------------------------------------------
+void
+snapshot_domain(const Node &dom,
+                const std::set<std::string> &fields,
+                Node &dest)
+{
+    Node src;
+    NodeConstIterator itr = dom.children();
+    while(itr.has_next())
+    {
+        const Node &child = itr.next();
+        const std::string name = itr.name();
+        if(name != "fields")
+        {
+            src[name].set_external(child);
+            continue;
+        }
+
+        Node &src_fields = src["fields"];
+        src_fields.set(DataType::object());
+        NodeConstIterator f_itr = child.children();
+        while(f_itr.has_next())
+        {
+            const Node &field = f_itr.next();
+            const std::string f_name = f_itr.name();
+            // keep special mfem fields (see SourceFieldFilter)
+            if(fields.find(f_name) != fields.end() ||
+               f_name.find("position") != std::string::npos ||
+               f_name.find("_nodes") != std::string::npos ||
+               f_name.find("_attribute") != std::string::npos ||
+               f_name.find("boundary") != std::string::npos)
+            {
+                src_fields[f_name].set_external(field);
+            }
+        }
+    }
+    snapshot_copy(src, dest);
+}
+
+//-----------------------------------------------------------------------------
+// Runs the runtime's publish and execute calls in order on a helper
+// thread. Published data is copied into one of two pooled snapshots,
+// so the caller can change it while the previous cycle executes.
+//-----------------------------------------------------------------------------
+class AsyncQueue
+{
+public:
+    AsyncQueue()
+    : m_stop(false),
+      m_running(false),
+      m_pending(0),
+      m_next_slot(0),
+      m_published_slot(-1)
+    {
+        m_slot_busy[0] = false;
+        m_slot_busy[1] = false;
+        m_thread = std::thread(&AsyncQueue::run, this);
+    }
+
+    ~AsyncQueue()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        m_thread.join();
+    }
+
+    // queues a publish of a snapshot of data, when fields is not null
+    // only those fields are copied. returns once the snapshot is taken
+    void publish_snapshot(Runtime *runtime,
+                          const Node &data,
+                          const std::set<std::string> *fields)
+    {
+        int slot = 0;
+        {
+            // wait until the runtime no longer uses the slot
+            std::unique_lock<std::mutex> lock(m_mutex);
+            slot = m_next_slot;
+            m_cv.wait(lock, [this, slot]() { return !m_slot_busy[slot]; });
+            m_slot_busy[slot] = true;
+            m_next_slot = 1 - slot;
+        }
+
+        Node &snapshot = m_slots[slot];
+        try
+        {
+            if(fields == NULL)
+            {
+                snapshot_copy(data, snapshot);
+            }
+            else if(blueprint::mesh::is_multi_domain(data))
+            {
+                if(!snapshot.dtype().is_list() ||
+                   snapshot.number_of_children() != data.number_of_children())
+                {
+                    snapshot.reset();
+                    for(int i = 0; i < data.number_of_children(); ++i)
+                    {
+                        snapshot.append();
+                    }
+                }
+
+                for(int i = 0; i < data.number_of_children(); ++i)
+                {
+                    snapshot_domain(data.child(i), *fields, snapshot.child(i));
+                }
+            }
+            else
+            {
+                snapshot_domain(data, *fields, snapshot);
+            }
+        }
+        catch(...)
+        {
+            release_slot(slot);
+            throw;
+        }
+
+        push([this, runtime, slot]()
+             {
+                 try
+                 {
+                     runtime->Publish(m_slots[slot]);
+                 }
+                 catch(...)
+                 {
+                     // the runtime may hold neither snapshot now
+                     published(-1);
+                     release_slot(slot);
+                     throw;
+                 }
+                 published(slot);
+             },
+             false);
+    }
+
+    void push(const std::function<void()> &task, bool is_execute)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back(std::make_pair(task, is_execute));
+            if(is_execute)
+            {
+                m_pending++;
+            }
+        }
+        m_cv.notify_all();
+    }
+
+    // blocks until all queued tasks are done
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this]() { return m_tasks.empty() && !m_running; });
+    }
+
+    // queued and running executes
+    int pending()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_pending;
+    }
+
+    // errors from tasks since the last call
+    void take_errors(std::vector<std::string> &errors)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        errors.swap(m_errors);
+        m_errors.clear();
+    }
+
+private:
+    // frees the previously published snapshot, slot is now referenced
+    // by the runtime (-1 for none)
+    void published(int slot)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(m_published_slot != -1 && m_published_slot != slot)
+            {
+                m_slot_busy[m_published_slot] = false;
+            }
+            m_published_slot = slot;
+        }
+        m_cv.notify_all();
+    }
+
+    void release_slot(int slot)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_slot_busy[slot] = false;
+        }
+        m_cv.notify_all();
+    }
+
+    void run()
+    {
+        while(true)
+        {
+            std::pair<std::function<void()>, bool> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+                if(m_tasks.empty())
+                {
+                    return;
+                }
+                task = m_tasks.front();
+                m_tasks.pop_front();
+                m_running = true;
+            }
+
+            std::string error;
+            try
+            {
+                task.first();
+            }
+            catch(conduit::Error &e)
+            {
+                error = e.message();
+            }
+            catch(std::exception &e)
+            {
+                error = e.what();
+            }
+            catch(...)
+            {
+                error = "unknown exception";
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_running = false;
+                if(task.second)
+                {
+                    m_pending--;
+                }
+                if(!error.empty())
+                {
+                    m_errors.push_back(error);
+                }
+            }
+            m_cv.notify_all();
+        }
+    }
+
+    bool                    m_stop;
+    bool                    m_running;
+    int                     m_pending;
+    int                     m_next_slot;
+    int                     m_published_slot;
+    bool                    m_slot_busy[2];
+    Node                    m_slots[2];
+    std::vector<std::string> m_errors;
+    std::deque<std::pair<std::function<void()>, bool>> m_tasks;
+    std::mutex              m_mutex;
+    std::condition_variable m_cv;
+    std::thread             m_thread;
+};
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::detail --
+//-----------------------------------------------------------------------------
+
 //-----------------------------------------------------------------------------
 Ascent::Ascent()
 : m_runtime(NULL),
   m_verbose_msgs(true),
   m_forward_exceptions(false),
-  m_actions_file("<<UNSET>>")
+  m_actions_file("<<UNSET>>"),
+  m_async(NULL),
+  m_async_data(NULL),
+  m_async_mpi_comm(-1)
 {
   m_options["mpi_comm"] = -1;
   set_status("Ascent instance created");
@@ -96,7 +440,11 @@ Ascent::Ascent()
 //-----------------------------------------------------------------------------
 Ascent::~Ascent()
 {
-
+  // finish any queued work
+  if(m_async != NULL)
+  {
+    delete m_async;
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -199,6 +547,75 @@ CheckForSettingsFile(std::string file_name,
 #endif
 }
 
+//-----------------------------------------------------------------------------
+// Like CheckForSettingsFile, but for actions files read on every execute.
+//
+// Rank 0 stats the file and broadcasts a small token built from its path,
+// mtime and size. The file is only loaded and broadcast when the token
+// changes, otherwise the actions parsed last time are reused.
+// Returns false if the file does not exist.
+//-----------------------------------------------------------------------------
+bool
+CheckForActionsFile(const std::string &file_name,
+                    conduit::Node &cached_actions,
+                    std::string &token,
+                    int mpi_comm_id)
+{
+    int rank = 0;
+#ifdef ASCENT_MPI_ENABLED
+    if(mpi_comm_id == -1)
+    {
+      // do nothing, an error will be thrown later
+      // so we can respect the exception handling
+      return false;
+    }
+    MPI_Comm mpi_comm = MPI_Comm_f2c(mpi_comm_id);
+    MPI_Comm_rank(mpi_comm, &rank);
+#endif
+
+    // has file, mtime, size
+    long long stats[3] = {0, 0, 0};
+    if(rank == 0 && file_name != "" &&
+       file_stats(file_name, stats[1], stats[2]))
+    {
+      stats[0] = 1;
+    }
+#ifdef ASCENT_MPI_ENABLED
+    MPI_Bcast(stats, 3, MPI_LONG_LONG, 0, mpi_comm);
+#endif
+
+    if(stats[0] == 0)
+    {
+      cached_actions.reset();
+      token = "";
+      return false;
+    }
+
+    std::ostringstream oss;
+    oss << file_name << ":" << stats[1] << ":" << stats[2];
+
+    if(oss.str() == token)
+    {
+      return true;
+    }
+
+    cached_actions.reset();
+    token = "";
+    CheckForSettingsFile(file_name,
+                         cached_actions,
+                         false,
+                         mpi_comm_id);
+
+    // the file could have gone away since we checked
+    if(cached_actions.dtype().is_empty())
+    {
+      return false;
+    }
+
+    token = oss.str();
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 void
 Ascent::open(const conduit::Node &options)
@@ -331,7 +748,65 @@ Ascent::open(const conduit::Node &options)
                            << " passed via 'runtime' open option.");
         }
 
-        m_runtime->Initialize(m_options);
+        bool use_async = false;
+        if(m_options.has_path("async") &&
+           m_options["async"].dtype().is_string() &&
+           m_options["async"].as_string() == "true")
+        {
+            m_async_snapshot = "copy";
+            if(m_options.has_path("async_snapshot"))
+            {
+                m_async_snapshot = m_options["async_snapshot"].as_string();
+                if(m_async_snapshot != "copy" &&
+                   m_async_snapshot != "fields" &&
+                   m_async_snapshot != "external")
+                {
+                    ASCENT_ERROR("async_snapshot must be 'copy', 'fields'"
+                                 " or 'external', got '"
+                                 << m_async_snapshot << "'");
+                }
+            }
+
+            use_async = true;
+#ifdef ASCENT_MPI_ENABLED
+            // the runtime's mpi calls happen on the helper thread,
+            // concurrent with the caller's
+            int provided = MPI_THREAD_SINGLE;
+            MPI_Query_thread(&provided);
+            if(provided < MPI_THREAD_MULTIPLE)
+            {
+                ASCENT_INFO("Ascent async execute requires MPI_THREAD_MULTIPLE,"
+                            " executing synchronously\n");
+                use_async = false;
+            }
+#endif
+        }
+
+        const Node *runtime_opts = &m_options;
+        Node async_opts;
+#ifdef ASCENT_MPI_ENABLED
+        if(use_async && m_options["mpi_comm"].to_int32() != -1)
+        {
+            // the runtime's collectives run on the helper thread, give
+            // them their own communicator so they can't be matched with
+            // the caller's collectives on the same communicator
+            MPI_Comm async_comm;
+            MPI_Comm_dup(MPI_Comm_f2c(m_options["mpi_comm"].to_int32()),
+                         &async_comm);
+            m_async_mpi_comm = MPI_Comm_c2f(async_comm);
+
+            async_opts.set(m_options);
+            async_opts["mpi_comm"] = m_async_mpi_comm;
+            runtime_opts = &async_opts;
+        }
+#endif
+
+        m_runtime->Initialize(*runtime_opts);
+
+        if(use_async)
+        {
+            m_async = new detail::AsyncQueue();
+        }
 
         // don't print info messages unless we are using verbose
         // Runtimes may set their own handlers in initialize, so
@@ -368,7 +843,31 @@ Ascent::publish(const conduit::Node &data)
     {
         if(m_runtime != NULL)
         {
-            m_runtime->Publish(data);
+            if(m_async != NULL)
+            {
+                report_async_errors();
+                if(m_async_snapshot == "external")
+                {
+                    // the caller promises not to change data until wait()
+                    Runtime *runtime = m_runtime;
+                    const Node *data_ptr = &data;
+                    m_async->push([runtime, data_ptr]()
+                                  {
+                                      runtime->Publish(*data_ptr);
+                                  },
+                                  false);
+                }
+                else
+                {
+                    // the snapshot is taken by execute, once we
+                    // know which fields the actions need
+                    m_async_data = &data;
+                }
+            }
+            else
+            {
+                m_runtime->Publish(data);
+            }
         }
         else
         {
@@ -404,6 +903,70 @@ Ascent::publish(const conduit::Node &data)
     }
 }
 
+//-----------------------------------------------------------------------------
+const conduit::Node &
+Ascent::resolve_actions(const conduit::Node &actions,
+                        std::string &actions_token)
+{
+    if(m_actions_file == "<<UNSET>>")
+    {
+        m_actions_file = "ascent_actions.json";
+
+        if(!conduit::utils::is_file(m_actions_file))
+        {
+            m_actions_file = "ascent_actions.yaml";
+        }
+    }
+
+    // actions from a file replace the passed actions
+    bool has_file = CheckForActionsFile(m_actions_file,
+                                        m_actions_file_cache,
+                                        m_actions_file_token,
+                                        m_options["mpi_comm"].to_int32());
+
+    if(has_file)
+    {
+        actions_token = m_actions_file_token;
+        return m_actions_file_cache;
+    }
+    else
+    {
+        if(m_actions_file != "ascent_actions.json" &&
+           m_actions_file != "ascent_actions.yaml" &&
+           m_actions_file != "")
+        {
+            // an actions file has been set by the user
+            // so we better let them know if we don't find
+            // it
+            ASCENT_ERROR("An actions file '"
+                         <<m_actions_file<<"' was specified "
+                         " but could not be found. Please "
+                         "check if the file is in the current "
+                         "directory or provide an absolute path.")
+        }
+        actions_token = "";
+        return actions;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+Ascent::report_async_errors()
+{
+    std::vector<std::string> errors;
+    m_async->take_errors(errors);
+    if(!errors.empty())
+    {
+        std::ostringstream oss;
+        for(size_t i = 0; i < errors.size(); ++i)
+        {
+            oss << errors[i] << std::endl;
+        }
+        ASCENT_ERROR("async publish / execute failed:" << std::endl
+                     << oss.str());
+    }
+}
+
 //-----------------------------------------------------------------------------
 void
 Ascent::execute(const conduit::Node &actions)
@@ -412,42 +975,53 @@ Ascent::execute(const conduit::Node &actions)
     {
         if(m_runtime != NULL)
         {
-            Node processed_actions(actions);
-
-            if(m_actions_file == "<<UNSET>>")
+            if(m_async != NULL)
             {
-                m_actions_file = "ascent_actions.json";
+                report_async_errors();
 
-                if(!conduit::utils::is_file(m_actions_file))
+                // actions files are read here, on the caller's
+                // communicator, so the snapshot sees the actions
+                // that will execute
+                std::string actions_token;
+                const Node &exec_actions = resolve_actions(actions,
+                                                           actions_token);
+
+                if(m_async_data != NULL)
                 {
-                    m_actions_file = "ascent_actions.yaml";
+                    std::set<std::string> fields;
+                    bool select_fields = false;
+                    if(m_async_snapshot == "fields" &&
+                       exec_actions.number_of_children() > 0)
+                    {
+                        select_fields = m_runtime->FieldList(exec_actions,
+                                                             fields);
+                    }
+
+                    m_async->publish_snapshot(m_runtime,
+                                              *m_async_data,
+                                              select_fields ? &fields : NULL);
+                    m_async_data = NULL;
                 }
+
+                std::shared_ptr<Node> queued_actions = std::make_shared<Node>(exec_actions);
+                Runtime *runtime = m_runtime;
+                m_async->push([runtime, queued_actions, actions_token]()
+                              {
+                                  runtime->Execute(*queued_actions,
+                                                   actions_token);
+                              },
+                              true);
+
+                set_status("Ascent::execute queued");
             }
-            else if(m_actions_file != "ascent_actions.json" &&
-                    m_actions_file != "ascent_actions.yaml" &&
-                    m_actions_file != "")
+            else
             {
-                // an actions file has been set by the user
-                // so we better let them know if we don't find
-                // it
-                if(!conduit::utils::is_file(m_actions_file))
-                {
-                    ASCENT_ERROR("An actions file '"
-                                 <<m_actions_file<<"' was specified "
-                                 " but could not be found. Please "
-                                 "check if the file is in the current "
-                                 "directory or provide an absolute path.")
-                }
+                std::string actions_token;
+                const Node &exec_actions = resolve_actions(actions,
+                                                           actions_token);
+                m_runtime->Execute(exec_actions, actions_token);
+                set_status("Ascent::execute completed");
             }
-
-            CheckForSettingsFile(m_actions_file,
-                                 processed_actions,
-                                 false,
-                                 m_options["mpi_comm"].to_int32());
-
-            m_runtime->Execute(processed_actions);
-
-            set_status("Ascent::execute completed");
         }
         else
         {
@@ -490,6 +1064,10 @@ Ascent::info(conduit::Node &info_out)
     {
         if(m_runtime != NULL)
         {
+            if(m_async != NULL)
+            {
+                m_async->wait();
+            }
             m_runtime->Info(info_out);
         }
 
@@ -525,18 +1103,98 @@ Ascent::info(conduit::Node &info_out)
     }
 }
 
+//-----------------------------------------------------------------------------
+void
+Ascent::wait()
+{
+    try
+    {
+        if(m_async != NULL)
+        {
+            m_async->wait();
+            report_async_errors();
+            set_status("Ascent::wait completed");
+        }
+    }
+    catch(conduit::Error &e)
+    {
+        set_status("Ascent::wait failed",
+                   e.message());
+
+        if(m_forward_exceptions)
+        {
+            throw e;
+        }
+        else
+        {
+          if(m_runtime != NULL)
+          {
+            std::stringstream msg;
+            msg << "[Error] Ascent::wait "
+                << e.message() << std::endl;
+            m_runtime->DisplayError(msg.str());
+          }
+          else
+          {
+            std::cerr<< "[Error] Ascent::wait "
+                     << e.message() << std::endl;
+          }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+Ascent::status(conduit::Node &status_out)
+{
+    status_out.reset();
+    status_out.set(m_status);
+    status_out["async"] = m_async != NULL ? "true" : "false";
+    status_out["pending"] = m_async != NULL ? m_async->pending() : 0;
+}
+
 //-----------------------------------------------------------------------------
 void
 Ascent::close()
 {
     try
     {
+        std::vector<std::string> async_errors;
+        if(m_async != NULL)
+        {
+            m_async->wait();
+            m_async->take_errors(async_errors);
+            delete m_async;
+            m_async = NULL;
+            m_async_data = NULL;
+        }
+
         if(m_runtime != NULL)
         {
             delete m_runtime;
             m_runtime = NULL;
         }
 
+#ifdef ASCENT_MPI_ENABLED
+        if(m_async_mpi_comm != -1)
+        {
+            MPI_Comm async_comm = MPI_Comm_f2c(m_async_mpi_comm);
+            MPI_Comm_free(&async_comm);
+            m_async_mpi_comm = -1;
+        }
+#endif
+
+        if(!async_errors.empty())
+        {
+            std::ostringstream oss;
+            for(size_t i = 0; i < async_errors.size(); ++i)
+            {
+                oss << async_errors[i] << std::endl;
+            }
+            ASCENT_ERROR("async publish / execute failed:" << std::endl
+                         << oss.str());
+        }
+
          set_status("Ascent::close completed");
     }
     catch(conduit::Error &e)
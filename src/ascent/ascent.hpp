@@ -74,6 +74,11 @@ namespace ascent
 // Forward Declare the ascent::Runtime interface class.
 class Runtime;
 
+namespace detail
+{
+class AsyncQueue;
+};
+
 //-----------------------------------------------------------------------------
 /// Ascent Interface
 //-----------------------------------------------------------------------------
@@ -88,10 +93,21 @@ public:
     void   publish(const conduit::Node &data);
     void   execute(const conduit::Node &actions);
     void   info(conduit::Node &info_out);
+    // async mode: blocks until all queued publishes and executes are done
+    void   wait();
+    // status message and the number of executes still pending
+    void   status(conduit::Node &status_out);
     void   close();
 
 private:
-    
+
+    // returns the actions to execute: the actions file when there is
+    // one, otherwise actions. actions_token is empty unless the actions
+    // came from the file
+    const conduit::Node &resolve_actions(const conduit::Node &actions,
+                                         std::string &actions_token);
+    void           report_async_errors();
+
     void           set_status(const std::string &msg);
     void           set_status(const std::string &msg,
                               const std::string &details);
@@ -99,8 +115,17 @@ private:
     bool           m_verbose_msgs;
     bool           m_forward_exceptions;
     std::string    m_actions_file;
+    // parsed actions file, reused while its token is unchanged
+    conduit::Node  m_actions_file_cache;
+    std::string    m_actions_file_token;
     conduit::Node  m_options;
     conduit::Node  m_status;
+    // async mode
+    detail::AsyncQueue  *m_async;
+    std::string          m_async_snapshot;
+    const conduit::Node *m_async_data;
+    // duplicate of the mpi comm used by the runtime on the helper thread
+    int                  m_async_mpi_comm;
 };
 
 
@@ -69,6 +69,22 @@ Runtime::~Runtime()
 
 }
 
+//-----------------------------------------------------------------------------
+void
+Runtime::Execute(const conduit::Node &actions,
+                 const std::string &/*actions_token*/)
+{
+    Execute(actions);
+}
+
+//-----------------------------------------------------------------------------
+bool
+Runtime::FieldList(const conduit::Node &/*actions*/,
+                   std::set<std::string> &/*fields*/)
+{
+    return false;
+}
+
 void Runtime::DisplayError(const std::string &msg)
 {
   std::cerr<<msg;
@@ -54,6 +54,9 @@
 
 #include <ascent.hpp>
 
+#include <set>
+#include <string>
+
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
 //-----------------------------------------------------------------------------
@@ -72,6 +75,18 @@ public:
 
     virtual void  Publish(const conduit::Node &data)=0;
     virtual void  Execute(const conduit::Node &actions)=0;
+    // actions_token identifies where the actions came from, a non empty
+    // token equal to the previous call's token means the actions are
+    // unchanged
+    virtual void  Execute(const conduit::Node &actions,
+                          const std::string &actions_token);
+
+    // fields the actions need from published data, including fields
+    // the runtime needs on its own (e.g., ghost fields). Returns false
+    // if they can't be determined. Can be called while another thread
+    // is in Publish or Execute
+    virtual bool  FieldList(const conduit::Node &actions,
+                            std::set<std::string> &fields);
 
     virtual void  Info(conduit::Node &info_out)=0;
 
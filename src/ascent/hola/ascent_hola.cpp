@@ -62,8 +62,17 @@
 // ascent includes
 //-----------------------------------------------------------------------------
 #include <ascent_logging.hpp>
+#include <ascent_field_codec.hpp>
 
+#include <algorithm>
 #include <fstream>
+#include <map>
+#include <set>
+#include <vector>
+
+#if defined(ASCENT_HDF5_ENABLED)
+    #include <conduit_relay_io_hdf5.hpp>
+#endif
 
 #if defined(ASCENT_MPI_ENABLED)
     #include "ascent_hola_mpi.hpp"
@@ -218,6 +227,32 @@ public:
         return Expand(m_file_pattern,file_id);
     }
 
+    //-------------------------------------------------------------------//
+    // file paths for all trees, builds the domain to file map once
+    void GenerateFilePaths(std::vector<std::string> &paths) const
+    {
+        paths.resize(m_num_trees);
+
+        if(m_num_trees == m_num_files || m_num_files == 1)
+        {
+            for(int i = 0; i < m_num_trees; i++)
+            {
+                paths[i] = GenerateFilePath(i);
+            }
+            return;
+        }
+
+        Node d2f_map;
+        gen_domain_to_file_map(m_num_trees,
+                               m_num_files,
+                               d2f_map);
+        int32_array v_domain_to_file = d2f_map["global_domain_to_file"].value();
+        for(int i = 0; i < m_num_trees; i++)
+        {
+            paths[i] = Expand(m_file_pattern,v_domain_to_file[i]);
+        }
+    }
+
     //-------------------------------------------------------------------//
     std::string GenerateTreePath(int tree_id) const
     {
@@ -241,13 +276,290 @@ private:
 };
 
 //-----------------------------------------------------------------------------
-void relay_blueprint_mesh_read(const Node &options,
-                               Node &data)
+// Builds the list of index entries to read for the optional
+// "fields" and "topologies" selections.
+//
+// Selected fields pull in their topologies, selected topologies pull in
+// their coordsets. Other entries (matsets, adjsets, ...) are read when
+// they live on a selected topology. Without a selection, or when a
+// selection does not name any field or topology in the index, all entries
+// are read.
+//-----------------------------------------------------------------------------
+void
+gen_read_selection(const Node &options,
+                   const Node &mesh_index,
+                   Node &selection)
 {
-    std::string root_fname = options["root_file"].as_string();
+    selection.reset();
+
+    std::set<std::string> fields;
+    std::set<std::string> topos;
+    std::set<std::string> csets;
+
+    bool has_fields = options.has_child("fields");
+    bool has_topos  = options.has_child("topologies");
+
+    if(has_fields)
+    {
+        NodeConstIterator itr = options["fields"].children();
+        while(itr.has_next())
+        {
+            std::string field = itr.next().as_string();
+            // fields we don't know about may be derived later on
+            if(mesh_index.has_path("fields/" + field))
+            {
+                fields.insert(field);
+                const Node &f_index = mesh_index["fields/" + field];
+                if(f_index.has_child("topology"))
+                {
+                    topos.insert(f_index["topology"].as_string());
+                }
+            }
+        }
+        // same as no field list
+        has_fields = !fields.empty();
+    }
+
+    if(has_topos)
+    {
+        NodeConstIterator itr = options["topologies"].children();
+        while(itr.has_next())
+        {
+            std::string topo = itr.next().as_string();
+            if(mesh_index.has_path("topologies/" + topo))
+            {
+                topos.insert(topo);
+            }
+        }
+    }
+
+    bool all_topos = topos.empty();
+
+    NodeConstIterator outer_itr = mesh_index.children();
+    while(outer_itr.has_next())
+    {
+        const Node &outer = outer_itr.next();
+        std::string outer_name = outer_itr.name();
+
+        // coordsets are added last, once we know which topologies are read
+        if(outer_name == "state" || outer_name == "coordsets")
+        {
+            continue;
+        }
+
+        NodeConstIterator itr = outer.children();
+        while(itr.has_next())
+        {
+            const Node &entry = itr.next();
+            std::string entry_name = itr.name();
 
-    // read the root file, it can be either json or hdf5
+            bool read = true;
+            if(outer_name == "fields")
+            {
+                if(has_fields)
+                {
+                    read = fields.find(entry_name) != fields.end();
+                }
+                else if(!all_topos && entry.has_child("topology"))
+                {
+                    read = topos.find(entry["topology"].as_string()) != topos.end();
+                }
+            }
+            else if(outer_name == "topologies")
+            {
+                read = all_topos || topos.find(entry_name) != topos.end();
+            }
+            else if(!all_topos && entry.has_child("topology"))
+            {
+                read = topos.find(entry["topology"].as_string()) != topos.end();
+            }
+
+            if(read)
+            {
+                selection[outer_name].append().set(entry_name);
+                if(outer_name == "topologies" && entry.has_child("coordset"))
+                {
+                    csets.insert(entry["coordset"].as_string());
+                }
+            }
+        }
+    }
+
+    if(mesh_index.has_child("coordsets"))
+    {
+        NodeConstIterator itr = mesh_index["coordsets"].children();
+        while(itr.has_next())
+        {
+            itr.next();
+            std::string cset_name = itr.name();
+            if(all_topos || csets.find(cset_name) != csets.end())
+            {
+                selection["coordsets"].append().set(cset_name);
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// reads the selected entries of one domain
+//-----------------------------------------------------------------------------
+void
+read_domain(const std::string &domain_file,
+            const std::string &data_protocol,
+            const std::string &tree_path,
+            const Node &mesh_index,
+            const Node &selection,
+            Node &mesh_out)
+{
+    relay::io::IOHandle hnd;
+    hnd.open(domain_file, data_protocol);
+
+    // special logic for state, since it was not included in the index
+    if(mesh_index.has_child("state"))
+    {
+        const Node &state = mesh_index["state"];
+        // we do need to read the state!
+        if(state.has_child("path"))
+        {
+            hnd.read(utils::join_path(tree_path,state["path"].as_string()),
+                     mesh_out["state"]);
+        }
+        else
+        {
+            if(state.has_child("cycle"))
+            {
+                mesh_out["state/cycle"] = state["cycle"];
+            }
+
+            if(state.has_child("time"))
+            {
+                mesh_out["state/time"] = state["time"];
+            }
+        }
+    }
+
+    NodeConstIterator outer_itr = selection.children();
+    while(outer_itr.has_next())
+    {
+        const Node &outer = outer_itr.next();
+        std::string outer_name = outer_itr.name();
+
+        NodeConstIterator itr = outer.children();
+        while(itr.has_next())
+        {
+            std::string entry_name = itr.next().as_string();
+            const Node &entry = mesh_index[outer_name][entry_name];
+            // check if it has a path
+            if(!entry.has_child("path"))
+            {
+                continue;
+            }
+
+            std::string fetch_path = utils::join_path(tree_path,
+                                                      entry["path"].as_string());
+            // some parts may not exist in all domains
+            // only read if they are there
+            if(hnd.has_path(fetch_path))
+            {
+                hnd.read(fetch_path,
+                         mesh_out[outer_name][entry_name]);
+            }
+        }
+    }
+
+    hnd.close();
+}
+
+//-----------------------------------------------------------------------------
+// read_domain for use in threads, returns an error message on failure
+//-----------------------------------------------------------------------------
+std::string
+try_read_domain(const std::string &domain_file,
+                const std::string &data_protocol,
+                const std::string &tree_path,
+                const Node &mesh_index,
+                const Node &selection,
+                Node &mesh_out)
+{
+    try
+    {
+        read_domain(domain_file,
+                    data_protocol,
+                    tree_path,
+                    mesh_index,
+                    selection,
+                    mesh_out);
+    }
+    catch(conduit::Error &e)
+    {
+        return e.message();
+    }
+    return "";
+}
+
+//-----------------------------------------------------------------------------
+// decodes fields compressed by relay extracts, returns an error message
+// on failure
+//-----------------------------------------------------------------------------
+std::string
+try_decode_fields(Node &mesh_out)
+{
+    try
+    {
+        field_codec::decode_fields(mesh_out);
+    }
+    catch(conduit::Error &e)
+    {
+        return e.message();
+    }
+    return "";
+}
+
+//-----------------------------------------------------------------------------
+// estimates the bytes of each domain from the size of its file
+//-----------------------------------------------------------------------------
+void
+domain_bytes(const std::vector<std::string> &domain_files,
+             std::vector<int64> &bytes)
+{
+    int num_domains = (int)domain_files.size();
+    bytes.assign(num_domains,0);
 
+    // domains that share a file split its size evenly
+    std::map<std::string,int> doms_per_file;
+    for(int i = 0; i < num_domains; i++)
+    {
+        doms_per_file[domain_files[i]]++;
+    }
+
+    std::map<std::string,int64> file_bytes;
+    std::map<std::string,int>::const_iterator itr;
+    for(itr = doms_per_file.begin(); itr != doms_per_file.end(); ++itr)
+    {
+        std::ifstream ifs(itr->first.c_str(),
+                          std::ifstream::binary | std::ifstream::ate);
+        int64 size = 0;
+        if(ifs.is_open())
+        {
+            size = (int64)ifs.tellg();
+        }
+        file_bytes[itr->first] = size;
+    }
+
+    for(int i = 0; i < num_domains; i++)
+    {
+        const std::string &fname = domain_files[i];
+        bytes[i] = file_bytes[fname] / doms_per_file[fname];
+    }
+}
+
+//-----------------------------------------------------------------------------
+// reads and checks a blueprint root file, it can be either json or hdf5
+//-----------------------------------------------------------------------------
+void
+load_root_file(const std::string &root_fname,
+               Node &root_node)
+{
     // assume hdf5, but check for json file
     std::string root_protocol = "hdf5";
 
@@ -271,7 +583,6 @@ void relay_blueprint_mesh_read(const Node &options,
        root_protocol = "json";
     }
 
-    Node root_node;
     relay::io::load(root_fname, root_protocol, root_node);
 
 
@@ -297,6 +608,51 @@ void relay_blueprint_mesh_read(const Node &options,
         ASCENT_ERROR("Mesh Blueprint index verify failed" << std::endl
                      << verify_info.to_json());
     }
+}
+
+//-----------------------------------------------------------------------------
+// generates the path of the file that holds each domain
+//-----------------------------------------------------------------------------
+void
+domain_file_paths(const std::string &root_fname,
+                  const Node &root_node,
+                  const BlueprintTreePathGenerator &gen,
+                  std::vector<std::string> &domain_files)
+{
+    int num_domains = root_node["number_of_trees"].to_int();
+
+    std::string current, next;
+    utils::rsplit_file_path (root_fname, current, next);
+
+    gen.GenerateFilePaths(domain_files);
+    for(int i = 0; i < num_domains; i++)
+    {
+        domain_files[i] = utils::join_path(next, domain_files[i]);
+    }
+}
+
+//-----------------------------------------------------------------------------
+//
+// options:
+//   root_file:  blueprint root file (required)
+//   mpi_comm:   mpi communicator id (mpi)
+//   fields:     optional list of fields to read
+//   topologies: optional list of topologies to read
+//   threads:    number of threads used to read domains (default: 4).
+//               hdf5 reads are serialized, threads overlap decoding
+//   balance:    "bytes" (default) or "count", how domains are divided
+//               across ranks
+//
+//-----------------------------------------------------------------------------
+void relay_blueprint_mesh_read(const Node &options,
+                               Node &data)
+{
+    std::string root_fname = options["root_file"].as_string();
+
+    Node root_node;
+    load_root_file(root_fname, root_node);
+
+    const Node &mesh_index = root_node["blueprint_index"].child(0);
 
     std::string data_protocol = "hdf5";
 
@@ -305,6 +661,9 @@ void relay_blueprint_mesh_read(const Node &options,
         data_protocol = root_node["protocol/name"].as_string();
     }
 
+    Node selection;
+    gen_read_selection(options, mesh_index, selection);
+
     // read the first mesh (all domains ...)
 
     int num_domains = root_node["number_of_trees"].to_int();
@@ -316,7 +675,8 @@ void relay_blueprint_mesh_read(const Node &options,
                                    data_protocol,
                                    mesh_index);
 
-    std::ostringstream oss;
+    std::vector<std::string> domain_files;
+    domain_file_paths(root_fname, root_node, gen, domain_files);
 
     int domain_start = 0;
     int domain_end = num_domains;
@@ -326,107 +686,160 @@ void relay_blueprint_mesh_read(const Node &options,
     int rank = relay::mpi::rank(comm);
     int total_size = relay::mpi::size(comm);
 
-    int read_size = num_domains / total_size;
-    int rem = num_domains % total_size;
-    if(rank < rem)
+    bool balance_bytes = true;
+    if(options.has_child("balance"))
     {
-      read_size++;
+        balance_bytes = options["balance"].as_string() != "count";
     }
 
-    conduit::Node n_read_size;
-    conduit::Node n_doms_per_rank;
-
-    n_read_size.set_int32(read_size);
+    // by default each rank reads a contiguous block of domains with
+    // about the same number of bytes, the sizes come from rank 0 so
+    // the file system only sees one set of queries
+    std::vector<int64> bytes(num_domains,0);
+    int64 total_bytes = 0;
+    if(balance_bytes && total_size > 1 && num_domains > 0)
+    {
+        if(rank == 0)
+        {
+            domain_bytes(domain_files, bytes);
+        }
+        MPI_Bcast(&bytes[0], num_domains, MPI_INT64_T, 0, comm);
 
-    relay::mpi::all_gather_using_schema(n_read_size,
-                                        n_doms_per_rank,
-                                        comm);
-    int *counts = (int*)n_doms_per_rank.data_ptr();
+        for(int i = 0; i < num_domains; i++)
+        {
+            total_bytes += bytes[i];
+        }
+    }
 
-    int rank_offset = 0;
-    for(int i = 0; i < rank; ++i)
+    if(total_bytes > 0)
     {
-      rank_offset += counts[i];
+        // a domain goes to the rank that owns the middle of its byte range
+        domain_start = num_domains;
+        domain_end = num_domains;
+        int64 prefix = 0;
+        for(int i = 0; i < num_domains; i++)
+        {
+            double mid = (double)prefix + 0.5 * (double)bytes[i];
+            int owner = (int)(mid * total_size / (double)total_bytes);
+            owner = std::min(owner, total_size - 1);
+            prefix += bytes[i];
+
+            if(owner == rank && domain_start == num_domains)
+            {
+                domain_start = i;
+            }
+            if(owner > rank)
+            {
+                domain_end = i;
+                break;
+            }
+        }
+        if(domain_start > domain_end)
+        {
+            domain_start = domain_end;
+        }
     }
+    else
+    {
+        int read_size = num_domains / total_size;
+        int rem = num_domains % total_size;
+        if(rank < rem)
+        {
+          read_size++;
+        }
 
-    domain_start = rank_offset;
-    domain_end = rank_offset + read_size;
-#endif
+        conduit::Node n_read_size;
+        conduit::Node n_doms_per_rank;
 
-    relay::io::IOHandle hnd;
-    for(int i = domain_start ; i < domain_end; i++)
-    {
-      char domain_fmt_buff[64];
-      snprintf(domain_fmt_buff, sizeof(domain_fmt_buff), "%06d",i);
-      oss.str("");
-      oss << "domain_" << std::string(domain_fmt_buff);
+        n_read_size.set_int32(read_size);
+
+        relay::mpi::all_gather_using_schema(n_read_size,
+                                            n_doms_per_rank,
+                                            comm);
+        int *counts = (int*)n_doms_per_rank.data_ptr();
 
-      std::string current, next;
-      utils::rsplit_file_path (root_fname, current, next);
-      std::string domain_file = utils::join_path(next, gen.GenerateFilePath(i));
+        int rank_offset = 0;
+        for(int i = 0; i < rank; ++i)
+        {
+          rank_offset += counts[i];
+        }
 
-      hnd.open(domain_file, data_protocol);
+        domain_start = rank_offset;
+        domain_end = rank_offset + read_size;
+    }
+#endif
 
-      // also need the tree path
-      std::string tree_path = gen.GenerateTreePath(i);
+    int num_local_domains = domain_end - domain_start;
 
-      //std::string mesh_path = conduit_fmt::format("domain_{:06d}",i);
-      std::string mesh_path = oss.str();
+    // create the outputs up front, threads only touch their own domain
+    std::vector<Node*> mesh_outs(num_local_domains);
+    std::ostringstream oss;
+    for(int i = 0; i < num_local_domains; i++)
+    {
+        char domain_fmt_buff[64];
+        snprintf(domain_fmt_buff, sizeof(domain_fmt_buff), "%06d",domain_start + i);
+        oss.str("");
+        oss << "domain_" << std::string(domain_fmt_buff);
+        mesh_outs[i] = &data[oss.str()];
+    }
 
-      Node &mesh_out = data[mesh_path];
+    int num_threads = 4;
+    if(options.has_child("threads"))
+    {
+        num_threads = std::max(1, options["threads"].to_int());
+    }
 
-      // read components of the mesh according to the mesh index
-      // for each child in the index
-      NodeConstIterator outer_itr = mesh_index.children();
-      while(outer_itr.has_next())
-      {
-        const Node &outer = outer_itr.next();
-        std::string outer_name = outer_itr.name();
+    // hdf5 is not thread safe, hdf5 calls are serialized
+    bool serialize_io = data_protocol.find("hdf5") != std::string::npos;
 
-        // special logic for state, since it was not included in the index
-        if(outer_name == "state" )
-        {
-          // we do need to read the state!
-          if(outer.has_child("path"))
-          {
-            hnd.read(utils::join_path(tree_path,outer["path"].as_string()),
-                     mesh_out[outer_name]);
-          }
-          else
-          {
-             if(outer.has_child("cycle"))
-             {
-                mesh_out[outer_name]["cycle"] = outer["cycle"];
-             }
-
-             if(outer.has_child("time"))
-             {
-               mesh_out[outer_name]["time"] = outer["time"];
-             }
-           }
-        }
+    std::vector<std::string> errors(num_local_domains);
 
-        NodeConstIterator itr = outer.children();
-        while(itr.has_next())
+#ifdef ASCENT_USE_OPENMP
+    #pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+#endif
+    for(int i = 0; i < num_local_domains; i++)
+    {
+        int domain_id = domain_start + i;
+        std::string tree_path = gen.GenerateTreePath(domain_id);
+        if(serialize_io)
         {
-          const Node &entry = itr.next();
-          // check if it has a path
-          if(entry.has_child("path"))
-          {
-            std::string entry_name = itr.name();
-            std::string entry_path = entry["path"].as_string();
-            std::string fetch_path = utils::join_path(tree_path,
-                                                      entry_path);
-            // some parts may not exist in all domains
-            // only read if they are there
-            if(hnd.has_path(fetch_path))
+#ifdef ASCENT_USE_OPENMP
+            #pragma omp critical(ascent_hola_hdf5)
+#endif
             {
-              hnd.read(fetch_path,
-                       mesh_out[outer_name][entry_name]);
+                errors[i] = try_read_domain(domain_files[domain_id],
+                                            data_protocol,
+                                            tree_path,
+                                            mesh_index,
+                                            selection,
+                                            *mesh_outs[i]);
             }
-          }
         }
-      }
+        else
+        {
+            errors[i] = try_read_domain(domain_files[domain_id],
+                                        data_protocol,
+                                        tree_path,
+                                        mesh_index,
+                                        selection,
+                                        *mesh_outs[i]);
+        }
+
+        // decoding happens outside of the io lock
+        if(errors[i].empty())
+        {
+            errors[i] = try_decode_fields(*mesh_outs[i]);
+        }
+    }
+
+    for(int i = 0; i < num_local_domains; i++)
+    {
+        if(!errors[i].empty())
+        {
+            ASCENT_ERROR("failed to read domain " << domain_start + i
+                         << " from " << domain_files[domain_start + i]
+                         << ": " << errors[i]);
+        }
     }
 }
 
@@ -455,6 +868,56 @@ void hola(const std::string &source,
 
 }
 
+//-----------------------------------------------------------------------------
+bool hola_hdf5_thread_safe()
+{
+#if defined(ASCENT_HDF5_ENABLED)
+    hbool_t thread_safe = 0;
+    if(H5is_library_threadsafe(&thread_safe) < 0)
+    {
+        return false;
+    }
+    return thread_safe > 0;
+#else
+    return true;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+int64 hola_file_bytes(const std::string &root_file)
+{
+    Node root_node;
+    load_root_file(root_file, root_node);
+
+    const Node &mesh_index = root_node["blueprint_index"].child(0);
+
+    std::string data_protocol = "hdf5";
+    if(root_node.has_child("protocol"))
+    {
+        data_protocol = root_node["protocol/name"].as_string();
+    }
+
+    BlueprintTreePathGenerator gen(root_node["file_pattern"].as_string(),
+                                   root_node["tree_pattern"].as_string(),
+                                   root_node["number_of_files"].to_int(),
+                                   root_node["number_of_trees"].to_int(),
+                                   data_protocol,
+                                   mesh_index);
+
+    std::vector<std::string> domain_files;
+    domain_file_paths(root_file, root_node, gen, domain_files);
+
+    std::vector<int64> bytes;
+    domain_bytes(domain_files, bytes);
+
+    int64 total_bytes = 0;
+    for(size_t i = 0; i < bytes.size(); i++)
+    {
+        total_bytes += bytes[i];
+    }
+    return total_bytes;
+}
+
 //-----------------------------------------------------------------------------
 // -- end ascent:: --
 //-----------------------------------------------------------------------------
@@ -71,6 +71,17 @@ void ASCENT_API hola(const std::string &source,
                      const conduit::Node &options,
                      conduit::Node &data);
 
+//-----------------------------------------------------------------------------
+// true if relay/blueprint/mesh reads can run while other threads use
+// hdf5 (e.g., relay extracts): hdf5 is disabled or built thread safe
+//-----------------------------------------------------------------------------
+bool ASCENT_API hola_hdf5_thread_safe();
+
+//-----------------------------------------------------------------------------
+// bytes on disk of the domain files a blueprint root file references
+//-----------------------------------------------------------------------------
+conduit::int64 ASCENT_API hola_file_bytes(const std::string &root_file);
+
 };
 //-----------------------------------------------------------------------------
 // -- end ascent:: --
@@ -62,7 +62,9 @@
 //-----------------------------------------------------------------------------
 #include <ascent_logging.hpp>
 
+#include <algorithm>
 #include <fstream>
+#include <map>
 
 using namespace conduit;
 using namespace std;
@@ -293,12 +295,622 @@ hola_mpi_recv(MPI_Comm comm,
     }
 }
 
+//-----------------------------------------------------------------------------
+// staging
+//-----------------------------------------------------------------------------
+
+// each receive slot uses its own tags for the domain counts,
+// message sizes and messages, so the two slots never match each
+// other's messages
+static const int HOLA_MPI_STAGE_TAG = 31000;
+
+enum HolaMPIStagePhase
+{
+    STAGE_IDLE = 0,
+    STAGE_COUNTS,
+    STAGE_SIZES,
+    STAGE_DATA,
+    STAGE_READY,
+    STAGE_CLOSED
+};
+
+//-----------------------------------------------------------------------------
+struct HolaMPIStage::Slot
+{
+    Slot()
+    : phase(STAGE_IDLE)
+    {}
+
+    int                      phase;
+    // domain counts per src (recv) or per dest (send)
+    std::vector<int64>       counts;
+    // message size per domain
+    std::vector<int64>       sizes;
+    // packed messages (send) or receive buffers (recv)
+    Node                     msgs;
+    std::vector<MPI_Request> requests;
+};
+
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+//-----------------------------------------------------------------------------
+int
+stage_tag(int slot_idx, int msg)
+{
+    return HOLA_MPI_STAGE_TAG + slot_idx * 3 + msg;
+}
+
+//-----------------------------------------------------------------------------
+// packs a domain the same way relay::mpi::send_using_schema does:
+// [int64 schema length][schema json][compact data]
+void
+stage_pack(const Node &dom, Node &msg)
+{
+    Schema s_data_compact;
+    if(dom.is_compact())
+    {
+        s_data_compact = dom.schema();
+    }
+    else
+    {
+        dom.schema().compact_to(s_data_compact);
+    }
+
+    std::string schema_json = s_data_compact.to_json();
+
+    Schema s_msg;
+    s_msg["schema_len"].set(DataType::int64());
+    s_msg["schema"].set(DataType::char8_str(schema_json.size()+1));
+    s_msg["data"].set(s_data_compact);
+
+    Schema s_msg_compact;
+    s_msg.compact_to(s_msg_compact);
+
+    msg.set_schema(s_msg_compact);
+    msg["schema_len"].set((int64)schema_json.size());
+    msg["schema"].set(schema_json);
+    msg["data"].update(dom);
+}
+
+//-----------------------------------------------------------------------------
+void
+stage_unpack(const Node &buff, Node &dom)
+{
+    uint8 *buff_ptr = (uint8*)buff.data_ptr();
+
+    Node n_msg;
+    n_msg["schema_len"].set_external((int64*)buff_ptr);
+    int64 schema_len = n_msg["schema_len"].value();
+    n_msg["schema"].set_external_char8_str((char*)(buff_ptr+8));
+
+    Schema rcv_schema;
+    Generator gen(n_msg["schema"].as_char8_str());
+    gen.walk(rcv_schema);
+
+    n_msg["data"].set_external(rcv_schema, buff_ptr + 8 + schema_len + 1);
+    dom.update(n_msg["data"]);
+}
+
+//-----------------------------------------------------------------------------
+// returns true when all requests are done
+bool
+stage_complete(std::vector<MPI_Request> &requests, bool block)
+{
+    if(requests.empty())
+    {
+        return true;
+    }
+
+    int flag = 1;
+    if(block)
+    {
+        MPI_Waitall((int)requests.size(),
+                    &requests[0],
+                    MPI_STATUSES_IGNORE);
+    }
+    else
+    {
+        MPI_Testall((int)requests.size(),
+                    &requests[0],
+                    &flag,
+                    MPI_STATUSES_IGNORE);
+    }
+
+    if(flag)
+    {
+        requests.clear();
+    }
+    return flag != 0;
+}
+
+//-----------------------------------------------------------------------------
+// stages used by hola_mpi, keyed by (mpi_comm, rank_split)
+std::map<std::pair<int,int>, HolaMPIStage*> &
+stages()
+{
+    static std::map<std::pair<int,int>, HolaMPIStage*> res;
+    return res;
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end detail:: --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+HolaMPIStage::HolaMPIStage(MPI_Comm comm, int rank_split)
+: m_comm(comm),
+  m_rank_split(rank_split),
+  m_has_comm_map(false),
+  m_closed(false),
+  m_cycle(0)
+{
+    // source ranks are 0 to rank_split - 1
+    m_is_source = relay::mpi::rank(comm) < rank_split;
+    m_slots[0] = new Slot();
+    m_slots[1] = new Slot();
+}
+
+//-----------------------------------------------------------------------------
+HolaMPIStage::~HolaMPIStage()
+{
+    delete m_slots[0];
+    delete m_slots[1];
+}
+
+//-----------------------------------------------------------------------------
+bool
+HolaMPIStage::is_source() const
+{
+    return m_is_source;
+}
+
+//-----------------------------------------------------------------------------
+void
+HolaMPIStage::init_comm_map(const Node &data)
+{
+    int total_size = relay::mpi::size(m_comm);
+
+    Node my_maps;
+    my_maps["wts"] = DataType::int32(total_size);
+    my_maps["wtd"] = DataType::int32(total_size);
+
+    int32_array world_to_src  = my_maps["wts"].value();
+    int32_array world_to_dest = my_maps["wtd"].value();
+
+    for(int i=0;i<total_size;i++)
+    {
+        if(i < m_rank_split)
+        {
+            world_to_dest[i] = -1;
+            world_to_src[i]  = i;
+        }
+        else
+        {
+            world_to_dest[i] = i - m_rank_split;
+            world_to_src[i] = -1;
+        }
+    }
+
+    hola_mpi_comm_map(data,
+                      m_comm,
+                      world_to_src,
+                      world_to_dest,
+                      m_comm_map);
+    m_has_comm_map = true;
+}
+
+//-----------------------------------------------------------------------------
+void
+HolaMPIStage::wait_sends(Slot &slot)
+{
+    detail::stage_complete(slot.requests, true);
+    slot.msgs.reset();
+}
+
+//-----------------------------------------------------------------------------
+void
+HolaMPIStage::send(const Node &data)
+{
+    if(!m_is_source)
+    {
+        ASCENT_ERROR("hola_mpi staging: send called on a destination rank");
+    }
+
+    if(m_closed)
+    {
+        ASCENT_ERROR("hola_mpi staging: send called after close");
+    }
+
+    // make sure we have multi domain data
+    const Node *data_ptr = &data;
+    Node md_data;
+    if(!blueprint::mesh::is_multi_domain(data))
+    {
+        md_data.append().set_external(data);
+        data_ptr = &md_data;
+    }
+
+    if(!m_has_comm_map)
+    {
+        init_comm_map(*data_ptr);
+    }
+
+    int slot_idx = m_cycle % 2;
+    Slot &slot = *m_slots[slot_idx];
+    // the sends from two cycles ago must be done before we reuse the slot
+    wait_sends(slot);
+
+    const int32 *src_counts    = m_comm_map["src_counts"].value();
+    const int32 *src_offsets   = m_comm_map["src_offsets"].value();
+    const int32 *dest_counts   = m_comm_map["dest_counts"].value();
+    const int32 *dest_offsets  = m_comm_map["dest_offsets"].value();
+    const int32 *dest_to_world = m_comm_map["dest_to_world"].value();
+    int dest_size = m_comm_map["dest_to_world"].dtype().number_of_elements();
+
+    int src_idx = relay::mpi::rank(m_comm);
+    int num_doms = data_ptr->number_of_children();
+
+    // the map is built from the first cycle, if the number of local
+    // domains grows the extra domains go to the dest of our last domain
+    std::vector<int> dom_dest(num_doms);
+    slot.counts.assign(dest_size,0);
+    for(int i = 0; i < num_doms; i++)
+    {
+        int32 g = src_offsets[src_idx];
+        if(src_counts[src_idx] > 0)
+        {
+            g += std::min(i, src_counts[src_idx] - 1);
+        }
+
+        int dest_idx = 0;
+        while(dest_idx < dest_size - 1 &&
+              g >= dest_offsets[dest_idx] + dest_counts[dest_idx])
+        {
+            dest_idx++;
+        }
+        dom_dest[i] = dest_idx;
+        slot.counts[dest_idx]++;
+    }
+
+    // copy the domains into the slot, the caller is free to change
+    // data as soon as we return
+    slot.sizes.resize(num_doms);
+    for(int i = 0; i < num_doms; i++)
+    {
+        Node &msg = slot.msgs.append();
+        detail::stage_pack(data_ptr->child(i), msg);
+        slot.sizes[i] = (int64)msg.total_bytes_compact();
+    }
+
+    slot.requests.resize(dest_size + 2 * num_doms);
+    int req = 0;
+    for(int d = 0; d < dest_size; d++)
+    {
+        MPI_Isend(&slot.counts[d],
+                  1,
+                  MPI_INT64_T,
+                  dest_to_world[d],
+                  detail::stage_tag(slot_idx,0),
+                  m_comm,
+                  &slot.requests[req++]);
+    }
+
+    for(int i = 0; i < num_doms; i++)
+    {
+        int dest_rank = dest_to_world[dom_dest[i]];
+        MPI_Isend(&slot.sizes[i],
+                  1,
+                  MPI_INT64_T,
+                  dest_rank,
+                  detail::stage_tag(slot_idx,1),
+                  m_comm,
+                  &slot.requests[req++]);
+
+        MPI_Isend(slot.msgs.child(i).data_ptr(),
+                  (int)slot.sizes[i],
+                  MPI_BYTE,
+                  dest_rank,
+                  detail::stage_tag(slot_idx,2),
+                  m_comm,
+                  &slot.requests[req++]);
+    }
+
+    m_cycle++;
+}
+
+//-----------------------------------------------------------------------------
+void
+HolaMPIStage::close()
+{
+    if(!m_is_source || m_closed)
+    {
+        return;
+    }
+
+    wait_sends(*m_slots[0]);
+    wait_sends(*m_slots[1]);
+
+    // destinations that never received a cycle are still waiting to
+    // build the comm map
+    if(!m_has_comm_map)
+    {
+        Node empty;
+        init_comm_map(empty);
+    }
+
+    const int32 *dest_to_world = m_comm_map["dest_to_world"].value();
+    int dest_size = m_comm_map["dest_to_world"].dtype().number_of_elements();
+
+    // a negative domain count ends the stream, send it for both slots
+    // to complete the receives posted by the destinations
+    int64 done = -1;
+    for(int s = 0; s < 2; s++)
+    {
+        for(int d = 0; d < dest_size; d++)
+        {
+            MPI_Send(&done,
+                     1,
+                     MPI_INT64_T,
+                     dest_to_world[d],
+                     detail::stage_tag(s,0),
+                     m_comm);
+        }
+    }
+
+    m_closed = true;
+}
+
+//-----------------------------------------------------------------------------
+void
+HolaMPIStage::post_recv(Slot &slot, int slot_idx)
+{
+    const int32 *src_to_world = m_comm_map["src_to_world"].value();
+    int src_size = m_comm_map["src_to_world"].dtype().number_of_elements();
+
+    slot.msgs.reset();
+    slot.sizes.clear();
+    slot.counts.assign(src_size,0);
+    slot.requests.resize(src_size);
+    for(int s = 0; s < src_size; s++)
+    {
+        MPI_Irecv(&slot.counts[s],
+                  1,
+                  MPI_INT64_T,
+                  src_to_world[s],
+                  detail::stage_tag(slot_idx,0),
+                  m_comm,
+                  &slot.requests[s]);
+    }
+    slot.phase = STAGE_COUNTS;
+}
+
+//-----------------------------------------------------------------------------
+bool
+HolaMPIStage::advance_recv(Slot &slot, int slot_idx, bool block)
+{
+    const int32 *src_to_world = m_comm_map["src_to_world"].value();
+    int src_size = m_comm_map["src_to_world"].dtype().number_of_elements();
+
+    while(slot.phase != STAGE_READY &&
+          slot.phase != STAGE_CLOSED)
+    {
+        if(!detail::stage_complete(slot.requests, block))
+        {
+            return false;
+        }
+
+        if(slot.phase == STAGE_COUNTS)
+        {
+            int64 num_doms = 0;
+            bool closed = false;
+            for(int s = 0; s < src_size; s++)
+            {
+                if(slot.counts[s] < 0)
+                {
+                    closed = true;
+                }
+                else
+                {
+                    num_doms += slot.counts[s];
+                }
+            }
+
+            if(closed)
+            {
+                slot.phase = STAGE_CLOSED;
+                break;
+            }
+
+            slot.sizes.assign(num_doms,0);
+            slot.requests.resize(num_doms);
+            int dom = 0;
+            for(int s = 0; s < src_size; s++)
+            {
+                for(int64 i = 0; i < slot.counts[s]; i++)
+                {
+                    MPI_Irecv(&slot.sizes[dom],
+                              1,
+                              MPI_INT64_T,
+                              src_to_world[s],
+                              detail::stage_tag(slot_idx,1),
+                              m_comm,
+                              &slot.requests[dom]);
+                    dom++;
+                }
+            }
+            slot.phase = STAGE_SIZES;
+        }
+        else if(slot.phase == STAGE_SIZES)
+        {
+            slot.requests.resize(slot.sizes.size());
+            int dom = 0;
+            for(int s = 0; s < src_size; s++)
+            {
+                for(int64 i = 0; i < slot.counts[s]; i++)
+                {
+                    Node &buff = slot.msgs.append();
+                    buff.set(DataType::uint8(slot.sizes[dom]));
+                    MPI_Irecv(buff.data_ptr(),
+                              (int)slot.sizes[dom],
+                              MPI_BYTE,
+                              src_to_world[s],
+                              detail::stage_tag(slot_idx,2),
+                              m_comm,
+                              &slot.requests[dom]);
+                    dom++;
+                }
+            }
+            slot.phase = STAGE_DATA;
+        }
+        else if(slot.phase == STAGE_DATA)
+        {
+            slot.phase = STAGE_READY;
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void
+HolaMPIStage::progress()
+{
+    if(m_is_source || !m_has_comm_map || m_closed)
+    {
+        return;
+    }
+
+    // slots use distinct tags, so both can advance independently
+    advance_recv(*m_slots[m_cycle % 2], m_cycle % 2, false);
+    advance_recv(*m_slots[(m_cycle + 1) % 2], (m_cycle + 1) % 2, false);
+}
+
+//-----------------------------------------------------------------------------
+bool
+HolaMPIStage::recv(Node &data)
+{
+    if(m_is_source)
+    {
+        ASCENT_ERROR("hola_mpi staging: recv called on a source rank");
+    }
+
+    data.reset();
+
+    if(m_closed)
+    {
+        return false;
+    }
+
+    if(!m_has_comm_map)
+    {
+        Node empty;
+        init_comm_map(empty);
+        post_recv(*m_slots[0],0);
+        post_recv(*m_slots[1],1);
+    }
+
+    int slot_idx = m_cycle % 2;
+    Slot &slot = *m_slots[slot_idx];
+    advance_recv(slot, slot_idx, true);
+
+    if(slot.phase == STAGE_CLOSED)
+    {
+        // the end marker was sent for both slots
+        int next_idx = (m_cycle + 1) % 2;
+        Slot &next = *m_slots[next_idx];
+        while(next.phase != STAGE_CLOSED)
+        {
+            advance_recv(next, next_idx, true);
+            if(next.phase == STAGE_READY)
+            {
+                // a cycle can't follow the end marker
+                ASCENT_ERROR("hola_mpi staging: data received after close");
+            }
+        }
+        m_closed = true;
+        return false;
+    }
+
+    // hand off the cycle
+    NodeConstIterator itr = slot.msgs.children();
+    while(itr.has_next())
+    {
+        detail::stage_unpack(itr.next(), data.append());
+    }
+
+    // the slot now waits for the cycle after next
+    post_recv(slot, slot_idx);
+    m_cycle++;
+    progress();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void
+hola_mpi_close_staging(const conduit::Node &options)
+{
+    int comm_id = options["mpi_comm"].to_int();
+    int rank_split = options["rank_split"].to_int();
+
+    std::pair<int,int> key(comm_id, rank_split);
+    std::map<std::pair<int,int>, HolaMPIStage*> &stages = detail::stages();
+    std::map<std::pair<int,int>, HolaMPIStage*>::iterator itr = stages.find(key);
+
+    if(itr != stages.end() && itr->second->is_source())
+    {
+        itr->second->close();
+        delete itr->second;
+        stages.erase(itr);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+hola_mpi_staged(const conduit::Node &options,
+                conduit::Node &data)
+{
+    int comm_id = options["mpi_comm"].to_int();
+    int rank_split = options["rank_split"].to_int();
+
+    std::pair<int,int> key(comm_id, rank_split);
+    std::map<std::pair<int,int>, HolaMPIStage*> &stages = detail::stages();
+
+    if(stages.find(key) == stages.end())
+    {
+        stages[key] = new HolaMPIStage(MPI_Comm_f2c(comm_id), rank_split);
+    }
+
+    HolaMPIStage *stage = stages[key];
+
+    if(stage->is_source())
+    {
+        stage->send(data);
+    }
+    else
+    {
+        // once the sources are done data is left empty. the closed stage
+        // is kept, so later calls do not redo its (collective) setup
+        stage->recv(data);
+    }
+}
+
 
 //-----------------------------------------------------------------------------
 void
 hola_mpi(const conduit::Node &options,
          conduit::Node &data)
 {
+    if(options.has_child("staging") &&
+       options["staging"].as_string() == "async")
+    {
+        hola_mpi_staged(options,data);
+        return;
+    }
+
     MPI_Comm comm  = MPI_Comm_f2c(options["mpi_comm"].to_int());
     // get my rank
     int rank = relay::mpi::rank(comm);
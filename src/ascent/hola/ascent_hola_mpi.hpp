@@ -56,6 +56,7 @@
 #include <ascent_exports.h>
 
 #include <string>
+#include <vector>
 #include <conduit.hpp>
 
 #include <mpi.h>
@@ -91,6 +92,63 @@ void ASCENT_API hola_mpi_recv(MPI_Comm comm,
                               const conduit::Node &comm_map,
                               conduit::Node &data);
 
+/// completes outstanding staged sends for the stage opened with the
+/// given options (mpi_comm and rank_split) on source ranks and tells the
+/// destination ranks that no more cycles will follow.
+/// (called by Ascent::close for the stages its extracts used)
+void ASCENT_API hola_mpi_close_staging(const conduit::Node &options);
+
+//-----------------------------------------------------------------------------
+/// Nonblocking in transit staging between source and destination ranks.
+///
+/// Source ranks copy each cycle into a send slot, post nonblocking
+/// schema plus payload sends and return. Destination ranks keep two
+/// receive slots, so the next cycle arrives while the current one is
+/// processed. Each cycle is handed off to the caller by recv().
+///
+/// The source to destination domain map is built (collectively) on
+/// the first send / recv, later cycles are not collective.
+/// MPI is not used by the destructor, sources must call close()
+/// before MPI_Finalize.
+//-----------------------------------------------------------------------------
+class ASCENT_API HolaMPIStage
+{
+public:
+    HolaMPIStage(MPI_Comm comm, int rank_split);
+    ~HolaMPIStage();
+
+    bool is_source() const;
+
+    /// source: copies data and posts sends for it, waits only for the
+    /// sends posted two cycles ago.
+    void send(const conduit::Node &data);
+    /// source: completes posted sends and signals the end of the stream.
+    void close();
+
+    /// destination: waits for the next cycle and hands it off (data is
+    /// reset). returns false once the sources have closed.
+    bool recv(conduit::Node &data);
+    /// destination: advances outstanding receives without blocking.
+    void progress();
+
+private:
+    struct Slot;
+
+    void init_comm_map(const conduit::Node &data);
+    void post_recv(Slot &slot, int slot_idx);
+    bool advance_recv(Slot &slot, int slot_idx, bool block);
+    void wait_sends(Slot &slot);
+
+    MPI_Comm      m_comm;
+    int           m_rank_split;
+    bool          m_is_source;
+    bool          m_has_comm_map;
+    bool          m_closed;
+    int           m_cycle;
+    conduit::Node m_comm_map;
+    Slot         *m_slots[2];
+};
+
 };
 //-----------------------------------------------------------------------------
 // -- end ascent:: --
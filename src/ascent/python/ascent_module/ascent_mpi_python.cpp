@@ -309,7 +309,11 @@ PyAscent_MPI_Ascent_publish(PyAscent_MPI_Ascent *self,
     }
 
     Node *node = PyConduit_Node_Get_Node_Ptr(py_node);
+    // release the GIL while ascent runs, python extracts
+    // reacquire it as needed
+    Py_BEGIN_ALLOW_THREADS
     self->ascent->publish(*node);
+    Py_END_ALLOW_THREADS
 
     Py_RETURN_NONE;
 }
@@ -345,7 +349,11 @@ PyAscent_MPI_Ascent_execute(PyAscent_MPI_Ascent *self,
     }
 
     Node *node = PyConduit_Node_Get_Node_Ptr(py_node);
+    // release the GIL while ascent runs, python extracts
+    // reacquire it as needed
+    Py_BEGIN_ALLOW_THREADS
     self->ascent->execute(*node);
+    Py_END_ALLOW_THREADS
 
     Py_RETURN_NONE;
 }
@@ -381,7 +389,11 @@ PyAscent_MPI_Ascent_info(PyAscent_MPI_Ascent *self,
     }
 
     Node *node = PyConduit_Node_Get_Node_Ptr(py_node);
+    // release the GIL while ascent runs, python extracts
+    // reacquire it as needed
+    Py_BEGIN_ALLOW_THREADS
     self->ascent->info(*node);
+    Py_END_ALLOW_THREADS
 
     Py_RETURN_NONE;
 }
@@ -391,7 +403,11 @@ PyAscent_MPI_Ascent_info(PyAscent_MPI_Ascent *self,
 static PyObject *
 PyAscent_MPI_Ascent_close(PyAscent_MPI_Ascent *self)
 {
+    // release the GIL while ascent runs, python extracts
+    // reacquire it as needed
+    Py_BEGIN_ALLOW_THREADS
     self->ascent->close();
+    Py_END_ALLOW_THREADS
     Py_RETURN_NONE;
 }
 
@@ -353,12 +353,16 @@ PyAscent_Ascent_publish(PyAscent_Ascent *self,
 
     Node *node = PyConduit_Node_Get_Node_Ptr(py_node);
 
+    // release the GIL while ascent runs, python extracts
+    // reacquire it as needed
+    PyThreadState *py_ts = PyEval_SaveThread();
     try
     {
         self->ascent->publish(*node);
     }
     catch(conduit::Error e)
     {
+        PyEval_RestoreThread(py_ts);
         PyAscent_Ascent_Error_To_PyErr(e);
         return NULL;
     }
@@ -366,14 +370,17 @@ PyAscent_Ascent_publish(PyAscent_Ascent *self,
     // from crashing due to uncaught exception
     catch(std::exception &e)
     {
+        PyEval_RestoreThread(py_ts);
         PyAscent_Cpp_Error_To_PyErr(e.what());
         return NULL;
     }
     catch(...)
     {
+        PyEval_RestoreThread(py_ts);
         PyAscent_Cpp_Error_To_PyErr("unknown cpp exception thrown");
         return NULL;
     }
+    PyEval_RestoreThread(py_ts);
 
     Py_RETURN_NONE;
 }
@@ -409,12 +416,16 @@ PyAscent_Ascent_execute(PyAscent_Ascent *self,
     }
 
     Node *node = PyConduit_Node_Get_Node_Ptr(py_node);
+    // release the GIL while ascent runs, python extracts
+    // reacquire it as needed
+    PyThreadState *py_ts = PyEval_SaveThread();
     try
     {
         self->ascent->execute(*node);
     }
     catch(conduit::Error e)
     {
+        PyEval_RestoreThread(py_ts);
         PyAscent_Ascent_Error_To_PyErr(e);
         return NULL;
     }
@@ -422,14 +433,17 @@ PyAscent_Ascent_execute(PyAscent_Ascent *self,
     // from crashing due to uncaught exception
     catch(std::exception &e)
     {
+        PyEval_RestoreThread(py_ts);
         PyAscent_Cpp_Error_To_PyErr(e.what());
         return NULL;
     }
     catch(...)
     {
+        PyEval_RestoreThread(py_ts);
         PyAscent_Cpp_Error_To_PyErr("unknown cpp exception thrown");
         return NULL;
     }
+    PyEval_RestoreThread(py_ts);
 
     Py_RETURN_NONE;
 }
@@ -466,12 +480,16 @@ PyAscent_Ascent_info(PyAscent_Ascent *self,
 
     Node *node = PyConduit_Node_Get_Node_Ptr(py_node);
 
+    // release the GIL while ascent runs, python extracts
+    // reacquire it as needed
+    PyThreadState *py_ts = PyEval_SaveThread();
     try
     {
-            self->ascent->info(*node);
+        self->ascent->info(*node);
     }
     catch(conduit::Error e)
     {
+        PyEval_RestoreThread(py_ts);
         PyAscent_Ascent_Error_To_PyErr(e);
         return NULL;
     }
@@ -479,15 +497,17 @@ PyAscent_Ascent_info(PyAscent_Ascent *self,
     // from crashing due to uncaught exception
     catch(std::exception &e)
     {
+        PyEval_RestoreThread(py_ts);
         PyAscent_Cpp_Error_To_PyErr(e.what());
         return NULL;
     }
     catch(...)
     {
+        PyEval_RestoreThread(py_ts);
         PyAscent_Cpp_Error_To_PyErr("unknown cpp exception thrown");
         return NULL;
     }
-
+    PyEval_RestoreThread(py_ts);
 
     Py_RETURN_NONE;
 }
@@ -497,12 +517,16 @@ PyAscent_Ascent_info(PyAscent_Ascent *self,
 static PyObject *
 PyAscent_Ascent_close(PyAscent_Ascent *self)
 {
+    // release the GIL while ascent runs, python extracts
+    // reacquire it as needed
+    PyThreadState *py_ts = PyEval_SaveThread();
     try
     {
         self->ascent->close();
     }
     catch(conduit::Error e)
     {
+        PyEval_RestoreThread(py_ts);
         PyAscent_Ascent_Error_To_PyErr(e);
         return NULL;
     }
@@ -510,14 +534,17 @@ PyAscent_Ascent_close(PyAscent_Ascent *self)
     // from crashing due to uncaught exception
     catch(std::exception &e)
     {
+        PyEval_RestoreThread(py_ts);
         PyAscent_Cpp_Error_To_PyErr(e.what());
         return NULL;
     }
     catch(...)
     {
+        PyEval_RestoreThread(py_ts);
         PyAscent_Cpp_Error_To_PyErr("unknown cpp exception thrown");
         return NULL;
     }
+    PyEval_RestoreThread(py_ts);
 
     Py_RETURN_NONE;
 }
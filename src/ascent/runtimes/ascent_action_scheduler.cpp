@@ -0,0 +1,493 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_action_scheduler.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "ascent_action_scheduler.hpp"
+#include "ascent_logging.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#ifdef ASCENT_MPI_ENABLED
+#include <mpi.h>
+#endif
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+namespace detail
+{
+// weight of the newest measurement in the cost estimates
+const double cost_smoothing = 0.5;
+
+// degraded costs are assumed to be this fraction of the full cost
+// until they are measured
+const double degraded_guess = 0.5;
+
+static void smooth(double measured, double &cost, bool &has_cost)
+{
+  cost = has_cost ? cost_smoothing * measured + (1.0 - cost_smoothing) * cost
+                  : measured;
+  has_cost = true;
+}
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+ActionScheduler::ActionScheduler()
+: m_budget(0.0),
+  m_fixed_cost(0.0),
+  m_fixed_measured(false)
+{
+}
+
+//-----------------------------------------------------------------------------
+void
+ActionScheduler::budget(double seconds)
+{
+  if(seconds < 0.0)
+  {
+    ASCENT_ERROR("schedule budget must be >= 0, not "<<seconds);
+  }
+  m_budget = seconds;
+}
+
+//-----------------------------------------------------------------------------
+double
+ActionScheduler::budget() const
+{
+  return m_budget;
+}
+
+//-----------------------------------------------------------------------------
+bool
+ActionScheduler::enabled() const
+{
+  return m_budget > 0.0;
+}
+
+//-----------------------------------------------------------------------------
+double
+ActionScheduler::estimate(const Item &item, bool degraded) const
+{
+  if(!degraded)
+  {
+    return item.cost;
+  }
+  return item.degraded_measured ? item.degraded_cost
+                                : item.cost * detail::degraded_guess;
+}
+
+//-----------------------------------------------------------------------------
+void
+ActionScheduler::schedule(const conduit::Node &actions,
+                          conduit::Node &out,
+                          std::set<std::string> &gated)
+{
+  //
+  // find the scenes and extracts and their schedule params
+  //
+  std::set<std::string> present;
+  const int num_actions = actions.number_of_children();
+  for(int a = 0; a < num_actions; ++a)
+  {
+    const conduit::Node &action = actions.child(a);
+    if(!action.has_child("action"))
+    {
+      continue;
+    }
+
+    const std::string action_name = action["action"].as_string();
+    std::string kind;
+    if(action_name == "add_scenes")
+    {
+      kind = "scenes";
+    }
+    else if(action_name == "add_extracts")
+    {
+      kind = "extracts";
+    }
+
+    if(kind == "" || !action.has_child(kind))
+    {
+      continue;
+    }
+
+    const conduit::Node &items = action[kind];
+    const std::vector<std::string> names = items.child_names();
+    for(size_t i = 0; i < names.size(); ++i)
+    {
+      const conduit::Node &n_item = items[names[i]];
+      const std::string key = kind + "/" + names[i];
+      present.insert(key);
+
+      std::map<std::string,Item>::iterator itr = m_items.find(key);
+      if(itr == m_items.end())
+      {
+        Item item;
+        item.cost = 0.0;
+        item.degraded_cost = 0.0;
+        item.measured = false;
+        item.degraded_measured = false;
+        item.waited = 0;
+        itr = m_items.insert(std::make_pair(key, item)).first;
+      }
+
+      Item &item = itr->second;
+      // filter that runs the scene or extract (see CreateScenes and
+      // ConvertExtractToFlow)
+      item.sink = kind == "scenes" ? "exec_" + names[i] : names[i];
+      item.priority = 1.0;
+      item.min_frequency = 0;
+      item.has_degraded = n_item.has_path("schedule/degraded");
+      if(n_item.has_path("schedule/priority"))
+      {
+        item.priority = n_item["schedule/priority"].to_float64();
+      }
+      if(n_item.has_path("schedule/min_frequency"))
+      {
+        item.min_frequency = n_item["schedule/min_frequency"].to_int32();
+      }
+    }
+  }
+
+  // forget what is no longer in the actions
+  std::map<std::string,Item>::iterator itr = m_items.begin();
+  while(itr != m_items.end())
+  {
+    if(present.find(itr->first) == present.end())
+    {
+      itr = m_items.erase(itr);
+    }
+    else
+    {
+      ++itr;
+    }
+  }
+
+  //
+  // decide: items due for their min frequency come first, then items
+  // we have not measured yet, then the rest by priority per second
+  // (boosted by how long they waited)
+  //
+  std::vector<std::string> order;
+  for(itr = m_items.begin(); itr != m_items.end(); ++itr)
+  {
+    order.push_back(itr->first);
+  }
+
+  std::stable_sort(order.begin(), order.end(),
+    [this](const std::string &a, const std::string &b)
+    {
+      const Item &ia = m_items.at(a);
+      const Item &ib = m_items.at(b);
+      const bool due_a = ia.min_frequency > 0 && ia.waited + 1 >= ia.min_frequency;
+      const bool due_b = ib.min_frequency > 0 && ib.waited + 1 >= ib.min_frequency;
+      if(due_a != due_b)
+      {
+        return due_a;
+      }
+      if(ia.measured != ib.measured)
+      {
+        return !ia.measured;
+      }
+      const double score_a = ia.priority * (ia.waited + 1) / std::max(ia.cost, 1e-6);
+      const double score_b = ib.priority * (ib.waited + 1) / std::max(ib.cost, 1e-6);
+      return score_a > score_b;
+    });
+
+  double available = m_budget - (m_fixed_measured ? m_fixed_cost : 0.0);
+  for(size_t i = 0; i < order.size(); ++i)
+  {
+    Item &item = m_items[order[i]];
+    const bool due = item.min_frequency > 0 &&
+                     item.waited + 1 >= item.min_frequency;
+
+    if(!item.measured)
+    {
+      // run once to learn what it costs
+      item.state = "run";
+    }
+    else if(estimate(item, false) <= available)
+    {
+      item.state = "run";
+      available -= estimate(item, false);
+    }
+    else if(item.has_degraded && estimate(item, true) <= available)
+    {
+      item.state = "degraded";
+      available -= estimate(item, true);
+    }
+    else if(due)
+    {
+      item.state = item.has_degraded ? "degraded" : "run";
+      available -= estimate(item, item.has_degraded);
+    }
+    else
+    {
+      item.state = "deferred";
+    }
+
+    item.waited = item.state == "deferred" ? item.waited + 1 : 0;
+  }
+
+  //
+  // build the actions to execute, deferred items are gated
+  //
+  out.reset();
+  gated.clear();
+  for(int a = 0; a < num_actions; ++a)
+  {
+    const conduit::Node &action = actions.child(a);
+    std::string action_name;
+    if(action.has_child("action"))
+    {
+      action_name = action["action"].as_string();
+    }
+
+    std::string kind;
+    if(action_name == "add_scenes")
+    {
+      kind = "scenes";
+    }
+    else if(action_name == "add_extracts")
+    {
+      kind = "extracts";
+    }
+
+    conduit::Node &n_action = out.append();
+    n_action.set(action);
+    if(kind == "" || !action.has_child(kind))
+    {
+      continue;
+    }
+
+    conduit::Node &items = n_action[kind];
+    const std::vector<std::string> names = items.child_names();
+    for(size_t i = 0; i < names.size(); ++i)
+    {
+      conduit::Node &n_item = items[names[i]];
+      const Item &item = m_items[kind + "/" + names[i]];
+      if(item.state == "deferred")
+      {
+        gated.insert(item.sink);
+      }
+      else if(item.state == "degraded")
+      {
+        n_item.update(n_item["schedule/degraded"]);
+      }
+
+      if(n_item.has_child("schedule"))
+      {
+        n_item.remove("schedule");
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+std::string
+ActionScheduler::token() const
+{
+  std::string res;
+  std::map<std::string,Item>::const_iterator itr;
+  for(itr = m_items.begin(); itr != m_items.end(); ++itr)
+  {
+    if(itr->second.state == "degraded")
+    {
+      res += ";" + itr->first;
+    }
+  }
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+void
+ActionScheduler::record(const flow::Workspace &w, double total_time)
+{
+  const std::map<std::string,double> &times = w.filter_times();
+  const flow::Graph &graph = w.graph();
+
+  // the filters each scene and extract that ran depends on
+  std::map<std::string,std::set<std::string>> closures;
+  std::set<std::string> item_filters;
+  std::map<std::string,Item>::iterator itr;
+  for(itr = m_items.begin(); itr != m_items.end(); ++itr)
+  {
+    const Item &item = itr->second;
+    if(item.state != "deferred" && times.find(item.sink) != times.end())
+    {
+      std::set<std::string> &closure = closures[itr->first];
+      graph.upstream(item.sink, closure);
+      item_filters.insert(closure.begin(), closure.end());
+    }
+  }
+
+  // anything that other work depends on runs anyway, it is a fixed cost
+  std::set<std::string> fixed;
+  std::map<std::string,double>::const_iterator t_itr;
+  for(t_itr = times.begin(); t_itr != times.end(); ++t_itr)
+  {
+    if(item_filters.find(t_itr->first) == item_filters.end())
+    {
+      graph.upstream(t_itr->first, fixed);
+    }
+  }
+
+  // filters shared by scenes and extracts are split between them
+  std::map<std::string,int> users;
+  std::map<std::string,std::set<std::string>>::const_iterator c_itr;
+  for(c_itr = closures.begin(); c_itr != closures.end(); ++c_itr)
+  {
+    const std::set<std::string> &closure = c_itr->second;
+    for(auto f = closure.begin(); f != closure.end(); ++f)
+    {
+      if(fixed.find(*f) == fixed.end())
+      {
+        users[*f]++;
+      }
+    }
+  }
+
+  // one entry per item (-1 if not measured) and the total
+  std::vector<double> costs;
+  for(itr = m_items.begin(); itr != m_items.end(); ++itr)
+  {
+    double cost = -1.0;
+    c_itr = closures.find(itr->first);
+    if(c_itr != closures.end())
+    {
+      cost = 0.0;
+      const std::set<std::string> &closure = c_itr->second;
+      for(auto f = closure.begin(); f != closure.end(); ++f)
+      {
+        t_itr = times.find(*f);
+        if(fixed.find(*f) == fixed.end() && t_itr != times.end())
+        {
+          cost += t_itr->second / users[*f];
+        }
+      }
+    }
+    costs.push_back(cost);
+  }
+  costs.push_back(total_time);
+
+#ifdef ASCENT_MPI_ENABLED
+  // the slowest rank decides, and all ranks see the same costs
+  MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+  MPI_Allreduce(MPI_IN_PLACE,
+                &costs[0],
+                (int)costs.size(),
+                MPI_DOUBLE,
+                MPI_MAX,
+                mpi_comm);
+#endif
+
+  double items_total = 0.0;
+  size_t idx = 0;
+  for(itr = m_items.begin(); itr != m_items.end(); ++itr, ++idx)
+  {
+    Item &item = itr->second;
+    const double cost = costs[idx];
+    if(cost < 0.0)
+    {
+      continue;
+    }
+
+    items_total += cost;
+    if(item.state == "degraded")
+    {
+      detail::smooth(cost, item.degraded_cost, item.degraded_measured);
+    }
+    else
+    {
+      detail::smooth(cost, item.cost, item.measured);
+    }
+  }
+
+  detail::smooth(std::max(costs.back() - items_total, 0.0),
+                 m_fixed_cost,
+                 m_fixed_measured);
+}
+
+//-----------------------------------------------------------------------------
+void
+ActionScheduler::info(conduit::Node &out) const
+{
+  out.reset();
+  out["budget"] = m_budget;
+  out["fixed_cost"] = m_fixed_cost;
+
+  std::map<std::string,Item>::const_iterator itr;
+  for(itr = m_items.begin(); itr != m_items.end(); ++itr)
+  {
+    const Item &item = itr->second;
+    conduit::Node &n_item = out["items"][itr->first];
+    n_item["state"] = item.state;
+    n_item["cost"] = item.cost;
+    if(item.has_degraded)
+    {
+      n_item["degraded_cost"] = estimate(item, true);
+    }
+    n_item["priority"] = item.priority;
+    n_item["min_frequency"] = item.min_frequency;
+    n_item["waited"] = item.waited;
+  }
+}
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
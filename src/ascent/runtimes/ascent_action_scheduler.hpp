@@ -0,0 +1,152 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_action_scheduler.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef ASCENT_ACTION_SCHEDULER_HPP
+#define ASCENT_ACTION_SCHEDULER_HPP
+
+#include <conduit.hpp>
+#include <flow_workspace.hpp>
+
+#include <map>
+#include <set>
+#include <string>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+///
+/// Decides which scenes and extracts run in an execute so a per execute
+/// time budget (in seconds) is held.
+///
+/// Scenes and extracts accept optional schedule params:
+///   schedule/priority      (default 1.0)
+///   schedule/min_frequency run at least once every N executes (default 0,
+///                          no guarantee)
+///   schedule/degraded      params merged into the scene or extract when
+///                          the full version does not fit the budget
+///                          (ex: smaller renders or fewer samples)
+///
+/// Costs are measured per filter (flow::Workspace::filter_times) and
+/// attributed to the scenes and extracts that depend on them. Work that
+/// always runs (pipelines used by queries, triggers, data conversion,
+/// etc) is tracked as a fixed cost that is taken off the budget first.
+/// In MPI builds costs are the max over all ranks, so all ranks make the
+/// same decisions.
+//-----------------------------------------------------------------------------
+class ActionScheduler
+{
+public:
+    ActionScheduler();
+
+    /// budget in seconds, 0 disables scheduling
+    void   budget(double seconds);
+    double budget() const;
+    bool   enabled() const;
+
+    /// selects the scenes and extracts to run, and sets out to the
+    /// actions to build the graph from (degraded items updated,
+    /// schedule params removed). Deferred items stay in the actions,
+    /// so deferring them does not change the graph; the filters that
+    /// run them are added to gated (see flow::Workspace::gate_filters)
+    void   schedule(const conduit::Node &actions,
+                    conduit::Node &out,
+                    std::set<std::string> &gated);
+
+    /// names the graph the last schedule() asked for, given the
+    /// actions. Only degraded items change it, deferring is gating.
+    std::string token() const;
+
+    /// updates cost estimates from the workspace's filter times and the
+    /// total time of the execute that ran the scheduled actions
+    void   record(const flow::Workspace &w, double total_time);
+
+    void   info(conduit::Node &out) const;
+
+private:
+    struct Item
+    {
+        std::string sink;
+        double      priority;
+        int         min_frequency;
+        bool        has_degraded;
+        // "run", "degraded" or "deferred"
+        std::string state;
+        double      cost;
+        double      degraded_cost;
+        bool        measured;
+        bool        degraded_measured;
+        int         waited;
+    };
+
+    double estimate(const Item &item, bool degraded) const;
+
+    double                      m_budget;
+    double                      m_fixed_cost;
+    bool                        m_fixed_measured;
+    // keyed by "scenes/{name}" and "extracts/{name}"
+    std::map<std::string,Item>  m_items;
+};
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
@@ -111,6 +111,7 @@ DataObject::DataObject()
     m_high_bp(nullptr),
 #if defined(ASCENT_VTKM_ENABLED)
     m_vtkh(nullptr),
+    m_mesh_cache_hash(false),
 #endif
 #if defined(ASCENT_DRAY_ENABLED)
     m_dray(nullptr),
@@ -125,6 +126,7 @@ DataObject::DataObject(VTKHCollection *dataset)
   : m_low_bp(nullptr),
     m_high_bp(nullptr),
     m_vtkh(dataset),
+    m_mesh_cache_hash(false),
 #if defined(ASCENT_DRAY_ENABLED)
     m_dray(nullptr),
 #endif
@@ -140,6 +142,7 @@ DataObject::DataObject(dray::Collection *dataset)
     m_high_bp(nullptr),
 #if defined(ASCENT_VTKM_ENABLED)
     m_vtkh(nullptr),
+    m_mesh_cache_hash(false),
 #endif
     m_dray(dataset),
     m_source(Source::DRAY)
@@ -153,6 +156,7 @@ DataObject::DataObject(conduit::Node *dataset)
     m_high_bp(nullptr)
 #if defined(ASCENT_VTKM_ENABLED)
     ,m_vtkh(nullptr)
+    ,m_mesh_cache_hash(false)
 #endif
 #if defined(ASCENT_DRAY_ENABLED)
     ,m_dray(nullptr)
@@ -175,6 +179,7 @@ std::string DataObject::name() const
 void DataObject::reset_all()
 {
   m_source = Source::INVALID;
+  m_param_values.clear();
   std::shared_ptr<conduit::Node>  null_low(nullptr);
   std::shared_ptr<conduit::Node>  null_high(nullptr);
   m_low_bp = null_low;
@@ -183,6 +188,7 @@ void DataObject::reset_all()
 #if defined(ASCENT_VTKM_ENABLED)
   std::shared_ptr<VTKHCollection> null_vtkh(nullptr);
   m_vtkh = null_vtkh;
+  reset_view();
 #endif
 
 #if defined(ASCENT_DRAY_ENABLED)
@@ -199,10 +205,12 @@ void DataObject::reset(std::shared_ptr<conduit::Node> dataset)
   std::shared_ptr<conduit::Node>  null_high(nullptr);
   m_low_bp = null_low;
   m_high_bp = null_high;
+  m_param_values.clear();
 
 #if defined(ASCENT_VTKM_ENABLED)
   std::shared_ptr<VTKHCollection> null_vtkh(nullptr);
   m_vtkh = null_vtkh;
+  reset_view();
 #endif
 
 #if defined(ASCENT_DRAY_ENABLED)
@@ -230,10 +238,12 @@ void DataObject::reset(conduit::Node *dataset)
   std::shared_ptr<conduit::Node>  null_high(nullptr);
   m_low_bp = null_low;
   m_high_bp = null_high;
+  m_param_values.clear();
 
 #if defined(ASCENT_VTKM_ENABLED)
   std::shared_ptr<VTKHCollection> null_vtkh(nullptr);
   m_vtkh = null_vtkh;
+  reset_view();
 #endif
 
 #if defined(ASCENT_DRAY_ENABLED)
@@ -341,9 +351,19 @@ std::shared_ptr<VTKHCollection> DataObject::as_vtkh_collection()
       }
     }
 
+    // published meshes are identified by address. high order
+    // conversions are rebuilt every cycle, possibly at the addresses of
+    // the last one, so their values are hashed as well (poly conversions
+    // are copied and always matched by value)
+    bool hash_mesh_values = m_mesh_cache_hash ||
+                            m_source != Source::LOW_BP;
+
     // convert to vtkh
     std::shared_ptr<VTKHCollection>
-      vtkh_dset(VTKHDataAdapter::BlueprintToVTKHCollection(*to_vtkh, zero_copy));
+      vtkh_dset(VTKHDataAdapter::BlueprintToVTKHCollection(*to_vtkh,
+                                                           zero_copy,
+                                                           m_mesh_cache.get(),
+                                                           hash_mesh_values));
 
     m_vtkh = vtkh_dset;
     
@@ -359,6 +379,13 @@ void DataObject::reset_vtkh_collection()
   if(m_source != Source::VTKH)
     m_vtkh.reset();
 }
+
+void DataObject::mesh_cache(std::shared_ptr<VTKHMeshCache> cache,
+                            bool hash_published)
+{
+  m_mesh_cache = cache;
+  m_mesh_cache_hash = hash_published;
+}
 #endif
 
 std::shared_ptr<conduit::Node>  DataObject::as_low_order_bp()
@@ -389,6 +416,8 @@ std::shared_ptr<conduit::Node>  DataObject::as_low_order_bp()
     detail::add_metadata(*out_data);
     std::shared_ptr<conduit::Node> bp(out_data);
     m_low_bp = bp;
+    // the full conversion supersedes any partial view
+    reset_view();
   }
 #endif
 
@@ -432,6 +461,7 @@ std::shared_ptr<conduit::Node>  DataObject::as_node()
     detail::add_metadata(*out_data);
     std::shared_ptr<conduit::Node> bp(out_data);
     m_low_bp = bp;
+    reset_view();
   }
 #endif
   if(m_high_bp != nullptr)
@@ -448,6 +478,197 @@ std::shared_ptr<conduit::Node>  DataObject::as_node()
   return nullptr;
 }
 
+#if defined(ASCENT_VTKM_ENABLED)
+void DataObject::reset_view()
+{
+  m_low_bp_view = nullptr;
+  m_view_topos.clear();
+  m_view_fields.clear();
+}
+
+void DataObject::convert_view(const std::string &topo_name,
+                              const std::vector<std::string> &field_names)
+{
+  // every rank makes the same requests, so these checks keep the
+  // collective conversion below in lock step
+  std::vector<std::string> fields;
+  for(size_t i = 0; i < field_names.size(); ++i)
+  {
+    if(m_view_fields.find(field_names[i]) == m_view_fields.end())
+    {
+      fields.push_back(field_names[i]);
+    }
+  }
+
+  if(fields.size() == 0 && m_view_topos.find(topo_name) != m_view_topos.end())
+  {
+    return;
+  }
+
+  // mfem needs its special fields next to the ones we hand out
+  if(m_view_topos.find(topo_name) == m_view_topos.end())
+  {
+    std::vector<std::string> names = m_vtkh->field_names();
+    for(size_t i = 0; i < names.size(); ++i)
+    {
+      if(names[i].find("_attribute") != std::string::npos)
+      {
+        fields.push_back(names[i]);
+      }
+    }
+  }
+
+  if(m_low_bp_view == nullptr)
+  {
+    m_low_bp_view = std::make_shared<conduit::Node>();
+  }
+
+  VTKHDataAdapter::VTKHCollectionToBlueprintView(m_vtkh.get(),
+                                                 topo_name,
+                                                 fields,
+                                                 *m_low_bp_view,
+                                                 true);
+  detail::add_metadata(*m_low_bp_view);
+
+  m_view_topos.insert(topo_name);
+  for(size_t i = 0; i < fields.size(); ++i)
+  {
+    m_view_fields[fields[i]] = topo_name;
+  }
+}
+#endif
+
+std::shared_ptr<conduit::Node> DataObject::as_topology_bp(const std::string &topo_name)
+{
+  if(m_source == Source::INVALID)
+  {
+    ASCENT_ERROR("Source never initialized: default constructed");
+  }
+#if defined(ASCENT_VTKM_ENABLED)
+  if(m_source == Source::VTKH && m_low_bp == nullptr)
+  {
+    if(m_view_topos.find(topo_name) == m_view_topos.end() &&
+       !m_vtkh->has_topology(topo_name))
+    {
+      // let the caller report the unknown name against everything
+      return as_low_order_bp();
+    }
+    convert_view(topo_name, std::vector<std::string>());
+    return m_low_bp_view;
+  }
+#endif
+  return as_low_order_bp();
+}
+
+std::shared_ptr<conduit::Node> DataObject::as_field_bp(const std::string &field_name)
+{
+  return as_fields_bp(std::vector<std::string>(1, field_name));
+}
+
+std::shared_ptr<conduit::Node>
+DataObject::as_fields_bp(const std::vector<std::string> &field_names)
+{
+  if(m_source == Source::INVALID)
+  {
+    ASCENT_ERROR("Source never initialized: default constructed");
+  }
+#if defined(ASCENT_VTKM_ENABLED)
+  if(m_source == Source::VTKH && m_low_bp == nullptr)
+  {
+    // group the fields we have not seen by topology
+    std::map<std::string, std::vector<std::string>> topo_fields;
+    for(size_t i = 0; i < field_names.size(); ++i)
+    {
+      const std::string &fname = field_names[i];
+      if(m_view_fields.find(fname) != m_view_fields.end())
+      {
+        continue;
+      }
+      const std::string topo_name = m_vtkh->field_topology(fname);
+      if(topo_name == "")
+      {
+        return as_low_order_bp();
+      }
+      topo_fields[topo_name].push_back(fname);
+    }
+
+    for(auto it = topo_fields.begin(); it != topo_fields.end(); ++it)
+    {
+      convert_view(it->first, it->second);
+    }
+
+    if(m_low_bp_view == nullptr)
+    {
+      // nothing was requested
+      m_low_bp_view = std::make_shared<conduit::Node>();
+    }
+    return m_low_bp_view;
+  }
+#endif
+  return as_low_order_bp();
+}
+
+conduit::Node DataObject::state_var(const std::string var_name)
+{
+  conduit::Node state;
+  if(m_source == Source::INVALID)
+  {
+    ASCENT_ERROR("Source never initialized: default constructed");
+  }
+
+  conduit::Node *bp = nullptr;
+  if(m_high_bp != nullptr)
+  {
+    bp = m_high_bp.get();
+  }
+  else if(m_low_bp != nullptr)
+  {
+    bp = m_low_bp.get();
+  }
+
+  if(bp != nullptr)
+  {
+    const int num_domains = bp->number_of_children();
+    for(int i = 0; i < num_domains; ++i)
+    {
+      const conduit::Node &dom = bp->child(i);
+      if(dom.has_path("state/" + var_name))
+      {
+        state = dom["state/" + var_name];
+        break;
+      }
+    }
+  }
+  else if(Metadata::n_metadata.has_path(var_name))
+  {
+    // vtkh and dray data only get state through the metadata
+    // (see detail::add_metadata), so we can skip the conversion
+    state = Metadata::n_metadata[var_name];
+  }
+
+  return state;
+}
+
+bool DataObject::has_param_value(const std::string &expr) const
+{
+  return m_param_values.find(expr) != m_param_values.end();
+}
+
+double DataObject::param_value(const std::string &expr) const
+{
+  auto it = m_param_values.find(expr);
+  if(it == m_param_values.end())
+  {
+    ASCENT_ERROR("No cached value for parameter expression '"<<expr<<"'");
+  }
+  return it->second;
+}
+
+void DataObject::param_value(const std::string &expr, const double value)
+{
+  m_param_values[expr] = value;
+}
+
 DataObject::Source DataObject::source() const
 {
   return m_source;
@@ -479,8 +700,58 @@ std::string DataObject::source_string() const
   return res;
 }
 
+void DataObject::memory_usage(size_t &host_bytes, size_t &device_bytes) const
+{
+  host_bytes = 0;
+  device_bytes = 0;
+
+  if(m_low_bp != nullptr)
+  {
+    host_bytes += m_low_bp->total_bytes_allocated();
+  }
+  if(m_high_bp != nullptr && m_high_bp != m_low_bp)
+  {
+    host_bytes += m_high_bp->total_bytes_allocated();
+  }
+#if defined(ASCENT_VTKM_ENABLED)
+  if(m_low_bp_view != nullptr)
+  {
+    host_bytes += m_low_bp_view->total_bytes_allocated();
+  }
+  if(m_vtkh != nullptr)
+  {
+#if defined(ASCENT_CUDA_ENABLED)
+    device_bytes += m_vtkh->memory_usage();
+#else
+    host_bytes += m_vtkh->memory_usage();
+#endif
+  }
+#endif
+  // dray collections do not report a footprint yet
+}
+
 //-----------------------------------------------------------------------------
 };
 //-----------------------------------------------------------------------------
 // -- end ascent:: --
 //-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// -- begin flow:: --
+//-----------------------------------------------------------------------------
+namespace flow
+{
+//-----------------------------------------------------------------------------
+template <>
+void
+memory_footprint<ascent::DataObject>(const ascent::DataObject *data,
+                                     size_t &host_bytes,
+                                     size_t &device_bytes)
+{
+  data->memory_usage(host_bytes, device_bytes);
+}
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end flow:: --
+//-----------------------------------------------------------------------------
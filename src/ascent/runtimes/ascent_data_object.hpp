@@ -54,7 +54,11 @@
 
 #include <ascent.hpp>
 #include <conduit.hpp>
+#include <flow_data.hpp>
+#include <map>
 #include <memory>
+#include <set>
+#include <vector>
 
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
@@ -74,6 +78,7 @@ namespace ascent
 #if defined(ASCENT_VTKM_ENABLED)
 // forward declare
 class VTKHCollection;
+class VTKHMeshCache;
 #endif
 
 
@@ -100,6 +105,12 @@ public:
 
   bool                            is_vtkh_coll_exists() const { return m_vtkh != nullptr; }
   void                            reset_vtkh_collection();
+  // lets conversions of low order sources reuse unchanged meshes
+  // from earlier cycles. The cache survives resets. hash_published
+  // compares the values of published meshes too, for published data
+  // that lives in reused memory (async snapshots)
+  void                            mesh_cache(std::shared_ptr<VTKHMeshCache> cache,
+                                             bool hash_published = false);
 
 #endif
 #if defined(ASCENT_DRAY_ENABLED)
@@ -109,13 +120,47 @@ public:
   std::shared_ptr<conduit::Node>  as_low_order_bp();
   std::shared_ptr<conduit::Node>  as_high_order_bp();
   std::shared_ptr<conduit::Node>  as_node();          // just return the coduit node
+
+  // low order blueprint holding at least the requested topology or
+  // fields (with their topologies and coordsets). For vtkh sources only
+  // those pieces are converted, zero-copy where possible, and the
+  // conversions are kept for later requests until the object is reset.
+  // Other sources, and unknown names, return as_low_order_bp()
+  std::shared_ptr<conduit::Node>  as_topology_bp(const std::string &topo_name);
+  std::shared_ptr<conduit::Node>  as_field_bp(const std::string &field_name);
+  std::shared_ptr<conduit::Node>  as_fields_bp(const std::vector<std::string> &field_names);
   DataObject::Source              source() const;
   std::string source_string() const;
+
+  // returns 'state/var_name' (e.g., cycle or time) without forcing
+  // a conversion to blueprint. Empty if the state is not known.
+  conduit::Node state_var(const std::string var_name);
+
+  // results of parameter expressions evaluated against this data.
+  // cleared when the data object is reset
+  bool   has_param_value(const std::string &expr) const;
+  double param_value(const std::string &expr) const;
+  void   param_value(const std::string &expr, const double value);
+
+  // bytes held by all representations this object currently has.
+  // vtkh collections are estimates and are counted as device memory
+  // when ascent is built with cuda
+  void memory_usage(size_t &host_bytes, size_t &device_bytes) const;
 protected:
   std::shared_ptr<conduit::Node>  m_low_bp;
   std::shared_ptr<conduit::Node>  m_high_bp;
 #if defined(ASCENT_VTKM_ENABLED)
   std::shared_ptr<VTKHCollection> m_vtkh;
+  std::shared_ptr<VTKHMeshCache>  m_mesh_cache;
+  bool                            m_mesh_cache_hash;
+  // partial blueprint built by the lazy views, along with the
+  // topologies and fields (mapped to their topology) already in it
+  std::shared_ptr<conduit::Node>     m_low_bp_view;
+  std::set<std::string>              m_view_topos;
+  std::map<std::string, std::string> m_view_fields;
+  void reset_view();
+  void convert_view(const std::string &topo_name,
+                    const std::vector<std::string> &field_names);
 #endif
 #if defined(ASCENT_DRAY_ENABLED)
   std::shared_ptr<dray::Collection> m_dray;
@@ -123,11 +168,27 @@ protected:
 
   Source m_source;
   std::string m_name;
+  std::map<std::string, double> m_param_values;
 };
 
 //-----------------------------------------------------------------------------
 };
-#endif
 //-----------------------------------------------------------------------------
 // -- end ascent:: --
 //-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// -- begin flow:: --
+//-----------------------------------------------------------------------------
+namespace flow
+{
+// lets the registry account for the memory held by data objects
+template <>
+void ASCENT_API memory_footprint<ascent::DataObject>(const ascent::DataObject *data,
+                                                     size_t &host_bytes,
+                                                     size_t &device_bytes);
+};
+//-----------------------------------------------------------------------------
+// -- end flow:: --
+//-----------------------------------------------------------------------------
+#endif
@@ -50,7 +50,8 @@
 
 #include <ascent_config.h>
 #include "ascent_expression_eval.hpp"
-#include "ascent_data_logger.hpp"
+#include "ascent_mpi_utils.hpp"
+#include "ascent_tracer.hpp"
 #include "expressions/ascent_blueprint_architect.hpp"
 #include "expressions/ascent_expression_filters.hpp"
 #include "expressions/ascent_expressions_ast.hpp"
@@ -267,11 +268,110 @@ void Cache::save(const std::string &filename,
   }
 }
 
+void
+Cache::lock_shared()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  // waiting writers go first so results can't be starved by new readers
+  m_cond.wait(lock, [this] { return !m_writing && m_waiting_writers == 0; });
+  m_readers++;
+}
+
+void
+Cache::unlock_shared()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_readers--;
+  if(m_readers == 0)
+  {
+    m_cond.notify_all();
+  }
+}
+
+void
+Cache::lock()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_waiting_writers++;
+  m_cond.wait(lock, [this] { return !m_writing && m_readers == 0; });
+  m_waiting_writers--;
+  m_writing = true;
+}
+
+void
+Cache::unlock()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_writing = false;
+  m_cond.notify_all();
+}
+
+std::mutex &
+Cache::expression_mutex(const std::string &expr_name)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::unique_ptr<std::mutex> &expr_mutex = m_expression_mutexes[expr_name];
+  if(!expr_mutex)
+  {
+    expr_mutex.reset(new std::mutex());
+  }
+  return *expr_mutex;
+}
+
 Cache::~Cache()
 {
   save();
 }
 
+namespace detail
+{
+
+// the generated parser and scanner keep their state in globals
+std::mutex &
+parser_mutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+// serializes evaluations that run collectives (more than one rank).
+// evaluations do not nest: an evaluation holds the cache and expression
+// locks while it runs
+std::mutex &
+collectives_mutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+// holds a shared lock on the cache while an expression executes
+class SharedCacheLock
+{
+public:
+  SharedCacheLock(Cache &cache) : m_cache(cache), m_locked(true)
+  {
+    m_cache.lock_shared();
+  }
+  ~SharedCacheLock()
+  {
+    unlock();
+  }
+  void unlock()
+  {
+    if(m_locked)
+    {
+      m_cache.unlock_shared();
+      m_locked = false;
+    }
+  }
+
+private:
+  Cache &m_cache;
+  bool m_locked;
+};
+
+} // namespace detail
+
 void
 register_builtin()
 {
@@ -327,12 +427,18 @@ register_builtin()
   flow::Workspace::register_filter_type<expressions::Bin>();
   flow::Workspace::register_filter_type<expressions::Bounds>();
   flow::Workspace::register_filter_type<expressions::Lineout>();
-
-  initialize_functions();
-  initialize_objects();
+  flow::Workspace::register_filter_type<expressions::Probe>();
+
+  // evaluations read the tables without locking, so they are built once
+  static std::once_flag tables_flag;
+  std::call_once(tables_flag, []() {
+    initialize_functions();
+    initialize_objects();
+  });
 }
 
 ExpressionEval::ExpressionEval(conduit::Node *data)
+  : m_save_graphs(false)
 {
   // wrap the pointer in a data object we can assume that this
   // is a valid multidomain dataset
@@ -342,7 +448,8 @@ ExpressionEval::ExpressionEval(conduit::Node *data)
 }
 
 ExpressionEval::ExpressionEval(DataObject &dataset)
-  : m_data_object(dataset)
+  : m_data_object(dataset),
+    m_save_graphs(false)
 {
 }
 
@@ -350,6 +457,7 @@ void
 ExpressionEval::load_cache(const std::string &dir, const std::string &session)
 {
   // the cache is static so don't load if we already have
+  std::lock_guard<Cache> lock(m_cache);
   if(!m_cache.loaded())
   {
     m_cache.load(dir, session);
@@ -985,6 +1093,24 @@ initialize_functions()
 
   // -------------------------------------------------------------
 
+  conduit::Node &probe_sig = (*functions)["probe"].append();
+  probe_sig["return_type"] = "probe";
+  probe_sig["filter_name"] = "probe";
+  probe_sig["args/points/type"] = "list";
+  probe_sig["args/points/description"] = "A list of ``vector`` points.";
+  probe_sig["args/field/type"] = "field";
+  probe_sig["args/empty_val/type"] = "double";
+  probe_sig["args/empty_val/optional"];
+  probe_sig["args/empty_val/description"] =
+      "The value of points outside the mesh. Defaults to ``0``.";
+  probe_sig["description"] =
+      "Samples a field at a list of points. Vertex fields are interpolated "
+      "and element fields take the value of the cell containing the point. "
+      "The cells are found with a locator that is built once per cycle and "
+      "shared with ``lineout``.";
+
+  // -------------------------------------------------------------
+
   conduit::Node &quantile_sig = (*functions)["quantile"].append();
   quantile_sig["return_type"] = "double";
   quantile_sig["filter_name"] = "quantile";
@@ -1437,6 +1563,14 @@ initialize_objects()
   histogram["num_bins/type"] = "int";
   histogram["clamp/type"] = "bool";
 
+  conduit::Node &probe = (*objects)["probe/attrs"];
+  probe["value/type"] = "array";
+  probe["value/description"] = "The sampled value of each point.";
+  probe["found/type"] = "array";
+  probe["found/description"] =
+      "``1`` for each point inside the mesh, ``0`` otherwise.";
+  probe["empty_value/type"] = "double";
+
   conduit::Node &value_position = (*objects)["value_position/attrs"];
   value_position["value/type"] = "double";
   value_position["position/type"] = "vector";
@@ -1518,6 +1652,19 @@ ExpressionEval::evaluate(const std::string expr, std::string expr_name)
     expr_name = expr;
   }
 
+  // reductions use the default communicator, collectives from concurrent
+  // evaluations would interleave
+  std::unique_lock<std::mutex> collectives_lock(
+      detail::collectives_mutex(), std::defer_lock);
+  if(mpi_size() > 1)
+  {
+    collectives_lock.lock();
+  }
+
+  // evaluations of different expressions can run concurrently, results of
+  // the same expression are added in order
+  std::lock_guard<std::mutex> expr_lock(m_cache.expression_mutex(expr_name));
+
   // stores temporary fields, topos, and coords that need to be removed after
   // the expression runs
   conduit::Node remove;
@@ -1527,25 +1674,33 @@ ExpressionEval::evaluate(const std::string expr, std::string expr_name)
   w.registry().add<conduit::Node>("cache", &m_cache.m_data, -1);
   w.registry().add<conduit::Node>("function_table", &g_function_table, -1);
   w.registry().add<conduit::Node>("object_table", &g_object_table, -1);
-  int cycle = get_state_var(*m_data_object.as_node().get(), "cycle").to_int32();
+  // state comes from the metadata when possible so we don't
+  // force a conversion of vtkh data to blueprint
+  int cycle = m_data_object.state_var("cycle").to_int32();
   w.registry().add<int>("cycle", &cycle, -1);
 
-  try
-  {
-    scan_string(expr.c_str());
-
-  }
-  catch(const char *msg)
+  ASTNode *root_node = nullptr;
   {
-    w.reset();
-    ASCENT_ERROR("Expression parsing error: " << msg << " in '" << expr << "'");
+    std::lock_guard<std::mutex> parser_lock(detail::parser_mutex());
+    try
+    {
+      scan_string(expr.c_str());
+    }
+    catch(const char *msg)
+    {
+      w.reset();
+      ASCENT_ERROR("Expression parsing error: " << msg << " in '" << expr
+                                                << "'");
+    }
+    root_node = get_result();
   }
 
-  ASTNode *root_node = get_result();
-
   conduit::Node root;
   conduit::Node symbol_table;
+  conduit::Node return_val;
 
+  // filters may read the results of other expressions while executing
+  detail::SharedCacheLock cache_lock(m_cache);
   try
   {
     flow::Timer build_graph_timer;
@@ -1566,8 +1721,10 @@ ExpressionEval::evaluate(const std::string expr, std::string expr_name)
       jit_root(root, expr_name);
     }
 
-#warning "get rig of this"
-    w.graph().save_dot_html("ascent_expressions_graph.html");
+    if(m_save_graphs)
+    {
+      w.graph().save_dot_html("ascent_expressions_graph.html");
+    }
     ASCENT_DATA_ADD("build_graph time", build_graph_timer.elapsed());
     flow::Timer execute_timer;
     w.execute();
@@ -1584,36 +1741,40 @@ ExpressionEval::evaluate(const std::string expr, std::string expr_name)
   std::string filter_name = root["filter_name"].as_string();
 
   conduit::Node *n_res = w.registry().fetch<conduit::Node>(filter_name);
-  conduit::Node return_val = *n_res;
+  return_val = *n_res;
+  cache_lock.unlock();
 
   //return_val.print();
 
 
   // remove temporary fields, topologies, and coordsets from the dataset
   #warning "Need a way to delete the intermediate results during execution"
-  conduit::Node *dataset = m_data_object.as_node().get();
-  const int num_domains = dataset->number_of_children();
-  for(int i = 0; i < num_domains; ++i)
+  if(remove.number_of_children() > 0)
   {
-    conduit::Node &dom = dataset->child(i);
-    for(const auto &field_name : remove["fields"].child_names())
+    conduit::Node *dataset = m_data_object.as_node().get();
+    const int num_domains = dataset->number_of_children();
+    for(int i = 0; i < num_domains; ++i)
     {
-      dom["fields"].remove(field_name);
-    }
-    for(const auto &topo_name : remove["topologies"].child_names())
-    {
-      dom["topologies"].remove(topo_name);
-    }
-    for(const auto &coords_name : remove["coordsets"].child_names())
-    {
-      dom["coordsets"].remove(coords_name);
+      conduit::Node &dom = dataset->child(i);
+      for(const auto &field_name : remove["fields"].child_names())
+      {
+        dom["fields"].remove(field_name);
+      }
+      for(const auto &topo_name : remove["topologies"].child_names())
+      {
+        dom["topologies"].remove(topo_name);
+      }
+      for(const auto &coords_name : remove["coordsets"].child_names())
+      {
+        dom["coordsets"].remove(coords_name);
+      }
     }
   }
 
   //std::cout<<m_data_object.as_node()->to_summary_string()<<"\n";
 
   // add the sim time
-  conduit::Node n_time = get_state_var(*m_data_object.as_node().get(), "time");
+  conduit::Node n_time = m_data_object.state_var("time");
   double time = 0;
   bool valid_time = false;
   if(!n_time.dtype().is_empty())
@@ -1623,47 +1784,48 @@ ExpressionEval::evaluate(const std::string expr, std::string expr_name)
   }
   return_val["time"] = time;
 
-  // check the cache for signs of time travel
-  // i.e., someone could have restarted the simulation from the beginning
-  // or from some earlier checkpoint
-  // There are a couple conditions:
-  // 0) only check one time on startup
-  // 1) only filter if we haven't done so before
-  // 2) only filter if we detect time travel
-  // 3) only filter if we have state/time
-  static bool first_execute = true;
-
-  if(first_execute &&
-     !m_cache.filtered() &&
-     time <= m_cache.last_known_time() &&
-     valid_time)
   {
-    // remove all cache entries that occur in the future
-    m_cache.filter_time(time);
-  }
-  first_execute = false;
+    std::lock_guard<Cache> cache_write_lock(m_cache);
+    // check the cache for signs of time travel
+    // i.e., someone could have restarted the simulation from the beginning
+    // or from some earlier checkpoint
+    // There are a couple conditions:
+    // 0) only check one time on startup
+    // 1) only filter if we haven't done so before
+    // 2) only filter if we detect time travel
+    // 3) only filter if we have state/time
+    if(!m_cache.m_time_checked &&
+       !m_cache.filtered() &&
+       time <= m_cache.last_known_time() &&
+       valid_time)
+    {
+      // remove all cache entries that occur in the future
+      m_cache.filter_time(time);
+    }
+    m_cache.m_time_checked = true;
 
-  m_cache.last_known_time(time);
+    m_cache.last_known_time(time);
 
-  //return_val.print();
-  // add the result to the cache
-  {
-    std::stringstream cache_entry;
-    cache_entry << expr_name << "/" << cycle;
-    m_cache.m_data[cache_entry.str()] = return_val;
-  }
-  // now we might have intermediate symbol, and
-  // we also need to add them to the cache
-  const int num_symbols = symbol_table.number_of_children();
-  for(int i = 0; i < num_symbols; ++i)
-  {
-    const conduit::Node &symbol = symbol_table.child(i);
-    if(symbol.has_path("value"))
+    //return_val.print();
+    // add the result to the cache
     {
-      const std::string symbol_name = symbol.name();
       std::stringstream cache_entry;
-      cache_entry << symbol_name << "/" << cycle;
-      m_cache.m_data[cache_entry.str()] = symbol;
+      cache_entry << expr_name << "/" << cycle;
+      m_cache.m_data[cache_entry.str()] = return_val;
+    }
+    // now we might have intermediate symbol, and
+    // we also need to add them to the cache
+    const int num_symbols = symbol_table.number_of_children();
+    for(int i = 0; i < num_symbols; ++i)
+    {
+      const conduit::Node &symbol = symbol_table.child(i);
+      if(symbol.has_path("value"))
+      {
+        const std::string symbol_name = symbol.name();
+        std::stringstream cache_entry;
+        cache_entry << symbol_name << "/" << cycle;
+        m_cache.m_data[cache_entry.str()] = symbol;
+      }
     }
   }
 
@@ -1713,24 +1875,28 @@ ExpressionEval::get_cache()
 void
 ExpressionEval::reset_cache()
 {
+  std::lock_guard<Cache> lock(m_cache);
   m_cache.m_data.reset();
 }
 
 void
 ExpressionEval::save_cache(const std::string &filename)
 {
+  std::lock_guard<Cache> lock(m_cache);
   m_cache.save(filename);
 }
 
 void
 ExpressionEval::save_cache()
 {
+  std::lock_guard<Cache> lock(m_cache);
   m_cache.save();
 }
 
 void ExpressionEval::get_last(conduit::Node &data)
 {
   data.reset();
+  std::lock_guard<Cache> lock(m_cache);
   const int entries = m_cache.m_data.number_of_children();
 
   for(int i = 0; i < entries; ++i)
@@ -1744,9 +1910,16 @@ void ExpressionEval::get_last(conduit::Node &data)
     }
   }
 }
+//-----------------------------------------------------------------------------
+void ExpressionEval::save_graphs(bool enabled)
+{
+  m_save_graphs = enabled;
+}
+//-----------------------------------------------------------------------------
 void ExpressionEval::save_cache(const std::string &filename,
                                 const std::vector<std::string> &selection)
 {
+  std::lock_guard<Cache> lock(m_cache);
   m_cache.save(filename, selection);
 }
 //-----------------------------------------------------------------------------
@@ -56,6 +56,11 @@
 #include <ascent_data_object.hpp>
 
 #include "flow_workspace.hpp"
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
 //-----------------------------------------------------------------------------
@@ -72,15 +77,19 @@ namespace expressions
 {
 
 void ASCENT_API register_builtin();
+// build the function and object tables shared by all evaluations.
+// register_builtin calls these once, the tables are read only afterwards
 void ASCENT_API initialize_functions();
 void ASCENT_API initialize_objects();
 
 struct Cache
 {
   conduit::Node m_data;
-  int m_rank;
+  int m_rank = 0;
   bool m_filtered = false;
   bool m_loaded = false;
+  // the time travel check only runs for the first result
+  bool m_time_checked = false;
   std::string m_session_file;
 
   void load(const std::string &dir,
@@ -97,10 +106,25 @@ struct Cache
   void save(const std::string &filename,
             const std::vector<std::string> &selection);
 
+  // Expressions read the cache while they execute (e.g. history) and only
+  // add their results at the end. Executing expressions share the cache
+  // (lock_shared), adding results needs it exclusively (lock).
+  void lock_shared();
+  void unlock_shared();
+  void lock();
+  void unlock();
+  // serializes evaluations of the same expression
+  std::mutex &expression_mutex(const std::string &expr_name);
+
   ~Cache();
-};
 
-static conduit::Node m_function_table;
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  int m_readers = 0;
+  int m_waiting_writers = 0;
+  bool m_writing = false;
+  std::map<std::string, std::unique_ptr<std::mutex>> m_expression_mutexes;
+};
 
 class ASCENT_API ExpressionEval
 {
@@ -108,12 +132,14 @@ protected:
   DataObject m_data_object;
   flow::Workspace w;
   static Cache m_cache;
+  bool m_save_graphs;
   void jit_root(conduit::Node &root, const std::string &expr_name);
 public:
   ExpressionEval(DataObject &dataset);
   ExpressionEval(conduit::Node *dataset);
   DataObject& data_object();
 
+  // not synchronized with running evaluations
   static const conduit::Node &get_cache();
   static void get_last(conduit::Node &data);
   static void reset_cache();
@@ -126,6 +152,22 @@ public:
   static void save_cache(const std::string &filename);
   static void save_cache();
 
+  // write this evaluator's flow graphs to ascent_expressions_graph.html
+  // (off by default)
+  void save_graphs(bool enabled);
+
+  // evaluate can run concurrently in several threads of a serial run.
+  // Derived fields are added to the data, so concurrent evaluators must not
+  // share a DataObject. Evaluators constructed from a conduit::Node work on
+  // their own view of it and can share the node.
+  //
+  // Reductions run collectives on flow::Workspace::default_mpi_comm(), so
+  // with more than one MPI rank evaluations run one at a time, and every
+  // rank must evaluate the same expressions in the same order.
+  //
+  // Parsing is always serialized by a global mutex: the scanner and parser
+  // keep their state in globals, and their grammar sources are not part of
+  // this tree, so they cannot be regenerated as reentrant.
   conduit::Node evaluate(const std::string expr, std::string exp_name = "");
 };
 
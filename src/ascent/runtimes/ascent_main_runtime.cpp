@@ -67,6 +67,7 @@
 #include <mpi.h>
 // -- conduit relay mpi
 #include <conduit_relay_mpi.hpp>
+#include <hola/ascent_hola_mpi.hpp>
 #endif
 
 #include <flow.hpp>
@@ -78,9 +79,10 @@
 #include <expressions/ascent_derived_jit.hpp>
 #include <ascent_transmogrifier.hpp>
 #include <ascent_data_object.hpp>
-#include <ascent_data_logger.hpp>
+#include <ascent_tracer.hpp>
 
 #if defined(ASCENT_VTKM_ENABLED)
+#include <ascent_vtkh_data_adapter.hpp>
 #include <vtkm/cont/Error.h>
 #include <vtkh/vtkh.hpp>
 #include <vtkh/Error.hpp>
@@ -126,6 +128,44 @@ class InfoHandler
 
 int InfoHandler::m_rank = 0;
 
+// filter level timeline for the tracer. flow calls after_execute even
+// when the filter throws, and any spans the filter left open are ended
+// with its own so the trace stays balanced
+class FilterTracer
+{
+  public:
+  static void
+  before_execute(const std::string &filter_name)
+  {
+    if(Tracer::enabled())
+    {
+      depths().push_back(Tracer::instance()->depth());
+      Tracer::instance()->begin(filter_name);
+    }
+  }
+
+  static void
+  after_execute(const std::string &filter_name)
+  {
+    if(!depths().empty())
+    {
+      const size_t depth = depths().back();
+      depths().pop_back();
+      Tracer::instance()->sample_memory();
+      Tracer::instance()->end_to(depth);
+    }
+  }
+
+  private:
+  // open depth before each running filter, per thread
+  static std::vector<size_t> &
+  depths()
+  {
+    thread_local std::vector<size_t> res;
+    return res;
+  }
+};
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 //
@@ -141,11 +181,14 @@ AscentRuntime::AscentRuntime()
  m_rank(0),
  m_default_output_dir("."),
  m_session_name("ascent_session"),
- m_field_filtering(false)
+ m_field_filtering("false"),
+ m_prune_fields(false),
+ m_eager_introspection(false)
 {
     m_ghost_fields.append() = "ascent_ghosts";
     flow::filters::register_builtin();
     ResetInfo();
+    RegisterInfoProducers();
 }
 
 //-----------------------------------------------------------------------------
@@ -183,7 +226,7 @@ AscentRuntime::Initialize(const conduit::Node &options)
     MPI_Comm comm = MPI_Comm_f2c(options["mpi_comm"].to_int());
     MPI_Comm_rank(comm,&m_rank);
     InfoHandler::m_rank = m_rank;
-    DataLogger::instance()->rank(m_rank);
+    Tracer::instance()->rank(m_rank);
 #else  // non mpi version
     if(options.has_child("mpi_comm"))
     {
@@ -314,19 +357,137 @@ AscentRuntime::Initialize(const conduit::Node &options)
 #endif
     }
 
+    // tracing is process wide, don't carry it over from another instance
+    if(options.has_path("trace"))
+    {
+      Tracer::instance()->enable(options["trace"].as_string() == "true");
+    }
+    else
+    {
+      Tracer::instance()->enable_default();
+    }
+
+    if(options.has_path("trace_buffer_size"))
+    {
+      Tracer::instance()->buffer_size(options["trace_buffer_size"].to_uint64());
+    }
+
+    flow::Workspace::set_filter_execute_callbacks(FilterTracer::before_execute,
+                                                  FilterTracer::after_execute);
+
+    if(options.has_path("memory_accounting"))
+    {
+      w.enable_memory_accounting(options["memory_accounting"].as_string() == "true");
+    }
+
+    // re-sampling all results after each filter is only worth its cost
+    // when tracing (a budget always does it)
+    w.enable_memory_sampling(Tracer::enabled());
+
+    if(options.has_path("memory_budget"))
+    {
+      w.set_memory_budget(options["memory_budget"].to_uint64());
+    }
+
+    if(options.has_path("memory_aware_scheduling"))
+    {
+      bool memory_aware = options["memory_aware_scheduling"].as_string() == "true";
+#ifdef ASCENT_MPI_ENABLED
+      // each rank orders filters by its own result sizes, and filters run
+      // collectives, so ranks could disagree on the order and deadlock
+      int comm_size = 1;
+      MPI_Comm_size(MPI_Comm_f2c(flow::Workspace::default_mpi_comm()),
+                    &comm_size);
+      if(memory_aware && comm_size > 1)
+      {
+        if(m_rank == 0)
+        {
+          ASCENT_WARN("memory_aware_scheduling is only supported with a "
+                      "single MPI rank, using the default schedule");
+        }
+        memory_aware = false;
+      }
+#endif
+      w.enable_memory_aware_scheduling(memory_aware);
+    }
+
     if(options.has_path("field_filtering"))
     {
-      if(options["field_filtering"].as_string() == "true")
+      m_field_filtering = options["field_filtering"].as_string();
+      if(m_field_filtering != "auto" &&
+         m_field_filtering != "true" &&
+         m_field_filtering != "false")
+      {
+        ASCENT_ERROR("field_filtering must be 'auto', 'true' or 'false'"
+                     " not '"<<m_field_filtering<<"'");
+      }
+    }
+
+    if(options.has_path("introspection"))
+    {
+      std::string introspection = options["introspection"].as_string();
+      if(introspection != "lazy" && introspection != "eager")
       {
-        m_field_filtering = true;
+        ASCENT_ERROR("introspection must be 'lazy' or 'eager'"
+                     " not '"<<introspection<<"'");
       }
+      m_eager_introspection = introspection == "eager";
+    }
+
+    std::string jit_engine = "auto";
+    int jit_compile_threshold = 3;
+    if(options.has_path("jit/engine"))
+    {
+      jit_engine = options["jit/engine"].as_string();
+    }
+    if(options.has_path("jit/compile_threshold"))
+    {
+      jit_compile_threshold = options["jit/compile_threshold"].to_int32();
     }
+    runtime::expressions::Jitable::set_engine(jit_engine,
+                                              jit_compile_threshold);
 
-    Node msg;
-    ascent::about(msg["about"]);
-    msg["options"] = options;
-    this->Info(msg["info"]);
-    m_web_interface.PushMessage(msg);
+    std::string jit_precision = "auto";
+    int jit_tile_size = 0;
+    if(options.has_path("jit/precision"))
+    {
+      jit_precision = options["jit/precision"].as_string();
+    }
+    if(options.has_path("jit/tile_size"))
+    {
+      jit_tile_size = options["jit/tile_size"].to_int32();
+    }
+    runtime::expressions::Jitable::set_precision(jit_precision,
+                                                 jit_tile_size);
+
+    if(options.has_path("schedule/budget"))
+    {
+      m_scheduler.budget(options["schedule/budget"].to_float64());
+    }
+    w.record_filter_times(m_scheduler.enabled());
+
+#if defined(ASCENT_VTKM_ENABLED)
+    if(options.has_path("mesh_cache") &&
+       options["mesh_cache"].as_string() == "true")
+    {
+      // async snapshots are copied into pooled memory, the same
+      // addresses hold new values every other cycle
+      bool snapshots = options.has_path("async") &&
+                       options["async"].as_string() == "true" &&
+                       !(options.has_path("async_snapshot") &&
+                         options["async_snapshot"].as_string() == "external");
+      m_data_object.mesh_cache(std::make_shared<VTKHMeshCache>(), snapshots);
+    }
+#endif
+
+    if(m_web_interface.Enabled())
+    {
+      Node msg;
+      ascent::about(msg["about"]);
+      msg["options"] = options;
+      this->Info(msg["info"]);
+      m_web_interface.PushMessage(msg);
+    }
 }
 
 
@@ -335,6 +496,62 @@ void
 AscentRuntime::Info(conduit::Node &out)
 {
     out.set(m_info);
+    if(!m_eager_introspection)
+    {
+      ProduceInfo(out);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+AscentRuntime::RegisterInfoProducers()
+{
+    // each producer adds its key to the given info node. they describe
+    // the last execute, the graph is kept until the actions change
+    m_info_producers["actions"] = [this](conduit::Node &out)
+    {
+      out["actions"] = m_previous_actions;
+    };
+
+    m_info_producers["flow_graph"] = [this](conduit::Node &out)
+    {
+      w.info(out["flow_graph"]);
+    };
+
+    m_info_producers["flow_graph_dot"] = [this](conduit::Node &out)
+    {
+      out["flow_graph_dot"] = w.graph().to_dot();
+    };
+
+    m_info_producers["flow_graph_dot_html"] = [this](conduit::Node &out)
+    {
+      out["flow_graph_dot_html"] = w.graph().to_dot_html();
+    };
+
+    m_info_producers["expressions"] = [](conduit::Node &out)
+    {
+      const conduit::Node &expression_cache =
+        runtime::expressions::ExpressionEval::get_cache();
+
+      if(expression_cache.number_of_children() > 0)
+      {
+        // get_last points into the cache, copy so out can outlive it
+        conduit::Node last;
+        runtime::expressions::ExpressionEval::get_last(last);
+        out["expressions"].set(last);
+      }
+    };
+}
+
+//-----------------------------------------------------------------------------
+void
+AscentRuntime::ProduceInfo(conduit::Node &out)
+{
+    std::map<std::string,std::function<void(conduit::Node &)>>::iterator itr;
+    for(itr = m_info_producers.begin(); itr != m_info_producers.end(); ++itr)
+    {
+      itr->second(out);
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -369,6 +586,21 @@ AscentRuntime::Cleanup()
         ftimings << w.timing_info();
         ftimings.close();
     }
+
+    if(Tracer::enabled())
+    {
+        Tracer::instance()->write(m_default_output_dir);
+    }
+
+#ifdef ASCENT_MPI_ENABLED
+    // finish any in transit cycles staged by our hola_mpi extracts
+    NodeConstIterator stage_itr = m_hola_mpi_staging.children();
+    while(stage_itr.has_next())
+    {
+        hola_mpi_close_staging(stage_itr.next());
+    }
+#endif
+    m_hola_mpi_staging.reset();
 }
 
 //-----------------------------------------------------------------------------
@@ -1152,8 +1384,6 @@ AscentRuntime::ConnectSource()
     data_node->set_external(m_source);
     m_data_object.reset(data_node);
 
-    SourceFieldFilter();
-
     // note: if the reg entry for data was already added
     // the set_external updates everything,
     // we don't need to remove and re-add.
@@ -1617,6 +1847,14 @@ AscentRuntime::BuildGraph(const conduit::Node &actions)
 //-----------------------------------------------------------------------------
 void
 AscentRuntime::Execute(const conduit::Node &actions)
+{
+    Execute(actions, "");
+}
+
+//-----------------------------------------------------------------------------
+void
+AscentRuntime::Execute(const conduit::Node &actions,
+                       const std::string &actions_token)
 {
     bool log_timings = false;
     if(m_runtime_options.has_child("timings") &&
@@ -1627,6 +1865,8 @@ AscentRuntime::Execute(const conduit::Node &actions)
 
     w.enable_timings(log_timings);
 
+    flow::Timer t_execute;
+
     // catch any errors that come up here and forward
     // them up as a conduit error
 
@@ -1635,40 +1875,59 @@ AscentRuntime::Execute(const conduit::Node &actions)
     {
         ResetInfo();
 
-        conduit::Node diff_info;
-        bool different_actions = m_previous_actions.diff(actions, diff_info);
-
-        if(different_actions)
+        // with a time budget, only the scenes and extracts
+        // the scheduler picks are executed, the others are gated
+        conduit::Node scheduled_actions;
+        std::set<std::string> gated;
+        const conduit::Node *exec_actions = &actions;
+        std::string exec_token = actions_token;
+        if(m_scheduler.enabled())
         {
-          if(m_field_filtering)
+          m_scheduler.schedule(actions, scheduled_actions, gated);
+          exec_actions = &scheduled_actions;
+          // the scheduled actions are the full actions with the
+          // degraded items updated
+          if(!exec_token.empty())
           {
-            // check to see if we can determine what
-            // fields the actions need
-            conduit::Node info;
-            bool success = field_list(actions, m_field_list, info);
-            if(!success)
-            {
-              ASCENT_ERROR("Field filtering failed: "<<info.to_yaml());
-            }
-            if(m_field_list.size() == 0)
-            {
-              ASCENT_ERROR("Field filtering failed to find any fields");
-            }
+            exec_token += m_scheduler.token();
           }
+        }
 
+        // the same actions token means the same actions, so we can
+        // skip the diff (and the copy below)
+        bool same_token = !exec_token.empty() &&
+                          exec_token == m_previous_actions_token;
+        bool different_actions = false;
+        if(!same_token)
+        {
+            conduit::Node diff_info;
+            different_actions = m_previous_actions.diff(*exec_actions,
+                                                        diff_info);
+        }
+
+        if(different_actions)
+        {
           // destroy existing graph an start anew
           w.reset();
           ConnectSource();
-          BuildGraph(actions);
+          BuildGraph(*exec_actions);
+          // work out what fields the new graph needs
+          ResolveFieldList(*exec_actions);
         }
         else
         {
           // always ensure that we have the source
           ConnectSource();
         }
+        SourceFieldFilter();
+        w.gate_filters(gated);
 
 
-        m_previous_actions = actions;
+        if(!same_token)
+        {
+            m_previous_actions = *exec_actions;
+        }
+        m_previous_actions_token = exec_token;
 
         PopulateMetadata(); // add metadata so filters can access it
 
@@ -1676,11 +1935,14 @@ AscentRuntime::Execute(const conduit::Node &actions)
         // about the original mesh (like bounds)
         w.registry().add<DataObject>("source_object", &m_data_object,1);
 
-        w.info(m_info["flow_graph"]);
-        m_info["actions"] = actions;
-        // w.print();
-        // std::cout<<w.graph().to_dot();
-        w.graph().save_dot_html("ascent_flow_graph.html");
+        if(m_eager_introspection)
+        {
+          // query, trigger and expression filters save their
+          // expression graphs when they see this entry
+          w.registry().add<bool>("save_expression_graphs",
+                                 &m_eager_introspection);
+          w.graph().save_dot_html("ascent_flow_graph.html");
+        }
 
 #if defined(ASCENT_VTKM_ENABLED)
         if(log_timings)
@@ -1696,9 +1958,36 @@ AscentRuntime::Execute(const conduit::Node &actions)
           vtkh::DataLogger::GetInstance()->AddLogData("cycle", cycle);
         }
 #endif
+        // one span name for every cycle keeps the tracer's string table
+        // bounded, the cycle is attached as a value
+        TraceScope cycle_trace("cycle");
+        if(Tracer::enabled())
+        {
+          Tracer::instance()->add("cycle",
+                                  m_data_object.state_var("cycle").to_int32());
+          Tracer::instance()->sample_memory();
+        }
+
         // now execute the data flow graph
         w.execute();
 
+        if((m_runtime_options.has_path("memory_accounting") &&
+            m_runtime_options["memory_accounting"].as_string() == "true") ||
+           (m_runtime_options.has_path("memory_aware_scheduling") &&
+            m_runtime_options["memory_aware_scheduling"].as_string() == "true") ||
+           w.memory_budget() > 0)
+        {
+          w.memory_info(m_info["flow_memory"]);
+        }
+
+        if(m_scheduler.enabled())
+        {
+          m_scheduler.record(w, t_execute.elapsed());
+          m_scheduler.info(m_info["schedule"]);
+        }
+
+        cycle_trace.close();
+
 #if defined(ASCENT_VTKM_ENABLED)
         if(log_timings)
         {
@@ -1710,10 +1999,13 @@ AscentRuntime::Execute(const conduit::Node &actions)
           SaveSession();
         }
 
-        Node msg;
-        this->Info(msg["info"]);
-        ascent::about(msg["about"]);
-        m_web_interface.PushMessage(msg);
+        if(m_web_interface.Enabled())
+        {
+          Node msg;
+          this->Info(msg["info"]);
+          ascent::about(msg["about"]);
+          m_web_interface.PushMessage(msg);
+        }
 
         // add render results to info
         Node render_file_names;
@@ -1737,18 +2029,20 @@ AscentRuntime::Execute(const conduit::Node &actions)
             extracts_list->reset();
         }
 
-        // add expression results to info
-        const conduit::Node &expression_cache =
-          runtime::expressions::ExpressionEval::get_cache();
-
-        if(expression_cache.number_of_children() > 0)
+        // remember the hola_mpi stages to close in Cleanup
+        if(w.registry().has_entry("hola_mpi_staging"))
         {
-          runtime::expressions::ExpressionEval::get_last(m_info["expressions"]);
+            Node *staging = w.registry().fetch<Node>("hola_mpi_staging");
+            m_hola_mpi_staging.update(*staging);
+            staging->reset();
         }
 
-        // add flow graphviz details to info
-        m_info["flow_graph_dot"]      = w.graph().to_dot();
-        m_info["flow_graph_dot_html"] = w.graph().to_dot_html();
+        // the graph, actions and expression results are otherwise
+        // only built when Info() asks for them
+        if(m_eager_introspection)
+        {
+          ProduceInfo(m_info);
+        }
 
         m_web_interface.PushRenders(render_file_names);
 
@@ -1827,10 +2121,84 @@ AscentRuntime::RegisterFilterType(const std::string  &role_path,
     }
 }
 
+//-----------------------------------------------------------------------------
+bool
+AscentRuntime::FieldList(const conduit::Node &actions,
+                         std::set<std::string> &fields)
+{
+  // only reads state set by Initialize, so this is safe to call
+  // while the async helper thread executes
+  conduit::Node info;
+  if(!field_list(actions, fields, info))
+  {
+    return false;
+  }
+
+  const int num_ghosts = m_ghost_fields.number_of_children();
+  for(int i = 0; i < num_ghosts; ++i)
+  {
+    fields.insert(m_ghost_fields.child(i).as_string());
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void AscentRuntime::ResolveFieldList(const conduit::Node &actions)
+{
+  m_prune_fields = false;
+  m_field_list.clear();
+
+  if(m_field_filtering == "false")
+  {
+    return;
+  }
+
+  // the fields every filter downstream of the source declares it uses
+  std::set<std::string> fields;
+  bool known = w.graph().fields_needed("source", fields);
+  conduit::Node info;
+
+  if(known)
+  {
+    // any param can be an expression, add the fields they reference
+    std::set<std::string> expr_fields;
+    field_list(actions, expr_fields, info);
+    fields.insert(expr_fields.begin(), expr_fields.end());
+  }
+  else if(m_field_filtering == "true")
+  {
+    // some filter did not declare its fields, so fall
+    // back to scanning the actions for field names
+    if(!field_list(actions, fields, info))
+    {
+      ASCENT_ERROR("Field filtering failed: "<<info.to_yaml());
+    }
+    if(fields.size() == 0)
+    {
+      ASCENT_ERROR("Field filtering failed to find any fields");
+    }
+    known = true;
+  }
+
+  if(!known)
+  {
+    return;
+  }
+
+  const int num_ghosts = m_ghost_fields.number_of_children();
+  for(int i = 0; i < num_ghosts; ++i)
+  {
+    fields.insert(m_ghost_fields.child(i).as_string());
+  }
+
+  m_field_list = fields;
+  m_prune_fields = true;
+}
+
 //-----------------------------------------------------------------------------
 void AscentRuntime::SourceFieldFilter()
 {
-  if(!m_field_filtering)
+  if(!m_prune_fields)
   {
     return;
   }
@@ -57,8 +57,12 @@
 #include <ascent_runtime.hpp>
 #include <ascent_data_object.hpp>
 #include <ascent_web_interface.hpp>
+#include <ascent_action_scheduler.hpp>
 #include <flow.hpp>
 
+#include <functional>
+#include <map>
+
 
 
 //-----------------------------------------------------------------------------
@@ -80,6 +84,10 @@ public:
 
     void  Publish(const conduit::Node &data) override;
     void  Execute(const conduit::Node &actions) override;
+    void  Execute(const conduit::Node &actions,
+                  const std::string &actions_token) override;
+    bool  FieldList(const conduit::Node &actions,
+                    std::set<std::string> &fields) override;
 
     void  Info(conduit::Node &out) override;
 
@@ -106,7 +114,12 @@ private:
     conduit::Node     m_scene_connections;
 
     conduit::Node     m_info;
+    // info entries that are only built when Info() asks for them,
+    // unless introspection is "eager"
+    std::map<std::string,std::function<void(conduit::Node &)>> m_info_producers;
+    bool              m_eager_introspection;
     conduit::Node     m_previous_actions;
+    std::string       m_previous_actions_token;
 
     WebInterface      m_web_interface;
     int               m_refinement_level;
@@ -117,12 +130,21 @@ private:
     std::string       m_session_name;
     conduit::Node     m_save_session_actions;
 
-    bool              m_field_filtering;
+    // "auto", "true" or "false"
+    std::string       m_field_filtering;
+    bool              m_prune_fields;
     std::set<std::string> m_field_list;
 
     conduit::Node     m_comments;
+    // hola_mpi stages (mpi_comm, rank_split) opened by our extracts
+    conduit::Node     m_hola_mpi_staging;
+
+    // picks the scenes and extracts to run under a time budget
+    ActionScheduler   m_scheduler;
 
     void              ResetInfo();
+    void              RegisterInfoProducers();
+    void              ProduceInfo(conduit::Node &out);
 
     flow::Workspace w;
     conduit::Node CreateDefaultFilters();
@@ -148,6 +170,7 @@ private:
     void ConnectSource();
     void ConnectGraphs();
     void SourceFieldFilter();
+    void ResolveFieldList(const conduit::Node &actions);
     void PaintNestsets();
     void VerifyGhosts();
     void SaveSession();
@@ -53,6 +53,11 @@
 #include "ascent_mpi_utils.hpp"
 #include "ascent_logging.hpp"
 
+#include <vtkh/utils/vtkm_dataset_info.hpp>
+#include <vtkm/cont/ArrayHandleCartesianProduct.h>
+#include <vtkm/cont/ArrayHandleSOA.h>
+#include <vtkm/cont/VariantArrayHandle.h>
+
 #if defined(ASCENT_MPI_ENABLED)
 #include <mpi.h>
 #include <conduit_relay_mpi.hpp>
@@ -110,6 +115,98 @@ int global_max(int local)
   return global_count;
 }
 
+//
+// adds the bytes of the array if it holds values of type T
+//
+template<typename T>
+bool add_array_bytes(const vtkm::cont::VariantArrayHandle &array, size_t &bytes)
+{
+  if(array.IsType<vtkm::cont::ArrayHandle<T>>())
+  {
+    bytes += array.GetNumberOfValues() * sizeof(T);
+    return true;
+  }
+  return false;
+}
+
+size_t array_bytes(const vtkm::cont::VariantArrayHandle &array)
+{
+  size_t bytes = 0;
+  if(add_array_bytes<vtkm::Float32>(array, bytes) ||
+     add_array_bytes<vtkm::Float64>(array, bytes) ||
+     add_array_bytes<vtkm::Int8>(array, bytes) ||
+     add_array_bytes<vtkm::UInt8>(array, bytes) ||
+     add_array_bytes<vtkm::Int32>(array, bytes) ||
+     add_array_bytes<vtkm::Int64>(array, bytes) ||
+     add_array_bytes<vtkm::Vec3f_32>(array, bytes) ||
+     add_array_bytes<vtkm::Vec3f_64>(array, bytes))
+  {
+    return bytes;
+  }
+  // other storage (e.g., implicit arrays), assume the default float type
+  return array.GetNumberOfValues()
+         * array.GetNumberOfComponents()
+         * sizeof(vtkm::FloatDefault);
+}
+
+//
+// adds the bytes of rectilinear coordinates with axes of type T
+//
+template<typename T>
+bool add_rectilinear_bytes(const vtkm::cont::VariantArrayHandle &coords,
+                           size_t &bytes)
+{
+  typedef vtkm::cont::ArrayHandle<T> Axis;
+  typedef vtkm::cont::ArrayHandleCartesianProduct<Axis, Axis, Axis> Cartesian;
+  if(coords.IsType<Cartesian>())
+  {
+    Cartesian points = coords.Cast<Cartesian>();
+    bytes += (points.GetFirstArray().GetNumberOfValues() +
+              points.GetSecondArray().GetNumberOfValues() +
+              points.GetThirdArray().GetNumberOfValues()) * sizeof(T);
+    return true;
+  }
+  return false;
+}
+
+//
+// adds the bytes of explicit coordinates with values of type T
+//
+template<typename T>
+bool add_explicit_bytes(const vtkm::cont::VariantArrayHandle &coords,
+                        size_t &bytes)
+{
+  typedef vtkm::Vec<T, 3> Vec3;
+  if(coords.IsType<vtkm::cont::ArrayHandleSOA<Vec3>>() ||
+     coords.IsType<vtkm::cont::ArrayHandle<Vec3>>())
+  {
+    bytes += coords.GetNumberOfValues() * sizeof(Vec3);
+    return true;
+  }
+  return false;
+}
+
+size_t coords_bytes(const vtkm::cont::DataSet &dom)
+{
+  // uniform coordinates are implicit
+  if(vtkh::VTKMDataSetInfo::IsUniform(dom))
+  {
+    return 0;
+  }
+
+  vtkm::cont::VariantArrayHandle coords(dom.GetCoordinateSystem().GetData());
+  size_t bytes = 0;
+  if(add_rectilinear_bytes<vtkm::Float32>(coords, bytes) ||
+     add_rectilinear_bytes<vtkm::Float64>(coords, bytes) ||
+     add_explicit_bytes<vtkm::Float32>(coords, bytes) ||
+     add_explicit_bytes<vtkm::Float64>(coords, bytes))
+  {
+    return bytes;
+  }
+  // other storage, assume the default float type
+  return coords.GetNumberOfValues() * 3 * sizeof(vtkm::FloatDefault);
+}
+
 } // namespace detail
 
 void VTKHCollection::add(vtkh::DataSet &dataset, const std::string topology_name)
@@ -341,6 +438,26 @@ VTKHCollection::by_domain_id()
   return res;
 }
 
+size_t VTKHCollection::memory_usage() const
+{
+  size_t bytes = 0;
+  for(auto it = m_datasets.begin(); it != m_datasets.end(); ++it)
+  {
+    vtkh::DataSet domains = it->second;
+    const int num_domains = domains.GetNumberOfDomains();
+    for(int d = 0; d < num_domains; ++d)
+    {
+      vtkm::cont::DataSet dom = domains.GetDomain(d);
+      bytes += detail::coords_bytes(dom);
+      for(int i = 0; i < dom.GetNumberOfFields(); ++i)
+      {
+        bytes += detail::array_bytes(dom.GetField(i).GetData());
+      }
+    }
+  }
+  return bytes;
+}
+
 int VTKHCollection::number_of_topologies() const
 {
   // this is not perfect. For example, we could
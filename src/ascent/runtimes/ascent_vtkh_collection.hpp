@@ -110,6 +110,11 @@ public:
   // returns the local number of topologies
   int number_of_topologies() const;
 
+  // returns an estimate of the local bytes held by explicit coordinates
+  // and fields, sized by their value types (cell connectivity is not
+  // counted)
+  size_t memory_usage() const;
+
   // returns a new collection without the specified topology
   // this is a shallow copy operation
   VTKHCollection* copy_without_topology(const std::string topology_name);
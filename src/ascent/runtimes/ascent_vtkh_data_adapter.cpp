@@ -522,18 +522,213 @@ void VTKmCellShape(const std::string shape_type,
   }
 }
 
+// 64 bit FNV-1a style hash of an array's values, mixed a word at a time
+uint64 content_hash(const conduit::Node &node)
+{
+  const uint64 prime = 1099511628211ULL;
+  uint64 hash = 14695981039346656037ULL;
+  const conduit::DataType &dtype = node.dtype();
+  const index_t num_elements = dtype.number_of_elements();
+  const index_t ele_bytes = dtype.element_bytes();
+
+  auto mix = [&](const unsigned char *bytes, const index_t size)
+  {
+    index_t i = 0;
+    for(; i + 8 <= size; i += 8)
+    {
+      uint64 word;
+      memcpy(&word, bytes + i, 8);
+      hash = (hash ^ word) * prime;
+    }
+    for(; i < size; ++i)
+    {
+      hash = (hash ^ bytes[i]) * prime;
+    }
+  };
+
+  if(dtype.is_compact())
+  {
+    mix(static_cast<const unsigned char *>(node.data_ptr()),
+        num_elements * ele_bytes);
+  }
+  else
+  {
+    for(index_t i = 0; i < num_elements; ++i)
+    {
+      mix(static_cast<const unsigned char *>(node.element_ptr(i)), ele_bytes);
+    }
+  }
+  return hash;
+}
+
+// arrays are recorded by size, address (when by_address is set) and a
+// hash of their values (when hash_values is set), everything small
+// enough is recorded by value
+void mesh_signature(const conduit::Node &node,
+                    bool by_address,
+                    bool hash_values,
+                    conduit::Node &sig)
+{
+  const index_t num_children = node.number_of_children();
+  if(num_children == 0)
+  {
+    const conduit::DataType &dtype = node.dtype();
+    if(dtype.is_string() || dtype.number_of_elements() <= 16)
+    {
+      sig["value"] = node;
+    }
+    else
+    {
+      sig["type"] = (int64) dtype.id();
+      sig["bytes"] = (int64) dtype.spanned_bytes();
+      if(by_address)
+      {
+        sig["ptr"] = (uint64) node.data_ptr();
+      }
+      if(hash_values)
+      {
+        sig["hash"] = content_hash(node);
+      }
+    }
+    return;
+  }
+
+  NodeConstIterator itr = node.children();
+  while(itr.has_next())
+  {
+    const conduit::Node &child = itr.next();
+    const std::string name = node.dtype().is_object() ?
+                             itr.name() : std::to_string(itr.index());
+    mesh_signature(child, by_address, hash_values, sig[name]);
+  }
+}
+
 };
 //-----------------------------------------------------------------------------
 // -- end detail:: --
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+// VTKHMeshCache
+//-----------------------------------------------------------------------------
+struct VTKHMeshCache::Entry
+{
+  conduit::Node       m_sig;
+  vtkm::cont::DataSet m_mesh;
+  int                 m_neles;
+  int                 m_nverts;
+  bool                m_used;
+};
+
+VTKHMeshCache::VTKHMeshCache()
+  : m_hits(0),
+    m_misses(0)
+{
+}
+
+void
+VTKHMeshCache::signature(const conduit::Node &dom,
+                         const std::string &topo_name,
+                         bool zero_copy,
+                         bool hash_values,
+                         conduit::Node &sig)
+{
+  sig.reset();
+  const conduit::Node &n_topo = dom["topologies/" + topo_name];
+  const std::string coords_name = n_topo["coordset"].as_string();
+
+  // zero copied meshes reference the arrays, so they must be the same
+  // arrays. copied meshes only need the same values
+  const bool by_address = zero_copy;
+  hash_values = hash_values || !zero_copy;
+
+  detail::mesh_signature(n_topo, by_address, hash_values, sig["topology"]);
+  detail::mesh_signature(dom["coordsets/" + coords_name],
+                         by_address,
+                         hash_values,
+                         sig["coordset"]);
+
+  if(dom.has_path("state/mesh_generation"))
+  {
+    sig["generation"] = dom["state/mesh_generation"].to_int64();
+  }
+}
+
+bool
+VTKHMeshCache::find(int domain_id,
+                    const std::string &topo_name,
+                    const conduit::Node &sig,
+                    vtkm::cont::DataSet &mesh,
+                    int &neles,
+                    int &nverts)
+{
+  auto it = m_entries.find(std::make_pair(domain_id, topo_name));
+  conduit::Node info;
+  if(it == m_entries.end() || it->second->m_sig.diff(sig, info, 0.0))
+  {
+    m_misses++;
+    return false;
+  }
+
+  Entry &entry = *it->second;
+  entry.m_used = true;
+  // a shallow copy, the cell set and coordinates are shared
+  mesh = entry.m_mesh;
+  neles = entry.m_neles;
+  nverts = entry.m_nverts;
+  m_hits++;
+  return true;
+}
+
+void
+VTKHMeshCache::insert(int domain_id,
+                      const std::string &topo_name,
+                      const conduit::Node &sig,
+                      const vtkm::cont::DataSet &mesh,
+                      int neles,
+                      int nverts)
+{
+  std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+  entry->m_sig.set(sig);
+  entry->m_mesh = mesh;
+  entry->m_neles = neles;
+  entry->m_nverts = nverts;
+  entry->m_used = true;
+  m_entries[std::make_pair(domain_id, topo_name)] = entry;
+}
+
+void
+VTKHMeshCache::prune()
+{
+  for(auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    if(!it->second->m_used)
+    {
+      it = m_entries.erase(it);
+    }
+    else
+    {
+      it->second->m_used = false;
+      ++it;
+    }
+  }
+}
+
+void
+VTKHMeshCache::clear()
+{
+  m_entries.clear();
+}
+
 //-----------------------------------------------------------------------------
 // VTKHDataAdapter public methods
 //-----------------------------------------------------------------------------
 
 VTKHCollection*
 VTKHDataAdapter::BlueprintToVTKHCollection(const conduit::Node &n,
-                                           bool zero_copy)
+                                           bool zero_copy,
+                                           VTKHMeshCache *mesh_cache,
+                                           bool hash_mesh_values)
 {
     // We must separate different topologies into
     // different vtkh data sets
@@ -570,13 +765,41 @@ VTKHDataAdapter::BlueprintToVTKHCollection(const conduit::Node &n,
       for(int t = 0; t < topo_names.size(); ++t)
       {
         const std::string topo_name = topo_names[t];
-        vtkm::cont::DataSet *dset = BlueprintToVTKmDataSet(dom, zero_copy, topo_name);
+        vtkm::cont::DataSet *dset = nullptr;
+        if(mesh_cache != nullptr)
+        {
+          conduit::Node sig;
+          VTKHMeshCache::signature(dom,
+                                   topo_name,
+                                   zero_copy,
+                                   hash_mesh_values,
+                                   sig);
+          int neles = 0;
+          int nverts = 0;
+          dset = new vtkm::cont::DataSet();
+          if(!mesh_cache->find(domain_id, topo_name, sig, *dset, neles, nverts))
+          {
+            delete dset;
+            dset = BlueprintToVTKmMesh(dom, zero_copy, topo_name, neles, nverts);
+            mesh_cache->insert(domain_id, topo_name, sig, *dset, neles, nverts);
+          }
+          AddFields(dom, topo_name, neles, nverts, dset, zero_copy);
+        }
+        else
+        {
+          dset = BlueprintToVTKmDataSet(dom, zero_copy, topo_name);
+        }
         datasets[topo_name].AddDomain(*dset,domain_id);
         delete dset;
       }
 
     }
 
+    if(mesh_cache != nullptr)
+    {
+      mesh_cache->prune();
+    }
+
     for(auto dset_it : datasets)
     {
       res->add(dset_it.second, dset_it.first);
@@ -639,7 +862,26 @@ VTKHDataAdapter::VTKmDataSetToVTKHDataSet(vtkm::cont::DataSet *dset)
 vtkm::cont::DataSet *
 VTKHDataAdapter::BlueprintToVTKmDataSet(const Node &node,
                                         bool zero_copy,
-                                        const std::string &topo_name_str)
+                                        const std::string &topo_name)
+{
+    int neles  = 0;
+    int nverts = 0;
+    vtkm::cont::DataSet *result = BlueprintToVTKmMesh(node,
+                                                      zero_copy,
+                                                      topo_name,
+                                                      neles,
+                                                      nverts);
+    AddFields(node, topo_name, neles, nverts, result, zero_copy);
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+vtkm::cont::DataSet *
+VTKHDataAdapter::BlueprintToVTKmMesh(const Node &node,
+                                     bool zero_copy,
+                                     const std::string &topo_name_str,
+                                     int &neles,
+                                     int &nverts)
 {
     vtkm::cont::DataSet * result = NULL;
 
@@ -659,8 +901,8 @@ VTKHDataAdapter::BlueprintToVTKmDataSet(const Node &node,
     string coords_name   = n_topo["coordset"].as_string();
     const Node &n_coords = node["coordsets"][coords_name];
 
-    int neles  = 0;
-    int nverts = 0;
+    neles  = 0;
+    nverts = 0;
 
     if( mesh_type ==  "uniform")
     {
@@ -707,7 +949,18 @@ VTKHDataAdapter::BlueprintToVTKmDataSet(const Node &node,
         ASCENT_ERROR("Unsupported topology/type:" << mesh_type);
     }
 
+    return result;
+}
 
+//-----------------------------------------------------------------------------
+void
+VTKHDataAdapter::AddFields(const Node &node,
+                           const std::string &topo_name,
+                           int neles,
+                           int nverts,
+                           vtkm::cont::DataSet *result,
+                           bool zero_copy)
+{
     if(node.has_child("fields"))
     {
         // add all of the fields:
@@ -766,7 +1019,6 @@ VTKHDataAdapter::BlueprintToVTKmDataSet(const Node &node,
             }
         }
     }
-    return result;
 }
 
 
@@ -2272,6 +2524,79 @@ void VTKHDataAdapter::VTKHCollectionToBlueprintDataSet(VTKHCollection *collectio
   }
 }
 
+void
+VTKHDataAdapter::VTKHCollectionToBlueprintView(VTKHCollection *collection,
+                                               const std::string &topo_name,
+                                               const std::vector<std::string> &field_names,
+                                               conduit::Node &node,
+                                               bool zero_copy)
+{
+  bool success = true;
+
+  // index the domains we already have so new pieces end up next
+  // to the ones converted by earlier requests
+  std::map<int, conduit::Node*> domains;
+  const int num_existing = node.number_of_children();
+  for(int i = 0; i < num_existing; ++i)
+  {
+    conduit::Node &dom = node.child(i);
+    domains[dom["state/domain_id"].to_int32()] = &dom;
+  }
+
+  try
+  {
+    vtkh::DataSet &vtkh_dset = collection->dataset_by_topology(topo_name);
+    const int num_doms = vtkh_dset.GetNumberOfDomains();
+    for(int i = 0; i < num_doms; ++i)
+    {
+      vtkm::cont::DataSet vtkm_dom;
+      vtkm::Id domain_id;
+      vtkh_dset.GetDomain(i, vtkm_dom, domain_id);
+
+      conduit::Node *dom = nullptr;
+      auto dom_it = domains.find((int) domain_id);
+      if(dom_it == domains.end())
+      {
+        dom = &node.append();
+        (*dom)["state/domain_id"] = (int) domain_id;
+        domains[(int) domain_id] = dom;
+      }
+      else
+      {
+        dom = dom_it->second;
+      }
+
+      if(!dom->has_path("topologies/" + topo_name))
+      {
+        bool is_empty = VTKmTopologyToBlueprint(*dom, vtkm_dom, topo_name, zero_copy);
+        if(is_empty)
+        {
+          continue;
+        }
+      }
+
+      for(size_t f = 0; f < field_names.size(); ++f)
+      {
+        const std::string &fname = field_names[f];
+        if(!dom->has_path("fields/" + fname) && vtkm_dom.HasField(fname))
+        {
+          VTKmFieldToBlueprint(*dom, vtkm_dom.GetField(fname), topo_name, zero_copy);
+        }
+      }
+    }
+  }
+  catch(...)
+  {
+    success = false;
+  }
+
+  success = global_agreement(success);
+  if(!success)
+  {
+    ASCENT_ERROR("Failed to convert vtkm data set to blueprint");
+  }
+}
+
 void
 VTKHDataAdapter::VTKHToBlueprintDataSet(vtkh::DataSet *dset,
                                         conduit::Node &node,
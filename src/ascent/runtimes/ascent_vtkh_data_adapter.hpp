@@ -76,6 +76,9 @@ class DataSet;
 // conduit includes
 #include <conduit.hpp>
 
+#include <map>
+#include <memory>
+
 
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
@@ -83,6 +86,66 @@ class DataSet;
 namespace ascent
 {
 
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// Keeps the vtkm coordinate systems and cell sets built for each
+// (domain, topology) so later cycles with an unchanged mesh only
+// rebind their fields.
+//
+// A mesh counts as unchanged when its coordset and topology arrays have
+// the same data pointers and sizes, their small values (types, dims,
+// origins, ...) are equal, and the domain's optional
+// 'state/mesh_generation' has not changed. Simulations that move their
+// coordinates in place must bump 'state/mesh_generation'.
+//
+// Memory that Ascent owns (its own conversions, async snapshots) is
+// reused for new values, so those meshes also compare a hash of their
+// array values. Meshes that were copied (zero_copy off) hold their own
+// arrays and are matched by values alone.
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+class ASCENT_API VTKHMeshCache
+{
+public:
+    VTKHMeshCache();
+
+    // builds the signature used to detect mesh changes
+    static void signature(const conduit::Node &dom,
+                          const std::string &topo_name,
+                          bool zero_copy,
+                          bool hash_values,
+                          conduit::Node &sig);
+
+    // copies the cached mesh (with no fields) into 'mesh' if
+    // its signature still matches
+    bool find(int domain_id,
+              const std::string &topo_name,
+              const conduit::Node &sig,
+              vtkm::cont::DataSet &mesh,
+              int &neles,
+              int &nverts);
+
+    void insert(int domain_id,
+                const std::string &topo_name,
+                const conduit::Node &sig,
+                const vtkm::cont::DataSet &mesh,
+                int neles,
+                int nverts);
+
+    // drops meshes that were not looked up since the last call
+    void prune();
+    void clear();
+
+    int hits() const   { return m_hits; }
+    int misses() const { return m_misses; }
+
+private:
+    struct Entry;
+    std::map<std::pair<int,std::string>, std::shared_ptr<Entry>> m_entries;
+    int m_hits;
+    int m_misses;
+};
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 // Class that Handles Blueprint to vtk-h, VTKm Data Transforms
@@ -97,8 +160,15 @@ public:
     // Convert a multi-domain blueprint data set to a VTKHCollection
     //  assumes: conduit::blueprint::mesh::verify(n,info) == true
     //
+    //  when a mesh cache is passed, meshes that are unchanged since
+    //  the last conversion are reused and only their fields are added.
+    //  hash_mesh_values also compares the mesh array values, for
+    //  memory that is reused for new values
+    //
     static VTKHCollection* BlueprintToVTKHCollection(const conduit::Node &n,
-                                                     bool zero_copy);
+                                                     bool zero_copy,
+                                                     VTKHMeshCache *mesh_cache = nullptr,
+                                                     bool hash_mesh_values = false);
     // convert blueprint data to a vtkh Data Set
     // assumes "n" conforms to the mesh blueprint
     //
@@ -135,7 +205,33 @@ public:
     static void              VTKHCollectionToBlueprintDataSet(VTKHCollection *collection,
                                                               conduit::Node &node,
                                                               bool zero_copy = false);
+
+    // converts one topology (with its coordset) and the listed fields
+    // associated with it, merging them into the domains already in 'node'
+    // (matched by state/domain_id). Pieces already present in a domain
+    // are not converted again. Collective, since failures are agreed on
+    // across ranks
+    static void              VTKHCollectionToBlueprintView(VTKHCollection *collection,
+                                                           const std::string &topo_name,
+                                                           const std::vector<std::string> &field_names,
+                                                           conduit::Node &node,
+                                                           bool zero_copy = false);
 private:
+    // converts the coordset and topology only
+    static vtkm::cont::DataSet  *BlueprintToVTKmMesh(const conduit::Node &n,
+                                                     bool zero_copy,
+                                                     const std::string &topo_name,
+                                                     int &neles,
+                                                     int &nverts);
+
+    // adds the fields associated with topo_name
+    static void                  AddFields(const conduit::Node &n,
+                                           const std::string &topo_name,
+                                           int neles,
+                                           int nverts,
+                                           vtkm::cont::DataSet *dset,
+                                           bool zero_copy);
+
     // helpers for specific conversion cases
     static vtkm::cont::DataSet  *UniformBlueprintToVTKmDataSet(const std::string &coords_name,
                                                                const conduit::Node &n_coords,
@@ -60,6 +60,7 @@
 #include <cmath>
 #include <cstring>
 #include <limits>
+#include <vector>
 
 #include <flow_workspace.hpp>
 
@@ -112,57 +113,6 @@ at_least_one(bool local)
   return agreement;
 }
 
-struct UniformCoords
-{
-  conduit::float64 m_origin[3] = {0., 0., 0.};
-  conduit::float64 m_spacing[3] = {1., 1., 1.};
-  int m_dims[3] = {0, 0, 0};
-  bool m_is_2d = true;
-
-  UniformCoords(const conduit::Node &n_coords)
-  {
-    populate(n_coords);
-  }
-
-  void
-  populate(const conduit::Node &n_coords)
-  {
-
-    const conduit::Node &n_dims = n_coords["dims"];
-
-    m_dims[0] = n_dims["i"].to_int();
-    m_dims[1] = n_dims["j"].to_int();
-    m_dims[2] = 1;
-
-    // check for 3d
-    if(n_dims.has_path("k"))
-    {
-      m_dims[2] = n_dims["k"].to_int();
-      m_is_2d = false;
-    }
-
-    const conduit::Node &n_origin = n_coords["origin"];
-
-    m_origin[0] = n_origin["x"].to_float64();
-    m_origin[1] = n_origin["y"].to_float64();
-
-    if(n_origin.has_child("z"))
-    {
-      m_origin[2] = n_origin["z"].to_float64();
-    }
-
-    const conduit::Node &n_spacing = n_coords["spacing"];
-
-    m_spacing[0] = n_spacing["dx"].to_float64();
-    m_spacing[1] = n_spacing["dy"].to_float64();
-
-    if(n_spacing.has_path("dz"))
-    {
-      m_spacing[2] = n_spacing["dz"].to_float64();
-    }
-  }
-};
-
 int
 get_num_indices(const std::string &shape_type)
 {
@@ -210,328 +160,410 @@ logical_index_3d(int *idx, const int vert_index, const int *dims)
 }
 
 void
-get_element_indices(const conduit::Node &n_topo,
-                    const int index,
-                    std::vector<int> &indices)
+logical_index(int *idx, const int index, const int *dims, const int num_dims)
 {
-
-  const std::string mesh_type = n_topo["type"].as_string();
-  if(mesh_type == "unstructured")
+  idx[0] = index;
+  idx[1] = 0;
+  idx[2] = 0;
+  if(num_dims == 2)
   {
-    // supports only single element type
-    const conduit::Node &n_topo_eles = n_topo["elements"];
-
-    // get the shape
-    const std::string ele_shape = n_topo_eles["shape"].as_string();
-    const int num_indices = get_num_indices(ele_shape);
-
-    indices.resize(num_indices);
-    // look up the connectivity
-    const conduit::Node &n_topo_conn = n_topo_eles["connectivity"];
-    const conduit::int32_array conn_a = n_topo_conn.value();
-    const int offset = index * num_indices;
-    for(int i = 0; i < num_indices; ++i)
-    {
-      indices[i] = conn_a[offset + i];
-    }
+    logical_index_2d(idx, index, dims);
   }
-  else
+  else if(num_dims == 3)
   {
-    bool is_2d = true;
-    int vert_dims[3] = {0, 0, 0};
-    vert_dims[0] = n_topo["elements/dims/i"].to_int32() + 1;
-    vert_dims[1] = n_topo["elements/dims/j"].to_int32() + 1;
-
-    if(n_topo.has_path("elements/dims/k"))
-    {
-      vert_dims[2] = n_topo["elements/dims/k"].to_int32() + 1;
-      is_2d = false;
-    }
-
-    const int element_dims[3] = {
-        vert_dims[0] - 1, vert_dims[1] - 1, vert_dims[2] - 1};
-
-    int element_index[3] = {0, 0, 0};
-    if(is_2d)
-    {
-      indices.resize(4);
-      logical_index_2d(element_index, index, element_dims);
-
-      indices[0] = element_index[1] * vert_dims[0] + element_index[0];
-      indices[1] = indices[0] + 1;
-      indices[2] = indices[1] + vert_dims[0];
-      indices[3] = indices[2] - 1;
-    }
-    else
-    {
-      indices.resize(8);
-      logical_index_3d(element_index, index, element_dims);
-
-      indices[0] =
-          (element_index[2] * vert_dims[1] + element_index[1]) * vert_dims[0] +
-          element_index[0];
-      indices[1] = indices[0] + 1;
-      indices[2] = indices[1] + vert_dims[1];
-      indices[3] = indices[2] - 1;
-      indices[4] = indices[0] + vert_dims[0] * vert_dims[2];
-      indices[5] = indices[4] + 1;
-      indices[6] = indices[5] + vert_dims[1];
-      indices[7] = indices[6] - 1;
-    }
+    logical_index_3d(idx, index, dims);
   }
 }
 
-conduit::Node
-get_uniform_vert(const conduit::Node &n_coords, const int &index)
+// min and max of a coordinate array in a single pass
+template <typename T>
+void
+axis_bounds(const conduit::DataArray<T> &values, double &min_val, double &max_val)
 {
+  const int size = values.number_of_elements();
+  T min_v = std::numeric_limits<T>::max();
+  T max_v = std::numeric_limits<T>::lowest();
 
-  UniformCoords coords(n_coords);
-
-  int logical_index[3] = {0, 0, 0};
-
-  if(coords.m_is_2d)
-  {
-    logical_index_2d(logical_index, index, coords.m_dims);
-  }
-  else
+  if(size == 0)
   {
-    logical_index_3d(logical_index, index, coords.m_dims);
+    return;
   }
 
-  double vert[3];
-  vert[0] = coords.m_origin[0] + logical_index[0] * coords.m_spacing[0];
-  vert[1] = coords.m_origin[1] + logical_index[1] * coords.m_spacing[1];
-  vert[2] = coords.m_origin[2] + logical_index[2] * coords.m_spacing[2];
-
-  conduit::Node res;
-  res.set(vert, 3);
-  return res;
-}
-
-conduit::Node
-get_explicit_vert(const conduit::Node &n_coords, const int &index)
-{
-  bool is_float64 = true;
-  if(n_coords["values/x"].dtype().is_float32())
-  {
-    is_float64 = false;
-  }
-  double vert[3] = {0., 0., 0.};
-  if(is_float64)
+  if(values.dtype().is_compact())
   {
-    conduit::float64_array x_a = n_coords["values/x"].value();
-    conduit::float64_array y_a = n_coords["values/y"].value();
-    vert[0] = x_a[index];
-    vert[1] = y_a[index];
-    if(n_coords.has_path("values/z"))
+    const T *ptr = static_cast<const T *>(values.element_ptr(0));
+#ifdef ASCENT_USE_OPENMP
+#pragma omp parallel for simd reduction(min:min_v) reduction(max:max_v)
+#endif
+    for(int i = 0; i < size; ++i)
     {
-      conduit::float64_array z_a = n_coords["values/z"].value();
-      vert[2] = z_a[index];
+      min_v = std::min(min_v, ptr[i]);
+      max_v = std::max(max_v, ptr[i]);
     }
   }
   else
   {
-    conduit::float32_array x_a = n_coords["values/x"].value();
-    conduit::float32_array y_a = n_coords["values/y"].value();
-    vert[0] = x_a[index];
-    vert[1] = y_a[index];
-    if(n_coords.has_path("values/z"))
+    // interleaved coordinates
+#ifdef ASCENT_USE_OPENMP
+#pragma omp parallel for reduction(min:min_v) reduction(max:max_v)
+#endif
+    for(int i = 0; i < size; ++i)
     {
-      conduit::float32_array z_a = n_coords["values/z"].value();
-      vert[2] = z_a[index];
+      const T val = values[i];
+      min_v = std::min(min_v, val);
+      max_v = std::max(max_v, val);
     }
   }
 
-  conduit::Node res;
-  res.set(vert, 3);
-  return res;
+  min_val = std::min(min_val, double(min_v));
+  max_val = std::max(max_val, double(max_v));
 }
 
-conduit::Node
-get_rectilinear_vert(const conduit::Node &n_coords, const int &index)
+// Typed view of a topology and its coordset in a single domain. The node
+// paths, dims and coordinate arrays are resolved once when the view is
+// created, so per vertex and per element queries only index into arrays.
+// Create one view per domain and reuse it for every index.
+class MeshView
 {
-  bool is_float64 = true;
-
-  int dims[3] = {0, 0, 0};
-  dims[0] = n_coords["values/x"].dtype().number_of_elements();
-  dims[1] = n_coords["values/y"].dtype().number_of_elements();
-
-  if(n_coords.has_path("values/z"))
-  {
-    dims[2] = n_coords["values/z"].dtype().number_of_elements();
-  }
-
-  if(n_coords["values/x"].dtype().is_float32())
+public:
+  MeshView(const conduit::Node &domain, const std::string &topo_name)
   {
-    is_float64 = false;
-  }
-  double vert[3] = {0., 0., 0.};
+    if(!domain.has_path("topologies/" + topo_name))
+    {
+      ASCENT_ERROR("The Architect: topology '" << topo_name
+                   << "' not found in domain");
+    }
 
-  int logical_index[3] = {0, 0, 0};
+    const conduit::Node &n_topo = domain["topologies/" + topo_name];
+    const std::string topo_type = n_topo["type"].as_string();
+    const std::string coords_name = n_topo["coordset"].as_string();
+    const conduit::Node &n_coords = domain["coordsets/" + coords_name];
+    const std::string coords_type = n_coords["type"].as_string();
 
-  if(dims[2] == 0)
-  {
-    logical_index_2d(logical_index, index, dims);
-  }
-  else
-  {
-    logical_index_3d(logical_index, index, dims);
-  }
+    const std::string logical[3] = {"i", "j", "k"};
+    const std::string spacing[3] = {"dx", "dy", "dz"};
+    const std::string axes[3] = {"x", "y", "z"};
 
-  if(is_float64)
-  {
-    conduit::float64_array x_a = n_coords["values/x"].value();
-    conduit::float64_array y_a = n_coords["values/y"].value();
-    vert[0] = x_a[logical_index[0]];
-    vert[1] = y_a[logical_index[1]];
-    if(dims[2] != 0)
+    if(coords_type == "uniform")
     {
-      conduit::float64_array z_a = n_coords["values/z"].value();
-      vert[2] = z_a[logical_index[2]];
+      m_coords_type = CoordsType::Uniform;
+      const conduit::Node &n_dims = n_coords["dims"];
+      m_num_dims = n_dims.number_of_children();
+      for(int i = 0; i < m_num_dims; ++i)
+      {
+        m_dims[i] = n_dims[logical[i]].to_int();
+        if(n_coords.has_path("origin/" + axes[i]))
+        {
+          m_origin[i] = n_coords["origin/" + axes[i]].to_float64();
+        }
+        if(n_coords.has_path("spacing/" + spacing[i]))
+        {
+          m_spacing[i] = n_coords["spacing/" + spacing[i]].to_float64();
+        }
+      }
     }
-  }
-  else
-  {
-    conduit::float32_array x_a = n_coords["values/x"].value();
-    conduit::float32_array y_a = n_coords["values/y"].value();
-    vert[0] = x_a[logical_index[0]];
-    vert[1] = y_a[logical_index[1]];
-    if(dims[2] != 0)
+    else if(coords_type == "rectilinear" || coords_type == "explicit")
+    {
+      m_coords_type = coords_type == "explicit" ? CoordsType::Explicit
+                                                : CoordsType::Rectilinear;
+      const conduit::Node &n_values = n_coords["values"];
+      m_num_dims = n_values.number_of_children();
+      m_is_float64 = !n_values.child(0).dtype().is_float32();
+      for(int i = 0; i < m_num_dims; ++i)
+      {
+        const conduit::Node &n_axis = n_values.child(i);
+        if(m_is_float64)
+        {
+          m_coords64[i] = n_axis.value();
+        }
+        else
+        {
+          m_coords32[i] = n_axis.value();
+        }
+        m_dims[i] = n_axis.dtype().number_of_elements();
+      }
+    }
+    else
     {
-      conduit::float32_array z_a = n_coords["values/z"].value();
-      vert[2] = z_a[logical_index[2]];
+      ASCENT_ERROR("The Architect: unknown coordset type: '"
+                   << coords_type << "'");
     }
-  }
-
-  conduit::Node res;
-  res.set(vert, 3);
-  return res;
-}
-// ----------------------  element locations ---------------------------------
-conduit::Node
-get_uniform_element(const conduit::Node &n_coords, const int &index)
-{
 
-  UniformCoords coords(n_coords);
+    if(m_num_dims < 1 || m_num_dims > 3)
+    {
+      ASCENT_ERROR("The Architect: topology '" << topo_name << "' with "
+                   << m_num_dims << " dimensions is not supported.");
+    }
 
-  int logical_index[3] = {0, 0, 0};
-  const int element_dims[3] = {
-      coords.m_dims[0] - 1, coords.m_dims[1] - 1, coords.m_dims[2] - 1};
+    m_num_points = m_dims[0];
+    if(m_coords_type != CoordsType::Explicit)
+    {
+      for(int i = 1; i < m_num_dims; ++i)
+      {
+        m_num_points *= m_dims[i];
+      }
+    }
 
-  if(coords.m_is_2d)
-  {
-    logical_index_2d(logical_index, index, element_dims);
+    if(topo_type == "uniform" || topo_type == "rectilinear")
+    {
+      m_topo_type = TopoType::Grid;
+      m_num_cells = 1;
+      for(int i = 0; i < m_num_dims; ++i)
+      {
+        m_num_cells *= m_dims[i] - 1;
+      }
+    }
+    else if(topo_type == "structured")
+    {
+      m_topo_type = TopoType::Structured;
+      const conduit::Node &n_dims = n_topo["elements/dims"];
+      m_num_cells = 1;
+      m_topo_num_dims = n_dims.number_of_children();
+      for(int i = 0; i < m_topo_num_dims; ++i)
+      {
+        const int cells = n_dims[logical[i]].to_int();
+        m_num_cells *= cells;
+        m_topo_dims[i] = cells + 1;
+      }
+    }
+    else if(topo_type == "unstructured")
+    {
+      m_topo_type = TopoType::Unstructured;
+      // supports only single element type
+      const conduit::Node &n_eles = n_topo["elements"];
+      m_shape_size = get_num_indices(n_eles["shape"].as_string());
+      m_conn = n_eles["connectivity"].value();
+      m_num_cells = m_conn.number_of_elements() / m_shape_size;
+    }
+    else if(topo_type == "points")
+    {
+      m_topo_type = TopoType::Points;
+      m_num_cells = m_num_points;
+    }
+    else
+    {
+      ASCENT_ERROR("The Architect: unknown topology type: '"
+                   << topo_type << "'");
+    }
   }
-  else
+
+  int
+  num_points() const
   {
-    logical_index_3d(logical_index, index, element_dims);
+    return m_num_points;
   }
 
-  // element logical index will be the lower left point index
-
-  double vert[3] = {0., 0., 0.};
-  vert[0] = coords.m_origin[0] + logical_index[0] * coords.m_spacing[0] +
-            coords.m_spacing[0] * 0.5;
-  vert[1] = coords.m_origin[1] + logical_index[1] * coords.m_spacing[1] +
-            coords.m_spacing[1] * 0.5;
-  vert[2] = coords.m_origin[2] + logical_index[2] * coords.m_spacing[2] +
-            coords.m_spacing[2] * 0.5;
-
-  conduit::Node res;
-  res.set(vert, 3);
-  return res;
-}
-
-conduit::Node
-get_rectilinear_element(const conduit::Node &n_coords, const int &index)
-{
-  bool is_float64 = true;
-
-  int dims[3] = {0, 0, 0};
-  dims[0] = n_coords["values/x"].dtype().number_of_elements();
-  dims[1] = n_coords["values/y"].dtype().number_of_elements();
-
-  if(n_coords.has_path("values/z"))
+  int
+  num_cells() const
   {
-    dims[2] = n_coords["values/z"].dtype().number_of_elements();
+    return m_num_cells;
   }
 
-  if(n_coords["values/x"].dtype().is_float32())
+  void
+  vertex(const int index, double *loc) const
   {
-    is_float64 = false;
+    loc[0] = 0.;
+    loc[1] = 0.;
+    loc[2] = 0.;
+    if(m_coords_type == CoordsType::Explicit)
+    {
+      for(int i = 0; i < m_num_dims; ++i)
+      {
+        loc[i] = coord(i, index);
+      }
+      return;
+    }
+
+    int idx[3];
+    logical_index(idx, index, m_dims, m_num_dims);
+    for(int i = 0; i < m_num_dims; ++i)
+    {
+      if(m_coords_type == CoordsType::Uniform)
+      {
+        loc[i] = m_origin[i] + idx[i] * m_spacing[i];
+      }
+      else
+      {
+        loc[i] = coord(i, idx[i]);
+      }
+    }
   }
-  const int element_dims[3] = {dims[0] - 1, dims[1] - 1, dims[2] - 1};
 
-  double vert[3] = {0., 0., 0.};
+  // the element centroid
+  void
+  element(const int index, double *loc) const
+  {
+    if(m_topo_type == TopoType::Points)
+    {
+      vertex(index, loc);
+      return;
+    }
 
-  int logical_index[3] = {0, 0, 0};
+    loc[0] = 0.;
+    loc[1] = 0.;
+    loc[2] = 0.;
+    if(m_topo_type == TopoType::Grid)
+    {
+      const int element_dims[3] = {m_dims[0] - 1, m_dims[1] - 1, m_dims[2] - 1};
+      int idx[3];
+      logical_index(idx, index, element_dims, m_num_dims);
+      for(int i = 0; i < m_num_dims; ++i)
+      {
+        if(m_coords_type == CoordsType::Uniform)
+        {
+          loc[i] = m_origin[i] + (idx[i] + 0.5) * m_spacing[i];
+        }
+        else
+        {
+          loc[i] = (coord(i, idx[i]) + coord(i, idx[i] + 1)) * 0.5;
+        }
+      }
+      return;
+    }
 
-  if(dims[2] == 0)
-  {
-    logical_index_2d(logical_index, index, element_dims);
+    int indices[8];
+    const int num_indices = element_indices(index, indices);
+    for(int v = 0; v < num_indices; ++v)
+    {
+      double vert[3];
+      vertex(indices[v], vert);
+      loc[0] += vert[0];
+      loc[1] += vert[1];
+      loc[2] += vert[2];
+    }
+    loc[0] /= double(num_indices);
+    loc[1] /= double(num_indices);
+    loc[2] /= double(num_indices);
   }
-  else
+
+  // fills 'out' with one coordinate of every vertex
+  void
+  vertex_coords(const int axis, double *out) const
   {
-    logical_index_3d(logical_index, index, element_dims);
+    const int size = m_num_points;
+#ifdef ASCENT_USE_OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < size; ++i)
+    {
+      double loc[3];
+      vertex(i, loc);
+      out[i] = loc[axis];
+    }
   }
 
-  if(is_float64)
+  // fills 'out' with one coordinate of every element centroid
+  void
+  element_coords(const int axis, double *out) const
   {
-    conduit::float64_array x_a = n_coords["values/x"].value();
-    conduit::float64_array y_a = n_coords["values/y"].value();
-    vert[0] = (x_a[logical_index[0]] + x_a[logical_index[0] + 1]) * 0.5;
-    vert[1] = (y_a[logical_index[1]] + y_a[logical_index[1] + 1]) * 0.5;
-    if(dims[2] != 0)
+    const int size = m_num_cells;
+#ifdef ASCENT_USE_OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < size; ++i)
     {
-      conduit::float64_array z_a = n_coords["values/z"].value();
-      vert[2] = (z_a[logical_index[2]] + z_a[logical_index[2] + 1]) * 0.5;
+      double loc[3];
+      element(i, loc);
+      out[i] = loc[axis];
     }
   }
-  else
+
+  // expands min_coords / max_coords by the bounds of this mesh
+  void
+  bounds(double *min_coords, double *max_coords) const
   {
-    conduit::float32_array x_a = n_coords["values/x"].value();
-    conduit::float32_array y_a = n_coords["values/y"].value();
-    vert[0] = (x_a[logical_index[0]] + x_a[logical_index[0] + 1]) * 0.5;
-    vert[1] = (y_a[logical_index[1]] + y_a[logical_index[1] + 1]) * 0.5;
-    if(dims[2] != 0)
+    for(int i = 0; i < m_num_dims; ++i)
     {
-      conduit::float32_array z_a = n_coords["values/z"].value();
-      vert[2] = (z_a[logical_index[2]] + z_a[logical_index[2] + 1]) * 0.5;
+      if(m_coords_type == CoordsType::Uniform)
+      {
+        const double end = m_origin[i] + (m_dims[i] - 1) * m_spacing[i];
+        min_coords[i] = std::min(min_coords[i], std::min(m_origin[i], end));
+        max_coords[i] = std::max(max_coords[i], std::max(m_origin[i], end));
+      }
+      else if(m_is_float64)
+      {
+        axis_bounds(m_coords64[i], min_coords[i], max_coords[i]);
+      }
+      else
+      {
+        axis_bounds(m_coords32[i], min_coords[i], max_coords[i]);
+      }
     }
   }
 
-  conduit::Node res;
-  res.set(vert, 3);
-  return res;
-}
-
-conduit::Node
-get_explicit_element(const conduit::Node &n_coords,
-                     const conduit::Node &n_topo,
-                     const int &index)
-{
-  std::vector<int> conn;
-  get_element_indices(n_topo, index, conn);
-  const int num_indices = conn.size();
-  double vert[3] = {0., 0., 0.};
-  for(int i = 0; i < num_indices; ++i)
+private:
+  double
+  coord(const int axis, const int index) const
   {
-    int vert_index = conn[i];
-    conduit::Node n_vert = get_explicit_vert(n_coords, vert_index);
-    double *ptr = n_vert.value();
-    vert[0] += ptr[0];
-    vert[1] += ptr[1];
-    vert[2] += ptr[2];
+    return m_is_float64 ? m_coords64[axis][index] : m_coords32[axis][index];
   }
 
-  vert[0] /= double(num_indices);
-  vert[1] /= double(num_indices);
-  vert[2] /= double(num_indices);
+  // vertex ids of an element, returns the number of vertices
+  int
+  element_indices(const int index, int *indices) const
+  {
+    if(m_topo_type == TopoType::Unstructured)
+    {
+      const int offset = index * m_shape_size;
+      for(int i = 0; i < m_shape_size; ++i)
+      {
+        indices[i] = m_conn[offset + i];
+      }
+      return m_shape_size;
+    }
+
+    // structured
+    const int *dims = m_topo_dims;
+    const int element_dims[3] = {dims[0] - 1, dims[1] - 1, dims[2] - 1};
+    int element_index[3] = {0, 0, 0};
+    if(m_topo_num_dims == 2)
+    {
+      logical_index_2d(element_index, index, element_dims);
 
-  conduit::Node res;
-  res.set(vert, 3);
-  return res;
-}
+      indices[0] = element_index[1] * dims[0] + element_index[0];
+      indices[1] = indices[0] + 1;
+      indices[2] = indices[1] + dims[0];
+      indices[3] = indices[2] - 1;
+      return 4;
+    }
+
+    logical_index_3d(element_index, index, element_dims);
+
+    indices[0] =
+        (element_index[2] * dims[1] + element_index[1]) * dims[0] +
+        element_index[0];
+    indices[1] = indices[0] + 1;
+    indices[2] = indices[1] + dims[0];
+    indices[3] = indices[2] - 1;
+    indices[4] = indices[0] + dims[0] * dims[1];
+    indices[5] = indices[4] + 1;
+    indices[6] = indices[5] + dims[0];
+    indices[7] = indices[6] - 1;
+    return 8;
+  }
+
+  // uniform and rectilinear topologies are both implicit grids
+  enum class TopoType { Grid, Structured, Unstructured, Points };
+  enum class CoordsType { Uniform, Rectilinear, Explicit };
+
+  TopoType m_topo_type;
+  CoordsType m_coords_type;
+  int m_num_dims = 0;
+  // vertex dims of uniform coordsets, number of values per axis otherwise
+  int m_dims[3] = {1, 1, 1};
+  // vertex dims of structured topologies
+  int m_topo_num_dims = 0;
+  int m_topo_dims[3] = {1, 1, 1};
+  conduit::float64 m_origin[3] = {0., 0., 0.};
+  conduit::float64 m_spacing[3] = {1., 1., 1.};
+  bool m_is_float64 = true;
+  conduit::float64_array m_coords64[3];
+  conduit::float32_array m_coords32[3];
+  conduit::int32_array m_conn;
+  int m_shape_size = 0;
+  int m_num_points = 0;
+  int m_num_cells = 0;
+};
 
 //-----------------------------------------------------------------------------
 }; // namespace detail
@@ -553,30 +585,11 @@ vert_location(const conduit::Node &domain,
     topo = itr.name();
   }
 
-  const conduit::Node &n_topo = domain["topologies"][topo];
-  const std::string mesh_type = n_topo["type"].as_string();
-  const std::string coords_name = n_topo["coordset"].as_string();
-
-  const conduit::Node &n_coords = domain["coordsets"][coords_name];
+  double vert[3];
+  detail::MeshView(domain, topo).vertex(index, vert);
 
   conduit::Node res;
-  if(mesh_type == "uniform")
-  {
-    res = detail::get_uniform_vert(n_coords, index);
-  }
-  else if(mesh_type == "rectilinear")
-  {
-    res = detail::get_rectilinear_vert(n_coords, index);
-  }
-  else if(mesh_type == "unstructured" || mesh_type == "structured")
-  {
-    res = detail::get_explicit_vert(n_coords, index);
-  }
-  else
-  {
-    ASCENT_ERROR("The Architect: unknown mesh type: '" << mesh_type << "'");
-  }
-
+  res.set(vert, 3);
   return res;
 }
 
@@ -594,30 +607,11 @@ element_location(const conduit::Node &domain,
     topo = itr.name();
   }
 
-  const conduit::Node &n_topo = domain["topologies"][topo];
-  const std::string mesh_type = n_topo["type"].as_string();
-  const std::string coords_name = n_topo["coordset"].as_string();
-
-  const conduit::Node &n_coords = domain["coordsets"][coords_name];
+  double vert[3];
+  detail::MeshView(domain, topo).element(index, vert);
 
   conduit::Node res;
-  if(mesh_type == "uniform")
-  {
-    res = detail::get_uniform_element(n_coords, index);
-  }
-  else if(mesh_type == "rectilinear")
-  {
-    res = detail::get_rectilinear_element(n_coords, index);
-  }
-  else if(mesh_type == "unstructured" || mesh_type == "structured")
-  {
-    res = detail::get_explicit_element(n_coords, n_topo, index);
-  }
-  else
-  {
-    ASCENT_ERROR("The Architect: unknown mesh type: '" << mesh_type << "'");
-  }
-
+  res.set(vert, 3);
   return res;
 }
 
@@ -788,117 +782,13 @@ is_xyz(const std::string &axis_name)
 int
 num_points(const conduit::Node &domain, const std::string &topo_name)
 {
-  int res = 0;
-
-  const conduit::Node &n_topo = domain["topologies/" + topo_name];
-
-  const std::string c_name = n_topo["coordset"].as_string();
-  const conduit::Node &n_coords = domain["coordsets/" + c_name];
-  const std::string c_type = n_coords["type"].as_string();
-
-  if(c_type == "uniform")
-  {
-    res = n_coords["dims/i"].to_int32();
-    if(n_coords.has_path("dims/j"))
-    {
-      res *= n_coords["dims/j"].to_int32();
-    }
-    if(n_coords.has_path("dims/k"))
-    {
-      res *= n_coords["dims/k"].to_int32();
-    }
-  }
-
-  if(c_type == "rectilinear")
-  {
-    res = n_coords["values/x"].dtype().number_of_elements();
-
-    if(n_coords.has_path("values/y"))
-    {
-      res *= n_coords["values/y"].dtype().number_of_elements();
-    }
-
-    if(n_coords.has_path("values/z"))
-    {
-      res *= n_coords["values/z"].dtype().number_of_elements();
-    }
-  }
-
-  if(c_type == "explicit")
-  {
-    res = n_coords["values/x"].dtype().number_of_elements();
-  }
-
-  return res;
+  return detail::MeshView(domain, topo_name).num_points();
 }
 
 int
 num_cells(const conduit::Node &domain, const std::string &topo_name)
 {
-  const conduit::Node &n_topo = domain["topologies/" + topo_name];
-  const std::string topo_type = n_topo["type"].as_string();
-
-  int res = -1;
-
-  if(topo_type == "unstructured")
-  {
-    const std::string shape = n_topo["elements/shape"].as_string();
-    const int conn_size =
-        n_topo["elements/connectivity"].dtype().number_of_elements();
-    const int per_cell = detail::get_num_indices(shape);
-    res = conn_size / per_cell;
-  }
-
-  if(topo_type == "points")
-  {
-    return num_points(domain, topo_name);
-  }
-
-  const std::string c_name = n_topo["coordset"].as_string();
-  const conduit::Node &n_coords = domain["coordsets/" + c_name];
-
-  if(topo_type == "uniform")
-  {
-    res = n_coords["dims/i"].to_int32() - 1;
-    if(n_coords.has_path("dims/j"))
-    {
-      res *= n_coords["dims/j"].to_int32() - 1;
-    }
-    if(n_coords.has_path("dims/k"))
-    {
-      res *= n_coords["dims/k"].to_int32() - 1;
-    }
-  }
-
-  if(topo_type == "rectilinear")
-  {
-    res = n_coords["values/x"].dtype().number_of_elements() - 1;
-
-    if(n_coords.has_path("values/y"))
-    {
-      res *= n_coords["values/y"].dtype().number_of_elements() - 1;
-    }
-
-    if(n_coords.has_path("values/z"))
-    {
-      res *= n_coords["values/z"].dtype().number_of_elements() - 1;
-    }
-  }
-
-  if(topo_type == "structured")
-  {
-    res = n_topo["elements/dims/i"].to_int32() - 1;
-    if(n_topo.has_path("elements/dims/j"))
-    {
-      res *= n_topo["elements/dims/j"].to_int32() - 1;
-    }
-    if(n_topo.has_path("elements/dims/k"))
-    {
-      res *= n_topo["elements/dims/k"].to_int32() - 1;
-    }
-  }
-
-  return res;
+  return detail::MeshView(domain, topo_name).num_cells();
 }
 
 conduit::Node
@@ -959,8 +849,6 @@ global_bounds(const conduit::Node &dataset, const std::string &topo_name)
   double max_coords[3] = {std::numeric_limits<double>::lowest(),
                           std::numeric_limits<double>::lowest(),
                           std::numeric_limits<double>::lowest()};
-  const std::string axes[3][3] = {
-      {"x", "i", "dx"}, {"y", "j", "dy"}, {"z", "k", "dz"}};
   for(int dom_index = 0; dom_index < dataset.number_of_children(); ++dom_index)
   {
     const conduit::Node &dom = dataset.child(dom_index);
@@ -968,42 +856,7 @@ global_bounds(const conduit::Node &dataset, const std::string &topo_name)
     {
       continue;
     }
-    const conduit::Node &n_topo = dom["topologies/" + topo_name];
-    const std::string topo_type = n_topo["type"].as_string();
-    const std::string coords_name = n_topo["coordset"].as_string();
-    const conduit::Node &n_coords = dom["coordsets/" + coords_name];
-
-    if(topo_type == "uniform")
-    {
-      int num_dims = n_coords["dims"].number_of_children();
-      for(int i = 0; i < num_dims; ++i)
-      {
-        double origin = n_coords["origin/" + axes[i][0]].to_float64();
-        int dim = n_coords["dims/" + axes[i][1]].to_int();
-        double spacing = n_coords["spacing/" + axes[i][2]].to_float64();
-
-        min_coords[i] = std::min(min_coords[i], origin);
-        max_coords[i] = std::max(min_coords[i], origin + (dim - 1) * spacing);
-      }
-    }
-    else if(topo_type == "rectilinear" || topo_type == "structured" ||
-            topo_type == "unstructured")
-    {
-      int num_dims = n_coords["values"].number_of_children();
-      for(int i = 0; i < num_dims; ++i)
-      {
-        const std::string axis_path = "values/" + axes[i][0];
-        min_coords[i] = std::min(
-            min_coords[i], array_min(n_coords[axis_path])["value"].as_double());
-        max_coords[i] = std::max(
-            max_coords[i], array_max(n_coords[axis_path])["value"].as_double());
-      }
-    }
-    else
-    {
-      ASCENT_ERROR("The Architect: unknown topology type: '" << topo_type
-                                                             << "'");
-    }
+    detail::MeshView(dom, topo_name).bounds(min_coords, max_coords);
   }
 #ifdef ASCENT_MPI_ENABLED
   MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
@@ -1316,19 +1169,19 @@ populate_homes(const conduit::Node &dom,
     else if(is_xyz(axis_name))
     {
       int coord = axis_name[0] - 'x';
+      std::vector<double> locs(homes_size);
+      detail::MeshView mesh(dom, topo_name);
+      if(assoc_str == "vertex")
+      {
+        mesh.vertex_coords(coord, locs.data());
+      }
+      else if(assoc_str == "element")
+      {
+        mesh.element_coords(coord, locs.data());
+      }
       for(int i = 0; i < homes_size; ++i)
       {
-        conduit::Node n_loc;
-        if(assoc_str == "vertex")
-        {
-          n_loc = vert_location(dom, i, topo_name);
-        }
-        else if(assoc_str == "element")
-        {
-          n_loc = element_location(dom, i, topo_name);
-        }
-        const double *loc = n_loc.value();
-        const int bin_index = get_bin_index(loc[coord], axis);
+        const int bin_index = get_bin_index(locs[i], axis);
         // don't set anything if we haven't found a bin yet
         if(homes[i] != -1)
         {
@@ -1588,24 +1441,24 @@ binning(const conduit::Node &dataset,
     else if(is_xyz(reduction_var))
     {
       int coord = reduction_var[0] - 'x';
+      std::vector<double> locs(homes_size);
+      detail::MeshView mesh(dom, topo_name);
+      if(assoc_str == "vertex")
+      {
+        mesh.vertex_coords(coord, locs.data());
+      }
+      else if(assoc_str == "element")
+      {
+        mesh.element_coords(coord, locs.data());
+      }
 //#ifdef ASCENT_USE_OPENMP
 //#pragma omp parallel for
 //#endif
       for(int i = 0; i < homes_size; ++i)
       {
-        conduit::Node n_loc;
-        if(assoc_str == "vertex")
-        {
-          n_loc = vert_location(dom, i, topo_name);
-        }
-        else if(assoc_str == "element")
-        {
-          n_loc = element_location(dom, i, topo_name);
-        }
-        const double *loc = n_loc.value();
         if(homes[i] != -1)
         {
-          update_bin(bins, homes[i], loc[coord], reduction_op);
+          update_bin(bins, homes[i], locs[i], reduction_op);
         }
       }
     }
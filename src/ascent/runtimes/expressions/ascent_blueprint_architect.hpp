@@ -74,13 +74,13 @@ namespace runtime
 namespace expressions
 {
 
-conduit::Node vert_location(const conduit::Node &domain,
-                            const int &index,
-                            const std::string &topo_name = "");
+conduit::Node ASCENT_API vert_location(const conduit::Node &domain,
+                                       const int &index,
+                                       const std::string &topo_name = "");
 
-conduit::Node element_location(const conduit::Node &domain,
-                               const int &index,
-                               const std::string &topo_name = "");
+conduit::Node ASCENT_API element_location(const conduit::Node &domain,
+                                          const int &index,
+                                          const std::string &topo_name = "");
 
 conduit::Node field_max(const conduit::Node &dataset,
                         const std::string &field_name);
@@ -111,8 +111,8 @@ conduit::Node field_entropy(const conduit::Node &hist);
 conduit::Node field_pdf(const conduit::Node &hist);
 conduit::Node field_cdf(const conduit::Node &hist);
 
-conduit::Node global_bounds(const conduit::Node &dataset,
-                            const std::string &topo_name);
+conduit::Node ASCENT_API global_bounds(const conduit::Node &dataset,
+                                       const std::string &topo_name);
 
 conduit::Node binning(const conduit::Node &dataset,
                       conduit::Node &bin_axes,
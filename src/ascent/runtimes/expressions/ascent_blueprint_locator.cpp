@@ -0,0 +1,1295 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_blueprint_locator.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "ascent_blueprint_locator.hpp"
+#include "ascent_blueprint_architect.hpp"
+
+#include <ascent_mpi_utils.hpp>
+#include <ascent_logging.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
+
+#include <flow_workspace.hpp>
+
+#ifdef ASCENT_MPI_ENABLED
+#include <mpi.h>
+#endif
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+namespace expressions
+{
+
+namespace detail
+{
+
+// parametric tolerance of the point in cell tests
+const double locator_eps = 1e-6;
+
+// vertex offsets of lines, quads and hexs in blueprint order
+const int tensor_offsets[8][3] = {{0, 0, 0},
+                                  {1, 0, 0},
+                                  {1, 1, 0},
+                                  {0, 1, 0},
+                                  {0, 0, 1},
+                                  {1, 0, 1},
+                                  {1, 1, 1},
+                                  {0, 1, 1}};
+
+void
+copy_coords(const conduit::Node &values, std::vector<double> &out)
+{
+  conduit::Node res;
+  values.to_float64_array(res);
+  const conduit::float64 *ptr = res.as_float64_ptr();
+  out.assign(ptr, ptr + res.dtype().number_of_elements());
+}
+
+bool
+is_value_type(const conduit::DataType &dtype)
+{
+  return dtype.is_float64() || dtype.is_float32() || dtype.is_int32() ||
+         dtype.is_int64() || dtype.is_uint32() || dtype.is_uint64();
+}
+
+// the caller checks is_value_type()
+double
+value_at(const conduit::Node &values, const int index)
+{
+  const void *ptr = values.element_ptr(index);
+  switch(values.dtype().id())
+  {
+  case conduit::DataType::FLOAT64_ID:
+    return *static_cast<const conduit::float64 *>(ptr);
+  case conduit::DataType::FLOAT32_ID:
+    return *static_cast<const conduit::float32 *>(ptr);
+  case conduit::DataType::INT32_ID:
+    return *static_cast<const conduit::int32 *>(ptr);
+  case conduit::DataType::INT64_ID:
+    return *static_cast<const conduit::int64 *>(ptr);
+  case conduit::DataType::UINT32_ID:
+    return *static_cast<const conduit::uint32 *>(ptr);
+  case conduit::DataType::UINT64_ID:
+    return *static_cast<const conduit::uint64 *>(ptr);
+  default:
+    return 0.;
+  }
+}
+
+// weights (and optionally their parametric derivatives) of the vertices of
+// a line, quad or hex at parametric coordinates 'r'
+void
+tensor_weights(const int num_dims,
+               const double *r,
+               double *weights,
+               double (*derivs)[3] = nullptr)
+{
+  const int num_verts = 1 << num_dims;
+  for(int v = 0; v < num_verts; ++v)
+  {
+    double w = 1.;
+    for(int d = 0; d < num_dims; ++d)
+    {
+      w *= tensor_offsets[v][d] == 1 ? r[d] : 1. - r[d];
+    }
+    weights[v] = w;
+
+    if(derivs == nullptr)
+    {
+      continue;
+    }
+    for(int d = 0; d < num_dims; ++d)
+    {
+      double dw = tensor_offsets[v][d] == 1 ? 1. : -1.;
+      for(int e = 0; e < num_dims; ++e)
+      {
+        if(e != d)
+        {
+          dw *= tensor_offsets[v][e] == 1 ? r[e] : 1. - r[e];
+        }
+      }
+      derivs[v][d] = dw;
+    }
+  }
+}
+
+double
+det3(const double a[3][3])
+{
+  return a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+         a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+         a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+}
+
+// solves a x = b for n <= 3
+bool
+solve(const int n, const double a[3][3], const double *b, double *x)
+{
+  if(n == 1)
+  {
+    if(a[0][0] == 0.)
+    {
+      return false;
+    }
+    x[0] = b[0] / a[0][0];
+    return true;
+  }
+
+  if(n == 2)
+  {
+    const double det = a[0][0] * a[1][1] - a[0][1] * a[1][0];
+    if(det == 0.)
+    {
+      return false;
+    }
+    x[0] = (b[0] * a[1][1] - a[0][1] * b[1]) / det;
+    x[1] = (a[0][0] * b[1] - b[0] * a[1][0]) / det;
+    return true;
+  }
+
+  const double det = det3(a);
+  if(det == 0.)
+  {
+    return false;
+  }
+  // cramer's rule
+  for(int c = 0; c < 3; ++c)
+  {
+    double m[3][3];
+    for(int i = 0; i < 3; ++i)
+    {
+      for(int j = 0; j < 3; ++j)
+      {
+        m[i][j] = j == c ? b[i] : a[i][j];
+      }
+    }
+    x[c] = det3(m) / det;
+  }
+  return true;
+}
+
+// finds the parametric coordinates of a point in a line, quad or hex with
+// newton's method, returns false if the point is outside
+bool
+invert_tensor(const int num_dims,
+              const double (*coords)[3],
+              const double *point,
+              double *r)
+{
+  const int num_verts = 1 << num_dims;
+  r[0] = r[1] = r[2] = 0.5;
+  for(int iter = 0; iter < 20; ++iter)
+  {
+    double weights[8];
+    double derivs[8][3];
+    tensor_weights(num_dims, r, weights, derivs);
+
+    double residual[3] = {0., 0., 0.};
+    double jac[3][3] = {{0., 0., 0.}, {0., 0., 0.}, {0., 0., 0.}};
+    for(int v = 0; v < num_verts; ++v)
+    {
+      for(int i = 0; i < num_dims; ++i)
+      {
+        residual[i] += weights[v] * coords[v][i];
+        for(int d = 0; d < num_dims; ++d)
+        {
+          jac[i][d] += derivs[v][d] * coords[v][i];
+        }
+      }
+    }
+    for(int i = 0; i < num_dims; ++i)
+    {
+      residual[i] = point[i] - residual[i];
+    }
+
+    double dr[3];
+    if(!solve(num_dims, jac, residual, dr))
+    {
+      return false;
+    }
+    double change = 0.;
+    for(int d = 0; d < num_dims; ++d)
+    {
+      r[d] += dr[d];
+      change = std::max(change, std::abs(dr[d]));
+    }
+    if(change < 1e-10)
+    {
+      break;
+    }
+  }
+
+  for(int d = 0; d < num_dims; ++d)
+  {
+    if(!(r[d] >= -locator_eps && r[d] <= 1. + locator_eps))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// barycentric weights of a point in a tri or tet, returns false if the
+// point is outside
+bool
+invert_simplex(const int num_dims,
+               const double (*coords)[3],
+               const double *point,
+               double *weights)
+{
+  double a[3][3];
+  double b[3];
+  for(int i = 0; i < num_dims; ++i)
+  {
+    for(int d = 0; d < num_dims; ++d)
+    {
+      a[i][d] = coords[d + 1][i] - coords[0][i];
+    }
+    b[i] = point[i] - coords[0][i];
+  }
+
+  double lambda[3];
+  if(!solve(num_dims, a, b, lambda))
+  {
+    return false;
+  }
+
+  double sum = 0.;
+  for(int d = 0; d < num_dims; ++d)
+  {
+    if(lambda[d] < -locator_eps)
+    {
+      return false;
+    }
+    weights[d + 1] = lambda[d];
+    sum += lambda[d];
+  }
+  weights[0] = 1. - sum;
+  return weights[0] >= -locator_eps;
+}
+
+// 64 bit FNV-1a style hash of an array's values, mixed a word at a time
+conduit::uint64
+content_hash(const conduit::Node &node)
+{
+  const conduit::uint64 prime = 1099511628211ULL;
+  conduit::uint64 hash = 14695981039346656037ULL;
+  const conduit::DataType &dtype = node.dtype();
+  const conduit::index_t num_elements = dtype.number_of_elements();
+  const conduit::index_t ele_bytes = dtype.element_bytes();
+
+  auto mix = [&](const unsigned char *bytes, const conduit::index_t size)
+  {
+    conduit::index_t i = 0;
+    for(; i + 8 <= size; i += 8)
+    {
+      conduit::uint64 word;
+      std::memcpy(&word, bytes + i, 8);
+      hash = (hash ^ word) * prime;
+    }
+    for(; i < size; ++i)
+    {
+      hash = (hash ^ bytes[i]) * prime;
+    }
+  };
+
+  if(dtype.is_compact())
+  {
+    mix(static_cast<const unsigned char *>(node.data_ptr()),
+        num_elements * ele_bytes);
+  }
+  else
+  {
+    for(conduit::index_t i = 0; i < num_elements; ++i)
+    {
+      mix(static_cast<const unsigned char *>(node.element_ptr(i)), ele_bytes);
+    }
+  }
+  return hash;
+}
+
+// arrays are recorded by address, size and a hash of their values (a
+// freed array can be replaced by another one at the same address),
+// everything small enough is recorded by value
+void
+mesh_signature(const conduit::Node &node, conduit::Node &sig)
+{
+  const conduit::index_t num_children = node.number_of_children();
+  if(num_children == 0)
+  {
+    const conduit::DataType &dtype = node.dtype();
+    if(dtype.is_string() || dtype.number_of_elements() <= 16)
+    {
+      sig["value"] = node;
+    }
+    else
+    {
+      sig["type"] = (conduit::int64)dtype.id();
+      sig["ptr"] = (conduit::uint64)node.data_ptr();
+      sig["bytes"] = (conduit::int64)dtype.spanned_bytes();
+      sig["hash"] = content_hash(node);
+    }
+    return;
+  }
+
+  conduit::NodeConstIterator itr = node.children();
+  while(itr.has_next())
+  {
+    const conduit::Node &child = itr.next();
+    const std::string name = node.dtype().is_object()
+                                 ? itr.name()
+                                 : std::to_string(itr.index());
+    mesh_signature(child, sig[name]);
+  }
+}
+
+struct LocatorEntry
+{
+  conduit::Node m_sig;
+  std::shared_ptr<const CellLocator> m_locator;
+  bool m_used;
+};
+
+// locators are shared by every expression evaluator
+struct LocatorCache
+{
+  std::mutex m_mutex;
+  std::map<std::string, LocatorEntry> m_entries;
+  conduit::int64 m_cycle = -1;
+  int m_builds = 0;
+};
+
+LocatorCache &
+locator_cache()
+{
+  static LocatorCache cache;
+  return cache;
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::expressions::detail--
+//-----------------------------------------------------------------------------
+
+CellLocator::CellLocator(const conduit::Node &domain,
+                         const std::string &topo_name)
+{
+  if(!domain.has_path("topologies/" + topo_name))
+  {
+    ASCENT_ERROR("CellLocator: topology '" << topo_name
+                 << "' not found in domain");
+  }
+
+  const conduit::Node &n_topo = domain["topologies/" + topo_name];
+  m_topo_type = n_topo["type"].as_string();
+  const std::string coords_name = n_topo["coordset"].as_string();
+  const conduit::Node &n_coords = domain["coordsets/" + coords_name];
+  m_coords_type = n_coords["type"].as_string();
+
+  const std::string logical[3] = {"i", "j", "k"};
+  const std::string spacing[3] = {"dx", "dy", "dz"};
+  const std::string axes[3] = {"x", "y", "z"};
+
+  if(m_coords_type == "uniform")
+  {
+    const conduit::Node &n_dims = n_coords["dims"];
+    m_num_dims = n_dims.number_of_children();
+    for(int i = 0; i < m_num_dims && i < 3; ++i)
+    {
+      m_dims[i] = n_dims[logical[i]].to_int();
+      if(n_coords.has_path("origin/" + axes[i]))
+      {
+        m_origin[i] = n_coords["origin/" + axes[i]].to_float64();
+      }
+      if(n_coords.has_path("spacing/" + spacing[i]))
+      {
+        m_spacing[i] = n_coords["spacing/" + spacing[i]].to_float64();
+      }
+    }
+  }
+  else if(m_coords_type == "rectilinear" || m_coords_type == "explicit")
+  {
+    const conduit::Node &n_values = n_coords["values"];
+    m_num_dims = n_values.number_of_children();
+    for(int i = 0; i < m_num_dims && i < 3; ++i)
+    {
+      detail::copy_coords(n_values.child(i), m_coords[i]);
+      m_dims[i] = m_coords[i].size();
+    }
+  }
+  else
+  {
+    ASCENT_ERROR("CellLocator: unknown coordset type: '"
+                 << m_coords_type << "'");
+  }
+
+  if(m_num_dims < 1 || m_num_dims > 3)
+  {
+    ASCENT_ERROR("CellLocator: topology '" << topo_name << "' with "
+                 << m_num_dims << " dimensions is not supported.");
+  }
+
+  m_num_points = m_dims[0];
+  if(m_coords_type != "explicit")
+  {
+    for(int i = 1; i < m_num_dims; ++i)
+    {
+      m_num_points *= m_dims[i];
+    }
+  }
+
+  const std::string implicit_shapes[3] = {"line", "quad", "hex"};
+  if(m_topo_type == "uniform" || m_topo_type == "rectilinear")
+  {
+    m_shape = implicit_shapes[m_num_dims - 1];
+    m_shape_size = 1 << m_num_dims;
+    m_num_cells = 1;
+    for(int i = 0; i < m_num_dims; ++i)
+    {
+      m_num_cells *= std::max(m_dims[i] - 1, 0);
+    }
+  }
+  else if(m_topo_type == "structured")
+  {
+    const conduit::Node &n_dims = n_topo["elements/dims"];
+    if(n_dims.number_of_children() != m_num_dims)
+    {
+      ASCENT_ERROR("CellLocator: structured topology '" << topo_name
+                   << "' does not match the dimensions of its coordset");
+    }
+    m_shape = implicit_shapes[m_num_dims - 1];
+    m_shape_size = 1 << m_num_dims;
+    m_num_cells = 1;
+    for(int i = 0; i < m_num_dims; ++i)
+    {
+      const int cells = n_dims[logical[i]].to_int();
+      m_num_cells *= cells;
+      m_dims[i] = cells + 1;
+    }
+  }
+  else if(m_topo_type == "unstructured")
+  {
+    const conduit::Node &n_eles = n_topo["elements"];
+    if(!n_eles.has_child("shape"))
+    {
+      ASCENT_ERROR("CellLocator: only single shape unstructured topologies"
+                   << " are supported");
+    }
+    m_shape = n_eles["shape"].as_string();
+    int shape_dims = 0;
+    if(m_shape == "line")
+    {
+      shape_dims = 1;
+    }
+    else if(m_shape == "tri" || m_shape == "quad")
+    {
+      shape_dims = 2;
+    }
+    else if(m_shape == "tet" || m_shape == "hex")
+    {
+      shape_dims = 3;
+    }
+    else
+    {
+      ASCENT_ERROR("CellLocator: unsupported shape '" << m_shape << "'");
+    }
+    if(shape_dims != m_num_dims)
+    {
+      ASCENT_ERROR("CellLocator: " << m_shape << " cells in "
+                   << m_num_dims << "D coordinates are not supported");
+    }
+    m_shape_size = (m_shape == "tri" || m_shape == "tet")
+                       ? shape_dims + 1
+                       : 1 << shape_dims;
+
+    conduit::Node conn;
+    n_eles["connectivity"].to_int32_array(conn);
+    const conduit::int32 *conn_ptr = conn.as_int32_ptr();
+    m_conn.assign(conn_ptr, conn_ptr + conn.dtype().number_of_elements());
+    m_num_cells = m_conn.size() / m_shape_size;
+  }
+  else
+  {
+    ASCENT_ERROR("CellLocator: cannot locate cells of topology type '"
+                 << m_topo_type << "'");
+  }
+
+  const double inf = std::numeric_limits<double>::infinity();
+  for(int i = 0; i < m_num_dims; ++i)
+  {
+    m_min[i] = inf;
+    m_max[i] = -inf;
+  }
+  if(m_coords_type == "uniform")
+  {
+    for(int i = 0; i < m_num_dims; ++i)
+    {
+      const double end = m_origin[i] + (m_dims[i] - 1) * m_spacing[i];
+      m_min[i] = std::min(m_origin[i], end);
+      m_max[i] = std::max(m_origin[i], end);
+    }
+  }
+  else
+  {
+    for(int i = 0; i < m_num_dims; ++i)
+    {
+      for(const double coord : m_coords[i])
+      {
+        m_min[i] = std::min(m_min[i], coord);
+        m_max[i] = std::max(m_max[i], coord);
+      }
+    }
+  }
+
+  if(m_topo_type == "structured" || m_topo_type == "unstructured")
+  {
+    build_bins();
+  }
+}
+
+int
+CellLocator::num_cells() const
+{
+  return m_num_cells;
+}
+
+int
+CellLocator::num_points() const
+{
+  return m_num_points;
+}
+
+void
+CellLocator::vertex(const int index, double *loc) const
+{
+  loc[0] = 0.;
+  loc[1] = 0.;
+  loc[2] = 0.;
+  if(m_coords_type == "explicit")
+  {
+    for(int i = 0; i < m_num_dims; ++i)
+    {
+      loc[i] = m_coords[i][index];
+    }
+    return;
+  }
+
+  const int idx[3] = {index % m_dims[0],
+                      (index / m_dims[0]) % m_dims[1],
+                      index / (m_dims[0] * m_dims[1])};
+  for(int i = 0; i < m_num_dims; ++i)
+  {
+    if(m_coords_type == "uniform")
+    {
+      loc[i] = m_origin[i] + idx[i] * m_spacing[i];
+    }
+    else
+    {
+      loc[i] = m_coords[i][idx[i]];
+    }
+  }
+}
+
+int
+CellLocator::cell_vertices(const int cell, int *verts) const
+{
+  if(m_topo_type == "unstructured")
+  {
+    const int offset = cell * m_shape_size;
+    for(int i = 0; i < m_shape_size; ++i)
+    {
+      verts[i] = m_conn[offset + i];
+    }
+    return m_shape_size;
+  }
+
+  const int cell_dims[2] = {m_dims[0] - 1, std::max(m_dims[1] - 1, 1)};
+  const int idx[3] = {cell % cell_dims[0],
+                      (cell / cell_dims[0]) % cell_dims[1],
+                      cell / (cell_dims[0] * cell_dims[1])};
+  for(int v = 0; v < m_shape_size; ++v)
+  {
+    const int *offset = detail::tensor_offsets[v];
+    verts[v] = ((idx[2] + offset[2]) * m_dims[1] + idx[1] + offset[1]) *
+                   m_dims[0] +
+               idx[0] + offset[0];
+  }
+  return m_shape_size;
+}
+
+bool
+CellLocator::in_cell(const int cell,
+                     const double *point,
+                     int &num_verts,
+                     int *verts,
+                     double *weights) const
+{
+  num_verts = cell_vertices(cell, verts);
+
+  double coords[max_cell_vertices][3];
+  for(int v = 0; v < num_verts; ++v)
+  {
+    vertex(verts[v], coords[v]);
+  }
+
+  // reject points outside the cell's bounds before the exact test
+  for(int i = 0; i < m_num_dims; ++i)
+  {
+    double lo = coords[0][i];
+    double hi = coords[0][i];
+    for(int v = 1; v < num_verts; ++v)
+    {
+      lo = std::min(lo, coords[v][i]);
+      hi = std::max(hi, coords[v][i]);
+    }
+    const double tol = (hi - lo) * detail::locator_eps;
+    if(point[i] < lo - tol || point[i] > hi + tol)
+    {
+      return false;
+    }
+  }
+
+  if(m_shape == "tri" || m_shape == "tet")
+  {
+    return detail::invert_simplex(m_num_dims, coords, point, weights);
+  }
+
+  double r[3];
+  if(!detail::invert_tensor(m_num_dims, coords, point, r))
+  {
+    return false;
+  }
+  detail::tensor_weights(m_num_dims, r, weights);
+  return true;
+}
+
+int
+CellLocator::find_logical_cell(const double *point,
+                               int &num_verts,
+                               int *verts,
+                               double *weights) const
+{
+  int idx[3] = {0, 0, 0};
+  double r[3] = {0., 0., 0.};
+  for(int d = 0; d < m_num_dims; ++d)
+  {
+    const int cells = m_dims[d] - 1;
+    if(cells < 1)
+    {
+      return -1;
+    }
+
+    double t;
+    if(m_coords_type == "uniform")
+    {
+      t = (point[d] - m_origin[d]) / m_spacing[d];
+    }
+    else
+    {
+      const std::vector<double> &axis = m_coords[d];
+      int i = int(std::upper_bound(axis.begin(), axis.end(), point[d]) -
+                  axis.begin()) - 1;
+      i = std::max(0, std::min(i, cells - 1));
+      t = i + (point[d] - axis[i]) / (axis[i + 1] - axis[i]);
+    }
+
+    if(!(t >= -detail::locator_eps && t <= cells + detail::locator_eps))
+    {
+      return -1;
+    }
+    const int i = std::max(0, std::min(int(std::floor(t)), cells - 1));
+    idx[d] = i;
+    r[d] = std::min(std::max(t - i, 0.), 1.);
+  }
+
+  const int cell = (idx[2] * std::max(m_dims[1] - 1, 1) + idx[1]) *
+                       (m_dims[0] - 1) +
+                   idx[0];
+  num_verts = cell_vertices(cell, verts);
+  detail::tensor_weights(m_num_dims, r, weights);
+  return cell;
+}
+
+int
+CellLocator::bin_index(const int axis, const double coord) const
+{
+  if(m_bin_dims[axis] == 1)
+  {
+    return 0;
+  }
+  const double t = (coord - m_min[axis]) / (m_max[axis] - m_min[axis]);
+  const int bin = int(t * m_bin_dims[axis]);
+  return std::max(0, std::min(bin, m_bin_dims[axis] - 1));
+}
+
+void
+CellLocator::build_bins()
+{
+  // aim for about one cell per bin
+  double extents[3] = {0., 0., 0.};
+  double volume = 1.;
+  int active_dims = 0;
+  for(int d = 0; d < m_num_dims; ++d)
+  {
+    extents[d] = m_max[d] - m_min[d];
+    if(extents[d] > 0.)
+    {
+      volume *= extents[d];
+      active_dims++;
+    }
+  }
+  const double bin_size =
+      active_dims > 0
+          ? std::pow(volume / std::max(m_num_cells, 1), 1. / active_dims)
+          : 1.;
+
+  int num_bins = 1;
+  for(int d = 0; d < 3; ++d)
+  {
+    m_bin_dims[d] = 1;
+    if(d < m_num_dims && extents[d] > 0.)
+    {
+      const int bins = int(std::ceil(extents[d] / bin_size));
+      m_bin_dims[d] = std::max(1, std::min(bins, 1024));
+    }
+    num_bins *= m_bin_dims[d];
+  }
+
+  // count the cells overlapping each bin, then fill them in
+  m_bin_offsets.assign(num_bins + 1, 0);
+  std::vector<int> cursor;
+  for(int pass = 0; pass < 2; ++pass)
+  {
+    for(int cell = 0; cell < m_num_cells; ++cell)
+    {
+      int verts[max_cell_vertices];
+      const int num_verts = cell_vertices(cell, verts);
+      int lo_bin[3] = {0, 0, 0};
+      int hi_bin[3] = {0, 0, 0};
+      double loc[3];
+      vertex(verts[0], loc);
+      double lo[3] = {loc[0], loc[1], loc[2]};
+      double hi[3] = {loc[0], loc[1], loc[2]};
+      for(int v = 1; v < num_verts; ++v)
+      {
+        vertex(verts[v], loc);
+        for(int d = 0; d < m_num_dims; ++d)
+        {
+          lo[d] = std::min(lo[d], loc[d]);
+          hi[d] = std::max(hi[d], loc[d]);
+        }
+      }
+      for(int d = 0; d < m_num_dims; ++d)
+      {
+        lo_bin[d] = bin_index(d, lo[d]);
+        hi_bin[d] = bin_index(d, hi[d]);
+      }
+
+      for(int k = lo_bin[2]; k <= hi_bin[2]; ++k)
+      {
+        for(int j = lo_bin[1]; j <= hi_bin[1]; ++j)
+        {
+          for(int i = lo_bin[0]; i <= hi_bin[0]; ++i)
+          {
+            const int bin = (k * m_bin_dims[1] + j) * m_bin_dims[0] + i;
+            if(pass == 0)
+            {
+              m_bin_offsets[bin + 1]++;
+            }
+            else
+            {
+              m_bin_cells[cursor[bin]++] = cell;
+            }
+          }
+        }
+      }
+    }
+
+    if(pass == 0)
+    {
+      for(int b = 0; b < num_bins; ++b)
+      {
+        m_bin_offsets[b + 1] += m_bin_offsets[b];
+      }
+      m_bin_cells.resize(m_bin_offsets[num_bins]);
+      cursor.assign(m_bin_offsets.begin(), m_bin_offsets.end() - 1);
+    }
+  }
+}
+
+int
+CellLocator::find_cell(const double *point,
+                       int &num_verts,
+                       int *verts,
+                       double *weights) const
+{
+  num_verts = 0;
+  for(int d = 0; d < m_num_dims; ++d)
+  {
+    const double tol = (m_max[d] - m_min[d]) * detail::locator_eps;
+    if(!(point[d] >= m_min[d] - tol && point[d] <= m_max[d] + tol))
+    {
+      return -1;
+    }
+  }
+
+  if(m_topo_type == "uniform" || m_topo_type == "rectilinear")
+  {
+    return find_logical_cell(point, num_verts, verts, weights);
+  }
+
+  int bin_idx[3] = {0, 0, 0};
+  for(int d = 0; d < m_num_dims; ++d)
+  {
+    bin_idx[d] = bin_index(d, point[d]);
+  }
+  const int bin =
+      (bin_idx[2] * m_bin_dims[1] + bin_idx[1]) * m_bin_dims[0] + bin_idx[0];
+  for(int c = m_bin_offsets[bin]; c < m_bin_offsets[bin + 1]; ++c)
+  {
+    const int cell = m_bin_cells[c];
+    if(in_cell(cell, point, num_verts, verts, weights))
+    {
+      return cell;
+    }
+  }
+  num_verts = 0;
+  return -1;
+}
+
+std::shared_ptr<const CellLocator>
+CellLocator::find_or_build(const conduit::Node &domain,
+                           const std::string &topo_name)
+{
+  const std::string domain_key = domain.has_path("state/domain_id")
+                                     ? domain["state/domain_id"].to_string()
+                                     : domain.path();
+  const std::string key = domain_key + "/" + topo_name;
+
+  conduit::Node sig;
+  const conduit::int64 cycle = domain.has_path("state/cycle")
+                                   ? domain["state/cycle"].to_int64()
+                                   : 0;
+  sig["cycle"] = cycle;
+  if(domain.has_path("state/mesh_generation"))
+  {
+    sig["generation"] = domain["state/mesh_generation"].to_int64();
+  }
+  if(domain.has_path("topologies/" + topo_name))
+  {
+    const conduit::Node &n_topo = domain["topologies/" + topo_name];
+    detail::mesh_signature(n_topo, sig["topology"]);
+    const std::string coords_name = n_topo["coordset"].as_string();
+    detail::mesh_signature(domain["coordsets/" + coords_name],
+                           sig["coordset"]);
+  }
+
+  detail::LocatorCache &cache = detail::locator_cache();
+  {
+    std::lock_guard<std::mutex> lock(cache.m_mutex);
+
+    // a new cycle drops the locators nobody asked for during the last one
+    if(cycle != cache.m_cycle)
+    {
+      for(auto it = cache.m_entries.begin(); it != cache.m_entries.end();)
+      {
+        if(!it->second.m_used)
+        {
+          it = cache.m_entries.erase(it);
+        }
+        else
+        {
+          it->second.m_used = false;
+          ++it;
+        }
+      }
+      cache.m_cycle = cycle;
+    }
+
+    auto it = cache.m_entries.find(key);
+    conduit::Node info;
+    if(it != cache.m_entries.end() && !it->second.m_sig.diff(sig, info, 0.0))
+    {
+      it->second.m_used = true;
+      return it->second.m_locator;
+    }
+  }
+
+  // build without the lock so other evaluators can use the cache
+  std::shared_ptr<const CellLocator> locator =
+      std::make_shared<CellLocator>(domain, topo_name);
+
+  std::lock_guard<std::mutex> lock(cache.m_mutex);
+  detail::LocatorEntry &entry = cache.m_entries[key];
+  conduit::Node info;
+  if(entry.m_locator != nullptr && !entry.m_sig.diff(sig, info, 0.0))
+  {
+    // another evaluator built the same locator first
+    entry.m_used = true;
+    return entry.m_locator;
+  }
+  entry.m_sig.set(sig);
+  entry.m_locator = locator;
+  entry.m_used = true;
+  cache.m_builds++;
+  return entry.m_locator;
+}
+
+void
+CellLocator::clear_cache()
+{
+  detail::LocatorCache &cache = detail::locator_cache();
+  std::lock_guard<std::mutex> lock(cache.m_mutex);
+  cache.m_entries.clear();
+  cache.m_cycle = -1;
+  cache.m_builds = 0;
+}
+
+int
+CellLocator::num_builds()
+{
+  detail::LocatorCache &cache = detail::locator_cache();
+  std::lock_guard<std::mutex> lock(cache.m_mutex);
+  return cache.m_builds;
+}
+
+conduit::Node
+probe_fields(const conduit::Node &dataset,
+             const std::vector<std::string> &fields,
+             const double *points,
+             const int num_points,
+             const double empty_val)
+{
+  const int num_fields = fields.size();
+  std::vector<std::string> names(num_fields);
+  std::vector<std::string> components(num_fields);
+  for(int f = 0; f < num_fields; ++f)
+  {
+    const size_t pos = fields[f].find('/');
+    names[f] = fields[f].substr(0, pos);
+    if(pos != std::string::npos)
+    {
+      components[f] = fields[f].substr(pos + 1);
+    }
+
+    if(!has_field(dataset, names[f]))
+    {
+      ASCENT_ERROR("Probe: unknown field '" << names[f] << "'");
+    }
+    if(!components[f].empty())
+    {
+      if(!has_component(dataset, names[f], components[f]))
+      {
+        ASCENT_ERROR("Probe: field '" << names[f]
+                     << "' does not have component '" << components[f]
+                     << "'. known components = "
+                     << possible_components(dataset, names[f]));
+      }
+    }
+    else if(num_components(dataset, names[f]) > 1)
+    {
+      ASCENT_ERROR("Probe: field '" << names[f]
+                   << "' has more than one component, select one with '"
+                   << names[f] << "/<component>'. known components = "
+                   << possible_components(dataset, names[f]));
+    }
+  }
+
+  std::vector<std::vector<double>> values(num_fields,
+                                          std::vector<double>(num_points, 0.));
+  std::vector<std::vector<char>> found(num_fields,
+                                       std::vector<char>(num_points, 0));
+
+  // locators and field checks are rank local, but every rank has to reach
+  // the reductions below. Agree on any error first, otherwise we deadlock
+  conduit::Node errors;
+  try
+  {
+    const int num_domains = dataset.number_of_children();
+    for(int dom_idx = 0; dom_idx < num_domains; ++dom_idx)
+    {
+      const conduit::Node &dom = dataset.child(dom_idx);
+
+      // each point is located once per topology
+      std::map<std::string, std::vector<int>> topo_fields;
+      for(int f = 0; f < num_fields; ++f)
+      {
+        if(dom.has_path("fields/" + names[f]))
+        {
+          const std::string topo =
+              dom["fields/" + names[f] + "/topology"].as_string();
+          topo_fields[topo].push_back(f);
+        }
+      }
+
+      for(const auto &topo_field : topo_fields)
+      {
+        std::shared_ptr<const CellLocator> locator =
+            CellLocator::find_or_build(dom, topo_field.first);
+        const std::vector<int> &field_ids = topo_field.second;
+        const int num_topo_fields = field_ids.size();
+
+        std::vector<const conduit::Node *> field_values(num_topo_fields);
+        std::vector<char> is_vertex(num_topo_fields);
+        for(int i = 0; i < num_topo_fields; ++i)
+        {
+          const int f = field_ids[i];
+          const conduit::Node &n_field = dom["fields/" + names[f]];
+          const std::string assoc = n_field["association"].as_string();
+          if(assoc != "vertex" && assoc != "element")
+          {
+            ASCENT_ERROR("Probe: field '" << names[f]
+                         << "' has unsupported association '" << assoc << "'");
+          }
+          is_vertex[i] = assoc == "vertex";
+
+          const conduit::Node &n_values = n_field["values"];
+          if(!components[f].empty())
+          {
+            field_values[i] = &n_values[components[f]];
+          }
+          else if(n_values.number_of_children() > 0)
+          {
+            field_values[i] = &n_values.child(0);
+          }
+          else
+          {
+            field_values[i] = &n_values;
+          }
+          if(!detail::is_value_type(field_values[i]->dtype()))
+          {
+            ASCENT_ERROR("Probe: field '" << fields[f]
+                         << "' has unsupported type '"
+                         << field_values[i]->dtype().name() << "'");
+          }
+        }
+
+#ifdef ASCENT_USE_OPENMP
+#pragma omp parallel for
+#endif
+        for(int p = 0; p < num_points; ++p)
+        {
+          // skip points an earlier domain already found
+          bool done = true;
+          for(int i = 0; i < num_topo_fields; ++i)
+          {
+            done = done && found[field_ids[i]][p];
+          }
+          if(done)
+          {
+            continue;
+          }
+
+          int num_verts;
+          int verts[CellLocator::max_cell_vertices];
+          double weights[CellLocator::max_cell_vertices];
+          const int cell =
+              locator->find_cell(points + 3 * p, num_verts, verts, weights);
+          if(cell == -1)
+          {
+            continue;
+          }
+
+          for(int i = 0; i < num_topo_fields; ++i)
+          {
+            const int f = field_ids[i];
+            if(found[f][p])
+            {
+              continue;
+            }
+            double val = 0.;
+            if(is_vertex[i])
+            {
+              for(int v = 0; v < num_verts; ++v)
+              {
+                val += weights[v] * detail::value_at(*field_values[i], verts[v]);
+              }
+            }
+            else
+            {
+              val = detail::value_at(*field_values[i], cell);
+            }
+            values[f][p] = val;
+            found[f][p] = 1;
+          }
+        }
+      }
+    }
+  }
+  catch(conduit::Error &e)
+  {
+    errors.append() = e.what();
+  }
+  catch(std::exception &e)
+  {
+    errors.append() = e.what();
+  }
+  catch(...)
+  {
+    errors.append() = "Unknown error occured in probe";
+  }
+
+  bool error = errors.number_of_children() > 0;
+  error = global_someone_agrees(error);
+  if(error)
+  {
+    std::set<std::string> error_strs;
+    for(int i = 0; i < errors.number_of_children(); ++i)
+    {
+      error_strs.insert(errors.child(i).as_string());
+    }
+    gather_strings(error_strs);
+    conduit::Node n_errors;
+    for(auto e : error_strs)
+    {
+      n_errors.append() = e;
+    }
+    ASCENT_ERROR("Probe errors: " << n_errors.to_string());
+  }
+
+  conduit::Node res;
+  res["found"].set(conduit::DataType::int32(num_points));
+  conduit::int32 *res_found = res["found"].value();
+  for(int p = 0; p < num_points; ++p)
+  {
+    res_found[p] = 1;
+  }
+
+#ifdef ASCENT_MPI_ENABLED
+  MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+  int rank;
+  MPI_Comm_rank(mpi_comm, &rank);
+#endif
+
+  for(int f = 0; f < num_fields; ++f)
+  {
+    std::vector<double> &field_vals = values[f];
+    std::vector<char> &field_found = found[f];
+#ifdef ASCENT_MPI_ENABLED
+    // the lowest rank that found a point owns its value
+    std::vector<int> owner(num_points);
+    std::vector<int> global_owner(num_points);
+    for(int p = 0; p < num_points; ++p)
+    {
+      owner[p] = field_found[p] ? rank : INT_MAX;
+    }
+    MPI_Allreduce(owner.data(),
+                  global_owner.data(),
+                  num_points,
+                  MPI_INT,
+                  MPI_MIN,
+                  mpi_comm);
+    for(int p = 0; p < num_points; ++p)
+    {
+      if(global_owner[p] != rank)
+      {
+        field_vals[p] = 0.;
+      }
+      field_found[p] = global_owner[p] != INT_MAX;
+    }
+    std::vector<double> global_vals(num_points);
+    MPI_Allreduce(field_vals.data(),
+                  global_vals.data(),
+                  num_points,
+                  MPI_DOUBLE,
+                  MPI_SUM,
+                  mpi_comm);
+    field_vals.swap(global_vals);
+#endif
+
+    conduit::Node &n_values = res["values/" + fields[f]];
+    n_values.set(conduit::DataType::float64(num_points));
+    conduit::float64 *res_values = n_values.value();
+    for(int p = 0; p < num_points; ++p)
+    {
+      res_values[p] = field_found[p] ? field_vals[p] : empty_val;
+      res_found[p] = res_found[p] && field_found[p];
+    }
+  }
+
+  return res;
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
@@ -0,0 +1,182 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_blueprint_locator.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef ASCENT_BLUEPRINT_LOCATOR
+#define ASCENT_BLUEPRINT_LOCATOR
+
+#include <conduit.hpp>
+#include <ascent_exports.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+namespace expressions
+{
+
+// Finds the cell of a topology in a single domain that contains a point.
+// Uniform and rectilinear topologies are indexed directly. Structured and
+// unstructured (tri, quad, tet, hex) topologies bin the bounds of their
+// cells into a uniform grid, so a query only tests the cells of one bin.
+class ASCENT_API CellLocator
+{
+public:
+  static const int max_cell_vertices = 8;
+
+  CellLocator(const conduit::Node &domain, const std::string &topo_name);
+
+  // Returns the id of the cell containing 'point', or -1. 'verts' and
+  // 'weights' receive the vertex ids of the cell and the weights that
+  // interpolate vertex values at the point.
+  int find_cell(const double *point,
+                int &num_verts,
+                int *verts,
+                double *weights) const;
+
+  int num_cells() const;
+  int num_points() const;
+
+  // Returns the locator of a domain's topology, building it the first time
+  // it is asked for. Locators are rebuilt when the domain's cycle,
+  // 'state/mesh_generation' or coordset and topology arrays (address, size
+  // or values) change, and dropped when a cycle passes without them being
+  // used. Locators are built outside the cache lock.
+  static std::shared_ptr<const CellLocator>
+  find_or_build(const conduit::Node &domain, const std::string &topo_name);
+
+  static void clear_cache();
+  // the number of locators built since the last clear_cache()
+  static int num_builds();
+
+private:
+  void vertex(const int index, double *loc) const;
+  int cell_vertices(const int cell, int *verts) const;
+  bool in_cell(const int cell,
+               const double *point,
+               int &num_verts,
+               int *verts,
+               double *weights) const;
+  int find_logical_cell(const double *point,
+                        int &num_verts,
+                        int *verts,
+                        double *weights) const;
+  void build_bins();
+  int bin_index(const int axis, const double coord) const;
+
+  std::string m_topo_type;
+  std::string m_coords_type;
+  std::string m_shape;
+  int m_num_dims = 0;
+  // vertex dims of implicit topologies
+  int m_dims[3] = {1, 1, 1};
+  double m_origin[3] = {0., 0., 0.};
+  double m_spacing[3] = {1., 1., 1.};
+  // rectilinear axes or explicit coordinates
+  std::vector<double> m_coords[3];
+  std::vector<int> m_conn;
+  int m_shape_size = 0;
+  int m_num_points = 0;
+  int m_num_cells = 0;
+  double m_min[3] = {0., 0., 0.};
+  double m_max[3] = {0., 0., 0.};
+  // cells overlapping each bin, in compressed row form
+  int m_bin_dims[3] = {1, 1, 1};
+  std::vector<int> m_bin_offsets;
+  std::vector<int> m_bin_cells;
+};
+
+// Samples fields of a multi-domain dataset at 'num_points' points (x, y, z
+// interleaved). A field name may select a component as 'field/component'.
+// Vertex fields are interpolated and element fields take the value of the
+// containing cell. Returns 'values/<field>' (float64, 'empty_val' outside the
+// mesh) and 'found' (int32, 1 if every field's topology contains the point).
+// Each point is located once per topology, across ranks when MPI is enabled.
+conduit::Node ASCENT_API probe_fields(const conduit::Node &dataset,
+                                      const std::vector<std::string> &fields,
+                                      const double *points,
+                                      const int num_points,
+                                      const double empty_val = 0.);
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
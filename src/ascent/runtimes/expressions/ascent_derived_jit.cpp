@@ -56,7 +56,7 @@
 #include "ascent_expressions_ast.hpp"
 #include <runtimes/flow_filters/ascent_runtime_utils.hpp>
 
-#include <ascent_data_logger.hpp>
+#include <ascent_tracer.hpp>
 #include <ascent_mpi_utils.hpp>
 #include <ascent_logging.hpp>
 
@@ -64,6 +64,7 @@
 #include <cstring>
 #include <functional>
 #include <limits>
+#include <mutex>
 
 #ifdef ASCENT_JIT_ENABLED
 #include <occa.hpp>
@@ -96,10 +97,21 @@ namespace expressions
 {
 
 int Jitable::m_cuda_device_id = -1;
+std::string Jitable::m_engine = "auto";
+int Jitable::m_compile_threshold = 3;
+std::string Jitable::m_precision = "auto";
+int Jitable::m_tile_size = 0;
+const int Jitable::max_gpu_tile_size;
 
 namespace detail
 {
 
+// how often each interpretable program ran, keyed by a hash of its bytecode
+// (see Jitable::use_interpreter). Forgotten once it tracks too many programs
+std::unordered_map<size_t, int> g_executions;
+std::mutex g_executions_mutex;
+const size_t max_tracked_programs = 1024;
+
 std::string
 type_string(const conduit::DataType &dtype)
 {
@@ -619,11 +631,18 @@ AlwaysExecutePolicy::get_name() const
 // I pass in args because I want execute to generate new args and also be
 // const so it can't just update the object's args
 std::string
-Jitable::generate_kernel(const int dom_idx, const conduit::Node &args) const
+Jitable::generate_kernel(const int dom_idx,
+                         const conduit::Node &args,
+                         const std::string &device_mode) const
 {
   const conduit::Node &cur_dom_info = dom_info.child(dom_idx);
   const Kernel &kernel = kernels.at(cur_dom_info["kernel_type"].as_string());
+  // specialize the kernel for its precision and the device
+  const std::string real_type = value_type(kernel);
   std::string kernel_string;
+  kernel_string += "#define JIT_REAL " + real_type + "\n";
+  kernel_string += "#define JIT_TILE " +
+                   std::to_string(tile_size(device_mode, real_type)) + "\n";
   kernel_string += kernel.functions.accumulate();
   kernel_string += "@kernel void map(";
   const int num_args = args.number_of_children();
@@ -779,7 +798,35 @@ Jitable::can_execute() const
 void
 Jitable::execute(conduit::Node &dataset, const std::string &field_name)
 {
-#ifdef ASCENT_JIT_ENABLED
+  // every rank computes (and stores) the field in the same precision,
+  // even if its own domains (or lack of them) would pick another
+  bool any_double = false;
+  bool any_float = false;
+  const int num_domains = dom_info.number_of_children();
+  for(int dom_idx = 0; dom_idx < num_domains; ++dom_idx)
+  {
+    const conduit::Node &cur_dom_info = dom_info.child(dom_idx);
+    if(!cur_dom_info.has_child("kernel_type"))
+    {
+      continue;
+    }
+    const auto kernel_it =
+        kernels.find(cur_dom_info["kernel_type"].as_string());
+    if(kernel_it != kernels.end())
+    {
+      any_double |= kernel_it->second.precision == "double";
+      any_float |= kernel_it->second.precision == "float";
+    }
+  }
+  any_double = global_someone_agrees(any_double);
+  any_float = global_someone_agrees(any_float);
+  const std::string precision =
+      any_double ? "double" : (any_float ? "float" : "");
+  for(auto &kernel : kernels)
+  {
+    kernel.second.precision = precision;
+  }
+
   // There are a lot of possible code paths that each rank/domain could
   // follow. All JIT code should not contain any MPI calls, but things
   // after JIT can call MPI, so its important that we globally catch errors
@@ -788,18 +835,6 @@ Jitable::execute(conduit::Node &dataset, const std::string &field_name)
   try
   {
     ASCENT_DATA_OPEN("jitable_execute");
-    // TODO set this during initialization not here
-    static bool init = false;
-    if(!init)
-    {
-      // running this in a loop segfaults...
-      init_occa();
-      init = true;
-    }
-    occa::device &device = occa::getDevice();
-    ASCENT_DATA_ADD("occa device", device.mode());
-    occa::kernel occa_kernel;
-
     // we need an association and topo so we can put the field back on the mesh
     if(topology.empty() || topology == "none")
     {
@@ -814,243 +849,469 @@ Jitable::execute(conduit::Node &dataset, const std::string &field_name)
                    "explicitely.");
     }
 
-    const int num_domains = dataset.number_of_children();
+    if(use_interpreter())
+    {
+      ASCENT_DATA_ADD("engine", "interpreter");
+      execute_interpreted(dataset, field_name);
+    }
+    else
+    {
+      ASCENT_DATA_ADD("engine", "occa");
+      execute_compiled(dataset, field_name);
+    }
+    ASCENT_DATA_CLOSE();
+  }
+  catch(conduit::Error &e)
+  {
+    errors.append() = e.what();
+  }
+  catch(std::exception &e)
+  {
+    errors.append() = e.what();
+  }
+  catch(...)
+  {
+    errors.append() = "Unknown error occured in JIT";
+  }
+
+  bool error = errors.number_of_children() > 0;
+  error = global_someone_agrees(error);
+  if(error)
+  {
+    std::set<std::string> error_strs;
+    for(int i = 0; i < errors.number_of_children(); ++i)
+    {
+      error_strs.insert(errors.child(i).as_string());
+    }
+    gather_strings(error_strs);
+    conduit::Node n_errors;
+    for(auto e : error_strs)
+    {
+      n_errors.append() = e;
+    }
+    ASCENT_ERROR("Jit errors: "<<n_errors.to_string());
+  }
+}
+
+bool
+Jitable::use_interpreter() const
+{
+  if(m_engine == "compile" || !can_interpret())
+  {
+    return false;
+  }
+#ifdef ASCENT_JIT_ENABLED
+  if(m_engine == "auto")
+  {
+    // count how often each program runs, compiling only pays off for
+    // expressions that are executed again and again
+    std::string key;
+    const int num_domains = dom_info.number_of_children();
     for(int dom_idx = 0; dom_idx < num_domains; ++dom_idx)
     {
-      ASCENT_DATA_OPEN("domain execute");
-      conduit::Node &dom = dataset.child(dom_idx);
+      const std::string &kernel_type =
+          dom_info.child(dom_idx)["kernel_type"].as_string();
+      key += kernel_type + "\n" + kernels.at(kernel_type).bytecode.to_string();
+    }
+    const size_t hash = std::hash<std::string>()(key);
+    std::lock_guard<std::mutex> lock(detail::g_executions_mutex);
+    if(detail::g_executions.size() >= detail::max_tracked_programs &&
+       detail::g_executions.find(hash) == detail::g_executions.end())
+    {
+      // programs start counting again, at worst they are interpreted
+      // a few more times before they are compiled
+      detail::g_executions.clear();
+    }
+    int &count = detail::g_executions[hash];
+    count++;
+    return count <= m_compile_threshold;
+  }
+#endif
+  // without OCCA the interpreter is the only option
+  return true;
+}
 
-      conduit::Node &cur_dom_info = dom_info.child(dom_idx);
+void
+Jitable::execute_interpreted(conduit::Node &dataset,
+                             const std::string &field_name)
+{
+  const int num_domains = dataset.number_of_children();
+  for(int dom_idx = 0; dom_idx < num_domains; ++dom_idx)
+  {
+    ASCENT_DATA_OPEN("domain execute");
+    conduit::Node &dom = dataset.child(dom_idx);
+    const conduit::Node &cur_dom_info = dom_info.child(dom_idx);
+    const Kernel &kernel = kernels.at(cur_dom_info["kernel_type"].as_string());
 
-      const Kernel &kernel = kernels.at(cur_dom_info["kernel_type"].as_string());
+    if(!cur_dom_info.has_child("entries"))
+    {
+      ASCENT_ERROR("Error while executing derived field: Could not determine "
+                   "the number of entries.");
+    }
+    const int entries = cur_dom_info["entries"].to_int64();
+
+    // same layout as the compiled output
+    conduit::Schema output_schema;
+    schemaFactory("interleaved",
+                  value_type(kernel) == "float"
+                      ? conduit::DataType::FLOAT32_ID
+                      : conduit::DataType::FLOAT64_ID,
+                  entries,
+                  kernel.num_components,
+                  output_schema);
+
+    conduit::Node &n_output = dom["fields/" + field_name];
+    n_output["association"] = association;
+    n_output["topology"] = topology;
+    n_output["values"].set(output_schema);
+
+    const conduit::Node empty_args;
+    const conduit::Node &args = cur_dom_info.has_child("args")
+                                    ? cur_dom_info["args"]
+                                    : empty_args;
+    flow::Timer interpret_timer;
+    kernel.bytecode.execute(args, entries, n_output["values"]);
+    ASCENT_DATA_ADD("interpreter runtime", interpret_timer.elapsed());
+    ASCENT_DATA_CLOSE();
+  }
+}
 
-      if(kernel.expr.empty())
+void
+Jitable::execute_compiled(conduit::Node &dataset,
+                          const std::string &field_name)
+{
+#ifdef ASCENT_JIT_ENABLED
+  // the occa device, the kernel cache, and the array registry are shared,
+  // so compiled expressions run one at a time
+  static std::mutex occa_mutex;
+  std::lock_guard<std::mutex> occa_lock(occa_mutex);
+  // TODO set this during initialization not here
+  static bool init = false;
+  if(!init)
+  {
+    // running this in a loop segfaults...
+    init_occa();
+    init = true;
+  }
+  occa::device &device = occa::getDevice();
+  ASCENT_DATA_ADD("occa device", device.mode());
+  occa::kernel occa_kernel;
+
+  const int num_domains = dataset.number_of_children();
+  for(int dom_idx = 0; dom_idx < num_domains; ++dom_idx)
+  {
+    ASCENT_DATA_OPEN("domain execute");
+    conduit::Node &dom = dataset.child(dom_idx);
+
+    conduit::Node &cur_dom_info = dom_info.child(dom_idx);
+
+    const Kernel &kernel = kernels.at(cur_dom_info["kernel_type"].as_string());
+
+    if(kernel.expr.empty())
+    {
+      ASCENT_ERROR("Cannot compile a kernel with an empty expr field. This "
+                   "shouldn't happen, call someone.");
+    }
+
+    // the final number of entries
+    const int entries = cur_dom_info["entries"].to_int64();
+
+    // pass entries into args just before we need to execute
+    cur_dom_info["args/entries"] = entries;
+
+    // create output array schema and put it in array_map
+    conduit::Schema output_schema;
+
+    // TODO output to the host is always interleaved
+    schemaFactory("interleaved",
+                  value_type(kernel) == "float"
+                      ? conduit::DataType::FLOAT32_ID
+                      : conduit::DataType::FLOAT64_ID,
+                  entries,
+                  kernel.num_components,
+                  output_schema);
+
+    arrays[dom_idx].array_map.insert(
+        std::make_pair("output", SchemaBool(output_schema, false)));
+
+    // allocate the output array in conduit
+    conduit::Node &n_output = dom["fields/" + field_name];
+    n_output["association"] = association;
+    n_output["topology"] = topology;
+
+    ASCENT_DATA_OPEN("host output alloc");
+    n_output["values"].set(output_schema);
+    unsigned char *output_ptr =
+        static_cast<unsigned char *>(n_output["values"].data_ptr());
+    // output to the host will always be compact
+    ASCENT_DATA_ADD("bytes", output_schema.total_bytes_compact());
+    ASCENT_DATA_CLOSE();
+
+    // these are reference counted
+    // need to keep the mem in scope or bad things happen
+    std::vector<Array<unsigned char>> array_buffers;
+    // slice is {index in array_buffers, offset, size}
+    std::vector<detail::slice_t> slices;
+    ASCENT_DATA_OPEN("host array alloc");
+    // allocate arrays
+    size_t output_index;
+    conduit::Node new_args;
+    for(const auto &array : arrays[dom_idx].array_map)
+    {
+      if(array.second.codegen_array)
       {
-        ASCENT_ERROR("Cannot compile a kernel with an empty expr field. This "
-                     "shouldn't happen, call someone.");
+        // codegen_arrays are false arrays used by the codegen
+        continue;
       }
-
-      // the final number of entries
-      const int entries = cur_dom_info["entries"].to_int64();
-
-      // pass entries into args just before we need to execute
-      cur_dom_info["args/entries"] = entries;
-
-      // create output array schema and put it in array_map
-      conduit::Schema output_schema;
-
-      // TODO output to the host is always interleaved
-      schemaFactory("interleaved",
-                    conduit::DataType::FLOAT64_ID,
-                    entries,
-                    kernel.num_components,
-                    output_schema);
-
-      arrays[dom_idx].array_map.insert(
-          std::make_pair("output", SchemaBool(output_schema, false)));
-
-      // allocate the output array in conduit
-      conduit::Node &n_output = dom["fields/" + field_name];
-      n_output["association"] = association;
-      n_output["topology"] = topology;
-
-      ASCENT_DATA_OPEN("host output alloc");
-      n_output["values"].set(output_schema);
-      unsigned char *output_ptr =
-          static_cast<unsigned char *>(n_output["values"].data_ptr());
-      // output to the host will always be compact
-      ASCENT_DATA_ADD("bytes", output_schema.total_bytes_compact());
-      ASCENT_DATA_CLOSE();
-
-      // these are reference counted
-      // need to keep the mem in scope or bad things happen
-      std::vector<Array<unsigned char>> array_buffers;
-      // slice is {index in array_buffers, offset, size}
-      std::vector<detail::slice_t> slices;
-      ASCENT_DATA_OPEN("host array alloc");
-      // allocate arrays
-      size_t output_index;
-      conduit::Node new_args;
-      for(const auto &array : arrays[dom_idx].array_map)
+      if(cur_dom_info["args"].has_path(array.first))
       {
-        if(array.second.codegen_array)
+        detail::device_alloc_array(cur_dom_info["args/" + array.first],
+                                   array.second.schema,
+                                   new_args,
+                                   array_buffers,
+                                   slices);
+      }
+      else
+      {
+        // not in args so doesn't point to any data, allocate a temporary
+        if(array.first == "output")
         {
-          // codegen_arrays are false arrays used by the codegen
-          continue;
+          output_index = array_buffers.size();
         }
-        if(cur_dom_info["args"].has_path(array.first))
+        if(array.first == "output" &&
+           (device.mode() == "Serial" || device.mode() == "OpenMP"))
         {
-          detail::device_alloc_array(cur_dom_info["args/" + array.first],
-                                     array.second.schema,
-                                     new_args,
-                                     array_buffers,
-                                     slices);
+          // in Serial and OpenMP we don't need a separate output array for
+          // the device, so just pass it conduit's array
+          detail::device_alloc_temporary(array.first,
+                                         array.second.schema,
+                                         new_args,
+                                         array_buffers,
+                                         slices,
+                                         output_ptr);
         }
         else
         {
-          // not in args so doesn't point to any data, allocate a temporary
-          if(array.first == "output")
-          {
-            output_index = array_buffers.size();
-          }
-          if(array.first == "output" &&
-             (device.mode() == "Serial" || device.mode() == "OpenMP"))
-          {
-            // in Serial and OpenMP we don't need a separate output array for
-            // the device, so just pass it conduit's array
-            detail::device_alloc_temporary(array.first,
-                                           array.second.schema,
-                                           new_args,
-                                           array_buffers,
-                                           slices,
-                                           output_ptr);
-          }
-          else
-          {
-            detail::device_alloc_temporary(array.first,
-                                           array.second.schema,
-                                           new_args,
-                                           array_buffers,
-                                           slices,
-                                           nullptr);
-          }
+          detail::device_alloc_temporary(array.first,
+                                         array.second.schema,
+                                         new_args,
+                                         array_buffers,
+                                         slices,
+                                         nullptr);
         }
       }
-      // copy the non-array types to new_args
-      const int original_num_args = cur_dom_info["args"].number_of_children();
-      for(int i = 0; i < original_num_args; ++i)
+    }
+    // copy the non-array types to new_args
+    const int original_num_args = cur_dom_info["args"].number_of_children();
+    for(int i = 0; i < original_num_args; ++i)
+    {
+      const conduit::Node &arg = cur_dom_info["args"].child(i);
+      if(arg.dtype().number_of_elements() == 1 &&
+         arg.number_of_children() == 0 && !arg.dtype().is_string())
       {
-        const conduit::Node &arg = cur_dom_info["args"].child(i);
-        if(arg.dtype().number_of_elements() == 1 &&
-           arg.number_of_children() == 0 && !arg.dtype().is_string())
-        {
-          new_args[arg.name()] = arg;
-        }
+        new_args[arg.name()] = arg;
       }
-      ASCENT_DATA_CLOSE();
+    }
+    ASCENT_DATA_CLOSE();
 
-      // generate and compile the kernel
-      const std::string kernel_string = generate_kernel(dom_idx, new_args);
+    // generate and compile the kernel
+    const std::string kernel_string =
+        generate_kernel(dom_idx, new_args, device.mode());
 
-      //std::cout << kernel_string << std::endl;
+    //std::cout << kernel_string << std::endl;
 
-      // store kernels so that we don't have to recompile, even loading a cached
-      // kernel from disk is slow
-      static std::unordered_map<std::string, occa::kernel> kernel_map;
-      try
-      {
-        flow::Timer kernel_compile_timer;
-        auto kernel_it = kernel_map.find(kernel_string);
-        if(kernel_it == kernel_map.end())
-        {
-          occa_kernel = device.buildKernelFromString(kernel_string, "map");
-          kernel_map[kernel_string] = occa_kernel;
-        }
-        else
-        {
-          occa_kernel = kernel_it->second;
-        }
-        ASCENT_DATA_ADD("kernel compile", kernel_compile_timer.elapsed());
-      }
-      catch(const occa::exception &e)
+    // store kernels so that we don't have to recompile, even loading a cached
+    // kernel from disk is slow
+    static std::unordered_map<std::string, occa::kernel> kernel_map;
+    try
+    {
+      flow::Timer kernel_compile_timer;
+      auto kernel_it = kernel_map.find(kernel_string);
+      if(kernel_it == kernel_map.end())
       {
-        ASCENT_ERROR("Jitable: Expression compilation failed:\n"
-                     << e.what() << "\n\n"
-                     << kernel_string);
+        occa_kernel = device.buildKernelFromString(kernel_string, "map");
+        kernel_map[kernel_string] = occa_kernel;
       }
-      catch(...)
+      else
       {
-        ASCENT_ERROR("Jitable: Expression compilation failed with an unknown "
-                     "error.\n\n"
-                     << kernel_string);
+        occa_kernel = kernel_it->second;
       }
+      ASCENT_DATA_ADD("kernel compile", kernel_compile_timer.elapsed());
+    }
+    catch(const occa::exception &e)
+    {
+      ASCENT_ERROR("Jitable: Expression compilation failed:\n"
+                   << e.what() << "\n\n"
+                   << kernel_string);
+    }
+    catch(...)
+    {
+      ASCENT_ERROR("Jitable: Expression compilation failed with an unknown "
+                   "error.\n\n"
+                   << kernel_string);
+    }
 
-      // pass input arguments
-      occa_kernel.clearArgs();
-      // get occa mem for devices
-      std::vector<occa::memory> array_memories;
-      detail::get_occa_mem(array_buffers, slices, array_memories);
+    // pass input arguments
+    occa_kernel.clearArgs();
+    // get occa mem for devices
+    std::vector<occa::memory> array_memories;
+    detail::get_occa_mem(array_buffers, slices, array_memories);
 
-      flow::Timer push_args_timer;
-      const int num_new_args = new_args.number_of_children();
-      for(int i = 0; i < num_new_args; ++i)
+    flow::Timer push_args_timer;
+    const int num_new_args = new_args.number_of_children();
+    for(int i = 0; i < num_new_args; ++i)
+    {
+      const conduit::Node &arg = new_args.child(i);
+      if(arg.dtype().is_integer())
       {
-        const conduit::Node &arg = new_args.child(i);
-        if(arg.dtype().is_integer())
-        {
-          occa_kernel.pushArg(arg.to_int64());
-        }
-        else if(arg.dtype().is_float64())
-        {
-          occa_kernel.pushArg(arg.to_float64());
-        }
-        else if(arg.dtype().is_float32())
-        {
-          occa_kernel.pushArg(arg.to_float32());
-        }
-        else if(arg.has_path("index"))
-        {
-          occa_kernel.pushArg(array_memories[arg["index"].to_int32()]);
-        }
-        else
-        {
-          ASCENT_ERROR("JIT: Unknown argument type of argument: " << arg.name());
-        }
+        occa_kernel.pushArg(arg.to_int64());
       }
-      ASCENT_DATA_ADD("push_input_args", push_args_timer.elapsed());
-
-      flow::Timer kernel_run_timer;
-      occa_kernel.run();
-      ASCENT_DATA_ADD("kernel runtime", kernel_run_timer.elapsed());
-
-      // copy back
-      flow::Timer copy_back_timer;
-      if(device.mode() != "Serial" && device.mode() != "OpenMP")
+      else if(arg.dtype().is_float64())
+      {
+        occa_kernel.pushArg(arg.to_float64());
+      }
+      else if(arg.dtype().is_float32())
+      {
+        occa_kernel.pushArg(arg.to_float32());
+      }
+      else if(arg.has_path("index"))
       {
-        array_memories[output_index].copyTo(output_ptr);
+        occa_kernel.pushArg(array_memories[arg["index"].to_int32()]);
       }
-      ASCENT_DATA_ADD("copy to host", copy_back_timer.elapsed());
+      else
+      {
+        ASCENT_ERROR("JIT: Unknown argument type of argument: " << arg.name());
+      }
+    }
+    ASCENT_DATA_ADD("push_input_args", push_args_timer.elapsed());
 
-      // dom["fields/" + field_name].print();
-      ASCENT_DATA_CLOSE();
+    flow::Timer kernel_run_timer;
+    occa_kernel.run();
+    ASCENT_DATA_ADD("kernel runtime", kernel_run_timer.elapsed());
+
+    // copy back
+    flow::Timer copy_back_timer;
+    if(device.mode() != "Serial" && device.mode() != "OpenMP")
+    {
+      array_memories[output_index].copyTo(output_ptr);
     }
+    ASCENT_DATA_ADD("copy to host", copy_back_timer.elapsed());
+
+    // dom["fields/" + field_name].print();
     ASCENT_DATA_CLOSE();
   }
-  catch(conduit::Error &e)
+#else
+  ASCENT_ERROR("JIT compilation for derived fields requires OCCA support"<<
+               " but Ascent was not compiled with OCCA.");
+#endif
+}
+
+bool
+Jitable::can_interpret() const
+{
+  const int num_domains = dom_info.number_of_children();
+  for(int dom_idx = 0; dom_idx < num_domains; ++dom_idx)
   {
-    errors.append() = e.what();
+    const std::string &kernel_type =
+        dom_info.child(dom_idx)["kernel_type"].as_string();
+    const auto kernel_it = kernels.find(kernel_type);
+    if(kernel_it == kernels.end() || !kernel_it->second.bytecode.valid() ||
+       static_cast<int>(kernel_it->second.bytecode.result.size()) !=
+           kernel_it->second.num_components)
+    {
+      return false;
+    }
   }
-  catch(std::exception &e)
+  return true;
+}
+
+void
+Jitable::set_engine(const std::string &engine, const int compile_threshold)
+{
+  if(engine != "auto" && engine != "interpret" && engine != "compile")
   {
-    errors.append() = e.what();
+    ASCENT_ERROR("Unknown derived field engine '"
+                 << engine
+                 << "'. Known engines are 'auto', 'interpret', and 'compile'.");
   }
-  catch(...)
+  m_engine = engine;
+  m_compile_threshold = compile_threshold;
+  reset_execution_counts();
+}
+
+void
+Jitable::reset_execution_counts()
+{
+  std::lock_guard<std::mutex> lock(detail::g_executions_mutex);
+  detail::g_executions.clear();
+}
+
+std::string
+Jitable::engine()
+{
+  return m_engine;
+}
+
+void
+Jitable::set_precision(const std::string &precision, const int tile_size)
+{
+  if(precision != "auto" && precision != "double")
   {
-    errors.append() = "Unknown error occured in JIT";
+    ASCENT_ERROR("Unknown derived field precision '"
+                 << precision << "'. Known precisions are 'auto' and 'double'.");
   }
+  if(tile_size < 0)
+  {
+    ASCENT_ERROR("Derived field tile size cannot be negative, got "
+                 << tile_size << ".");
+  }
+  m_precision = precision;
+  m_tile_size = tile_size;
+}
 
-  bool error = errors.number_of_children() > 0;
-  error = global_someone_agrees(error);
-  if(error)
+std::string
+Jitable::precision()
+{
+  return m_precision;
+}
+
+std::string
+Jitable::value_type(const Kernel &kernel)
+{
+  if(m_precision == "auto" && kernel.precision == "float")
   {
-    std::set<std::string> error_strs;
-    for(int i = 0; i < errors.number_of_children(); ++i)
-    {
-      error_strs.insert(errors.child(i).as_string());
-    }
-    gather_strings(error_strs);
-    conduit::Node n_errors;
-    for(auto e : error_strs)
+    return "float";
+  }
+  return "double";
+}
+
+int
+Jitable::tile_size(const std::string &device_mode,
+                   const std::string &value_type)
+{
+  const bool host = device_mode == "Serial" || device_mode == "OpenMP";
+  if(m_tile_size > 0)
+  {
+    // @inner loops are thread blocks on the GPU
+    if(!host && m_tile_size > max_gpu_tile_size)
     {
-      n_errors.append() = e;
+      ASCENT_ERROR("Derived field tile size "
+                   << m_tile_size << " is larger than the "
+                   << max_gpu_tile_size << " threads per block "
+                   << device_mode << " supports.");
     }
-    ASCENT_ERROR("Jit errors: "<<n_errors.to_string());
+    return m_tile_size;
   }
-
-#else
-  ASCENT_ERROR("JIT compilation for derived fields requires OCCA support"<<
-               " but Ascent was not compiled with OCCA.");
-#endif
+  if(host)
+  {
+    // on the host each @outer iteration is a task and the @inner loop
+    // is vectorized, use enough items for 64 full 512-bit vectors so
+    // float kernels get twice the items of double kernels
+    const int value_bytes = value_type == "float" ? 4 : 8;
+    return 64 * (64 / value_bytes);
+  }
+  // threads per block on the GPU
+  return 128;
 }
 
 void Jitable::init_occa()
@@ -86,6 +86,16 @@ class Jitable
 {
 protected:
   static int m_cuda_device_id;
+  static std::string m_engine;
+  static int m_compile_threshold;
+  static std::string m_precision;
+  static int m_tile_size;
+
+  bool use_interpreter() const;
+  void execute_interpreted(conduit::Node &dataset,
+                           const std::string &field_name);
+  void execute_compiled(conduit::Node &dataset,
+                        const std::string &field_name);
 public:
   Jitable(const int num_domains)
   {
@@ -99,13 +109,43 @@ public:
   static void init_occa();
   static void set_cuda_device(int device_id);
   static int num_cuda_devices();
-
+  // how derived fields are executed:
+  //   "auto": interpret an expression until it has been executed
+  //           'compile_threshold' times, then compile it with OCCA
+  //   "interpret": interpret whenever possible
+  //   "compile": always compile
+  // Expressions the interpreter does not support are always compiled.
+  // (also resets the execution counts)
+  static void set_engine(const std::string &engine,
+                         const int compile_threshold = 3);
+  static std::string engine();
+  // forgets how often expressions ran, "auto" interprets them again
+  static void reset_execution_counts();
+  // the precision derived fields are computed and stored in:
+  //   "auto": float32 if every field the expression depends on is float32
+  //   "double": always float64, for when accuracy matters more than speed
+  // 'tile_size' is the number of items each @outer iteration handles, 0
+  // picks a size based on the device and the precision. On GPUs a tile is
+  // a thread block, so it can be at most max_gpu_tile_size.
+  // In MPI runs every rank uses the precision that "auto" picks for the
+  // union of all ranks' fields.
+  static void set_precision(const std::string &precision,
+                            const int tile_size = 0);
+  static std::string precision();
+  // the C type a kernel computes its values in ("float" or "double")
+  static std::string value_type(const Kernel &kernel);
+  static int tile_size(const std::string &device_mode,
+                       const std::string &value_type);
+  static const int max_gpu_tile_size = 1024;
 
   void fuse_vars(const Jitable &from);
   bool can_execute() const;
+  // true if the kernels of every domain have valid bytecode
+  bool can_interpret() const;
   void execute(conduit::Node &dataset, const std::string &field_name);
   std::string generate_kernel(const int dom_idx,
-                              const conduit::Node &args) const;
+                              const conduit::Node &args,
+                              const std::string &device_mode) const;
 
   // map of kernel types (e.g. for different topologies)
   std::unordered_map<std::string, Kernel> kernels;
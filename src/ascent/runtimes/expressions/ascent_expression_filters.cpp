@@ -61,6 +61,7 @@
 // ascent includes
 //-----------------------------------------------------------------------------
 #include "ascent_blueprint_architect.hpp"
+#include "ascent_blueprint_locator.hpp"
 #include "ascent_conduit_reductions.hpp"
 #include <ascent_config.h>
 #include <ascent_logging.hpp>
@@ -75,6 +76,10 @@
 #include <cmath>
 #include <typeinfo>
 
+#if defined(ASCENT_VTKM_ENABLED)
+#include <ascent_vtkh_collection.hpp>
+#endif
+
 #if defined(ASCENT_DRAY_ENABLED)
 #include <dray/queries/lineout.hpp>
 #endif
@@ -1110,7 +1115,7 @@ FieldMin::execute()
 
   DataObject *data_object =
     graph().workspace().registry().fetch<DataObject>("dataset");
-  const conduit::Node *const dataset = data_object->as_low_order_bp().get();
+  const conduit::Node *const dataset = data_object->as_field_bp(field).get();
 
   if(!is_scalar_field(*dataset, field))
   {
@@ -1219,7 +1224,7 @@ FieldMax::execute()
 
   DataObject *data_object =
     graph().workspace().registry().fetch<DataObject>("dataset");
-  const conduit::Node *const dataset = data_object->as_low_order_bp().get();
+  const conduit::Node *const dataset = data_object->as_field_bp(field).get();
 
   if(!is_scalar_field(*dataset, field))
   {
@@ -2020,7 +2025,7 @@ FieldAvg::execute()
 
   DataObject *data_object =
     graph().workspace().registry().fetch<DataObject>("dataset");
-  const conduit::Node *const dataset = data_object->as_low_order_bp().get();
+  const conduit::Node *const dataset = data_object->as_field_bp(field).get();
 
   if(!is_scalar_field(*dataset, field))
   {
@@ -2075,10 +2080,8 @@ Cycle::execute()
   DataObject *data_object =
     graph().workspace().registry().fetch<DataObject>("dataset");
   // we are just getting state so we don't care if its high or low
-  // order
-  const conduit::Node *const dataset = data_object->as_node().get();
-
-  conduit::Node state = get_state_var(*dataset, "cycle");
+  // order, or if it has been converted to blueprint at all
+  conduit::Node state = data_object->state_var("cycle");
   if(!state.dtype().is_number())
   {
     ASCENT_ERROR("Expressions: cycle() is not a number");
@@ -2129,10 +2132,8 @@ Time::execute()
   DataObject *data_object =
     graph().workspace().registry().fetch<DataObject>("dataset");
   // we are just getting state so we don't care if its high or low
-  // order
-  const conduit::Node *const dataset = data_object->as_node().get();
-
-  conduit::Node state = get_state_var(*dataset, "time");
+  // order, or if it has been converted to blueprint at all
+  conduit::Node state = data_object->state_var("time");
   if(!state.dtype().is_number())
   {
     ASCENT_ERROR("Expressions: time() is not a number");
@@ -2680,7 +2681,7 @@ Field::execute()
 
   DataObject *data_object =
     graph().workspace().registry().fetch<DataObject>("dataset");
-  const conduit::Node *const dataset = data_object->as_low_order_bp().get();
+  const conduit::Node *const dataset = data_object->as_field_bp(field_name).get();
 
   if(!has_field(*dataset, field_name))
   {
@@ -2979,7 +2980,7 @@ Histogram::execute()
 
   DataObject *data_object =
     graph().workspace().registry().fetch<DataObject>("dataset");
-  const conduit::Node *const dataset = data_object->as_low_order_bp().get();
+  const conduit::Node *const dataset = data_object->as_field_bp(field).get();
 
   if(!is_scalar_field(*dataset, field))
   {
@@ -3619,7 +3620,7 @@ FieldSum::execute()
 
   DataObject *data_object =
     graph().workspace().registry().fetch<DataObject>("dataset");
-  const conduit::Node *const dataset = data_object->as_low_order_bp().get();
+  const conduit::Node *const dataset = data_object->as_field_bp(field).get();
 
   conduit::Node *output = new conduit::Node();
   (*output)["value"] = field_sum(*dataset, field)["value"];
@@ -3667,7 +3668,7 @@ FieldNanCount::execute()
 
   DataObject *data_object =
     graph().workspace().registry().fetch<DataObject>("dataset");
-  conduit::Node *dataset = data_object->as_low_order_bp().get();
+  conduit::Node *dataset = data_object->as_field_bp(field).get();
 
   conduit::Node *output = new conduit::Node();
   (*output)["value"] = field_nan_count(*dataset, field)["value"];
@@ -3715,7 +3716,7 @@ FieldInfCount::execute()
 
   DataObject *data_object =
     graph().workspace().registry().fetch<DataObject>("dataset");
-  conduit::Node *dataset = data_object->as_low_order_bp().get();
+  conduit::Node *dataset = data_object->as_field_bp(field).get();
 
   conduit::Node *output = new conduit::Node();
   (*output)["value"] = field_inf_count(*dataset, field)["value"];
@@ -4131,11 +4132,6 @@ Lineout::verify_params(const conduit::Node &params, conduit::Node &info)
 void
 Lineout::execute()
 {
-
-#if not defined(ASCENT_DRAY_ENABLED)
-  ASCENT_ERROR("Lineout only supported when Devil Ray is built");
-#else
-
   conduit::Node &n_samples = *input<Node>("samples");
   int32 samples = n_samples["value"].to_int32();;
   if(samples < 1)
@@ -4146,50 +4142,116 @@ Lineout::execute()
   conduit::Node &n_start = *input<Node>("start");
   double *p_start = n_start["value"].as_float64_ptr();
 
+  conduit::Node &n_end= *input<Node>("end");
+  double *p_end = n_end["value"].as_float64_ptr();
+
+  conduit::Node &n_empty_val = *input<Node>("empty_val");
+  double empty_val = 0.;
+  if(!n_empty_val.dtype().is_empty())
+  {
+    empty_val = n_empty_val["value"].to_float64();
+  }
+
+  // figure out the number of fields we will use
+  std::vector<std::string> vars;
+  conduit::Node &n_fields = (*input<Node>("fields"))["value"];
+  const int num_fields = n_fields.number_of_children();
+  for(int i = 0; i < num_fields; ++i)
+  {
+    const conduit::Node &n_field = n_fields.child(i);
+    if(n_field["type"].as_string() != "string")
+    {
+      ASCENT_ERROR("Lineout: field list item is not a string");
+    }
+    vars.push_back(n_field["value"].as_string());
+  }
+
+  conduit::Node *output = new conduit::Node();
+  (*output)["type"] = "lineout";
+
+  DataObject *data_object =
+    graph().workspace().registry().fetch<DataObject>("dataset");
+
+  const bool high_order = data_object->source() == DataObject::Source::HIGH_BP ||
+                          data_object->source() == DataObject::Source::DRAY;
+  if(!high_order)
+  {
+    // low order meshes are sampled with the same cell locators as probe()
+    std::vector<double> points(3 * samples);
+    for(int i = 0; i < samples; ++i)
+    {
+      const double t = samples > 1 ? double(i) / double(samples - 1) : 0.;
+      for(int d = 0; d < 3; ++d)
+      {
+        points[3 * i + d] = p_start[d] + t * (p_end[d] - p_start[d]);
+      }
+    }
+
+    conduit::Node n_probe;
+    if(!vars.empty())
+    {
+      const conduit::Node *const dataset = data_object->as_fields_bp(vars).get();
+      n_probe = probe_fields(*dataset, vars, points.data(), samples, empty_val);
+    }
+
+    (*output)["attrs/empty_value/value"] = empty_val;
+    (*output)["attrs/empty_value/type"] = "double";
+    (*output)["attrs/samples/value"] = int(samples);
+    (*output)["attrs/samples/type"] = "int";
+    const std::string axes[3] = {"x", "y", "z"};
+    for(int d = 0; d < 3; ++d)
+    {
+      conduit::Node &n_coords = (*output)["attrs/coordinates/" + axes[d]];
+      n_coords["value"] = conduit::DataType::float64(samples);
+      n_coords["type"] = "array";
+      float64_array coords = n_coords["value"].value();
+      for(int i = 0; i < samples; ++i)
+      {
+        coords[i] = points[3 * i + d];
+      }
+    }
+    for(const std::string &var : vars)
+    {
+      (*output)["attrs/vars/"+var+"/value"] = n_probe["values/" + var];
+      (*output)["attrs/vars/"+var+"/type"] = "array";
+    }
+
+    resolve_symbol_result(graph(), output, this->name());
+    set_output<conduit::Node>(output);
+    return;
+  }
+
+#if not defined(ASCENT_DRAY_ENABLED)
+  delete output;
+  ASCENT_ERROR("Lineout of high order data only supported when Devil Ray is built");
+#else
+
   dray::Vec<dray::Float,3> start;
   start[0] = static_cast<dray::Float>(p_start[0]);
   start[1] = static_cast<dray::Float>(p_start[1]);
   start[2] = static_cast<dray::Float>(p_start[2]);
 
-  conduit::Node &n_end= *input<Node>("end");
-  double *p_end = n_end["value"].as_float64_ptr();
-
   dray::Vec<dray::Float,3> end;
   end[0] = static_cast<dray::Float>(p_end[0]);
   end[1] = static_cast<dray::Float>(p_end[1]);
   end[2] = static_cast<dray::Float>(p_end[2]);
 
-  conduit::Node *output = new conduit::Node();
-
-  DataObject *data_object =
-    graph().workspace().registry().fetch<DataObject>("dataset");
   dray::Collection * collection = data_object->as_dray_collection().get();
 
   dray::Lineout lineout;
 
   lineout.samples(samples);
 
-  conduit::Node &n_empty_val = *input<Node>("empty_val");
   if(!n_empty_val.dtype().is_empty())
   {
-    double empty_val = n_empty_val["value"].to_float64();
     lineout.empty_val(empty_val);
   }
 
-  // figure out the number of fields we will use
-  conduit::Node &n_fields = (*input<Node>("fields"))["value"];
-  const int num_fields = n_fields.number_of_children();
   if(num_fields > 0)
   {
-    for(int i = 0; i < num_fields; ++i)
+    for(const std::string &var : vars)
     {
-      const conduit::Node &n_field = n_fields.child(i);
-      if(n_field["type"].as_string() != "string")
-      {
-        ASCENT_ERROR("Lineout: field list item is not a string");
-      }
-
-      lineout.add_var(n_field["value"].as_string());
+      lineout.add_var(var);
     }
   }
   else
@@ -4213,7 +4275,6 @@ Lineout::execute()
   lineout.add_line(start, end);
 
   dray::Lineout::Result res = lineout.execute(*collection);
-  (*output)["type"] = "lineout";
   (*output)["attrs/empty_value/value"] = double(res.m_empty_val);
   (*output)["attrs/empty_value/type"] = "double";
   (*output)["attrs/samples/value"] = int(res.m_points_per_line);
@@ -4256,6 +4317,95 @@ Lineout::execute()
 
 }
 
+//-----------------------------------------------------------------------------
+Probe::Probe() : Filter()
+{
+  // empty
+}
+
+//-----------------------------------------------------------------------------
+Probe::~Probe()
+{
+  // empty
+}
+
+//-----------------------------------------------------------------------------
+void
+Probe::declare_interface(Node &i)
+{
+  i["type_name"] = "probe";
+  i["port_names"].append() = "points";
+  i["port_names"].append() = "field";
+  i["port_names"].append() = "empty_val";
+  i["output_port"] = "true";
+}
+
+//-----------------------------------------------------------------------------
+bool
+Probe::verify_params(const conduit::Node &params, conduit::Node &info)
+{
+  info.reset();
+  bool res = true;
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+void
+Probe::execute()
+{
+  const conduit::Node &n_points = (*input<Node>("points"))["value"];
+  const conduit::Node *n_field = input<Node>("field");
+  const conduit::Node *n_empty_val = input<Node>("empty_val");
+
+  double empty_val = 0.;
+  if(!n_empty_val->dtype().is_empty())
+  {
+    empty_val = (*n_empty_val)["value"].to_float64();
+  }
+
+  const int num_points = n_points.number_of_children();
+  std::vector<double> points(3 * num_points);
+  for(int i = 0; i < num_points; ++i)
+  {
+    const conduit::Node &n_point = n_points.child(i);
+    if(n_point["type"].as_string() != "vector")
+    {
+      ASCENT_ERROR("Probe: points list item is not a vector");
+    }
+    const double *point = n_point["value"].as_float64_ptr();
+    points[3 * i] = point[0];
+    points[3 * i + 1] = point[1];
+    points[3 * i + 2] = point[2];
+  }
+
+  const std::string field = (*n_field)["value"].as_string();
+  std::string var = field;
+  if(n_field->has_path("component"))
+  {
+    var += "/" + (*n_field)["component"].as_string();
+  }
+
+  DataObject *data_object =
+    graph().workspace().registry().fetch<DataObject>("dataset");
+  const conduit::Node *const dataset = data_object->as_field_bp(field).get();
+
+  conduit::Node n_probe =
+    probe_fields(*dataset, {var}, points.data(), num_points, empty_val);
+
+  conduit::Node *output = new conduit::Node();
+  (*output)["type"] = "probe";
+  (*output)["attrs/value/value"] = n_probe["values/" + var];
+  (*output)["attrs/value/type"] = "array";
+  // arrays in expressions are float64
+  n_probe["found"].to_float64_array((*output)["attrs/found/value"]);
+  (*output)["attrs/found/type"] = "array";
+  (*output)["attrs/empty_value/value"] = empty_val;
+  (*output)["attrs/empty_value/type"] = "double";
+
+  resolve_symbol_result(graph(), output, this->name());
+  set_output<conduit::Node>(output);
+}
+
 //-----------------------------------------------------------------------------
 Bounds::Bounds() : Filter()
 {
@@ -4295,44 +4445,87 @@ Bounds::execute()
 
   DataObject *data_object =
     graph().workspace().registry().fetch<DataObject>("dataset");
-  const conduit::Node *const dataset = data_object->as_low_order_bp().get();
 
-  std::set<std::string> topos;
+  double inf = std::numeric_limits<double>::infinity();
+  double min_vec[3] = {inf, inf, inf};
+  double max_vec[3] = {-inf, -inf, -inf};
 
-  if(!n_topology.dtype().is_empty())
+#if defined(ASCENT_VTKM_ENABLED)
+  // vtkh data already knows its bounds, so we don't need to convert
+  // the whole collection back to blueprint to answer
+  if(data_object->source() == DataObject::Source::VTKH)
   {
-    std::string topo = n_topology["value"].as_string();
-    if(!has_topology(*dataset, topo))
+    std::shared_ptr<VTKHCollection> collection =
+      data_object->as_vtkh_collection();
+    vtkm::Bounds bounds;
+    if(!n_topology.dtype().is_empty())
     {
-      std::set<std::string> names = topology_names(*dataset);
-      std::stringstream msg;
-      msg<<"Unknown topology: '"<<topo<<"'. Known topologies: [";
-      for(auto &name : names)
+      std::string topo = n_topology["value"].as_string();
+      if(!collection->has_topology(topo))
       {
-        msg<<" "<<name;
+        std::vector<std::string> names = collection->topology_names();
+        std::stringstream msg;
+        msg<<"Unknown topology: '"<<topo<<"'. Known topologies: [";
+        for(auto &name : names)
+        {
+          msg<<" "<<name;
+        }
+        msg<<" ]";
+        ASCENT_ERROR(msg.str());
       }
-      msg<<" ]";
-      ASCENT_ERROR(msg.str());
+      bounds = collection->dataset_by_topology(topo).GetGlobalBounds();
     }
-    topos.insert(topo);
+    else
+    {
+      bounds = collection->global_bounds();
+    }
+
+    min_vec[0] = bounds.X.Min;
+    min_vec[1] = bounds.Y.Min;
+    min_vec[2] = bounds.Z.Min;
+    max_vec[0] = bounds.X.Max;
+    max_vec[1] = bounds.Y.Max;
+    max_vec[2] = bounds.Z.Max;
   }
   else
+#endif
   {
-    topos = topology_names(*dataset);
-  }
+    const conduit::Node *const dataset = data_object->as_low_order_bp().get();
 
-  double inf = std::numeric_limits<double>::infinity();
-  double min_vec[3] = {inf, inf, inf};
-  double max_vec[3] = {-inf, -inf, -inf};
-  for(auto &topo_name : topos)
-  {
-    conduit::Node n_aabb = global_bounds(*dataset, topo_name);
-    double *t_min = n_aabb["min_coords"].as_float64_ptr();
-    double *t_max = n_aabb["max_coords"].as_float64_ptr();
-    for(int i = 0; i < 3; ++i)
+    std::set<std::string> topos;
+
+    if(!n_topology.dtype().is_empty())
     {
-      min_vec[i] = std::min(t_min[i],min_vec[i]);
-      max_vec[i] = std::max(t_max[i],max_vec[i]);
+      std::string topo = n_topology["value"].as_string();
+      if(!has_topology(*dataset, topo))
+      {
+        std::set<std::string> names = topology_names(*dataset);
+        std::stringstream msg;
+        msg<<"Unknown topology: '"<<topo<<"'. Known topologies: [";
+        for(auto &name : names)
+        {
+          msg<<" "<<name;
+        }
+        msg<<" ]";
+        ASCENT_ERROR(msg.str());
+      }
+      topos.insert(topo);
+    }
+    else
+    {
+      topos = topology_names(*dataset);
+    }
+
+    for(auto &topo_name : topos)
+    {
+      conduit::Node n_aabb = global_bounds(*dataset, topo_name);
+      double *t_min = n_aabb["min_coords"].as_float64_ptr();
+      double *t_max = n_aabb["max_coords"].as_float64_ptr();
+      for(int i = 0; i < 3; ++i)
+      {
+        min_vec[i] = std::min(t_min[i],min_vec[i]);
+        max_vec[i] = std::max(t_max[i],max_vec[i]);
+      }
     }
   }
 
@@ -4391,7 +4584,7 @@ Topo::execute()
 
   DataObject *data_object =
     graph().workspace().registry().fetch<DataObject>("dataset");
-  const conduit::Node *const dataset = data_object->as_low_order_bp().get();
+  const conduit::Node *const dataset = data_object->as_topology_bp(topo).get();
 
   if(!has_topology(*dataset, topo))
   {
@@ -654,6 +654,17 @@ public:
   virtual void execute();
 };
 
+class Probe : public ::flow::Filter
+{
+public:
+  Probe();
+  ~Probe();
+
+  virtual void declare_interface(conduit::Node &i);
+  virtual bool verify_params(const conduit::Node &params, conduit::Node &info);
+  virtual void execute();
+};
+
 class Nan : public ::flow::Filter
 {
 public:
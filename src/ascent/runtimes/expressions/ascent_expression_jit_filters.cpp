@@ -12,6 +12,8 @@
 #include <flow_workspace.hpp>
 
 #include <list>
+#include <map>
+#include <mutex>
 
 using namespace conduit;
 using namespace std;
@@ -228,13 +230,16 @@ JitFilter::execute()
 
           if(type == "int" || type == "double" || type == "bool")
           {
-            // force everthing to a double
+            // force everthing to the precision of the kernel, constants
+            // don't decide the precision themselves
             for(int i = 0; i < num_domains; ++i)
             {
               jitable.dom_info.child(i)["args/" + input_fname] = (*inp)["value"];
             }
-            default_kernel.expr = "((double)" + input_fname + ")";
+            default_kernel.expr = "((JIT_REAL)" + input_fname + ")";
             default_kernel.num_components = 1;
+            Bytecode &bc = default_kernel.bytecode;
+            bc.result = {bc.arg(input_fname)};
           }
           else if(type == "vector")
           {
@@ -244,11 +249,17 @@ JitFilter::execute()
             }
             default_kernel.expr = input_fname;
             default_kernel.num_components = 3;
+            Bytecode &bc = default_kernel.bytecode;
+            for(int c = 0; c < 3; ++c)
+            {
+              bc.result.push_back(bc.arg(input_fname, c));
+            }
           }
           // field or a jitable that was executed at runtime
           else if(type == "field" || type == "jitable")
           {
             std::string field_name = (*inp)["value"].as_string();
+            bool is_integer = false;
             // error checking and dom args information
             for(int i = 0; i < num_domains; ++i)
             {
@@ -273,14 +284,28 @@ JitFilter::execute()
                 default_kernel.num_components = std::max(1, num_children);
               }
 
-              bool is_float64;
+              bool is_float32;
               if(field[values_path].number_of_children() > 1)
               {
-                is_float64 = field[values_path].child(0).dtype().is_float64();
+                is_float32 = field[values_path].child(0).dtype().is_float32();
+                is_integer |= field[values_path].child(0).dtype().is_integer();
+              }
+              else
+              {
+                is_float32 = field[values_path].dtype().is_float32();
+                is_integer |= field[values_path].dtype().is_integer();
+              }
+              // integer fields are computed in double, a field that is
+              // float32 in one domain and float64 in another is double
+              const std::string precision = is_float32 ? "float" : "double";
+              if(i == 0)
+              {
+                default_kernel.precision = precision;
               }
               else
               {
-                is_float64 = field[values_path].dtype().is_float64();
+                default_kernel.precision = Kernel::promote_precision(
+                    default_kernel.precision, precision);
               }
 
               pack_array(field[values_path],
@@ -347,11 +372,17 @@ JitFilter::execute()
             if(default_kernel.num_components == 1)
             {
               default_kernel.expr = jitable.arrays[0].index(field_name, "item");
+              // integer values are promoted like the interpreter does, so
+              // e.g. division is never integer division
+              if(is_integer)
+              {
+                default_kernel.expr = "((JIT_REAL)" + default_kernel.expr + ")";
+              }
             }
             else
             {
               default_kernel.for_body.insert(
-                  "double " + field_name + "_item[" +
+                  "JIT_REAL " + field_name + "_item[" +
                   std::to_string(default_kernel.num_components) + "];\n");
               for(int i = 0; i < default_kernel.num_components; ++i)
               {
@@ -361,6 +392,19 @@ JitFilter::execute()
               }
               default_kernel.expr = field_name + "_item";
             }
+
+            Bytecode &bc = default_kernel.bytecode;
+            if(default_kernel.num_components == 1)
+            {
+              bc.result = {bc.load(field_name)};
+            }
+            else
+            {
+              for(int c = 0; c < default_kernel.num_components; ++c)
+              {
+                bc.result.push_back(bc.load(field_name, c));
+              }
+            }
           }
           else if(type == "binning")
           {
@@ -647,41 +691,57 @@ JitFilter::execute()
   }
 }
 //-----------------------------------------------------------------------------
+// The factory only gets the filter type name, so the number of inputs and
+// the policy of each registered type are looked up by name. Expressions can
+// be evaluated concurrently so the table is locked.
 class JitFilterFactoryFunctor
 {
 public:
   static void
-  set(const int num_inputs_,
-      const std::shared_ptr<const JitExecutionPolicy> exec_policy_)
+  set(const std::string &filter_type_name,
+      const int num_inputs,
+      const std::shared_ptr<const JitExecutionPolicy> exec_policy)
   {
-    num_inputs = num_inputs_;
-    exec_policy = exec_policy_;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_types[filter_type_name] = std::make_pair(num_inputs, exec_policy);
   }
   static Filter *
   JitFilterFactory(const std::string &filter_type_name)
   {
-    return new JitFilter(num_inputs, exec_policy);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto type_it = m_types.find(filter_type_name);
+    if(type_it == m_types.end())
+    {
+      ASCENT_ERROR("Unknown jit filter type '" << filter_type_name << "'");
+    }
+    return new JitFilter(type_it->second.first, type_it->second.second);
   }
 
 private:
-  static int num_inputs;
-  static std::shared_ptr<const JitExecutionPolicy> exec_policy;
+  static std::mutex m_mutex;
+  static std::map<std::string,
+                  std::pair<int, std::shared_ptr<const JitExecutionPolicy>>>
+      m_types;
 };
 
 // apparently I have to do this for the linker to be happy
-int JitFilterFactoryFunctor::num_inputs;
-std::shared_ptr<const JitExecutionPolicy> JitFilterFactoryFunctor::exec_policy;
+std::mutex JitFilterFactoryFunctor::m_mutex;
+std::map<std::string, std::pair<int, std::shared_ptr<const JitExecutionPolicy>>>
+    JitFilterFactoryFunctor::m_types;
 
 std::string
 register_jit_filter(flow::Workspace &w,
                     const int num_inputs,
                     const std::shared_ptr<const JitExecutionPolicy> exec_policy)
 {
-  JitFilterFactoryFunctor::set(num_inputs, exec_policy);
+  // registering checks then adds the type, two threads must not race
+  static std::mutex register_mutex;
   std::stringstream ss;
   ss << "jit_filter_" << num_inputs << "_" << exec_policy->get_name();
+  std::lock_guard<std::mutex> lock(register_mutex);
   if(!w.supports_filter_type(ss.str()))
   {
+    JitFilterFactoryFunctor::set(ss.str(), num_inputs, exec_policy);
     flow::Workspace::register_filter_type(
         ss.str(), JitFilterFactoryFunctor::JitFilterFactory);
   }
@@ -570,7 +570,8 @@ BuildGraphVisitor::visit(const ASTMethodCall &call)
     ASCENT_ERROR("Missing function table");
   }
 
-  conduit::Node *f_table = w.registry().fetch<conduit::Node>("function_table");
+  const conduit::Node *f_table =
+      w.registry().fetch<conduit::Node>("function_table");
   // resolve the function
   if(!f_table->has_path(call.m_id->m_name))
   {
@@ -1298,7 +1299,8 @@ BuildGraphVisitor::visit(const ASTDotAccess &expr)
   {
     ASCENT_ERROR("Missing object table");
   }
-  conduit::Node *o_table = w.registry().fetch<conduit::Node>("object_table");
+  const conduit::Node *o_table =
+      w.registry().fetch<conduit::Node>("object_table");
 
   // get the object
   if(!o_table->has_path(obj_type))
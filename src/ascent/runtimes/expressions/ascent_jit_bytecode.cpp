@@ -0,0 +1,640 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_jit_bytecode.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "ascent_jit_bytecode.hpp"
+#include <ascent_config.h>
+#include <ascent_logging.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <sstream>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+namespace expressions
+{
+
+namespace detail
+{
+
+const char *op_names[] = {"load", "arg",  "const", "add", "sub",  "mul",
+                          "div",  "mod",  "lt",    "gt",  "le",   "ge",
+                          "eq",   "ne",   "and",   "or",  "not",  "min",
+                          "max",  "pow",  "sin",   "cos", "tan",  "sqrt",
+                          "abs",  "exp",  "log",   "select", "skip_none",
+                          "skip_all"};
+
+// where a load reads its values from
+struct LoadSource
+{
+  const unsigned char *ptr;
+  conduit::index_t stride;
+  bool is_float32;
+};
+
+// where a result component is written to
+struct OutputDest
+{
+  unsigned char *ptr;
+  conduit::index_t stride;
+  bool is_float32;
+};
+
+template <typename S, typename T>
+void
+load_block(const LoadSource &src, const int start, const int len, T *dest)
+{
+  const unsigned char *ptr = src.ptr + start * src.stride;
+  for(int i = 0; i < len; ++i)
+  {
+    dest[i] = static_cast<T>(
+        *reinterpret_cast<const S *>(ptr + i * src.stride));
+  }
+}
+
+template <typename T, typename D>
+void
+store_block(const T *res, const int start, const int len, const OutputDest &dest)
+{
+  unsigned char *ptr = dest.ptr + start * dest.stride;
+  for(int i = 0; i < len; ++i)
+  {
+    *reinterpret_cast<D *>(ptr + i * dest.stride) = static_cast<D>(res[i]);
+  }
+}
+
+// registers are T, float kernels are computed in float like the
+// compiled code
+template <typename T>
+void
+run_block(const Bytecode::Instruction &inst,
+          const LoadSource &src,
+          const double scalar,
+          const int start,
+          const int len,
+          T *regs)
+{
+  const int bs = Bytecode::block_size;
+  const T zero = 0;
+  T *d = regs + inst.dest * bs;
+  const T *a = inst.a >= 0 ? regs + inst.a * bs : nullptr;
+  const T *b = inst.b >= 0 ? regs + inst.b * bs : nullptr;
+  const T *c = inst.c >= 0 ? regs + inst.c * bs : nullptr;
+
+  switch(inst.op)
+  {
+  case Bytecode::LOAD:
+    if(src.is_float32)
+    {
+      load_block<float>(src, start, len, d);
+    }
+    else
+    {
+      load_block<double>(src, start, len, d);
+    }
+    break;
+  case Bytecode::ARG:
+  case Bytecode::CONST:
+    for(int i = 0; i < len; ++i) d[i] = static_cast<T>(scalar);
+    break;
+  case Bytecode::ADD:
+    for(int i = 0; i < len; ++i) d[i] = a[i] + b[i];
+    break;
+  case Bytecode::SUB:
+    for(int i = 0; i < len; ++i) d[i] = a[i] - b[i];
+    break;
+  case Bytecode::MUL:
+    for(int i = 0; i < len; ++i) d[i] = a[i] * b[i];
+    break;
+  case Bytecode::DIV:
+    for(int i = 0; i < len; ++i) d[i] = a[i] / b[i];
+    break;
+  case Bytecode::MOD:
+    for(int i = 0; i < len; ++i) d[i] = std::fmod(a[i], b[i]);
+    break;
+  case Bytecode::LT:
+    for(int i = 0; i < len; ++i) d[i] = a[i] < b[i];
+    break;
+  case Bytecode::GT:
+    for(int i = 0; i < len; ++i) d[i] = a[i] > b[i];
+    break;
+  case Bytecode::LE:
+    for(int i = 0; i < len; ++i) d[i] = a[i] <= b[i];
+    break;
+  case Bytecode::GE:
+    for(int i = 0; i < len; ++i) d[i] = a[i] >= b[i];
+    break;
+  case Bytecode::EQ:
+    for(int i = 0; i < len; ++i) d[i] = a[i] == b[i];
+    break;
+  case Bytecode::NE:
+    for(int i = 0; i < len; ++i) d[i] = a[i] != b[i];
+    break;
+  case Bytecode::AND:
+    for(int i = 0; i < len; ++i) d[i] = (a[i] != zero) && (b[i] != zero);
+    break;
+  case Bytecode::OR:
+    for(int i = 0; i < len; ++i) d[i] = (a[i] != zero) || (b[i] != zero);
+    break;
+  case Bytecode::NOT:
+    for(int i = 0; i < len; ++i) d[i] = a[i] == zero;
+    break;
+  case Bytecode::MIN:
+    for(int i = 0; i < len; ++i) d[i] = std::min(a[i], b[i]);
+    break;
+  case Bytecode::MAX:
+    for(int i = 0; i < len; ++i) d[i] = std::max(a[i], b[i]);
+    break;
+  case Bytecode::POW:
+    for(int i = 0; i < len; ++i) d[i] = std::pow(a[i], b[i]);
+    break;
+  case Bytecode::SIN:
+    for(int i = 0; i < len; ++i) d[i] = std::sin(a[i]);
+    break;
+  case Bytecode::COS:
+    for(int i = 0; i < len; ++i) d[i] = std::cos(a[i]);
+    break;
+  case Bytecode::TAN:
+    for(int i = 0; i < len; ++i) d[i] = std::tan(a[i]);
+    break;
+  case Bytecode::SQRT:
+    for(int i = 0; i < len; ++i) d[i] = std::sqrt(a[i]);
+    break;
+  case Bytecode::ABS:
+    for(int i = 0; i < len; ++i) d[i] = std::fabs(a[i]);
+    break;
+  case Bytecode::EXP:
+    for(int i = 0; i < len; ++i) d[i] = std::exp(a[i]);
+    break;
+  case Bytecode::LOG:
+    for(int i = 0; i < len; ++i) d[i] = std::log(a[i]);
+    break;
+  case Bytecode::SELECT:
+    for(int i = 0; i < len; ++i) d[i] = a[i] != zero ? b[i] : c[i];
+    break;
+  case Bytecode::SKIP_NONE:
+  case Bytecode::SKIP_ALL:
+    // handled by run_program
+    break;
+  }
+}
+
+// true if a skip instruction skips the instructions it covers in this block
+template <typename T>
+bool
+skips(const Bytecode::Instruction &inst, const int len, const T *regs)
+{
+  const T *a = regs + inst.a * Bytecode::block_size;
+  const bool want = inst.op == Bytecode::SKIP_ALL;
+  for(int i = 0; i < len; ++i)
+  {
+    if((a[i] != T(0)) != want)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+void
+run_program(const Bytecode &bc,
+            const std::vector<LoadSource> &sources,
+            const std::vector<double> &scalars,
+            const std::vector<OutputDest> &outputs,
+            const int entries)
+{
+  const int bs = Bytecode::block_size;
+  const int num_insts = static_cast<int>(bc.code.size());
+  const int num_components = static_cast<int>(bc.result.size());
+  const int num_blocks = (entries + bs - 1) / bs;
+
+#ifdef ASCENT_USE_OPENMP
+#pragma omp parallel
+#endif
+  {
+    // each thread gets its own registers
+    std::vector<T> regs(static_cast<size_t>(bc.num_registers) * bs);
+#ifdef ASCENT_USE_OPENMP
+#pragma omp for schedule(static)
+#endif
+    for(int block = 0; block < num_blocks; ++block)
+    {
+      const int start = block * bs;
+      const int len = std::min(bs, entries - start);
+      for(int i = 0; i < num_insts; ++i)
+      {
+        const Bytecode::Instruction &inst = bc.code[i];
+        if(inst.op == Bytecode::SKIP_NONE || inst.op == Bytecode::SKIP_ALL)
+        {
+          if(skips(inst, len, regs.data()))
+          {
+            i += inst.count;
+          }
+          continue;
+        }
+        run_block(inst, sources[i], scalars[i], start, len, regs.data());
+      }
+      for(int comp = 0; comp < num_components; ++comp)
+      {
+        const T *res = regs.data() + bc.result[comp] * bs;
+        if(outputs[comp].is_float32)
+        {
+          store_block<T, float>(res, start, len, outputs[comp]);
+        }
+        else
+        {
+          store_block<T, double>(res, start, len, outputs[comp]);
+        }
+      }
+    }
+  }
+}
+
+};
+
+const int Bytecode::block_size;
+
+Bytecode::Bytecode() : num_registers(0)
+{
+}
+
+bool
+Bytecode::valid() const
+{
+  return !result.empty();
+}
+
+void
+Bytecode::invalidate()
+{
+  code.clear();
+  result.clear();
+  num_registers = 0;
+}
+
+int
+Bytecode::load(const std::string &name, const int component)
+{
+  Instruction inst = {LOAD, num_registers++, -1, -1, -1, 0.0, name, component, 0};
+  code.push_back(inst);
+  return inst.dest;
+}
+
+int
+Bytecode::arg(const std::string &name, const int component)
+{
+  Instruction inst = {ARG, num_registers++, -1, -1, -1, 0.0, name, component, 0};
+  code.push_back(inst);
+  return inst.dest;
+}
+
+int
+Bytecode::constant(const double value)
+{
+  Instruction inst = {CONST, num_registers++, -1, -1, -1, value, "", -1, 0};
+  code.push_back(inst);
+  return inst.dest;
+}
+
+int
+Bytecode::unary(const OpCode op, const int a)
+{
+  Instruction inst = {op, num_registers++, a, -1, -1, 0.0, "", -1, 0};
+  code.push_back(inst);
+  return inst.dest;
+}
+
+int
+Bytecode::binary(const OpCode op, const int a, const int b)
+{
+  Instruction inst = {op, num_registers++, a, b, -1, 0.0, "", -1, 0};
+  code.push_back(inst);
+  return inst.dest;
+}
+
+int
+Bytecode::select(const int cond, const int a, const int b)
+{
+  Instruction inst = {SELECT, num_registers++, cond, a, b, 0.0, "", -1, 0};
+  code.push_back(inst);
+  return inst.dest;
+}
+
+int
+Bytecode::skip(const OpCode op, const int cond)
+{
+  Instruction inst = {op, -1, cond, -1, -1, 0.0, "", -1, 0};
+  code.push_back(inst);
+  return static_cast<int>(code.size()) - 1;
+}
+
+void
+Bytecode::end_skip(const int skip_index)
+{
+  code[skip_index].count = static_cast<int>(code.size()) - skip_index - 1;
+}
+
+std::vector<int>
+Bytecode::append(const Bytecode &from)
+{
+  const int offset = num_registers;
+  for(const Instruction &from_inst : from.code)
+  {
+    Instruction inst = from_inst;
+    if(inst.dest >= 0) inst.dest += offset;
+    if(inst.a >= 0) inst.a += offset;
+    if(inst.b >= 0) inst.b += offset;
+    if(inst.c >= 0) inst.c += offset;
+    code.push_back(inst);
+  }
+  num_registers += from.num_registers;
+
+  std::vector<int> res;
+  for(const int reg : from.result)
+  {
+    res.push_back(reg + offset);
+  }
+  return res;
+}
+
+bool
+Bytecode::binary_op_code(const std::string &op_str, OpCode &op)
+{
+  if(op_str == "+") op = ADD;
+  else if(op_str == "-") op = SUB;
+  else if(op_str == "*") op = MUL;
+  else if(op_str == "/") op = DIV;
+  else if(op_str == "%") op = MOD;
+  else if(op_str == "<") op = LT;
+  else if(op_str == ">") op = GT;
+  else if(op_str == "<=") op = LE;
+  else if(op_str == ">=") op = GE;
+  else if(op_str == "==") op = EQ;
+  else if(op_str == "!=") op = NE;
+  else if(op_str == "and" || op_str == "&&") op = AND;
+  else if(op_str == "or" || op_str == "||") op = OR;
+  else return false;
+  return true;
+}
+
+bool
+Bytecode::function_op_code(const std::string &name,
+                           const int num_args,
+                           OpCode &op)
+{
+  if(num_args == 1)
+  {
+    if(name == "sin") op = SIN;
+    else if(name == "cos") op = COS;
+    else if(name == "tan") op = TAN;
+    else if(name == "sqrt") op = SQRT;
+    else if(name == "abs") op = ABS;
+    else if(name == "exp") op = EXP;
+    else if(name == "log") op = LOG;
+    else return false;
+    return true;
+  }
+  if(num_args == 2)
+  {
+    if(name == "min") op = MIN;
+    else if(name == "max") op = MAX;
+    else if(name == "pow") op = POW;
+    else return false;
+    return true;
+  }
+  return false;
+}
+
+void
+Bytecode::execute(const conduit::Node &args,
+                  const int entries,
+                  conduit::Node &output) const
+{
+  if(!valid())
+  {
+    ASCENT_ERROR("Bytecode: cannot execute a program without a result.");
+  }
+
+  // resolve loads and scalar arguments once, before the parallel loop
+  const int num_insts = static_cast<int>(code.size());
+  std::vector<detail::LoadSource> sources(num_insts);
+  std::vector<double> scalars(num_insts, 0.0);
+  // keeps converted copies of arrays that aren't float32 or float64
+  std::list<conduit::Node> converted;
+  for(int i = 0; i < num_insts; ++i)
+  {
+    const Instruction &inst = code[i];
+    if(inst.op == CONST)
+    {
+      scalars[i] = inst.value;
+    }
+    else if(inst.op == ARG || inst.op == LOAD)
+    {
+      if(!args.has_child(inst.name))
+      {
+        ASCENT_ERROR("Bytecode: missing argument '" << inst.name << "'");
+      }
+      const conduit::Node &arg = args[inst.name];
+      if(inst.op == ARG)
+      {
+        if(inst.component < 0)
+        {
+          scalars[i] = arg.to_float64();
+        }
+        else if(arg.number_of_children() > 0)
+        {
+          scalars[i] = arg.child(inst.component).to_float64();
+        }
+        else
+        {
+          // vector literals are a single array
+          conduit::Node tmp;
+          arg.to_float64_array(tmp);
+          scalars[i] = tmp.as_float64_ptr()[inst.component];
+        }
+        continue;
+      }
+
+      const conduit::Node *values = &arg;
+      if(inst.component >= 0)
+      {
+        values = &arg.child(inst.component);
+      }
+      else if(arg.number_of_children() > 0)
+      {
+        // single component mcarray
+        values = &arg.child(0);
+      }
+      const conduit::index_t id = values->dtype().id();
+      if(id != conduit::DataType::FLOAT64_ID &&
+         id != conduit::DataType::FLOAT32_ID)
+      {
+        converted.emplace_back();
+        values->to_float64_array(converted.back());
+        values = &converted.back();
+      }
+      if(values->dtype().number_of_elements() < entries)
+      {
+        ASCENT_ERROR("Bytecode: argument '"
+                     << inst.name << "' has "
+                     << values->dtype().number_of_elements()
+                     << " values but " << entries << " are needed.");
+      }
+      sources[i].ptr =
+          static_cast<const unsigned char *>(values->element_ptr(0));
+      sources[i].stride = values->dtype().stride();
+      sources[i].is_float32 =
+          values->dtype().id() == conduit::DataType::FLOAT32_ID;
+    }
+  }
+
+  // float32 outputs are computed in float, like the compiled kernels
+  const int num_components = static_cast<int>(result.size());
+  std::vector<detail::OutputDest> outputs(num_components);
+  bool all_float32 = true;
+  for(int comp = 0; comp < num_components; ++comp)
+  {
+    conduit::Node &out =
+        num_components == 1 ? output : output.child(comp);
+    outputs[comp].ptr = static_cast<unsigned char *>(out.element_ptr(0));
+    outputs[comp].stride = out.dtype().stride();
+    outputs[comp].is_float32 = out.dtype().is_float32();
+    if(!outputs[comp].is_float32 && !out.dtype().is_float64())
+    {
+      ASCENT_ERROR("Bytecode: output must be float32 or float64 not "
+                   << out.dtype().name());
+    }
+    all_float32 = all_float32 && outputs[comp].is_float32;
+  }
+
+  if(all_float32)
+  {
+    detail::run_program<float>(*this, sources, scalars, outputs, entries);
+  }
+  else
+  {
+    detail::run_program<double>(*this, sources, scalars, outputs, entries);
+  }
+}
+
+std::string
+Bytecode::to_string() const
+{
+  std::stringstream ss;
+  ss.precision(17);
+  for(const Instruction &inst : code)
+  {
+    if(inst.dest >= 0)
+    {
+      ss << "r" << inst.dest << " = ";
+    }
+    ss << detail::op_names[inst.op];
+    if(inst.op == LOAD || inst.op == ARG)
+    {
+      ss << " " << inst.name;
+      if(inst.component >= 0)
+      {
+        ss << "[" << inst.component << "]";
+      }
+    }
+    else if(inst.op == CONST)
+    {
+      ss << " " << inst.value;
+    }
+    else if(inst.op == SKIP_NONE || inst.op == SKIP_ALL)
+    {
+      ss << " " << inst.count;
+    }
+    if(inst.a >= 0) ss << " r" << inst.a;
+    if(inst.b >= 0) ss << " r" << inst.b;
+    if(inst.c >= 0) ss << " r" << inst.c;
+    ss << "\n";
+  }
+  ss << "result";
+  for(const int reg : result)
+  {
+    ss << " r" << reg;
+  }
+  ss << "\n";
+  return ss.str();
+}
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
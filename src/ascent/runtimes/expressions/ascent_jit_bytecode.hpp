@@ -0,0 +1,206 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_jit_bytecode.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef ASCENT_JIT_BYTECODE_HPP
+#define ASCENT_JIT_BYTECODE_HPP
+
+#include <conduit.hpp>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+namespace expressions
+{
+
+// A register program that computes the same values as a Kernel's generated
+// code, without compiling anything. Each register holds a block of values so
+// every instruction is a simple loop the compiler can vectorize. Blocks are
+// independent and are split across OpenMP threads.
+//
+// Branches are lazy per block: a branch that no value in the block takes is
+// skipped (see SKIP_NONE and SKIP_ALL), otherwise both branches run and
+// SELECT picks the values.
+//
+// A program is built alongside the kernel code during fusion. Anything the
+// interpreter does not support (e.g. topology attributes, gradients,
+// binnings) leaves the program without a result, and the kernel has to be
+// compiled.
+class Bytecode
+{
+public:
+  enum OpCode
+  {
+    LOAD,   // dest = array args[name] (component)
+    ARG,    // dest = scalar args[name] (component)
+    CONST,  // dest = value
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+    MOD,    // dest = fmod(a, b)
+    LT,
+    GT,
+    LE,
+    GE,
+    EQ,
+    NE,
+    AND,
+    OR,
+    NOT,
+    MIN,
+    MAX,
+    POW,
+    SIN,
+    COS,
+    TAN,
+    SQRT,
+    ABS,
+    EXP,
+    LOG,
+    SELECT, // dest = a ? b : c
+    SKIP_NONE, // skip the next 'count' instructions if no a is true
+    SKIP_ALL   // skip the next 'count' instructions if every a is true
+  };
+
+  struct Instruction
+  {
+    OpCode op;
+    int dest;
+    int a;
+    int b;
+    int c;
+    double value;
+    std::string name;
+    int component;
+    int count;
+  };
+
+  // number of values held by each register
+  static const int block_size = 256;
+
+  Bytecode();
+
+  bool valid() const;
+  void invalidate();
+
+  int load(const std::string &name, const int component = -1);
+  int arg(const std::string &name, const int component = -1);
+  int constant(const double value);
+  int unary(const OpCode op, const int a);
+  int binary(const OpCode op, const int a, const int b);
+  int select(const int cond, const int a, const int b);
+  // adds a skip over the instructions that follow, returns its index so
+  // the count can be set with end_skip once they are added
+  int skip(const OpCode op, const int cond);
+  void end_skip(const int skip_index);
+
+  // copies the instructions of 'from' into this program and returns the
+  // registers holding its result
+  std::vector<int> append(const Bytecode &from);
+
+  // op codes for expression operators and built-in functions,
+  // return false if the interpreter does not support them
+  static bool binary_op_code(const std::string &op_str, OpCode &op);
+  static bool function_op_code(const std::string &name,
+                               const int num_args,
+                               OpCode &op);
+
+  // computes 'entries' values using the arrays and scalars in 'args'.
+  // 'output' holds one float32 or float64 array per result component (a leaf
+  // array when there is a single component). Values are computed in float
+  // when every output is float32, like the compiled kernel, else in double
+  void execute(const conduit::Node &args,
+               const int entries,
+               conduit::Node &output) const;
+
+  std::string to_string() const;
+
+  std::vector<Instruction> code;
+  // registers that hold each component of the result
+  std::vector<int> result;
+  int num_registers;
+};
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
@@ -71,7 +71,122 @@ namespace runtime
 namespace expressions
 {
 
+// The bytecode_* functions lower the same operations as the code generators
+// for the interpreter. They return an invalid program if any input is invalid
+// or the operation isn't supported.
 
+Bytecode
+bytecode_binary_op(const std::string &op_str,
+                   const Bytecode &lhs_bc,
+                   const Bytecode &rhs_bc)
+{
+  Bytecode bc;
+  if(op_str == "not")
+  {
+    if(rhs_bc.valid() && rhs_bc.result.size() == 1)
+    {
+      const std::vector<int> rhs = bc.append(rhs_bc);
+      bc.result = {bc.unary(Bytecode::NOT, rhs[0])};
+    }
+    return bc;
+  }
+
+  Bytecode::OpCode op;
+  if(!lhs_bc.valid() || !rhs_bc.valid() ||
+     !Bytecode::binary_op_code(op_str, op))
+  {
+    return bc;
+  }
+
+  const std::vector<int> lhs = bc.append(lhs_bc);
+  const std::vector<int> rhs = bc.append(rhs_bc);
+  if(lhs.size() == 1 && rhs.size() == 1)
+  {
+    bc.result = {bc.binary(op, lhs[0], rhs[0])};
+  }
+  else if(lhs.size() == rhs.size() &&
+          (op == Bytecode::ADD || op == Bytecode::SUB))
+  {
+    for(size_t i = 0; i < lhs.size(); ++i)
+    {
+      bc.result.push_back(bc.binary(op, lhs[i], rhs[i]));
+    }
+  }
+  else if(lhs.size() == rhs.size() && op == Bytecode::MUL)
+  {
+    // dot product
+    int sum = bc.binary(Bytecode::MUL, lhs[0], rhs[0]);
+    for(size_t i = 1; i < lhs.size(); ++i)
+    {
+      const int prod = bc.binary(Bytecode::MUL, lhs[i], rhs[i]);
+      sum = bc.binary(Bytecode::ADD, sum, prod);
+    }
+    bc.result = {sum};
+  }
+  else
+  {
+    bc.invalidate();
+  }
+  return bc;
+}
+
+Bytecode
+bytecode_function(const std::string &function_name,
+                  const std::vector<const Bytecode *> &args)
+{
+  Bytecode bc;
+  Bytecode::OpCode op;
+  if(!Bytecode::function_op_code(function_name, args.size(), op))
+  {
+    return bc;
+  }
+  std::vector<int> regs;
+  for(const Bytecode *arg : args)
+  {
+    if(!arg->valid() || arg->result.size() != 1)
+    {
+      return Bytecode();
+    }
+    regs.push_back(bc.append(*arg)[0]);
+  }
+  if(regs.size() == 1)
+  {
+    bc.result = {bc.unary(op, regs[0])};
+  }
+  else
+  {
+    bc.result = {bc.binary(op, regs[0], regs[1])};
+  }
+  return bc;
+}
+
+Bytecode
+bytecode_if(const Bytecode &cond_bc,
+            const Bytecode &if_bc,
+            const Bytecode &else_bc)
+{
+  Bytecode bc;
+  if(!cond_bc.valid() || !if_bc.valid() || !else_bc.valid() ||
+     cond_bc.result.size() != 1 ||
+     if_bc.result.size() != else_bc.result.size())
+  {
+    return bc;
+  }
+  // a branch runs for a block if any of its values take it, the
+  // registers of a skipped branch are never selected
+  const int cond = bc.append(cond_bc)[0];
+  const int skip_if = bc.skip(Bytecode::SKIP_NONE, cond);
+  const std::vector<int> if_res = bc.append(if_bc);
+  bc.end_skip(skip_if);
+  const int skip_else = bc.skip(Bytecode::SKIP_ALL, cond);
+  const std::vector<int> else_res = bc.append(else_bc);
+  bc.end_skip(skip_else);
+  for(size_t i = 0; i < if_res.size(); ++i)
+  {
+    bc.result.push_back(bc.select(cond, if_res[i], else_res[i]));
+  }
+  return bc;
+}
 
 JitableFusion::JitableFusion(
     const conduit::Node &params,
@@ -113,6 +228,11 @@ JitableFusion::binary_op()
       {
         out_kernel.expr = "!(" + rhs_expr + ")";
       }
+      else if(op_str == "%")
+      {
+        // fields are promoted to JIT_REAL, so % is a floating point mod
+        out_kernel.expr = "fmod(" + lhs_expr + ", " + rhs_expr + ")";
+      }
       else
       {
         std::string occa_op_str;
@@ -128,7 +248,7 @@ JitableFusion::binary_op()
         {
           occa_op_str = op_str;
         }
-        out_kernel.expr = "(" + lhs_expr + " " + op_str + " " + rhs_expr + ")";
+        out_kernel.expr = "(" + lhs_expr + " " + occa_op_str + " " + rhs_expr + ")";
       }
       out_kernel.num_components = 1;
     }
@@ -138,33 +258,43 @@ JitableFusion::binary_op()
       bool error = false;
       if(lhs_kernel.num_components == rhs_kernel.num_components)
       {
+        const std::string num_comps =
+            std::to_string(lhs_kernel.num_components);
         if(op_str == "+")
         {
+          out_kernel.for_body.insert("JIT_REAL " + filter_name + "[" +
+                                     num_comps + "];\n");
           MathCode().vector_add(out_kernel.for_body,
                                 lhs_expr,
                                 rhs_expr,
                                 filter_name,
-                                lhs_kernel.num_components);
+                                lhs_kernel.num_components,
+                                false);
 
           out_kernel.num_components = lhs_kernel.num_components;
         }
         else if(op_str == "-")
         {
+          out_kernel.for_body.insert("JIT_REAL " + filter_name + "[" +
+                                     num_comps + "];\n");
           MathCode().vector_subtract(out_kernel.for_body,
                                      lhs_expr,
                                      rhs_expr,
                                      filter_name,
-                                     lhs_kernel.num_components);
+                                     lhs_kernel.num_components,
+                                     false);
 
           out_kernel.num_components = lhs_kernel.num_components;
         }
         else if(op_str == "*")
         {
+          out_kernel.for_body.insert("JIT_REAL " + filter_name + " = 0;\n");
           MathCode().dot_product(out_kernel.for_body,
                                  lhs_expr,
                                  rhs_expr,
                                  filter_name,
-                                 lhs_kernel.num_components);
+                                 lhs_kernel.num_components,
+                                 false);
 
           out_kernel.num_components = 1;
         }
@@ -186,6 +316,8 @@ JitableFusion::binary_op()
                      << " components).");
       }
     }
+    out_kernel.bytecode =
+        bytecode_binary_op(op_str, lhs_kernel.bytecode, rhs_kernel.bytecode);
   }
   else
   {
@@ -200,11 +332,13 @@ JitableFusion::builtin_functions(const std::string &function_name)
   if(not_fused)
   {
     out_kernel.expr = function_name + "(";
+    std::vector<const Bytecode *> inp_bytecodes;
     const int num_inputs = inputs.number_of_children();
     for(int i = 0; i < num_inputs; ++i)
     {
       const int port_num = inputs.child(i)["port"].to_int32();
       const Kernel &inp_kernel = *input_kernels[port_num];
+      inp_bytecodes.push_back(&inp_kernel.bytecode);
       if(inp_kernel.num_components > 1)
       {
         ASCENT_ERROR("Built-in function '"
@@ -222,6 +356,7 @@ JitableFusion::builtin_functions(const std::string &function_name)
     }
     out_kernel.expr += ")";
     out_kernel.num_components = 1;
+    out_kernel.bytecode = bytecode_function(function_name, inp_bytecodes);
   }
 }
 
@@ -404,9 +539,21 @@ JitableFusion::expr_dot()
   {
     if(is_xyz(name) && available_component(name, obj_kernel.num_components))
     {
+      const int component = name[0] - 'x';
       out_kernel.expr =
-          obj_kernel.expr + "[" + std::to_string(name[0] - 'x') + "]";
+          obj_kernel.expr + "[" + std::to_string(component) + "]";
       out_kernel.num_components = 1;
+      const Bytecode &obj_bc = obj_kernel.bytecode;
+      if(obj_bc.valid() &&
+         component < static_cast<int>(obj_bc.result.size()))
+      {
+        out_kernel.bytecode = obj_bc;
+        out_kernel.bytecode.result = {obj_bc.result[component]};
+      }
+      else
+      {
+        out_kernel.bytecode.invalidate();
+      }
     }
     else
     {
@@ -422,6 +569,13 @@ JitableFusion::expr_dot()
     topo_attrs(obj, name);
     // for now all topology attributes have one component :)
     out_kernel.num_components = 1;
+    // coordinates and cell measures are always computed in double
+    if(name != "id")
+    {
+      out_kernel.precision = "double";
+    }
+    // topology code is only generated, not interpreted
+    out_kernel.bytecode.invalidate();
   }
   else
   {
@@ -450,6 +604,9 @@ JitableFusion::expr_if()
     out_kernel.kernel_body.insert(condition_kernel.kernel_body);
     out_kernel.kernel_body.insert(if_kernel.kernel_body);
     out_kernel.kernel_body.insert(else_kernel.kernel_body);
+    out_kernel.precision = Kernel::promote_precision(
+        condition_kernel.precision,
+        Kernel::promote_precision(if_kernel.precision, else_kernel.precision));
     const std::string cond_name = filter_name + "_cond";
     const std::string res_name = filter_name + "_res";
 
@@ -458,7 +615,7 @@ JitableFusion::expr_if()
         condition_kernel.generate_output(cond_name, true));
 
     InsertionOrderedSet<std::string> if_else;
-    if_else.insert("double " + res_name + ";\n");
+    if_else.insert("JIT_REAL " + res_name + ";\n");
     if_else.insert("if(" + cond_name + ")\n{\n");
     if_else.insert(if_kernel.for_body.accumulate() +
                    if_kernel.generate_output(res_name, false));
@@ -478,6 +635,9 @@ JitableFusion::expr_if()
                    << " but they must have the same number of components.");
     }
     out_kernel.num_components = if_kernel.num_components;
+    out_kernel.bytecode = bytecode_if(condition_kernel.bytecode,
+                                      if_kernel.bytecode,
+                                      else_kernel.bytecode);
   }
 }
 
@@ -561,6 +721,7 @@ JitableFusion::derived_field()
     out_kernel.fuse_kernel(arg1_kernel);
     out_kernel.expr = arg1_kernel.expr;
     out_kernel.num_components = arg1_kernel.num_components;
+    out_kernel.bytecode = arg1_kernel.bytecode;
   }
 }
 
@@ -674,6 +835,7 @@ JitableFusion::gradient(const int field_port, const int component)
                       (component == -1 ? "" : "_" + std::to_string(component)) +
                       "_gradient";
     out_kernel.num_components = 3;
+    out_kernel.precision = "double";
   }
 }
 
@@ -715,6 +877,7 @@ JitableFusion::curl()
     field_code.curl(out_kernel.for_body);
     out_kernel.expr = field_name + "_curl";
     out_kernel.num_components = field_kernel.num_components;
+    out_kernel.precision = "double";
   }
 }
 
@@ -794,6 +957,7 @@ JitableFusion::recenter()
     field_code.recenter(out_kernel.for_body, target_association, res_name);
     out_kernel.expr = res_name;
     out_kernel.num_components = field_kernel.num_components;
+    out_kernel.precision = "double";
   }
 }
 
@@ -810,12 +974,28 @@ JitableFusion::magnitude()
                    << vector_kernel.num_components << " components.");
     }
     out_kernel.fuse_kernel(vector_kernel);
+    out_kernel.for_body.insert("JIT_REAL " + filter_name + ";\n");
     MathCode().magnitude(out_kernel.for_body,
                          vector_kernel.expr,
                          filter_name,
-                         vector_kernel.num_components);
+                         vector_kernel.num_components,
+                         false);
     out_kernel.expr = filter_name;
     out_kernel.num_components = 1;
+
+    if(vector_kernel.bytecode.valid())
+    {
+      Bytecode &bc = out_kernel.bytecode;
+      bc = Bytecode();
+      const std::vector<int> comps = bc.append(vector_kernel.bytecode);
+      int sum = bc.binary(Bytecode::MUL, comps[0], comps[0]);
+      for(size_t i = 1; i < comps.size(); ++i)
+      {
+        const int square = bc.binary(Bytecode::MUL, comps[i], comps[i]);
+        sum = bc.binary(Bytecode::ADD, sum, square);
+      }
+      bc.result = {bc.unary(Bytecode::SQRT, sum)};
+    }
   }
 }
 
@@ -864,12 +1044,27 @@ JitableFusion::vector()
     const std::string arg1_expr = arg1_kernel.expr;
     const std::string arg2_expr = arg2_kernel.expr;
     const std::string arg3_expr = arg3_kernel.expr;
-    out_kernel.for_body.insert({"double " + filter_name + "[3];\n",
+    out_kernel.for_body.insert({"JIT_REAL " + filter_name + "[3];\n",
                                 filter_name + "[0] = " + arg1_expr + ";\n",
                                 filter_name + "[1] = " + arg2_expr + ";\n",
                                 filter_name + "[2] = " + arg3_expr + ";\n"});
     out_kernel.expr = filter_name;
     out_kernel.num_components = 3;
+
+    const Bytecode *arg_bcs[3] = {&arg1_kernel.bytecode,
+                                  &arg2_kernel.bytecode,
+                                  &arg3_kernel.bytecode};
+    Bytecode &bc = out_kernel.bytecode;
+    bc = Bytecode();
+    for(int i = 0; i < 3; ++i)
+    {
+      if(!arg_bcs[i]->valid())
+      {
+        bc.invalidate();
+        break;
+      }
+      bc.result.push_back(bc.append(*arg_bcs[i])[0]);
+    }
   }
 }
 
@@ -1088,6 +1283,7 @@ JitableFusion::binning_value(const conduit::Node &binning)
                      default_value + ";\n}\n"});
     out_kernel.expr = filter_name;
     out_kernel.num_components = 1;
+    out_kernel.precision = "double";
   }
 }
 
@@ -1117,6 +1313,7 @@ JitableFusion::rand()
     out_kernel.functions.insert(halton);
     out_kernel.expr = "rand(item + " + filter_name + "_seed)";
     out_kernel.num_components = 1;
+    out_kernel.precision = "double";
   }
 }
 
@@ -75,6 +75,21 @@ Kernel::fuse_kernel(const Kernel &from)
   functions.insert(from.functions);
   kernel_body.insert(from.kernel_body);
   for_body.insert(from.for_body);
+  precision = promote_precision(precision, from.precision);
+}
+
+std::string
+Kernel::promote_precision(const std::string &a, const std::string &b)
+{
+  if(a == "double" || b == "double")
+  {
+    return "double";
+  }
+  if(a == "float" || b == "float")
+  {
+    return "float";
+  }
+  return "";
 }
 
 // copy expr into a variable (scalar or vector) "output"
@@ -84,7 +99,7 @@ Kernel::generate_output(const std::string &output, bool declare) const
   std::string res;
   if(declare)
   {
-    res += "double " + output;
+    res += "JIT_REAL " + output;
     if(num_components > 1)
     {
       res += "[" + std::to_string(num_components) + "]";
@@ -114,9 +129,9 @@ Kernel::generate_loop(const std::string &output,
 {
   // clang-format off
   std::string res =
-    "for (int group = 0; group < " + entries_name + "; group += 128; @outer)\n"
+    "for (int group = 0; group < " + entries_name + "; group += JIT_TILE; @outer)\n"
        "{\n"
-         "for (int item = group; item < (group + 128); ++item; @inner)\n"
+         "for (int item = group; item < (group + JIT_TILE); ++item; @inner)\n"
          "{\n"
            "if (item < " + entries_name + ")\n"
            "{\n" +
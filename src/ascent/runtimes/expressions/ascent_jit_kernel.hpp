@@ -52,6 +52,7 @@
 #define ASCENT_JIT_KERNEL_HPP
 
 #include "ascent_jit_array.hpp"
+#include "ascent_jit_bytecode.hpp"
 #include "ascent_insertion_ordered_set.hpp"
 
 //-----------------------------------------------------------------------------
@@ -77,6 +78,10 @@ class Kernel
 public:
   void fuse_kernel(const Kernel &from);
 
+  // the precision needed to compute two fused expressions
+  static std::string promote_precision(const std::string &a,
+                                       const std::string &b);
+
   std::string generate_output(const std::string &output,
                               bool output_exists) const;
 
@@ -91,6 +96,15 @@ public:
   // number of components associated with the expression in expr
   // if the expression is a vector expr will just be the name of a single vector
   int num_components;
+  // "float" if expr only depends on float32 fields, "double" if it depends on
+  // anything that needs double precision (float64 fields, topologies) and
+  // empty if it doesn't depend on any field (e.g. a constant).
+  // Generated code declares values as JIT_REAL and loops over tiles of
+  // JIT_TILE items, both are defined when the whole kernel is generated.
+  std::string precision;
+  // the same expression for the interpreter, only valid if every part of the
+  // expression can be interpreted
+  Bytecode bytecode;
 };
 
 //-----------------------------------------------------------------------------
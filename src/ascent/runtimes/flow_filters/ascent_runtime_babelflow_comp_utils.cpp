@@ -193,8 +193,14 @@ void ImageData::deserialize(BabelFlow::Payload payload)
 
 void ImageData::delBuffers()
 {
-  delete[] zbuf; zbuf = nullptr;
-  delete[] image; image = nullptr;
+  if( !borrowed )
+  {
+    delete[] zbuf;
+    delete[] image;
+  }
+  zbuf = nullptr;
+  image = nullptr;
+  borrowed = false;
   delete[] bounds; bounds = nullptr;
   delete[] rend_bounds; rend_bounds = nullptr;
 }
@@ -579,11 +585,27 @@ BabelGraphWrapper::BabelGraphWrapper(const ImageData& input_img,
 
 void BabelGraphWrapper::Execute()
 {
+  // other graphs may have registered callbacks for the same graph ids
+  // since this one was initialized
+  RegisterCallbacks();
   m_master.run(m_inputs);
 }
 
 //-----------------------------------------------------------------------------
 
+void BabelGraphWrapper::SetInputImage(const ImageData& input_img,
+                                      const std::string& img_name)
+{
+  m_inputImg = input_img;
+  sIMAGE_NAME = img_name;
+
+  // the payloads of the previous run were released by the tasks
+  m_inputs.clear();
+  m_inputs[m_rankId] = m_inputImg.serialize();
+}
+
+//-----------------------------------------------------------------------------
+
 
 //-----------------------------------------------------------------------------
 // -- BabelCompReduce implementation --
@@ -624,10 +646,7 @@ void BabelCompReduce::Initialize()
   m_reduceGraph = BabelFlow::ComposableTaskGraph( gr_vec, gr_connectors );
   m_reduceTaskMap = BabelFlow::ComposableTaskMap( task_maps );
 
-  BabelFlow::TaskGraph::registerCallback( 0, BabelFlow::SingleTaskGraph::SINGLE_TASK_CB, bflow_comp::pre_proc );
-  BabelFlow::TaskGraph::registerCallback( 1, BabelFlow::KWayReduction::LEAF_TASK_CB, bflow_comp::volume_render_red );
-  BabelFlow::TaskGraph::registerCallback( 1, BabelFlow::KWayReduction::MID_TASK_CB, bflow_comp::composite_red );
-  BabelFlow::TaskGraph::registerCallback( 1, BabelFlow::KWayReduction::ROOT_TASK_CB, bflow_comp::write_results_red );
+  RegisterCallbacks();
 
 #ifdef BFLOW_COMP_UTIL_DEBUG
   if( m_rankId == 0 )
@@ -643,6 +662,16 @@ void BabelCompReduce::Initialize()
 
 //-----------------------------------------------------------------------------
 
+void BabelCompReduce::RegisterCallbacks()
+{
+  BabelFlow::TaskGraph::registerCallback( 0, BabelFlow::SingleTaskGraph::SINGLE_TASK_CB, bflow_comp::pre_proc );
+  BabelFlow::TaskGraph::registerCallback( 1, BabelFlow::KWayReduction::LEAF_TASK_CB, bflow_comp::volume_render_red );
+  BabelFlow::TaskGraph::registerCallback( 1, BabelFlow::KWayReduction::MID_TASK_CB, bflow_comp::composite_red );
+  BabelFlow::TaskGraph::registerCallback( 1, BabelFlow::KWayReduction::ROOT_TASK_CB, bflow_comp::write_results_red );
+}
+
+//-----------------------------------------------------------------------------
+
 
 //-----------------------------------------------------------------------------
 // -- BabelVolRenderingBinswap implementation --
@@ -681,10 +710,7 @@ void BabelCompBinswap::Initialize()
   m_binSwapGraph = BabelFlow::ComposableTaskGraph( gr_vec, gr_connectors );
   m_binSwapTaskMap = BabelFlow::ComposableTaskMap( task_maps );
 
-  BabelFlow::TaskGraph::registerCallback( 0, BabelFlow::SingleTaskGraph::SINGLE_TASK_CB, bflow_comp::pre_proc );
-  BabelFlow::TaskGraph::registerCallback( 1, BabelFlow::BinarySwap::LEAF_TASK_CB, bflow_comp::volume_render_binswap );
-  BabelFlow::TaskGraph::registerCallback( 1, BabelFlow::BinarySwap::MID_TASK_CB, bflow_comp::composite_binswap );
-  BabelFlow::TaskGraph::registerCallback( 1, BabelFlow::BinarySwap::ROOT_TASK_CB, bflow_comp::write_results_binswap );
+  RegisterCallbacks();
 
 #ifdef BFLOW_COMP_UTIL_DEBUG
   if( m_rankId == 0 )
@@ -700,6 +726,16 @@ void BabelCompBinswap::Initialize()
 
 //-----------------------------------------------------------------------------
 
+void BabelCompBinswap::RegisterCallbacks()
+{
+  BabelFlow::TaskGraph::registerCallback( 0, BabelFlow::SingleTaskGraph::SINGLE_TASK_CB, bflow_comp::pre_proc );
+  BabelFlow::TaskGraph::registerCallback( 1, BabelFlow::BinarySwap::LEAF_TASK_CB, bflow_comp::volume_render_binswap );
+  BabelFlow::TaskGraph::registerCallback( 1, BabelFlow::BinarySwap::MID_TASK_CB, bflow_comp::composite_binswap );
+  BabelFlow::TaskGraph::registerCallback( 1, BabelFlow::BinarySwap::ROOT_TASK_CB, bflow_comp::write_results_binswap );
+}
+
+//-----------------------------------------------------------------------------
+
 
 //-----------------------------------------------------------------------------
 // -- BabelVolRenderingRadixK implementation --
@@ -760,12 +796,7 @@ void BabelCompRadixK::Initialize()
   m_radGatherGraph = BabelFlow::ComposableTaskGraph( gr_vec, gr_connectors );
   m_radGatherTaskMap = BabelFlow::ComposableTaskMap( task_maps );
 
-  BabelFlow::TaskGraph::registerCallback( 0, BabelFlow::RadixKExchange::LEAF_TASK_CB, bflow_comp::volume_render_radixk );
-  BabelFlow::TaskGraph::registerCallback( 0, BabelFlow::RadixKExchange::MID_TASK_CB, bflow_comp::composite_radixk );
-  BabelFlow::TaskGraph::registerCallback( 0, BabelFlow::RadixKExchange::ROOT_TASK_CB, bflow_comp::composite_radixk );
-  BabelFlow::TaskGraph::registerCallback( 1, BabelFlow::KWayReduction::LEAF_TASK_CB, BabelFlow::relay_message );
-  BabelFlow::TaskGraph::registerCallback( 1, BabelFlow::KWayReduction::MID_TASK_CB, bflow_comp::gather_results_radixk) ;
-  BabelFlow::TaskGraph::registerCallback( 1, BabelFlow::KWayReduction::ROOT_TASK_CB, bflow_comp::write_results_radixk );
+  RegisterCallbacks();
 
 #ifdef BFLOW_COMP_UTIL_DEBUG
   if( m_rankId == 0 )
@@ -784,6 +815,18 @@ void BabelCompRadixK::Initialize()
 
 //-----------------------------------------------------------------------------
 
+void BabelCompRadixK::RegisterCallbacks()
+{
+  BabelFlow::TaskGraph::registerCallback( 0, BabelFlow::RadixKExchange::LEAF_TASK_CB, bflow_comp::volume_render_radixk );
+  BabelFlow::TaskGraph::registerCallback( 0, BabelFlow::RadixKExchange::MID_TASK_CB, bflow_comp::composite_radixk );
+  BabelFlow::TaskGraph::registerCallback( 0, BabelFlow::RadixKExchange::ROOT_TASK_CB, bflow_comp::composite_radixk );
+  BabelFlow::TaskGraph::registerCallback( 1, BabelFlow::KWayReduction::LEAF_TASK_CB, BabelFlow::relay_message );
+  BabelFlow::TaskGraph::registerCallback( 1, BabelFlow::KWayReduction::MID_TASK_CB, bflow_comp::gather_results_radixk) ;
+  BabelFlow::TaskGraph::registerCallback( 1, BabelFlow::KWayReduction::ROOT_TASK_CB, bflow_comp::write_results_radixk );
+}
+
+//-----------------------------------------------------------------------------
+
 
 //-----------------------------------------------------------------------------
 }
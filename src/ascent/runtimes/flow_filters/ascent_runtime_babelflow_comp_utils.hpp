@@ -69,8 +69,9 @@ struct ImageData
   PixelType* zbuf;
   uint32_t* bounds;
   uint32_t* rend_bounds;     // Used only for binswap and k-radix
+  bool borrowed;             // image and zbuf are owned by the caller
   
-  ImageData() : image( nullptr ), zbuf( nullptr ), bounds( nullptr ), rend_bounds( nullptr ) {}
+  ImageData() : image( nullptr ), zbuf( nullptr ), bounds( nullptr ), rend_bounds( nullptr ), borrowed( false ) {}
   
   void writeImage(const char* filename, uint32_t* extent);
   void writeDepth(const char* filename, uint32_t* extent);
@@ -106,7 +107,12 @@ public:
                     MPI_Comm mpi_comm);
   virtual ~BabelGraphWrapper() {}
   virtual void Initialize() = 0;
+  virtual void RegisterCallbacks() = 0;
   virtual void Execute();
+
+  // Replaces the input image, so that an initialized graph can run again
+  // for a new image on the same ranks
+  void SetInputImage(const ImageData& input_img, const std::string& img_name);
   
 protected:
   ImageData m_inputImg;
@@ -133,6 +139,7 @@ public:
                   MPI_Comm mpi_comm);
   virtual ~BabelCompReduce() {}
   virtual void Initialize() override;
+  virtual void RegisterCallbacks() override;
 
 private:
   BabelFlow::SingleTaskGraph m_preProcTaskGr;
@@ -160,6 +167,7 @@ public:
                    MPI_Comm mpi_comm);
   virtual ~BabelCompBinswap() {}
   virtual void Initialize() override;
+  virtual void RegisterCallbacks() override;
 
 private:
   BabelFlow::SingleTaskGraph m_preProcTaskGr;
@@ -191,6 +199,7 @@ public:
   virtual void InitRadixKGraph();
   virtual void InitGatherGraph();
   virtual void Initialize() override;
+  virtual void RegisterCallbacks() override;
   
 protected:
   std::vector<uint32_t> m_Radices;
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <fstream>
 #include <limits>
+#include <memory>
 
 #include <conduit.hpp>
 #include <conduit_relay.hpp>
@@ -36,6 +37,34 @@
 // #define BFLOW_COMP_DEBUG
 
 
+//-----------------------------------------------------------------------------
+// Returns the values as float32, in place when they already are compact
+// float32 and otherwise converted once into 'converted'.
+//-----------------------------------------------------------------------------
+static const float* float32_values(const conduit::Node &values, conduit::Node &converted)
+{
+  if( values.dtype().is_float32() && values.dtype().is_compact() )
+  {
+    return values.as_float32_ptr();
+  }
+
+  values.to_float32_array( converted );
+  return converted.as_float32_ptr();
+}
+
+
+//-----------------------------------------------------------------------------
+// The task graph, task maps and controller only depend on the compositing
+// type, the ranks, the fan-in and the radices, so they are built once and
+// rerun for the image of each cycle until one of those changes.
+//-----------------------------------------------------------------------------
+struct ascent::runtime::filters::BFlowCompose::Cache
+{
+  conduit::Node graph_key;
+  std::unique_ptr<ascent::bflow_comp::BabelGraphWrapper> graph;
+};
+
+
 //-----------------------------------------------------------------------------
 ///
 /// BFlowCompose Filter
@@ -125,29 +154,29 @@ MPI_Comm mpi_comm;
     ASCENT_ERROR("BabelFlow comp extract requires element association in pixel and zbuf fields");
   }
 
-  conduit::Node pixel_vals_node;
-  color_node["values"].to_float32_array( pixel_vals_node );
+  const conduit::Node& pixel_vals = color_node["values"];
+  const conduit::Node& depth_vals = depth_node["values"];
 
-  conduit::Node depth_vals_node;
-  depth_node["values"].to_float32_array( depth_vals_node );
-
-  float* pixel_data = pixel_vals_node.as_float_ptr();
-  float* depth_data = depth_vals_node.as_float_ptr();
-
-  if( pixel_vals_node.dtype().number_of_elements() != img_width*img_height*bflow_comp::ImageData::sNUM_CHANNELS ||
-      depth_vals_node.dtype().number_of_elements() != img_width*img_height )
+  if( pixel_vals.dtype().number_of_elements() != img_width*img_height*bflow_comp::ImageData::sNUM_CHANNELS ||
+      depth_vals.dtype().number_of_elements() != img_width*img_height )
   {
-    std::cerr << "BFlowCompose: pixels_arr num elems = " << pixel_vals_node.dtype().number_of_elements() << std::endl;
-    std::cerr << "BFlowCompose: zbuff_arr num elems = " << depth_vals_node.dtype().number_of_elements() << std::endl;
+    std::cerr << "BFlowCompose: pixels_arr num elems = " << pixel_vals.dtype().number_of_elements() << std::endl;
+    std::cerr << "BFlowCompose: zbuff_arr num elems = " << depth_vals.dtype().number_of_elements() << std::endl;
     ASCENT_ERROR("BabelFlow comp extract pixel array or zbuf array element count problem");
   }
 
+  // The images are only read until they are serialized for the graph, so
+  // float32 fields (e.g. from dray_project_colors_2d) are used in place
+  conduit::Node pixel_vals_node;
+  conduit::Node depth_vals_node;
+  const float* pixel_data = float32_values( pixel_vals, pixel_vals_node );
+  const float* depth_data = float32_values( depth_vals, depth_vals_node );
+
   bflow_comp::ImageData input_img;
 
-  input_img.image = new bflow_comp::ImageData::PixelType[img_width*img_height*bflow_comp::ImageData::sNUM_CHANNELS];
-  input_img.zbuf = new bflow_comp::ImageData::PixelType[img_width*img_height];
-  memcpy( input_img.image, pixel_data, pixel_vals_node.dtype().number_of_elements()*sizeof(bflow_comp::ImageData::PixelType) );
-  memcpy( input_img.zbuf, depth_data, depth_vals_node.dtype().number_of_elements()*sizeof(bflow_comp::ImageData::PixelType) );
+  input_img.image = const_cast<bflow_comp::ImageData::PixelType*>( pixel_data );
+  input_img.zbuf = const_cast<bflow_comp::ImageData::PixelType*>( depth_data );
+  input_img.borrowed = true;
   input_img.bounds = new uint32_t[4];
   input_img.rend_bounds = new uint32_t[4];
   input_img.bounds[0] = input_img.rend_bounds[0] = 0;
@@ -183,56 +212,72 @@ MPI_Comm mpi_comm;
   }
 #endif
 
-  switch (compositing_flag)
+  std::vector<uint32_t> radix_v(1);
+  radix_v[0] = n_ranks;
+  if(compositing_flag == CompositingType::RADIX_K && p.has_path("radices"))
   {
-    case CompositingType::REDUCE:
-      {
-        bflow_comp::BabelCompReduce red_graph(input_img,
-                                              image_name,
-                                              my_rank,
-                                              n_ranks,
-                                              fanin,
-                                              mpi_comm);
-
-        red_graph.Initialize();
-        red_graph.Execute();
-      }
-      break;
-    case CompositingType::BINSWAP:
-      {
-        bflow_comp::BabelCompBinswap binswap_graph(input_img,
-                                                   image_name,
-                                                   my_rank,
-                                                   n_ranks,
-                                                   fanin,
-                                                   mpi_comm);
-        binswap_graph.Initialize();
-        binswap_graph.Execute();
-      }
-      break;
-    case CompositingType::RADIX_K:
-      {
-        std::vector<uint32_t> radix_v(1);
-        radix_v[0] = n_ranks;
-        if(p.has_path("radices"))
-        {
-          conduit::DataArray<int64_t> radices_arr = p["radices"].as_int64_array();
-          radix_v.resize(radices_arr.number_of_elements());
-          for (uint32_t i = 0; i < radix_v.size(); ++i) radix_v[i] = (uint32_t)radices_arr[i];
-        }
-        bflow_comp::BabelCompRadixK radixk_graph(input_img,
-                                                 image_name,
-                                                 my_rank,
-                                                 n_ranks,
-                                                 fanin,
-                                                 mpi_comm,
-                                                 radix_v);
-        radixk_graph.Initialize();
-        radixk_graph.Execute();
-      }
-      break;
+    conduit::DataArray<int64_t> radices_arr = p["radices"].as_int64_array();
+    radix_v.resize(radices_arr.number_of_elements());
+    for (uint32_t i = 0; i < radix_v.size(); ++i) radix_v[i] = (uint32_t)radices_arr[i];
   }
 
+  // every rank sees the same params, so they all agree on a rebuild
+  conduit::Node graph_key;
+  graph_key["compositing"] = (int64_t)compositing_flag;
+  graph_key["n_ranks"] = n_ranks;
+  graph_key["fanin"] = fanin;
+  graph_key["radices"].set(radix_v);
+
+  if(!m_cache)
+  {
+    m_cache = std::make_shared<Cache>();
+  }
+
+  conduit::Node diff_info;
+  if(!m_cache->graph || m_cache->graph_key.diff(graph_key, diff_info))
+  {
+    switch (compositing_flag)
+    {
+      case CompositingType::REDUCE:
+        m_cache->graph.reset(new bflow_comp::BabelCompReduce(input_img,
+                                                             image_name,
+                                                             my_rank,
+                                                             n_ranks,
+                                                             fanin,
+                                                             mpi_comm));
+        break;
+      case CompositingType::BINSWAP:
+        m_cache->graph.reset(new bflow_comp::BabelCompBinswap(input_img,
+                                                              image_name,
+                                                              my_rank,
+                                                              n_ranks,
+                                                              fanin,
+                                                              mpi_comm));
+        break;
+      case CompositingType::RADIX_K:
+        m_cache->graph.reset(new bflow_comp::BabelCompRadixK(input_img,
+                                                             image_name,
+                                                             my_rank,
+                                                             n_ranks,
+                                                             fanin,
+                                                             mpi_comm,
+                                                             radix_v));
+        break;
+      default:
+        input_img.delBuffers();
+        ASCENT_ERROR("BabelFlow comp extract unknown compositing type "
+                     << compositing_flag);
+    }
+    m_cache->graph_key = graph_key;
+    m_cache->graph->Initialize();
+  }
+  else
+  {
+    m_cache->graph->SetInputImage(input_img, image_name);
+  }
+
+  m_cache->graph->Execute();
+
   input_img.delBuffers();
 }
 
@@ -7,6 +7,7 @@
 
 #include <flow_filter.hpp>
 #include <fstream>
+#include <memory>
 #include <sstream>
 
 
@@ -40,6 +41,11 @@ public:
     virtual bool   verify_params(const conduit::Node &params,
                                  conduit::Node &info) override;
     virtual void   execute() override;
+
+private:
+    // communicators and merge tree graph kept across cycles
+    struct Cache;
+    std::shared_ptr<Cache> m_cache;
 };
 
 
@@ -56,6 +62,11 @@ public:
     virtual bool   verify_params(const conduit::Node &params,
                                  conduit::Node &info) override;
     virtual void   execute() override;
+
+private:
+    // compositing graph kept across cycles
+    struct Cache;
+    std::shared_ptr<Cache> m_cache;
 };
 
 
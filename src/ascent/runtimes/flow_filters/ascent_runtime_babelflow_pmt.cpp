@@ -45,6 +45,7 @@
 #include <sstream>
 #include <float.h>
 #include <climits>
+#include <memory>
 
 
 // #define BFLOW_PMT_DEBUG
@@ -60,8 +61,14 @@ public:
 
   void Initialize();
 
+  // Sets the block data of the next Execute(), the graph built by
+  // Initialize() is reused as long as the decomposition is the same
+  void SetInput(FunctionType *data_ptr, FunctionType threshold);
+
   void Execute();
 
+  static void RegisterCallbacks();
+
   void ExtractSegmentation(FunctionType* output_data_ptr);
 
   static int DownSizeGhosts(std::vector<BabelFlow::Payload> &inputs, std::vector<BabelFlow::Payload> &output,
@@ -293,12 +300,7 @@ void ParallelMergeTree::Initialize()
   m_preProcTaskGr.setGraphId( 0 );
   m_kWayMergeGr.setGraphId( 1 );
 
-  BabelFlow::TaskGraph::registerCallback( 0, BabelFlow::SingleTaskGraph::SINGLE_TASK_CB, pre_proc );
-  BabelFlow::TaskGraph::registerCallback( 1, KWayMerge::LOCAL_COMP_CB, local_compute );
-  BabelFlow::TaskGraph::registerCallback( 1, KWayMerge::JOIN_COMP_CB, join );
-  BabelFlow::TaskGraph::registerCallback( 1, KWayMerge::LOCAL_CORR_CB, local_correction );
-  BabelFlow::TaskGraph::registerCallback( 1, KWayMerge::WRITE_RES_CB, write_results );
-  BabelFlow::TaskGraph::registerCallback( 1, KWayMerge::RELAY_CB, BabelFlow::relay_message );
+  RegisterCallbacks();
 
 #ifdef BFLOW_PMT_DEBUG
   if( my_rank == 0 ) 
@@ -325,12 +327,36 @@ void ParallelMergeTree::Initialize()
 #endif
 
   m_master.initialize( m_fullGraph, &m_fullTaskMap, m_comm, &m_cMap );
- 
-  m_inputs[m_taskId] = make_local_block( m_dataPtr, m_low, m_high, m_threshold );
+}
+
+void ParallelMergeTree::RegisterCallbacks()
+{
+  BabelFlow::TaskGraph::registerCallback( 0, BabelFlow::SingleTaskGraph::SINGLE_TASK_CB, pre_proc );
+  BabelFlow::TaskGraph::registerCallback( 1, KWayMerge::LOCAL_COMP_CB, local_compute );
+  BabelFlow::TaskGraph::registerCallback( 1, KWayMerge::JOIN_COMP_CB, join );
+  BabelFlow::TaskGraph::registerCallback( 1, KWayMerge::LOCAL_CORR_CB, local_correction );
+  BabelFlow::TaskGraph::registerCallback( 1, KWayMerge::WRITE_RES_CB, write_results );
+  BabelFlow::TaskGraph::registerCallback( 1, KWayMerge::RELAY_CB, BabelFlow::relay_message );
+}
+
+void ParallelMergeTree::SetInput(FunctionType *data_ptr, FunctionType threshold)
+{
+  m_dataPtr = data_ptr;
+  m_threshold = threshold;
+  sLocalData = data_ptr;
 }
 
 void ParallelMergeTree::Execute() 
 {
+  // the callbacks and merge tree dims are global, another instance may
+  // have changed them since this graph was initialized
+  RegisterCallbacks();
+  MergeTree::setDimension( m_dataSize );
+
+  // the previous input block was released by the pre processing task
+  m_inputs.clear();
+  m_inputs[m_taskId] = make_local_block( m_dataPtr, m_low, m_high, m_threshold );
+
   m_master.run( m_inputs );
 }
 
@@ -405,6 +431,54 @@ ParallelMergeTree::ParallelMergeTree( FunctionType *data_ptr,
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+// Splitting the communicators takes two MPI_Comm_split calls and an
+// allgather of the grid spacings, and building the merge tree graph walks
+// every block. Both stay the same while the decomposition does, so they
+// are kept across cycles.
+//-----------------------------------------------------------------------------
+struct ascent::runtime::filters::BFlowPmt::Cache
+{
+  Cache()
+  : uniform_color(-1), spacing(0), ugrid_select(0), color(0), has_comms(false)
+  {}
+
+  ~Cache()
+  {
+    free_comms();
+  }
+
+  void free_comms()
+  {
+    pmt.reset();
+#ifdef ASCENT_MPI_ENABLED
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if(has_comms && !finalized)
+    {
+      MPI_Comm_free(&comm);
+      MPI_Comm_free(&uniform_comm);
+    }
+#endif
+    has_comms = false;
+  }
+
+  // what the communicators were split for
+  int uniform_color;
+  double spacing;
+  int64_t ugrid_select;
+
+  MPI_Comm uniform_comm;
+  MPI_Comm comm;
+  int color;
+  bool has_comms;
+
+  // the decomposition the merge tree graph was built for
+  conduit::Node graph_key;
+  std::unique_ptr<ParallelMergeTree> pmt;
+};
+
+
 
 //-----------------------------------------------------------------------------
 ///
@@ -500,43 +574,77 @@ void ascent::runtime::filters::BFlowPmt::execute()
   // Decide which uniform grid to work on (default 0, the finest spacing)
   double selected_spacing = 0;
 
-  MPI_Comm uniform_comm;
-  MPI_Comm_split(world_comm, uniform_color, world_rank, &uniform_comm);
-  int uniform_rank, uniform_comm_size;
-  MPI_Comm_rank(uniform_comm, &uniform_rank);
-  MPI_Comm_size(uniform_comm, &uniform_comm_size);
-
-  if(uniform_color){
-    double myspacing = 0;
-    
+  double myspacing = 0;
+  if(uniform_color)
+  {
     // uniform grid should not have spacing as {x,y,z}
     // this is a workaround to support old Ascent dataset using {x,y,z}
     if(data_node.has_path("coordsets/coords/spacing/x"))
       myspacing = data_node["coordsets/coords/spacing/x"].to_float64();
     else if(data_node.has_path("coordsets/coords/spacing/dx"))
       myspacing = data_node["coordsets/coords/spacing/dx"].to_float64();
-    
-    std::vector<double> uniform_spacing(uniform_comm_size);
-    
-    MPI_Allgather(&myspacing, 1, MPI_DOUBLE, uniform_spacing.data(), 1, MPI_DOUBLE, uniform_comm);
-    
-    std::sort(uniform_spacing.begin(), uniform_spacing.end());
-    std::unique(uniform_spacing.begin(), uniform_spacing.end());
-    
-    if(p.has_path("ugrid_select")) 
-      selected_spacing = *std::next(uniform_spacing.begin(), p["ugrid_select"].as_int64());
-    else
-      selected_spacing = *std::next(uniform_spacing.begin(), 0);
-    
-    color = fabs(myspacing - selected_spacing) < EPSILON;
-    
-    //std::cout << "Selected spacing "<< selected_spacing << " rank " << world_rank << " contributing " << color <<"\n";
   }
 
-  MPI_Barrier(uniform_comm);
+  int64_t ugrid_select = 0;
+  if(p.has_path("ugrid_select"))
+    ugrid_select = p["ugrid_select"].as_int64();
 
-  MPI_Comm comm;
-  MPI_Comm_split(uniform_comm, color, uniform_rank, &comm);
+  if(!m_cache)
+  {
+    m_cache = std::make_shared<Cache>();
+  }
+  Cache &cache = *m_cache;
+
+  // only split again when the grids changed on some rank
+  int comms_changed = !cache.has_comms ||
+                      cache.uniform_color != uniform_color ||
+                      cache.spacing != myspacing ||
+                      cache.ugrid_select != ugrid_select;
+#ifdef ASCENT_MPI_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, &comms_changed, 1, MPI_INT, MPI_MAX, world_comm);
+#endif
+
+  if(comms_changed)
+  {
+    cache.free_comms();
+
+    MPI_Comm uniform_comm;
+    MPI_Comm_split(world_comm, uniform_color, world_rank, &uniform_comm);
+    int uniform_rank, uniform_comm_size;
+    MPI_Comm_rank(uniform_comm, &uniform_rank);
+    MPI_Comm_size(uniform_comm, &uniform_comm_size);
+
+    if(uniform_color){
+      std::vector<double> uniform_spacing(uniform_comm_size);
+      
+      MPI_Allgather(&myspacing, 1, MPI_DOUBLE, uniform_spacing.data(), 1, MPI_DOUBLE, uniform_comm);
+      
+      std::sort(uniform_spacing.begin(), uniform_spacing.end());
+      std::unique(uniform_spacing.begin(), uniform_spacing.end());
+      
+      selected_spacing = *std::next(uniform_spacing.begin(), ugrid_select);
+      
+      color = fabs(myspacing - selected_spacing) < EPSILON;
+      
+      //std::cout << "Selected spacing "<< selected_spacing << " rank " << world_rank << " contributing " << color <<"\n";
+    }
+
+    MPI_Barrier(uniform_comm);
+
+    MPI_Comm comm;
+    MPI_Comm_split(uniform_comm, color, uniform_rank, &comm);
+
+    cache.uniform_color = uniform_color;
+    cache.spacing = myspacing;
+    cache.ugrid_select = ugrid_select;
+    cache.uniform_comm = uniform_comm;
+    cache.comm = comm;
+    cache.color = color;
+    cache.has_comms = true;
+  }
+
+  color = cache.color;
+  MPI_Comm comm = cache.comm;
 
   int rank, comm_size;
   MPI_Comm_rank(comm, &rank);
@@ -675,18 +783,42 @@ void ascent::runtime::filters::BFlowPmt::execute()
     FunctionType threshold = p["threshold"].as_float64();
     int64_t gen_field = p["gen_segment"].as_int64();
 
-    // create ParallelMergeTree instance and run
-    ParallelMergeTree pmt(array, 
-                          task_id,
-                          data_size,
-                          n_blocks,
-                          low, high,
-                          fanin, threshold, comm);
-
     ParallelMergeTree::s_data_size[0] = data_size[0];
     ParallelMergeTree::s_data_size[1] = data_size[1];
     ParallelMergeTree::s_data_size[2] = data_size[2];
 
+    // rebuild the merge tree graph when the decomposition or fan-in
+    // changed on any rank
+    conduit::Node graph_key;
+    graph_key["data_size"].set(data_size, 3);
+    graph_key["n_blocks"].set(n_blocks, 3);
+    graph_key["low"].set(low, 3);
+    graph_key["high"].set(high, 3);
+    graph_key["fanin"] = fanin;
+
+    conduit::Node diff_info;
+    int graph_changed = !cache.pmt || cache.graph_key.diff(graph_key, diff_info);
+#ifdef ASCENT_MPI_ENABLED
+    MPI_Allreduce(MPI_IN_PLACE, &graph_changed, 1, MPI_INT, MPI_MAX, comm);
+#endif
+
+    bool initialize = false;
+    if(graph_changed)
+    {
+      // create ParallelMergeTree instance
+      cache.pmt.reset(new ParallelMergeTree(array, 
+                                            task_id,
+                                            data_size,
+                                            n_blocks,
+                                            low, high,
+                                            fanin, threshold, comm));
+      cache.graph_key = graph_key;
+      initialize = true;
+    }
+
+    ParallelMergeTree &pmt = *cache.pmt;
+    pmt.SetInput(array, threshold);
+
 #ifdef BFLOW_PMT_DEBUG
     // Reduce all of the local sums into the global sum
     {
@@ -721,7 +853,10 @@ void ascent::runtime::filters::BFlowPmt::execute()
     //std::cout<<"----------------------"<<std::endl;
 #endif
     
-    pmt.Initialize();
+    if(initialize)
+    {
+      pmt.Initialize();
+    }
     pmt.Execute();
 
     MPI_Barrier(comm);
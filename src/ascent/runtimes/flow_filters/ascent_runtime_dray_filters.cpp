@@ -1183,6 +1183,7 @@ DRayPseudocolor::declare_interface(Node &i)
     i["type_name"]   = "dray_pseudocolor";
     i["port_names"].append() = "in";
     i["output_port"] = "false";
+    i["fields/reads"].append() = "field";
 }
 
 //-----------------------------------------------------------------------------
@@ -1368,6 +1369,7 @@ DRay3Slice::declare_interface(Node &i)
     i["type_name"]   = "dray_3slice";
     i["port_names"].append() = "in";
     i["output_port"] = "false";
+    i["fields/reads"].append() = "field";
 }
 
 //-----------------------------------------------------------------------------
@@ -1763,6 +1765,7 @@ DRayVolume::declare_interface(Node &i)
     i["type_name"]   = "dray_volume";
     i["port_names"].append() = "in";
     i["output_port"] = "false";
+    i["fields/reads"].append() = "field";
 }
 
 //-----------------------------------------------------------------------------
@@ -1977,6 +1980,7 @@ DRayReflect::declare_interface(Node &i)
     i["type_name"]   = "dray_reflect";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"] = DataType::list();
 }
 
 //-----------------------------------------------------------------------------
@@ -2091,6 +2095,15 @@ DRayProject2d::declare_interface(Node &i)
     i["output_port"] = "true";
 }
 
+//-----------------------------------------------------------------------------
+bool
+DRayProject2d::declare_fields(std::set<std::string> &reads,
+                             std::set<std::string> &produces)
+{
+    // without a field list every field is used
+    return declare_field_list(params(), reads);
+}
+
 //-----------------------------------------------------------------------------
 bool
 DRayProject2d::verify_params(const conduit::Node &params,
@@ -2277,6 +2290,7 @@ DRayProjectColors2d::declare_interface(Node &i)
     i["type_name"]   = "dray_project_colors_2d";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
 }
 
 //-----------------------------------------------------------------------------
@@ -2420,6 +2434,8 @@ DRayVectorComponent::declare_interface(Node &i)
     i["type_name"]   = "dray_vector_component";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
+    i["fields/produces"].append() = "output_name";
 }
 
 //-----------------------------------------------------------------------------
@@ -53,6 +53,8 @@
 
 #include "ascent_hola_mpi.hpp"
 
+#include <sstream>
+
 //-----------------------------------------------------------------------------
 // thirdparty includes
 //-----------------------------------------------------------------------------
@@ -136,6 +138,17 @@ HolaMPIExtract::verify_params(const conduit::Node &params,
         info["errors"].append() = "Missing required integer parameter 'rank_split'";
     }
 
+    if(params.has_child("staging"))
+    {
+        if(!params["staging"].dtype().is_string() ||
+           (params["staging"].as_string() != "sync" &&
+            params["staging"].as_string() != "async"))
+        {
+            info["errors"].append() = "Optional parameter 'staging' must be 'sync' or 'async'";
+            res = false;
+        }
+    }
+
     return res;
 }
 
@@ -156,6 +169,28 @@ HolaMPIExtract::execute()
 
     hola_mpi(params(),*n_input);
 
+    // the runtime closes the stages its extracts used
+    if(params().has_child("staging") &&
+       params()["staging"].as_string() == "async")
+    {
+        if(!graph().workspace().registry().has_entry("hola_mpi_staging"))
+        {
+          conduit::Node *staging = new conduit::Node();
+          graph().workspace().registry().add<Node>("hola_mpi_staging",
+                                                   staging,
+                                                   -1);
+        }
+
+        conduit::Node *staging = graph().workspace().registry().fetch<Node>("hola_mpi_staging");
+
+        std::ostringstream oss;
+        oss << params()["mpi_comm"].to_int() << "_"
+            << params()["rank_split"].to_int();
+        Node &stage = (*staging)[oss.str()];
+        stage["mpi_comm"] = params()["mpi_comm"].to_int();
+        stage["rank_split"] = params()["rank_split"].to_int();
+    }
+
 }
 
 
@@ -300,6 +300,78 @@ float conduit_cast<float>(const conduit::Node &node)
   return node.to_float32();
 }
 
+namespace detail
+{
+
+double eval_scalar_expression(expressions::ExpressionEval &eval,
+                              const std::string &expr)
+{
+  conduit::Node res = eval.evaluate(expr);
+
+  if(!res.has_path("value"))
+  {
+    ASCENT_ERROR("expression '"<<expr
+                 <<"': failed to extract a value from the result."
+                 <<" '"<<res.to_yaml()<<"'");
+  }
+
+  if(res["value"].dtype().number_of_elements() != 1)
+  {
+    ASCENT_ERROR("expression '"<<expr
+                 <<"' resulted in multiple values."
+                 <<" Expected scalar. '"<<res.to_yaml()<<"'");
+  }
+  return res["value"].to_float64();
+}
+
+} // namespace detail
+
+void eval_param_expressions(const conduit::Node &params,
+                            const std::vector<std::string> &paths,
+                            DataObject *dataset)
+{
+  if(dataset == nullptr)
+  {
+    return;
+  }
+
+  std::vector<std::string> exprs;
+  for(const std::string &path : paths)
+  {
+    if(!params.has_path(path) || !params[path].dtype().is_string())
+    {
+      continue;
+    }
+    const std::string expr = params[path].as_string();
+    if(!dataset->has_param_value(expr) &&
+       std::find(exprs.begin(), exprs.end(), expr) == exprs.end())
+    {
+      exprs.push_back(expr);
+    }
+  }
+
+  if(exprs.size() == 0)
+  {
+    return;
+  }
+
+  // a single evaluator for all the parameters so any conversion
+  // of the data set happens at most once
+  expressions::ExpressionEval eval(*dataset);
+  std::vector<double> values;
+  for(const std::string &expr : exprs)
+  {
+    values.push_back(detail::eval_scalar_expression(eval, expr));
+  }
+
+  // keep any conversions the evaluator needed
+  *dataset = eval.data_object();
+  for(size_t i = 0; i < exprs.size(); ++i)
+  {
+    dataset->param_value(exprs[i], values[i]);
+  }
+}
+
 template<typename T>
 T get_value(const conduit::Node &node, DataObject *dataset)
 {
@@ -322,26 +394,20 @@ T get_value(const conduit::Node &node, DataObject *dataset)
                    <<node.to_string()<<"'");
 
     }
-    // TODO: we want to zero copy this
-    conduit::Node * bp_dset = dataset->as_low_order_bp().get();
-    expressions::ExpressionEval eval(bp_dset);
     std::string expr = node.as_string();
-    conduit::Node res = eval.evaluate(expr);
-
-    if(!res.has_path("value"))
-    {
-      ASCENT_ERROR("expression '"<<expr
-                   <<"': failed to extract a value from the result."
-                   <<" '"<<res.to_yaml()<<"'");
-    }
-
-    if(res["value"].dtype().number_of_elements() != 1)
+    // results are memoized on the data object, which lives
+    // for a single cycle
+    if(!dataset->has_param_value(expr))
     {
-      ASCENT_ERROR("expression '"<<expr
-                   <<"' resulted in multiple values."
-                   <<" Expected scalar. '"<<res.to_yaml()<<"'");
+      // the evaluator works directly on the data object, so
+      // data is only converted if the expression needs it
+      expressions::ExpressionEval eval(*dataset);
+      double res = detail::eval_scalar_expression(eval, expr);
+      // keep any conversions the evaluator needed
+      *dataset = eval.data_object();
+      dataset->param_value(expr, res);
     }
-    value = res["value"].to_float64();
+    value = dataset->param_value(expr);
   }
   else
   {
@@ -108,6 +108,13 @@ std::string ASCENT_API surprise_check(const std::vector<std::string> &valid_path
                                       const std::vector<std::string> &ignore_paths,
                                       const conduit::Node &node);
 
+// evaluates the expression parameters found at 'paths' with a single
+// evaluator. Results are memoized on the data object so following
+// calls to get_float64, etc, are lookups
+void ASCENT_API eval_param_expressions(const conduit::Node &params,
+                                       const std::vector<std::string> &paths,
+                                       DataObject *dataset);
+
 // evalute expression or return value
 double ASCENT_API get_float64(const conduit::Node &node, DataObject *dataset);
 float ASCENT_API get_float32(const conduit::Node &node, DataObject *dataset);
@@ -66,6 +66,7 @@
 #include <ascent_logging.hpp>
 #include <ascent_data_object.hpp>
 #include <ascent_runtime_param_check.hpp>
+#include <ascent_actions_utils.hpp>
 
 #include <flow_graph.hpp>
 #include <flow_workspace.hpp>
@@ -121,6 +122,16 @@ BasicQuery::declare_interface(Node &i)
     i["output_port"] = "true";
 }
 
+//-----------------------------------------------------------------------------
+bool
+BasicQuery::declare_fields(std::set<std::string> &reads,
+                          std::set<std::string> &produces)
+{
+    // the fields referenced by the expression
+    Node info;
+    return field_list(params(), reads, info);
+}
+
 //-----------------------------------------------------------------------------
 bool
 BasicQuery::verify_params(const conduit::Node &params,
@@ -162,6 +173,10 @@ BasicQuery::execute()
 
     // The mere act of a query stores the results
     runtime::expressions::ExpressionEval eval(*data_object);
+    if(graph().workspace().registry().has_entry("save_expression_graphs"))
+    {
+      eval.save_graphs(true);
+    }
     conduit::Node res = eval.evaluate(expression, name);
 
     // we never actually use the output port
@@ -192,6 +207,22 @@ FilterQuery::declare_interface(Node &i)
     i["output_port"] = "true";
 }
 
+//-----------------------------------------------------------------------------
+bool
+FilterQuery::declare_fields(std::set<std::string> &reads,
+                           std::set<std::string> &produces)
+{
+    // the fields referenced by the expression, derived fields
+    // are added to the data under the query name
+    Node info;
+    bool res = field_list(params(), reads, info);
+    if(params().has_path("name"))
+    {
+      produces.insert(params()["name"].as_string());
+    }
+    return res;
+}
+
 //-----------------------------------------------------------------------------
 bool
 FilterQuery::verify_params(const conduit::Node &params,
@@ -229,6 +260,10 @@ FilterQuery::execute()
     // The mere act of a query stores the results
     //runtime::expressions::ExpressionEval eval(n_input.get());
     runtime::expressions::ExpressionEval eval(*data_object);
+    if(graph().workspace().registry().has_entry("save_expression_graphs"))
+    {
+      eval.save_graphs(true);
+    }
     conduit::Node res = eval.evaluate(expression, name);
 
     // if the end result is a derived field the for sure we want to make
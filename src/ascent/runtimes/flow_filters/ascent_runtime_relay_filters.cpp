@@ -67,6 +67,7 @@
 #include <ascent_logging.hpp>
 #include <ascent_metadata.hpp>
 #include <ascent_file_system.hpp>
+#include <ascent_field_codec.hpp>
 #include <ascent_mpi_utils.hpp>
 #include <ascent_runtime_utils.hpp>
 #include <ascent_runtime_param_check.hpp>
@@ -543,13 +544,27 @@ verify_io_params(const conduit::Node &params,
         }
     }
 
+    if( params.has_child("compression") )
+    {
+        if(!field_codec::verify_options(params["compression"], info))
+        {
+            res = false;
+        }
+        else
+        {
+            info["info"].append() = "includes 'compression'";
+        }
+    }
+
     std::vector<std::string> valid_paths;
     std::vector<std::string> ignore_paths;
     valid_paths.push_back("path");
     valid_paths.push_back("protocol");
     valid_paths.push_back("fields");
     valid_paths.push_back("num_files");
+    valid_paths.push_back("compression");
     ignore_paths.push_back("fields");
+    ignore_paths.push_back("compression");
 
     std::string surprises = surprise_check(valid_paths, ignore_paths, params);
 
@@ -609,7 +624,8 @@ void mesh_blueprint_save(const Node &data,
                          const std::string &path,
                          const std::string &file_protocol,
                          int num_files,
-                         std::string &root_file_out)
+                         std::string &root_file_out,
+                         const Node &compression)
 {
     // The assumption here is that everything is multi domain
 
@@ -759,12 +775,23 @@ void mesh_blueprint_save(const Node &data,
         ASCENT_ERROR("Error: failed to create directory " << output_dir);
     }
 
+    // compress field values before writing, domains are encoded
+    // in parallel. The index is generated from the original data.
+    const bool compress = !compression.dtype().is_empty();
+    Node encoded_doms;
+    Node *out_doms = &multi_dom;
+    if(compress)
+    {
+        field_codec::encode_domains(multi_dom, compression, encoded_doms);
+        out_doms = &encoded_doms;
+    }
+
     if(global_num_domains == num_files)
     {
         // write out each domain
         for(int i = 0; i < local_num_domains; ++i)
         {
-            const Node &dom = multi_dom.child(i);
+            const Node &dom = out_doms->child(i);
             uint64 domain = dom["state/domain_id"].to_uint64();
 
             snprintf(fmt_buff, sizeof(fmt_buff), "%06llu",domain);
@@ -872,7 +899,7 @@ void mesh_blueprint_save(const Node &data,
                             // now is the time to write!
                             // pattern is:
                             //  file_%06llu.{protocol}:/domain_%06llu/...
-                            const Node &dom = multi_dom.child(d);
+                            const Node &dom = out_doms->child(d);
                             uint64 domain_id = dom["state/domain_id"].to_uint64();
                             // construct file name
                             snprintf(fmt_buff, sizeof(fmt_buff), "%06d",f);
@@ -990,6 +1017,54 @@ void mesh_blueprint_save(const Node &data,
                                        bp_idx["mesh"]);
 #endif
 
+    if(compress && bp_idx.has_path("mesh/fields"))
+    {
+        // record how each field was stored (quantize falls back to
+        // lossless for values it can't quantize), readers decode
+        // any values that carry codec info
+        Node &fields_idx = bp_idx["mesh/fields"];
+        const int num_fields = fields_idx.number_of_children();
+        std::vector<int> modes(num_fields, 0);
+        for(int i = 0; i < num_fields; ++i)
+        {
+            modes[i] = field_codec::applied_modes(encoded_doms,
+                                                  fields_idx.child(i).name());
+        }
+#ifdef ASCENT_MPI_ENABLED
+        // the index is the same on all ranks, so are its fields
+        if(num_fields > 0)
+        {
+            MPI_Allreduce(MPI_IN_PLACE,
+                          &modes[0],
+                          num_fields,
+                          MPI_INT,
+                          MPI_BOR,
+                          mpi_comm);
+        }
+#endif
+        for(int i = 0; i < num_fields; ++i)
+        {
+            Node &field_idx = fields_idx.child(i);
+            if(modes[i] == 0)
+            {
+                continue;
+            }
+
+            Node &f_comp = field_idx["compression"];
+            field_codec::field_options(compression, field_idx.name(), f_comp);
+            if(modes[i] == field_codec::applied_lossless)
+            {
+                f_comp["mode"] = "lossless";
+                f_comp.remove("error_bound");
+            }
+            else if(modes[i] != field_codec::applied_quantize)
+            {
+                // some domains fell back to lossless
+                f_comp["mode"] = "mixed";
+            }
+        }
+    }
+
     // let selected rank write out the root file
     if(par_rank == root_file_writer)
     {
@@ -1069,6 +1144,15 @@ RelayIOSave::declare_interface(Node &i)
     i["output_port"] = "false";
 }
 
+//-----------------------------------------------------------------------------
+bool
+RelayIOSave::declare_fields(std::set<std::string> &reads,
+                           std::set<std::string> &produces)
+{
+    // without a field list every field is used
+    return declare_field_list(params(), reads);
+}
+
 //-----------------------------------------------------------------------------
 bool
 RelayIOSave::verify_params(const conduit::Node &params,
@@ -1102,9 +1186,7 @@ RelayIOSave::execute()
     {
       return;
     }
-    std::shared_ptr<Node> n_input = data_object->as_node();
-
-    Node *in = n_input.get();
+    std::shared_ptr<Node> n_input;
 
     Node selected;
     conduit::Node test;
@@ -1126,12 +1208,22 @@ RelayIOSave::execute()
         }
         field_selection.push_back(f.as_string());
       }
-      detail::filter_fields(*in, selected, field_selection, graph());
+      if(data_object->source() == DataObject::Source::VTKH)
+      {
+        // only convert what we are going to save
+        n_input = data_object->as_fields_bp(field_selection);
+      }
+      else
+      {
+        n_input = data_object->as_node();
+      }
+      detail::filter_fields(*n_input, selected, field_selection, graph());
     }
     else
     {
       // select all fields
-      selected.set_external(*in);
+      n_input = data_object->as_node();
+      selected.set_external(*n_input);
     }
 
     Node meta = Metadata::n_metadata;
@@ -1162,6 +1254,24 @@ RelayIOSave::execute()
         num_files = params()["num_files"].to_int();
     }
 
+    Node compression;
+    if(params().has_path("compression"))
+    {
+        compression.set_external(params()["compression"]);
+    }
+
+    bool blueprint_protocol = protocol == "blueprint/mesh/hdf5" ||
+                              protocol == "blueprint/mesh/json" ||
+                              protocol == "blueprint/mesh/yaml" ||
+                              protocol == "hdf5" ||
+                              protocol == "json" ||
+                              protocol == "yaml";
+    if(!compression.dtype().is_empty() && !blueprint_protocol)
+    {
+        ASCENT_WARN("relay_io_save: 'compression' is only supported by "
+                    "blueprint protocols (hdf5, json, yaml). Ignoring.");
+    }
+
     std::string result_path;
     if(protocol.empty())
     {
@@ -1174,7 +1284,8 @@ RelayIOSave::execute()
                             path,
                             "hdf5",
                             num_files,
-                            result_path);
+                            result_path,
+                            compression);
     }
     else if( protocol == "blueprint/mesh/json" || protocol == "json")
     {
@@ -1182,7 +1293,8 @@ RelayIOSave::execute()
                             path,
                             "json",
                             num_files,
-                            result_path);
+                            result_path,
+                            compression);
 
     }
     else if( protocol == "blueprint/mesh/yaml" || protocol == "yaml")
@@ -1191,7 +1303,8 @@ RelayIOSave::execute()
                             path,
                             "yaml",
                             num_files,
-                            result_path);
+                            result_path,
+                            compression);
 
     }
     else
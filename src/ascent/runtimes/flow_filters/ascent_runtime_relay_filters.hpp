@@ -81,11 +81,13 @@ namespace filters
 ///
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
-void mesh_blueprint_save(const conduit::Node &data,
-                         const std::string &path,
-                         const std::string &file_protocol,
-                         int num_files,
-                         std::string &root_file_out);
+void ASCENT_API mesh_blueprint_save(const conduit::Node &data,
+                                    const std::string &path,
+                                    const std::string &file_protocol,
+                                    int num_files,
+                                    std::string &root_file_out,
+                                    const conduit::Node &compression
+                                        = conduit::Node());
 
 class ASCENT_API RelayIOSave : public ::flow::Filter
 {
@@ -96,6 +98,8 @@ public:
     virtual void   declare_interface(conduit::Node &i);
     virtual bool   verify_params(const conduit::Node &params,
                                  conduit::Node &info);
+    virtual bool   declare_fields(std::set<std::string> &reads,
+                                  std::set<std::string> &produces);
     virtual void   execute();
 };
 
@@ -876,6 +876,7 @@ DefaultRender::declare_interface(Node &i)
     i["type_name"] = "default_render";
     i["port_names"].append() = "a";
     i["output_port"] = "true";
+    i["fields/reads"] = DataType::list();
 }
 
 //-----------------------------------------------------------------------------
@@ -1155,6 +1156,7 @@ VTKHBounds::declare_interface(Node &i)
     i["type_name"] = "vtkh_bounds";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"] = DataType::list();
 }
 
 
@@ -1203,6 +1205,7 @@ VTKHUnionBounds::declare_interface(Node &i)
     i["port_names"].append() = "a";
     i["port_names"].append() = "b";
     i["output_port"] = "true";
+    i["fields/reads"] = DataType::list();
 }
 
 
@@ -1251,6 +1254,7 @@ AddPlot::declare_interface(Node &i)
     i["port_names"].append() = "scene";
     i["port_names"].append() = "plot";
     i["output_port"] = "true";
+    i["fields/reads"] = DataType::list();
 }
 
 //-----------------------------------------------------------------------------
@@ -1300,6 +1304,7 @@ CreatePlot::declare_interface(Node &i)
     i["type_name"] = "create_plot";
     i["port_names"].append() = "a";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
 }
 
 
@@ -1577,6 +1582,7 @@ CreateScene::declare_interface(Node &i)
     i["type_name"]   = "create_scene";
     i["output_port"] = "true";
     i["port_names"] = DataType::empty();
+    i["fields/reads"] = DataType::list();
 }
 
 //-----------------------------------------------------------------------------
@@ -1608,6 +1614,7 @@ ExecScene::declare_interface(conduit::Node &i)
     i["port_names"].append() = "scene";
     i["port_names"].append() = "renders";
     i["output_port"] = "false";
+    i["fields/reads"] = DataType::list();
 }
 
 //-----------------------------------------------------------------------------
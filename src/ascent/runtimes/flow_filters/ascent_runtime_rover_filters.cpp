@@ -136,6 +136,8 @@ RoverXRay::declare_interface(Node &i)
     i["type_name"]   = "xray";
     i["port_names"].append() = "in";
     i["output_port"] = "false";
+    i["fields/reads"].append() = "absorption";
+    i["fields/reads"].append() = "emission";
 }
 
 //-----------------------------------------------------------------------------
@@ -393,6 +395,7 @@ RoverVolume::declare_interface(Node &i)
     i["type_name"]   = "rover_volume";
     i["port_names"].append() = "in";
     i["output_port"] = "false";
+    i["fields/reads"].append() = "field";
 }
 
 //-----------------------------------------------------------------------------
@@ -66,6 +66,7 @@
 #include <ascent_data_object.hpp>
 #include <ascent_logging.hpp>
 #include <ascent_runtime_param_check.hpp>
+#include <ascent_actions_utils.hpp>
 
 #include <flow_graph.hpp>
 #include <flow_workspace.hpp>
@@ -116,6 +117,29 @@ BasicTrigger::declare_interface(Node &i)
     i["output_port"] = "false";
 }
 
+//-----------------------------------------------------------------------------
+bool
+BasicTrigger::declare_fields(std::set<std::string> &reads,
+                            std::set<std::string> &produces)
+{
+    // actions files are only read when the trigger fires
+    if(!params().has_path("actions"))
+    {
+      return false;
+    }
+
+    // the fields used by the trigger actions and the condition
+    Node info;
+    bool res = field_list(params()["actions"], reads, info);
+
+    Node condition;
+    condition["expression"] = params()["condition"];
+    std::set<std::string> condition_fields;
+    res &= field_list(condition, condition_fields, info);
+    reads.insert(condition_fields.begin(), condition_fields.end());
+    return res;
+}
+
 //-----------------------------------------------------------------------------
 bool
 BasicTrigger::verify_params(const conduit::Node &params,
@@ -204,6 +228,10 @@ BasicTrigger::execute()
 
 
     runtime::expressions::ExpressionEval eval(n_input.get());
+    if(graph().workspace().registry().has_entry("save_expression_graphs"))
+    {
+      eval.save_graphs(true);
+    }
     conduit::Node res = eval.evaluate(expression);
 
     if(res["type"].as_string() != "bool")
@@ -117,6 +117,26 @@ std::string filter_to_path(const std::string filter_name)
   }
   return res;
 }
+
+bool declare_field_list(const conduit::Node &params,
+                        std::set<std::string> &fields)
+{
+  if(!params.has_path("fields"))
+  {
+    return false;
+  }
+
+  const conduit::Node &flist = params["fields"];
+  const int num_fields = flist.number_of_children();
+  for(int i = 0; i < num_fields; ++i)
+  {
+    if(flist.child(i).dtype().is_string())
+    {
+      fields.insert(flist.child(i).as_string());
+    }
+  }
+  return true;
+}
 //-----------------------------------------------------------------------------
 };
 //-----------------------------------------------------------------------------
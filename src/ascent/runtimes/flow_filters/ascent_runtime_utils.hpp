@@ -54,6 +54,7 @@
 
 #include <conduit.hpp>
 #include <ascent_exports.h>
+#include <set>
 #include <string>
 
 //-----------------------------------------------------------------------------
@@ -85,6 +86,11 @@ std::string ASCENT_API default_dir();
 
 std::string ASCENT_API filter_to_path(const std::string filter_name);
 
+// for filters that use all fields unless given a 'fields' list.
+// returns false when there is no list
+bool ASCENT_API declare_field_list(const conduit::Node &params,
+                                   std::set<std::string> &fields);
+
 //-----------------------------------------------------------------------------
 };
 //-----------------------------------------------------------------------------
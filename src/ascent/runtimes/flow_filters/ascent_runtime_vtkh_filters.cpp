@@ -163,6 +163,7 @@ VTKHMarchingCubes::declare_interface(Node &i)
     i["type_name"]   = "vtkh_marchingcubes";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
 }
 
 //-----------------------------------------------------------------------------
@@ -294,6 +295,8 @@ VTKHVectorMagnitude::declare_interface(Node &i)
     i["type_name"]   = "vtkh_vector_magnitude";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
+    i["fields/produces"].append() = "output_name";
 }
 
 //-----------------------------------------------------------------------------
@@ -398,6 +401,7 @@ VTKH3Slice::declare_interface(Node &i)
     i["type_name"]   = "vtkh_3slice";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"] = DataType::list();
 }
 
 //-----------------------------------------------------------------------------
@@ -550,6 +554,7 @@ VTKHTriangulate::declare_interface(Node &i)
     i["type_name"]   = "vtkh_triangulate";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"] = DataType::list();
 }
 
 //-----------------------------------------------------------------------------
@@ -645,6 +650,7 @@ VTKHCleanGrid::declare_interface(Node &i)
     i["type_name"]   = "vtkh_clean";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"] = DataType::list();
 }
 
 //-----------------------------------------------------------------------------
@@ -743,6 +749,7 @@ VTKHSlice::declare_interface(Node &i)
     i["type_name"]   = "vtkh_slice";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"] = DataType::list();
 }
 
 //-----------------------------------------------------------------------------
@@ -924,6 +931,7 @@ VTKHGhostStripper::declare_interface(Node &i)
     i["type_name"]   = "vtkh_ghost_stripper";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
 }
 
 //-----------------------------------------------------------------------------
@@ -1037,6 +1045,7 @@ VTKHThreshold::declare_interface(Node &i)
     i["type_name"]   = "vtkh_threshold";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
 }
 
 //-----------------------------------------------------------------------------
@@ -1147,6 +1156,7 @@ VTKHClip::declare_interface(Node &i)
     i["type_name"] = "vtkh_clip";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"] = DataType::list();
 }
 
 //-----------------------------------------------------------------------------
@@ -1412,6 +1422,7 @@ VTKHClipWithField::declare_interface(Node &i)
     i["type_name"] = "vtkh_clip_with_field";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
 }
 
 //-----------------------------------------------------------------------------
@@ -1524,6 +1535,7 @@ VTKHIsoVolume::declare_interface(Node &i)
     i["type_name"] = "vtkh_iso_volume";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
 }
 
 //-----------------------------------------------------------------------------
@@ -1630,6 +1642,7 @@ VTKHLagrangian::declare_interface(Node &i)
     i["type_name"]   = "vtkh_lagrangian";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
 }
 
 //-----------------------------------------------------------------------------
@@ -1752,6 +1765,8 @@ VTKHLog::declare_interface(Node &i)
     i["type_name"]   = "vtkh_log";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
+    i["fields/produces"].append() = "output_name";
 }
 
 //-----------------------------------------------------------------------------
@@ -1863,6 +1878,7 @@ VTKHRecenter::declare_interface(Node &i)
     i["type_name"]   = "vtkh_recenter";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
 }
 
 //-----------------------------------------------------------------------------
@@ -1977,6 +1993,7 @@ VTKHHistSampling::declare_interface(Node &i)
     i["type_name"]   = "vtkh_hist_sampling";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
 }
 
 //-----------------------------------------------------------------------------
@@ -2038,6 +2055,8 @@ VTKHHistSampling::execute()
 
     vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
 
+    eval_param_expressions(params(), {"sample_rate", "bins"}, data_object);
+
     float sample_rate = .1f;
     if(params().has_path("sample_rate"))
     {
@@ -2130,6 +2149,8 @@ VTKHQCriterion::declare_interface(Node &i)
     i["type_name"]   = "vtkh_qcriterion";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
+    i["fields/produces"].append() = "output_name";
 }
 
 //-----------------------------------------------------------------------------
@@ -2243,6 +2264,8 @@ VTKHDivergence::declare_interface(Node &i)
     i["type_name"]   = "vtkh_divergence";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
+    i["fields/produces"].append() = "output_name";
 }
 
 //-----------------------------------------------------------------------------
@@ -2357,6 +2380,8 @@ VTKHVorticity::declare_interface(Node &i)
     i["type_name"]   = "vtkh_curl";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
+    i["fields/produces"].append() = "output_name";
 }
 
 //-----------------------------------------------------------------------------
@@ -2471,6 +2496,8 @@ VTKHGradient::declare_interface(Node &i)
     i["type_name"]   = "vtkh_gradient";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
+    i["fields/produces"].append() = "output_name";
 }
 
 //-----------------------------------------------------------------------------
@@ -2586,6 +2613,7 @@ VTKHStats::declare_interface(Node &i)
     i["type_name"]   = "vtkh_stats";
     i["port_names"].append() = "in";
     i["output_port"] = "false";
+    i["fields/reads"].append() = "field";
 }
 
 //-----------------------------------------------------------------------------
@@ -2677,6 +2705,7 @@ VTKHHistogram::declare_interface(Node &i)
     i["type_name"]   = "vtkh_histogram";
     i["port_names"].append() = "in";
     i["output_port"] = "false";
+    i["fields/reads"].append() = "field";
 }
 
 //-----------------------------------------------------------------------------
@@ -2779,6 +2808,15 @@ VTKHProject2d::declare_interface(Node &i)
     i["output_port"] = "true";
 }
 
+//-----------------------------------------------------------------------------
+bool
+VTKHProject2d::declare_fields(std::set<std::string> &reads,
+                             std::set<std::string> &produces)
+{
+    // without a field list every field is used
+    return declare_field_list(params(), reads);
+}
+
 //-----------------------------------------------------------------------------
 bool
 VTKHProject2d::verify_params(const conduit::Node &params,
@@ -2900,6 +2938,7 @@ VTKHNoOp::declare_interface(Node &i)
     i["type_name"]   = "vtkh_no_op";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
 }
 
 //-----------------------------------------------------------------------------
@@ -2998,6 +3037,8 @@ VTKHVectorComponent::declare_interface(Node &i)
     i["type_name"]   = "vtkh_vector_component";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
+    i["fields/produces"].append() = "output_name";
 }
 
 //-----------------------------------------------------------------------------
@@ -3104,6 +3145,10 @@ VTKHCompositeVector::declare_interface(Node &i)
     i["type_name"]   = "vtkh_composite_vector";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field1";
+    i["fields/reads"].append() = "field2";
+    i["fields/reads"].append() = "field3";
+    i["fields/produces"].append() = "output_name";
 }
 
 //-----------------------------------------------------------------------------
@@ -3242,6 +3287,7 @@ VTKHScale::declare_interface(Node &i)
     i["type_name"]   = "vtkh_scale_transform";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"] = DataType::list();
 }
 
 //-----------------------------------------------------------------------------
@@ -3341,6 +3387,7 @@ VTKHParticleAdvection::declare_interface(Node &i)
     i["type_name"]   = "vtkh_particle_advection";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
 }
 
 //-----------------------------------------------------------------------------
@@ -3417,6 +3464,18 @@ VTKHParticleAdvection::execute()
     vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
 
 
+    const std::vector<std::string> numeric_params =
+      {"num_seeds",
+       "num_steps",
+       "step_size",
+       "seed_bounding_box_xmin",
+       "seed_bounding_box_xmax",
+       "seed_bounding_box_ymin",
+       "seed_bounding_box_ymax",
+       "seed_bounding_box_zmin",
+       "seed_bounding_box_zmax"};
+    eval_param_expressions(params(), numeric_params, data_object);
+
     int numSeeds = get_int32(params()["num_seeds"], data_object);
     int numSteps = get_int32(params()["num_steps"], data_object);
     float stepSize = get_float32(params()["step_size"], data_object);
@@ -3507,6 +3566,7 @@ VTKHStreamline::declare_interface(Node &i)
     i["type_name"]   = "vtkh_streamline";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["fields/reads"].append() = "field";
 }
 
 //-----------------------------------------------------------------------------
@@ -378,6 +378,8 @@ public:
     virtual void   declare_interface(conduit::Node &i);
     virtual bool   verify_params(const conduit::Node &params,
                                  conduit::Node &info);
+    virtual bool   declare_fields(std::set<std::string> &reads,
+                                  std::set<std::string> &produces);
     virtual void   execute();
 };
 
@@ -175,7 +175,8 @@ void parse_expression(const std::string &expression,
   parse_binning(expression, fields);
   parse_field_list(expression, fields);
 
-  std::regex e ("field\\('(.*?)'\\)");
+  // match the first argument only so 'field('vel', 'x')' yields 'vel'
+  std::regex e ("field\\(\\s*'([^']*)'");
   std::smatch m;
 
   std::set<std::string> matches;
@@ -226,6 +227,12 @@ void filter_fields(const conduit::Node &node,
       {
         parse_expression(child.as_string(), fields);
       }
+      else if(child.dtype().is_string())
+      {
+        // any param can be an expression,
+        // e.g., iso_values: "max(field('density')) / 2"
+        parse_expression(child.as_string(), fields);
+      }
       // special detection for filters that use
       // all fields by default
       if(names[i] == "type")
@@ -0,0 +1,1099 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_field_codec.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "ascent_field_codec.hpp"
+
+#include <ascent_config.h>
+#include "ascent_logging.hpp"
+
+// standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace conduit;
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::field_codec --
+//-----------------------------------------------------------------------------
+namespace field_codec
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::field_codec::detail --
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+//
+// The lz format is a stream of sequences, each made of:
+//
+//   token: high nibble is the literal count, low nibble is match length - 4
+//          (a nibble of 15 is followed by extra length bytes, 255 means
+//           keep reading)
+//   literals
+//   match offset: 2 bytes, little endian
+//   extra match length bytes
+//
+// The last sequence only holds literals and ends the stream.
+//
+const index_t lz_min_match  = 4;
+const index_t lz_max_offset = 65535;
+const int     lz_hash_bits  = 16;
+
+//-----------------------------------------------------------------------------
+inline uint32
+read32(const uint8 *ptr)
+{
+    uint32 res;
+    memcpy(&res, ptr, sizeof(uint32));
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+inline uint32
+lz_hash(uint32 value)
+{
+    return (value * 2654435761u) >> (32 - lz_hash_bits);
+}
+
+//-----------------------------------------------------------------------------
+void
+write_length(index_t length, std::vector<uint8> &out)
+{
+    while(length >= 255)
+    {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back((uint8)length);
+}
+
+//-----------------------------------------------------------------------------
+index_t
+read_length(const uint8 *&ptr, const uint8 *end)
+{
+    index_t length = 0;
+    uint8 b = 255;
+    while(b == 255)
+    {
+        if(ptr >= end)
+        {
+            ASCENT_ERROR("field_codec: truncated lz stream");
+        }
+        b = *ptr++;
+        length += b;
+    }
+    return length;
+}
+
+//-----------------------------------------------------------------------------
+// a match length of zero marks the last sequence
+void
+write_sequence(const uint8 *literals,
+               index_t num_literals,
+               index_t offset,
+               index_t match_length,
+               std::vector<uint8> &out)
+{
+    index_t lit_code = std::min(num_literals, (index_t)15);
+    index_t match_code = 0;
+    if(match_length > 0)
+    {
+        match_code = std::min(match_length - lz_min_match, (index_t)15);
+    }
+
+    out.push_back((uint8)((lit_code << 4) | match_code));
+    if(lit_code == 15)
+    {
+        write_length(num_literals - 15, out);
+    }
+
+    out.insert(out.end(), literals, literals + num_literals);
+
+    if(match_length > 0)
+    {
+        out.push_back((uint8)(offset & 0xff));
+        out.push_back((uint8)((offset >> 8) & 0xff));
+        if(match_code == 15)
+        {
+            write_length(match_length - lz_min_match - 15, out);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+DataType
+make_dtype(index_t dtype_id, index_t num_elements)
+{
+    switch(dtype_id)
+    {
+        case DataType::INT8_ID:    return DataType::int8(num_elements);
+        case DataType::INT16_ID:   return DataType::int16(num_elements);
+        case DataType::INT32_ID:   return DataType::int32(num_elements);
+        case DataType::INT64_ID:   return DataType::int64(num_elements);
+        case DataType::UINT8_ID:   return DataType::uint8(num_elements);
+        case DataType::UINT16_ID:  return DataType::uint16(num_elements);
+        case DataType::UINT32_ID:  return DataType::uint32(num_elements);
+        case DataType::UINT64_ID:  return DataType::uint64(num_elements);
+        case DataType::FLOAT32_ID: return DataType::float32(num_elements);
+        case DataType::FLOAT64_ID: return DataType::float64(num_elements);
+        default:
+            ASCENT_ERROR("field_codec: unsupported dtype '"
+                         << DataType::id_to_name(dtype_id) << "'");
+    }
+    return DataType::empty();
+}
+
+//-----------------------------------------------------------------------------
+template<typename T>
+bool
+value_range(const T *values, index_t size, double &vmin, double &vmax)
+{
+    vmin = std::numeric_limits<double>::max();
+    vmax = std::numeric_limits<double>::lowest();
+    for(index_t i = 0; i < size; ++i)
+    {
+        const double v = static_cast<double>(values[i]);
+        if(!std::isfinite(v))
+        {
+            return false;
+        }
+        vmin = std::min(vmin, v);
+        vmax = std::max(vmax, v);
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+template<typename T, typename Q>
+void
+quantize(const T *values, index_t size, double offset, double step, Q *q)
+{
+    for(index_t i = 0; i < size; ++i)
+    {
+        q[i] = static_cast<Q>(
+                 std::floor((static_cast<double>(values[i]) - offset) / step + 0.5));
+    }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Q, typename T>
+void
+dequantize(const Q *q, index_t size, double offset, double step, T *values)
+{
+    for(index_t i = 0; i < size; ++i)
+    {
+        values[i] = static_cast<T>(offset + static_cast<double>(q[i]) * step);
+    }
+}
+
+//-----------------------------------------------------------------------------
+template<typename T>
+void
+quantize_to(const T *values, double offset, double step, Node &q)
+{
+    const index_t size = q.dtype().number_of_elements();
+    void *ptr = q.element_ptr(0);
+    switch(q.dtype().id())
+    {
+        case DataType::UINT8_ID:
+            quantize(values, size, offset, step, static_cast<uint8*>(ptr));
+            break;
+        case DataType::UINT16_ID:
+            quantize(values, size, offset, step, static_cast<uint16*>(ptr));
+            break;
+        case DataType::UINT32_ID:
+            quantize(values, size, offset, step, static_cast<uint32*>(ptr));
+            break;
+        default:
+            quantize(values, size, offset, step, static_cast<uint64*>(ptr));
+    }
+}
+
+//-----------------------------------------------------------------------------
+template<typename T>
+void
+dequantize_from(const Node &q, double offset, double step, T *values)
+{
+    const index_t size = q.dtype().number_of_elements();
+    const void *ptr = q.element_ptr(0);
+    switch(q.dtype().id())
+    {
+        case DataType::UINT8_ID:
+            dequantize(static_cast<const uint8*>(ptr), size, offset, step, values);
+            break;
+        case DataType::UINT16_ID:
+            dequantize(static_cast<const uint16*>(ptr), size, offset, step, values);
+            break;
+        case DataType::UINT32_ID:
+            dequantize(static_cast<const uint32*>(ptr), size, offset, step, values);
+            break;
+        case DataType::UINT64_ID:
+            dequantize(static_cast<const uint64*>(ptr), size, offset, step, values);
+            break;
+        default:
+            ASCENT_ERROR("field_codec: invalid quantized dtype '"
+                         << q.dtype().name() << "'");
+    }
+}
+
+//-----------------------------------------------------------------------------
+// levels are computed in double precision, past 2^53 neighboring levels
+// are no longer distinct
+const double max_quantize_levels = 9007199254740992.0;
+
+//-----------------------------------------------------------------------------
+// true if every dequantized value is within error_bound of the original
+//-----------------------------------------------------------------------------
+template<typename T>
+bool
+quantized_within(const T *values,
+                 const Node &q,
+                 double offset,
+                 double step,
+                 double error_bound)
+{
+    const index_t size = q.dtype().number_of_elements();
+    std::vector<T> recon(size);
+    dequantize_from(q, offset, step, recon.data());
+    for(index_t i = 0; i < size; ++i)
+    {
+        if(std::abs(static_cast<double>(recon[i]) -
+                    static_cast<double>(values[i])) > error_bound)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// maps floating point values onto integers spaced step apart, using the
+// smallest unsigned type that holds every level. The step is 2 *
+// error_bound less the rounding error of storing a reconstructed value
+// in the field's type, and the reconstruction is checked. Returns false
+// when the values cannot be quantized (non finite values, more than
+// max_quantize_levels levels, or a bound below the type's precision)
+//-----------------------------------------------------------------------------
+bool
+quantize_values(const Node &values,
+                double error_bound,
+                Node &out,
+                double &offset,
+                double &step)
+{
+    const index_t size = values.dtype().number_of_elements();
+    const bool is_float32 = values.dtype().id() == DataType::FLOAT32_ID;
+
+    double vmin, vmax;
+    bool finite;
+    if(is_float32)
+    {
+        finite = value_range(static_cast<const float32*>(values.element_ptr(0)),
+                             size, vmin, vmax);
+    }
+    else
+    {
+        finite = value_range(static_cast<const float64*>(values.element_ptr(0)),
+                             size, vmin, vmax);
+    }
+
+    if(!finite)
+    {
+        return false;
+    }
+
+    // half an ulp of the largest magnitude (for the final rounding to
+    // the field's type), twice to cover the double arithmetic as well
+    const double max_abs = std::max(std::abs(vmin), std::abs(vmax));
+    const double unit_roundoff = is_float32 ? std::ldexp(1.0, -24)
+                                            : std::ldexp(1.0, -53);
+    const double bound = error_bound - 2.0 * max_abs * unit_roundoff;
+    if(bound <= 0.0)
+    {
+        return false;
+    }
+
+    step = 2.0 * bound;
+    const double levels = std::ceil((vmax - vmin) / step);
+
+    if(levels <= 255.0)
+    {
+        out.set(DataType::uint8(size));
+    }
+    else if(levels <= 65535.0)
+    {
+        out.set(DataType::uint16(size));
+    }
+    else if(levels <= 4294967295.0)
+    {
+        out.set(DataType::uint32(size));
+    }
+    else if(levels <= max_quantize_levels)
+    {
+        out.set(DataType::uint64(size));
+    }
+    else
+    {
+        return false;
+    }
+
+    offset = vmin;
+    if(is_float32)
+    {
+        const float32 *ptr = static_cast<const float32*>(values.element_ptr(0));
+        quantize_to(ptr, offset, step, out);
+        return quantized_within(ptr, out, offset, step, error_bound);
+    }
+    else
+    {
+        const float64 *ptr = static_cast<const float64*>(values.element_ptr(0));
+        quantize_to(ptr, offset, step, out);
+        return quantized_within(ptr, out, offset, step, error_bound);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+encode_array(Node &values,
+             const Node &options,
+             Node &out)
+{
+    // leave anything we can't (or don't need to) compress as is
+    if(!values.dtype().is_number() ||
+       values.dtype().number_of_elements() == 0)
+    {
+        out.set_external(values);
+        return;
+    }
+    encode(values, options, out);
+}
+
+//-----------------------------------------------------------------------------
+void
+encode_domain(Node &dom,
+              const Node &options,
+              Node &out)
+{
+    NodeIterator itr = dom.children();
+    while(itr.has_next())
+    {
+        Node &child = itr.next();
+        const std::string name = itr.name();
+        if(name != "fields")
+        {
+            out[name].set_external(child);
+            continue;
+        }
+
+        NodeIterator f_itr = child.children();
+        while(f_itr.has_next())
+        {
+            Node &field = f_itr.next();
+            const std::string field_name = f_itr.name();
+            Node &field_out = out["fields"][field_name];
+
+            Node f_opts;
+            field_options(options, field_name, f_opts);
+            const bool skip = f_opts["mode"].as_string() == "none";
+
+            NodeIterator e_itr = field.children();
+            while(e_itr.has_next())
+            {
+                Node &entry = e_itr.next();
+                const std::string entry_name = e_itr.name();
+                if(skip || entry_name != "values")
+                {
+                    field_out[entry_name].set_external(entry);
+                }
+                else if(entry.dtype().is_object())
+                {
+                    // mcarray, encode each component
+                    NodeIterator c_itr = entry.children();
+                    while(c_itr.has_next())
+                    {
+                        Node &comp = c_itr.next();
+                        encode_array(comp,
+                                     f_opts,
+                                     field_out["values"][c_itr.name()]);
+                    }
+                }
+                else
+                {
+                    encode_array(entry, f_opts, field_out["values"]);
+                }
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+decode_in_place(Node &values)
+{
+    // the compressed copy is small compared to the decoded values
+    Node encoded;
+    encoded.set(values);
+    decode(encoded, values);
+}
+
+//-----------------------------------------------------------------------------
+int
+applied_mode(const Node &encoded)
+{
+    return encoded["mode"].as_string() == "quantize" ? applied_quantize
+                                                     : applied_lossless;
+}
+
+//-----------------------------------------------------------------------------
+bool
+verify_mode(const Node &options,
+            const std::string &prefix,
+            Node &info)
+{
+    bool res = true;
+    if(options.has_child("mode"))
+    {
+        const Node &mode = options["mode"];
+        if(!mode.dtype().is_string())
+        {
+            info["errors"].append() = prefix + "'mode' must be a string";
+            res = false;
+        }
+        else if(mode.as_string() != "lossless" &&
+                mode.as_string() != "quantize" &&
+                mode.as_string() != "none")
+        {
+            info["errors"].append() = prefix + "'mode' must be 'lossless', "
+                                      "'quantize', or 'none'";
+            res = false;
+        }
+    }
+
+    if(options.has_child("error_bound"))
+    {
+        const Node &eb = options["error_bound"];
+        if(!eb.dtype().is_number())
+        {
+            info["errors"].append() = prefix + "'error_bound' must be a number";
+            res = false;
+        }
+        else if(eb.to_float64() < 0.0)
+        {
+            info["errors"].append() = prefix +
+                                      "'error_bound' must not be negative";
+            res = false;
+        }
+    }
+    return res;
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::field_codec::detail --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+bool
+is_encoded(const Node &node)
+{
+    return node.dtype().is_object() && node.has_child("ascent_codec");
+}
+
+//-----------------------------------------------------------------------------
+bool
+verify_options(const Node &options,
+               Node &info)
+{
+    if(!options.dtype().is_object())
+    {
+        info["errors"].append() = "'compression' must be an object";
+        return false;
+    }
+
+    bool res = detail::verify_mode(options, "compression: ", info);
+
+    NodeConstIterator itr = options.children();
+    while(itr.has_next())
+    {
+        const Node &child = itr.next();
+        const std::string name = itr.name();
+        if(name == "mode" || name == "error_bound")
+        {
+            continue;
+        }
+        else if(name != "fields")
+        {
+            info["errors"].append() = "compression: unknown entry '" + name + "'";
+            res = false;
+            continue;
+        }
+
+        NodeConstIterator f_itr = child.children();
+        while(f_itr.has_next())
+        {
+            const Node &field = f_itr.next();
+            const std::string prefix = "compression: fields/" + f_itr.name() + ": ";
+            if(!field.dtype().is_object())
+            {
+                info["errors"].append() = prefix + "must be an object";
+                res = false;
+                continue;
+            }
+            res &= detail::verify_mode(field, prefix, info);
+        }
+    }
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+void
+field_options(const Node &options,
+              const std::string &field_name,
+              Node &out)
+{
+    out.reset();
+    out["mode"] = "lossless";
+    out["error_bound"] = 0.0;
+
+    const Node *sources[2] = {&options, NULL};
+    if(options.has_child("fields") && options["fields"].has_child(field_name))
+    {
+        sources[1] = &options["fields"][field_name];
+    }
+
+    // per field options override the defaults
+    for(int i = 0; i < 2; ++i)
+    {
+        if(sources[i] == NULL)
+        {
+            continue;
+        }
+        if(sources[i]->has_child("mode"))
+        {
+            out["mode"] = (*sources[i])["mode"].as_string();
+        }
+        if(sources[i]->has_child("error_bound"))
+        {
+            out["error_bound"] = (*sources[i])["error_bound"].to_float64();
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+encode(const Node &values,
+       const Node &options,
+       Node &out)
+{
+    const DataType &dtype = values.dtype();
+    if(!dtype.is_number())
+    {
+        ASCENT_ERROR("field_codec: can only encode numeric arrays");
+    }
+
+    const Node *src = &values;
+    Node compact;
+    if(!values.is_compact())
+    {
+        values.compact_to(compact);
+        src = &compact;
+    }
+
+    const index_t num_elements = dtype.number_of_elements();
+
+    std::string mode = "lossless";
+    double error_bound = 0.0;
+    if(options.has_child("mode"))
+    {
+        mode = options["mode"].as_string();
+    }
+    if(options.has_child("error_bound"))
+    {
+        error_bound = options["error_bound"].to_float64();
+    }
+
+    out.reset();
+    out["ascent_codec"] = "shuffle_lz";
+    out["dtype"] = dtype.name();
+    out["num_elements"] = (int64) num_elements;
+
+    // only floating point values are quantized, everything
+    // else (and values we cannot quantize) falls back to lossless
+    Node quantized;
+    double offset = 0.0;
+    double step = 0.0;
+    if(mode == "quantize" &&
+       dtype.is_floating_point() &&
+       error_bound > 0.0 &&
+       detail::quantize_values(*src, error_bound, quantized, offset, step))
+    {
+        src = &quantized;
+        out["mode"] = "quantize";
+        out["error_bound"] = error_bound;
+        out["offset"] = offset;
+        out["step"] = step;
+    }
+    else
+    {
+        out["mode"] = "lossless";
+    }
+
+    const index_t element_bytes = src->dtype().element_bytes();
+    const index_t stored_bytes = num_elements * element_bytes;
+
+    std::vector<uint8> shuffled(stored_bytes);
+    shuffle(static_cast<const uint8*>(src->element_ptr(0)),
+            num_elements,
+            element_bytes,
+            shuffled.data());
+
+    std::vector<uint8> compressed;
+    lz_compress(shuffled.data(), stored_bytes, compressed);
+
+    out["stored_dtype"] = src->dtype().name();
+    out["stored_bytes"] = (int64) stored_bytes;
+    out["data"].set(compressed);
+}
+
+//-----------------------------------------------------------------------------
+void
+decode(const Node &encoded,
+       Node &values)
+{
+    if(!is_encoded(encoded))
+    {
+        ASCENT_ERROR("field_codec: node is not an encoded array");
+    }
+
+    const std::string codec = encoded["ascent_codec"].as_string();
+    if(codec != "shuffle_lz")
+    {
+        ASCENT_ERROR("field_codec: unknown codec '" << codec << "'");
+    }
+
+    const index_t num_elements = encoded["num_elements"].to_int64();
+    const index_t dtype_id = DataType::name_to_id(encoded["dtype"].as_string());
+    const index_t stored_id =
+        DataType::name_to_id(encoded["stored_dtype"].as_string());
+    const std::string mode = encoded["mode"].as_string();
+
+    DataType stored_dtype = detail::make_dtype(stored_id, num_elements);
+    const index_t element_bytes = stored_dtype.element_bytes();
+    const index_t stored_bytes = num_elements * element_bytes;
+
+    if(encoded["stored_bytes"].to_int64() != stored_bytes)
+    {
+        ASCENT_ERROR("field_codec: stored size does not match dtype '"
+                     << encoded["stored_dtype"].as_string() << "'");
+    }
+
+    // json and yaml may not preserve the exact byte type
+    const Node *data = &encoded["data"];
+    Node data_bytes;
+    if(data->dtype().id() != DataType::UINT8_ID || !data->is_compact())
+    {
+        data->to_uint8_array(data_bytes);
+        data = &data_bytes;
+    }
+
+    std::vector<uint8> shuffled(stored_bytes);
+    lz_decompress(static_cast<const uint8*>(data->element_ptr(0)),
+                  data->dtype().number_of_elements(),
+                  shuffled.data(),
+                  stored_bytes);
+
+    if(mode == "quantize")
+    {
+        Node quantized;
+        quantized.set(stored_dtype);
+        unshuffle(shuffled.data(),
+                  num_elements,
+                  element_bytes,
+                  static_cast<uint8*>(quantized.element_ptr(0)));
+
+        const double offset = encoded["offset"].to_float64();
+        // older encodings spaced levels 2 * error_bound apart
+        const double step = encoded.has_child("step")
+                                 ? encoded["step"].to_float64()
+                                 : 2.0 * encoded["error_bound"].to_float64();
+
+        values.reset();
+        values.set(detail::make_dtype(dtype_id, num_elements));
+        if(dtype_id == DataType::FLOAT32_ID)
+        {
+            detail::dequantize_from(quantized, offset, step,
+                                    static_cast<float32*>(values.element_ptr(0)));
+        }
+        else if(dtype_id == DataType::FLOAT64_ID)
+        {
+            detail::dequantize_from(quantized, offset, step,
+                                    static_cast<float64*>(values.element_ptr(0)));
+        }
+        else
+        {
+            ASCENT_ERROR("field_codec: quantized values must be floating point");
+        }
+    }
+    else
+    {
+        if(stored_id != dtype_id)
+        {
+            ASCENT_ERROR("field_codec: lossless dtype mismatch");
+        }
+        values.reset();
+        values.set(stored_dtype);
+        unshuffle(shuffled.data(),
+                  num_elements,
+                  element_bytes,
+                  static_cast<uint8*>(values.element_ptr(0)));
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+encode_domains(Node &multi_dom,
+               const Node &options,
+               Node &out)
+{
+    out.reset();
+    const index_t num_domains = multi_dom.number_of_children();
+
+    // create the outputs up front, threads only touch their own domain
+    std::vector<Node*> outs(num_domains);
+    for(index_t i = 0; i < num_domains; ++i)
+    {
+        outs[i] = &out.append();
+    }
+
+    std::vector<std::string> errors(num_domains);
+
+#ifdef ASCENT_USE_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for(index_t i = 0; i < num_domains; ++i)
+    {
+        try
+        {
+            detail::encode_domain(multi_dom.child(i), options, *outs[i]);
+        }
+        catch(conduit::Error &e)
+        {
+            errors[i] = e.message();
+        }
+    }
+
+    for(index_t i = 0; i < num_domains; ++i)
+    {
+        if(!errors[i].empty())
+        {
+            ASCENT_ERROR("field_codec: failed to encode domain " << i
+                         << ": " << errors[i]);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+int
+applied_modes(const Node &encoded_doms,
+              const std::string &field_name)
+{
+    int res = 0;
+    const std::string path = "fields/" + field_name + "/values";
+    const index_t num_domains = encoded_doms.number_of_children();
+    for(index_t i = 0; i < num_domains; ++i)
+    {
+        const Node &dom = encoded_doms.child(i);
+        if(!dom.has_path(path))
+        {
+            continue;
+        }
+
+        const Node &values = dom[path];
+        if(is_encoded(values))
+        {
+            res |= detail::applied_mode(values);
+        }
+        else if(values.dtype().is_object())
+        {
+            NodeConstIterator itr = values.children();
+            while(itr.has_next())
+            {
+                const Node &comp = itr.next();
+                if(is_encoded(comp))
+                {
+                    res |= detail::applied_mode(comp);
+                }
+            }
+        }
+    }
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+void
+decode_fields(Node &dom)
+{
+    if(!dom.has_child("fields"))
+    {
+        return;
+    }
+
+    NodeIterator itr = dom["fields"].children();
+    while(itr.has_next())
+    {
+        Node &field = itr.next();
+        if(!field.has_child("values"))
+        {
+            continue;
+        }
+
+        Node &values = field["values"];
+        if(is_encoded(values))
+        {
+            detail::decode_in_place(values);
+        }
+        else if(values.dtype().is_object())
+        {
+            NodeIterator c_itr = values.children();
+            while(c_itr.has_next())
+            {
+                Node &comp = c_itr.next();
+                if(is_encoded(comp))
+                {
+                    detail::decode_in_place(comp);
+                }
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+shuffle(const uint8 *src,
+        index_t num_elements,
+        index_t element_bytes,
+        uint8 *dest)
+{
+    // group the i-th byte of every element together, the high bytes
+    // of smooth fields repeat and compress much better
+    for(index_t b = 0; b < element_bytes; ++b)
+    {
+        uint8 *out = dest + b * num_elements;
+        for(index_t i = 0; i < num_elements; ++i)
+        {
+            out[i] = src[i * element_bytes + b];
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+unshuffle(const uint8 *src,
+          index_t num_elements,
+          index_t element_bytes,
+          uint8 *dest)
+{
+    for(index_t b = 0; b < element_bytes; ++b)
+    {
+        const uint8 *in = src + b * num_elements;
+        for(index_t i = 0; i < num_elements; ++i)
+        {
+            dest[i * element_bytes + b] = in[i];
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+lz_compress(const uint8 *src,
+            index_t size,
+            std::vector<uint8> &out)
+{
+    out.clear();
+    out.reserve(size + size / 255 + 16);
+
+    std::vector<index_t> table(1 << detail::lz_hash_bits, -1);
+
+    index_t anchor = 0;
+    index_t pos = 0;
+    // the last position a match can start from
+    const index_t limit = size - detail::lz_min_match;
+
+    while(pos <= limit)
+    {
+        const uint32 seq = detail::read32(src + pos);
+        const uint32 hash = detail::lz_hash(seq);
+        const index_t candidate = table[hash];
+        table[hash] = pos;
+
+        if(candidate >= 0 &&
+           pos - candidate <= detail::lz_max_offset &&
+           detail::read32(src + candidate) == seq)
+        {
+            index_t length = detail::lz_min_match;
+            while(pos + length < size &&
+                  src[candidate + length] == src[pos + length])
+            {
+                length++;
+            }
+
+            detail::write_sequence(src + anchor,
+                                   pos - anchor,
+                                   pos - candidate,
+                                   length,
+                                   out);
+            pos += length;
+            anchor = pos;
+        }
+        else
+        {
+            pos++;
+        }
+    }
+
+    if(anchor < size)
+    {
+        detail::write_sequence(src + anchor, size - anchor, 0, 0, out);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+lz_decompress(const uint8 *src,
+              index_t size,
+              uint8 *dest,
+              index_t dest_size)
+{
+    const uint8 *in = src;
+    const uint8 *in_end = src + size;
+    uint8 *op = dest;
+    uint8 *op_end = dest + dest_size;
+
+    while(in < in_end)
+    {
+        const uint8 token = *in++;
+
+        index_t num_literals = token >> 4;
+        if(num_literals == 15)
+        {
+            num_literals += detail::read_length(in, in_end);
+        }
+
+        if(num_literals > in_end - in || num_literals > op_end - op)
+        {
+            ASCENT_ERROR("field_codec: corrupt lz stream (literals)");
+        }
+
+        memcpy(op, in, num_literals);
+        op += num_literals;
+        in += num_literals;
+
+        // the last sequence has no match
+        if(in == in_end)
+        {
+            break;
+        }
+
+        if(in_end - in < 2)
+        {
+            ASCENT_ERROR("field_codec: truncated lz stream");
+        }
+
+        const index_t offset = in[0] | (in[1] << 8);
+        in += 2;
+
+        index_t length = token & 15;
+        if(length == 15)
+        {
+            length += detail::read_length(in, in_end);
+        }
+        length += detail::lz_min_match;
+
+        if(offset == 0 || offset > op - dest || length > op_end - op)
+        {
+            ASCENT_ERROR("field_codec: corrupt lz stream (match)");
+        }
+
+        // matches may overlap the bytes they produce, copy forward
+        const uint8 *match = op - offset;
+        for(index_t i = 0; i < length; ++i)
+        {
+            op[i] = match[i];
+        }
+        op += length;
+    }
+
+    if(op != op_end)
+    {
+        ASCENT_ERROR("field_codec: decompressed " << (op - dest)
+                     << " bytes, expected " << dest_size);
+    }
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::field_codec --
+//-----------------------------------------------------------------------------
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
@@ -0,0 +1,166 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_field_codec.hpp
+///
+//-----------------------------------------------------------------------------
+#ifndef ASCENT_FIELD_CODEC_HPP
+#define ASCENT_FIELD_CODEC_HPP
+
+#include <ascent_exports.h>
+#include <conduit.hpp>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::field_codec --
+//-----------------------------------------------------------------------------
+//
+// Compression for blueprint field values written by relay extracts.
+//
+// Each encoded array is replaced by a node that describes how to restore it:
+//
+//   ascent_codec: "shuffle_lz"
+//   mode: "lossless" or "quantize"
+//   dtype: name of the original dtype (ex: "float64")
+//   num_elements: number of elements in the original array
+//   stored_dtype: dtype of the shuffled elements (differs when quantized)
+//   stored_bytes: uncompressed size of the shuffled elements
+//   error_bound, offset, step: quantization parameters (quantize only)
+//   data: compressed bytes (uint8)
+//
+// Options (from the relay 'compression' params):
+//
+//   mode: "lossless" (default), "quantize", or "none"
+//   error_bound: max absolute error allowed by "quantize"
+//   fields:
+//     <field name>: per field overrides of 'mode' and 'error_bound'
+//
+namespace field_codec
+{
+
+// returns true if the node was produced by encode
+bool ASCENT_API is_encoded(const conduit::Node &node);
+
+// checks compression options, adds messages to info["errors"]
+bool ASCENT_API verify_options(const conduit::Node &options,
+                               conduit::Node &info);
+
+// resolves the options that apply to the named field
+void ASCENT_API field_options(const conduit::Node &options,
+                              const std::string &field_name,
+                              conduit::Node &out);
+
+// encodes a numeric leaf array
+void ASCENT_API encode(const conduit::Node &values,
+                       const conduit::Node &options,
+                       conduit::Node &out);
+
+// restores an array produced by encode
+void ASCENT_API decode(const conduit::Node &encoded,
+                       conduit::Node &values);
+
+// encodes the field values of every domain of a multi domain mesh,
+// domains are encoded in parallel. Everything but the encoded values
+// is referenced externally from 'multi_dom'
+void ASCENT_API encode_domains(conduit::Node &multi_dom,
+                               const conduit::Node &options,
+                               conduit::Node &out);
+
+// modes applied to a field's values in the output of encode_domains,
+// a combination of the flags below (0 if no values were encoded).
+// 'quantize' falls back to lossless for values it cannot quantize
+const int applied_lossless = 1;
+const int applied_quantize = 2;
+int ASCENT_API applied_modes(const conduit::Node &encoded_doms,
+                             const std::string &field_name);
+
+// decodes any encoded field values of a single domain in place
+void ASCENT_API decode_fields(conduit::Node &dom);
+
+// byte level building blocks
+void ASCENT_API shuffle(const conduit::uint8 *src,
+                        conduit::index_t num_elements,
+                        conduit::index_t element_bytes,
+                        conduit::uint8 *dest);
+
+void ASCENT_API unshuffle(const conduit::uint8 *src,
+                          conduit::index_t num_elements,
+                          conduit::index_t element_bytes,
+                          conduit::uint8 *dest);
+
+void ASCENT_API lz_compress(const conduit::uint8 *src,
+                            conduit::index_t size,
+                            std::vector<conduit::uint8> &out);
+
+// 'dest' must hold 'dest_size' bytes, the expected decompressed size
+void ASCENT_API lz_decompress(const conduit::uint8 *src,
+                              conduit::index_t size,
+                              conduit::uint8 *dest,
+                              conduit::index_t dest_size);
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::field_codec --
+//-----------------------------------------------------------------------------
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
+
@@ -94,6 +94,29 @@ copy_file(const std::string &src_path,
 }
 
 
+//-----------------------------------------------------------------------------
+bool
+file_stats(const std::string &path,
+           long long &mtime,
+           long long &size)
+{
+    struct stat path_stat;
+    if(stat(path.c_str(), &path_stat) != 0 ||
+       !S_ISREG(path_stat.st_mode))
+    {
+        return false;
+    }
+
+#if defined(__APPLE__)
+    const struct timespec &ts = path_stat.st_mtimespec;
+#else
+    const struct timespec &ts = path_stat.st_mtim;
+#endif
+    mtime = (long long)ts.tv_sec * 1000000000LL + (long long)ts.tv_nsec;
+    size  = (long long)path_stat.st_size;
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 bool
 copy_directory(const std::string &src_path,
@@ -75,6 +75,12 @@ bool ASCENT_API copy_file(const std::string &src_path,
 bool ASCENT_API copy_directory(const std::string &src_path,
                                const std::string &dest_path);
 
+// modification time (nanoseconds) and size (bytes) of a file,
+// returns false if the path is not a file
+bool ASCENT_API file_stats(const std::string &path,
+                           long long &mtime,
+                           long long &size);
+
 
 //-----------------------------------------------------------------------------
 };
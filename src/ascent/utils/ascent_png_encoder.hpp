@@ -50,6 +50,7 @@
 #ifndef ASCENT_PNG_ENCODER_HPP
 #define ASCENT_PNG_ENCODER_HPP
 
+#include <ascent_exports.h>
 #include <conduit.hpp>
 #include <string>
 
@@ -59,7 +60,7 @@
 namespace ascent
 {
 
-class PNGEncoder
+class ASCENT_API PNGEncoder
 {
 public:
     PNGEncoder();
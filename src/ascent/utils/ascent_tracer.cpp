@@ -0,0 +1,524 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_tracer.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "ascent_tracer.hpp"
+#include <ascent_config.h>
+#include <ascent_logging.hpp>
+
+#if defined(ASCENT_JIT_ENABLED)
+#include <expressions/ascent_array_registry.hpp>
+#endif
+
+#if defined(ASCENT_CUDA_ENABLED)
+#include <cuda_runtime.h>
+#endif
+
+#if defined(ASCENT_PLATFORM_UNIX)
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+namespace detail
+{
+
+// each thread lazily registers its own buffer
+thread_local Tracer::ThreadBuffer *t_trace_buffer = nullptr;
+
+conduit::uint64 wall_time_ns()
+{
+  auto now = std::chrono::system_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+// resident set size in bytes, -1 if unknown
+double resident_bytes()
+{
+  double res = -1.;
+#if defined(ASCENT_PLATFORM_UNIX) && !defined(ASCENT_PLATFORM_APPLE)
+  std::ifstream statm("/proc/self/statm");
+  long pages_total, pages_resident;
+  if(statm >> pages_total >> pages_resident)
+  {
+    res = static_cast<double>(pages_resident) *
+          static_cast<double>(sysconf(_SC_PAGESIZE));
+  }
+#endif
+  return res;
+}
+
+bool env_enabled()
+{
+  if(const char *trace = std::getenv("ASCENT_TRACE"))
+  {
+    std::string val(trace);
+    return val != "" && val != "0" && val != "false";
+  }
+  return false;
+}
+
+// id of the name shared by names past Tracer::max_names
+const conduit::uint32 other_name = 1;
+
+} // namespace detail
+
+std::atomic<bool> Tracer::m_enabled(false);
+const conduit::uint32 Tracer::max_names;
+Tracer Tracer::m_instance;
+
+Tracer::Tracer()
+  : m_buffer_size(1 << 16),
+    m_rank(0)
+{
+  // 0 is always the empty string
+  m_strings.push_back("");
+  m_string_ids[""] = 0;
+  m_strings.push_back("<other>");
+  m_string_ids["<other>"] = detail::other_name;
+
+  m_enabled = detail::env_enabled();
+}
+
+Tracer::~Tracer()
+{
+  for(auto buffer : m_buffers)
+  {
+    delete buffer;
+  }
+  m_buffers.clear();
+}
+
+Tracer*
+Tracer::instance()
+{
+  return &Tracer::m_instance;
+}
+
+void
+Tracer::enable(bool on)
+{
+  m_enabled = on;
+}
+
+void
+Tracer::enable_default()
+{
+  m_enabled = detail::env_enabled();
+}
+
+void
+Tracer::rank(int rank)
+{
+  m_rank = rank;
+}
+
+void
+Tracer::buffer_size(size_t events)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_buffer_size = std::max(events, size_t(1));
+  // existing buffers are resized and restarted
+  for(auto buffer : m_buffers)
+  {
+    std::lock_guard<std::mutex> buffer_lock(buffer->m_mutex);
+    reset_buffer(*buffer);
+  }
+}
+
+void
+Tracer::reset_buffer(ThreadBuffer &buffer)
+{
+  // the caller holds m_mutex and the buffer's mutex
+  buffer.m_events.clear();
+  buffer.m_events.resize(m_buffer_size);
+  buffer.m_count = 0;
+  buffer.m_values.clear();
+  buffer.m_values.resize(std::max(m_buffer_size / 16, size_t(1)));
+  buffer.m_value_count = 0;
+}
+
+conduit::uint64
+Tracer::now() const
+{
+  // absolute wall time so traces from different ranks line up
+  return detail::wall_time_ns();
+}
+
+Tracer::ThreadBuffer &
+Tracer::thread_buffer()
+{
+  if(detail::t_trace_buffer == nullptr)
+  {
+    ThreadBuffer *buffer = new ThreadBuffer();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    reset_buffer(*buffer);
+    buffer->m_depth = 0;
+    buffer->m_thread_id = static_cast<int>(m_buffers.size());
+    m_buffers.push_back(buffer);
+    detail::t_trace_buffer = buffer;
+  }
+  return *detail::t_trace_buffer;
+}
+
+conduit::uint32
+Tracer::intern(const std::string &name)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_string_ids.find(name);
+  if(it != m_string_ids.end())
+  {
+    return it->second;
+  }
+  if(m_strings.size() >= max_names)
+  {
+    return detail::other_name;
+  }
+  conduit::uint32 id = static_cast<conduit::uint32>(m_strings.size());
+  m_strings.push_back(name);
+  m_string_ids[name] = id;
+  return id;
+}
+
+conduit::uint32
+Tracer::intern(ThreadBuffer &buffer, const std::string &name)
+{
+  // names repeat a lot, so keep a thread local cache to
+  // avoid taking the lock
+  auto it = buffer.m_names.find(name);
+  if(it != buffer.m_names.end())
+  {
+    return it->second;
+  }
+  conduit::uint32 id = intern(name);
+  // names past the cap are not cached, so the cache stays bounded too
+  if(id != detail::other_name)
+  {
+    buffer.m_names[name] = id;
+  }
+  return id;
+}
+
+void
+Tracer::record(const EventType type,
+               const std::string &name,
+               const conduit::float64 value,
+               const conduit::uint32 str)
+{
+  ThreadBuffer &buffer = thread_buffer();
+  const conduit::uint32 name_id = type == END ? 0 : intern(buffer, name);
+  std::lock_guard<std::mutex> lock(buffer.m_mutex);
+  const size_t size = buffer.m_events.size();
+  Event &event = buffer.m_events[buffer.m_count % size];
+  event.m_time = now();
+  event.m_value = value;
+  event.m_name = name_id;
+  event.m_string = str;
+  event.m_type = static_cast<conduit::uint8>(type);
+  buffer.m_count++;
+  if(type == BEGIN)
+  {
+    buffer.m_depth++;
+  }
+  else if(type == END && buffer.m_depth > 0)
+  {
+    buffer.m_depth--;
+  }
+}
+
+void
+Tracer::record_string(const std::string &name, const std::string &value)
+{
+  ThreadBuffer &buffer = thread_buffer();
+  const conduit::uint32 name_id = intern(buffer, name);
+  std::lock_guard<std::mutex> lock(buffer.m_mutex);
+  const conduit::uint64 value_id = buffer.m_value_count++;
+  buffer.m_values[value_id % buffer.m_values.size()] = value;
+
+  const size_t size = buffer.m_events.size();
+  Event &event = buffer.m_events[buffer.m_count % size];
+  event.m_time = now();
+  // the value's position in the string ring, exact below 2^53
+  event.m_value = static_cast<conduit::float64>(value_id);
+  event.m_name = name_id;
+  event.m_string = 0;
+  event.m_type = static_cast<conduit::uint8>(STRING);
+  buffer.m_count++;
+}
+
+void
+Tracer::begin(const std::string &name)
+{
+  record(BEGIN, name, 0., 0);
+}
+
+void
+Tracer::end()
+{
+  record(END, "", 0., 0);
+}
+
+size_t
+Tracer::depth()
+{
+  ThreadBuffer &buffer = thread_buffer();
+  std::lock_guard<std::mutex> lock(buffer.m_mutex);
+  return buffer.m_depth;
+}
+
+void
+Tracer::end_to(size_t depth)
+{
+  while(this->depth() > depth)
+  {
+    end();
+  }
+}
+
+void
+Tracer::counter(const std::string &name, const conduit::float64 value)
+{
+  record(COUNTER, name, value, 0);
+}
+
+void
+Tracer::sample_memory()
+{
+  double rss = detail::resident_bytes();
+  if(rss >= 0.)
+  {
+    counter("host resident bytes", rss);
+  }
+#if defined(ASCENT_JIT_ENABLED)
+  counter("array registry host bytes",
+          static_cast<double>(runtime::ArrayRegistry::host_usage()));
+  counter("array registry device bytes",
+          static_cast<double>(runtime::ArrayRegistry::device_usage()));
+#endif
+#if defined(ASCENT_CUDA_ENABLED)
+  // device memory in use, this includes vtk-m allocations
+  size_t free_bytes = 0, total_bytes = 0;
+  if(cudaMemGetInfo(&free_bytes, &total_bytes) == cudaSuccess)
+  {
+    counter("device used bytes",
+            static_cast<double>(total_bytes - free_bytes));
+  }
+#endif
+}
+
+conduit::uint64
+Tracer::dropped() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  conduit::uint64 res = 0;
+  for(auto buffer : m_buffers)
+  {
+    std::lock_guard<std::mutex> buffer_lock(buffer->m_mutex);
+    const conduit::uint64 size = buffer->m_events.size();
+    if(buffer->m_count > size)
+    {
+      res += buffer->m_count - size;
+    }
+  }
+  return res;
+}
+
+void
+Tracer::clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for(auto buffer : m_buffers)
+  {
+    std::lock_guard<std::mutex> buffer_lock(buffer->m_mutex);
+    buffer->m_count = 0;
+    buffer->m_value_count = 0;
+  }
+}
+
+void
+Tracer::to_chrome_trace(conduit::Node &trace)
+{
+  trace.reset();
+  conduit::Node &events = trace["traceEvents"];
+  // make sure we always produce a list
+  events.set(conduit::DataType::list());
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for(auto buffer : m_buffers)
+  {
+    // the owning thread waits while its buffer is exported
+    std::lock_guard<std::mutex> buffer_lock(buffer->m_mutex);
+    const conduit::uint64 size = buffer->m_events.size();
+    const conduit::uint64 count = buffer->m_count;
+    const conduit::uint64 num_values = buffer->m_values.size();
+    const conduit::uint64 start = count > size ? count - size : 0;
+    // begin events for names of END events, and to detect
+    // ends that lost their begin to a wrapped buffer
+    std::vector<conduit::uint32> open;
+    for(conduit::uint64 i = start; i < count; ++i)
+    {
+      const Event &event = buffer->m_events[i % size];
+      const double ts = static_cast<double>(event.m_time) * 1e-3;
+
+      if(event.m_type == END && open.size() == 0)
+      {
+        continue;
+      }
+
+      conduit::Node &e = events.append();
+      e["pid"] = m_rank;
+      e["tid"] = buffer->m_thread_id;
+      e["ts"] = ts;
+
+      if(event.m_type == BEGIN)
+      {
+        e["ph"] = "B";
+        e["name"] = m_strings[event.m_name];
+        open.push_back(event.m_name);
+      }
+      else if(event.m_type == END)
+      {
+        e["ph"] = "E";
+        e["name"] = m_strings[open.back()];
+        open.pop_back();
+      }
+      else if(event.m_type == VALUE || event.m_type == STRING)
+      {
+        // values are attached to the enclosing duration as
+        // instant events with args
+        e["ph"] = "i";
+        e["s"] = "t";
+        e["name"] = m_strings[event.m_name];
+        if(event.m_type == VALUE)
+        {
+          e["args/value"] = event.m_value;
+        }
+        else
+        {
+          // the string may have been overwritten by newer ones
+          const conduit::uint64 value_id =
+            static_cast<conduit::uint64>(event.m_value);
+          if(buffer->m_value_count - value_id <= num_values)
+          {
+            e["args/value"] = buffer->m_values[value_id % num_values];
+          }
+          else
+          {
+            e["args/value"] = "<dropped>";
+          }
+        }
+      }
+      else if(event.m_type == COUNTER)
+      {
+        e["ph"] = "C";
+        e["name"] = m_strings[event.m_name];
+        e["args/value"] = event.m_value;
+      }
+    }
+  }
+
+  conduit::Node &meta = events.append();
+  meta["pid"] = m_rank;
+  meta["ph"] = "M";
+  meta["name"] = "process_name";
+  meta["args/name"] = "rank " + std::to_string(m_rank);
+}
+
+void
+Tracer::write(const std::string &dir)
+{
+  conduit::Node trace;
+  to_chrome_trace(trace);
+
+  std::string prefix = "ascent_trace";
+  if(const char* trace_p = std::getenv("ASCENT_TRACE_PREFIX"))
+  {
+    prefix = std::string(trace_p);
+  }
+
+  std::stringstream name;
+  name<<prefix<<"_"<<std::setfill('0')<<std::setw(6)<<m_rank<<".json";
+
+  std::string file_name = name.str();
+  if(dir != "")
+  {
+    file_name = conduit::utils::join_file_path(dir, file_name);
+  }
+
+  std::ofstream stream;
+  stream.open(file_name.c_str());
+  if(!stream.is_open())
+  {
+    ASCENT_WARN("could not open the ascent trace file '"
+                <<file_name<<"'");
+    return;
+  }
+  trace.to_json_stream(stream);
+  stream.close();
+
+  clear();
+}
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
@@ -0,0 +1,276 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_tracer.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef ASCENT_TRACER_HPP
+#define ASCENT_TRACER_HPP
+
+#include <ascent_exports.h>
+#include <conduit.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+//
+// Tracer records fixed size binary events into per-thread ring buffers.
+// Tracing is always compiled in, and toggled at runtime. When disabled
+// the cost of a trace point is a single branch. Recorded events are only
+// formatted on export, as Chrome/Perfetto trace event json (one file per
+// rank, see the trace_merge utility to combine them).
+//
+//-----------------------------------------------------------------------------
+class ASCENT_API Tracer
+{
+public:
+  enum EventType
+  {
+    BEGIN   = 0, // start of a duration event
+    END     = 1, // end of the most recent duration event
+    VALUE   = 2, // named numeric value
+    STRING  = 3, // named string value
+    COUNTER = 4  // numeric counter sample
+  };
+
+  // 32 bytes, no pointers
+  struct Event
+  {
+    conduit::uint64  m_time;   // wall time in nanoseconds
+    conduit::float64 m_value;  // VALUE and COUNTER payload
+    conduit::uint32  m_name;   // interned name
+    conduit::uint32  m_string; // interned STRING payload
+    conduit::uint8   m_type;
+    conduit::uint8   m_pad[7];
+  };
+
+  // a ring buffer written by a single thread. The buffer's mutex is
+  // only contended while another thread exports, clears or resizes it
+  struct ThreadBuffer
+  {
+    std::mutex         m_mutex;
+    std::vector<Event> m_events;
+    conduit::uint64    m_count;  // total events ever recorded
+    int                m_thread_id;
+    std::unordered_map<std::string, conduit::uint32> m_names;
+    // STRING payloads, a smaller ring next to the events
+    std::vector<std::string> m_values;
+    conduit::uint64          m_value_count;
+    // duration events this thread began and has not ended
+    size_t                   m_depth;
+  };
+
+  // names interned beyond this many are all exported as "<other>"
+  static const conduit::uint32 max_names = 1 << 16;
+
+  ~Tracer();
+  static Tracer *instance();
+
+  static bool enabled() { return m_enabled.load(std::memory_order_relaxed); }
+  void enable(bool on);
+  // enables tracing if the ASCENT_TRACE env var asks for it,
+  // disables it otherwise
+  void enable_default();
+  void rank(int rank);
+  // number of events kept per thread before the oldest are overwritten
+  void buffer_size(size_t events);
+
+  void begin(const std::string &name);
+  void end();
+  // duration events the calling thread has open
+  size_t depth();
+  // ends the calling thread's duration events until depth are open
+  void end_to(size_t depth);
+
+  // numeric values are stored as float64, everything else as a string
+  template<typename T>
+  typename std::enable_if<std::is_arithmetic<T>::value>::type
+  add(const std::string &key, const T &value)
+  {
+    record(VALUE, key, static_cast<conduit::float64>(value), 0);
+  }
+
+  // string values are kept per thread, only names are interned
+  template<typename T>
+  typename std::enable_if<!std::is_arithmetic<T>::value>::type
+  add(const std::string &key, const T &value)
+  {
+    record_string(key, to_string(value));
+  }
+
+  void counter(const std::string &name, const conduit::float64 value);
+  // samples the known memory counters (array registry and process rss)
+  void sample_memory();
+
+  // events dropped because a ring buffer wrapped
+  conduit::uint64 dropped() const;
+  // discard all recorded events
+  void clear();
+
+  // chrome trace event format: {"traceEvents": [...]}
+  void to_chrome_trace(conduit::Node &trace);
+  // writes '<prefix>_<rank>.json' and clears the buffers. The prefix
+  // defaults to 'ascent_trace', override with ASCENT_TRACE_PREFIX
+  void write(const std::string &dir = "");
+
+protected:
+  Tracer();
+  Tracer(Tracer const &);
+
+  void record(const EventType type,
+              const std::string &name,
+              const conduit::float64 value,
+              const conduit::uint32 str);
+  void record_string(const std::string &name, const std::string &value);
+  void reset_buffer(ThreadBuffer &buffer);
+  ThreadBuffer &thread_buffer();
+  conduit::uint32 intern(const std::string &name);
+  conduit::uint32 intern(ThreadBuffer &buffer, const std::string &name);
+  conduit::uint64 now() const;
+
+  template<typename T>
+  static std::string to_string(const T &value)
+  {
+    std::stringstream ss;
+    ss<<value;
+    return ss.str();
+  }
+
+  static std::atomic<bool> m_enabled;
+  static class Tracer m_instance;
+
+  mutable std::mutex        m_mutex;
+  std::vector<ThreadBuffer*> m_buffers;
+  std::vector<std::string>  m_strings;
+  std::unordered_map<std::string, conduit::uint32> m_string_ids;
+  size_t                    m_buffer_size;
+  int                       m_rank;
+};
+
+//-----------------------------------------------------------------------------
+// Begins a duration event and ends it when the scope exits, including
+// by an exception, unless close() ended it first. Events begun inside
+// the scope and left open (e.g., by an exception) are ended with it.
+// Tracing that is enabled in between is not picked up.
+//-----------------------------------------------------------------------------
+class ASCENT_API TraceScope
+{
+public:
+  TraceScope(const std::string &name)
+    : m_open(Tracer::enabled()),
+      m_depth(0)
+  {
+    if(m_open)
+    {
+      m_depth = Tracer::instance()->depth();
+      Tracer::instance()->begin(name);
+    }
+  }
+
+  ~TraceScope()
+  {
+    close();
+  }
+
+  void close()
+  {
+    if(m_open)
+    {
+      Tracer::instance()->end_to(m_depth);
+      m_open = false;
+    }
+  }
+
+private:
+  TraceScope(const TraceScope &);
+  TraceScope &operator=(const TraceScope &);
+
+  bool   m_open;
+  size_t m_depth;
+};
+
+#define ASCENT_DATA_OPEN(key)                                       \
+{                                                                   \
+  if(ascent::Tracer::enabled())                                     \
+    ascent::Tracer::instance()->begin(key);                         \
+}
+
+#define ASCENT_DATA_CLOSE()                                         \
+{                                                                   \
+  if(ascent::Tracer::enabled())                                     \
+    ascent::Tracer::instance()->end();                              \
+}
+
+#define ASCENT_DATA_ADD(key,value)                                  \
+{                                                                   \
+  if(ascent::Tracer::enabled())                                     \
+    ascent::Tracer::instance()->add(key, value);                    \
+}
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
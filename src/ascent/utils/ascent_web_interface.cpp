@@ -145,6 +145,13 @@ WebInterface::Enable()
     m_enabled = true;
 }
 
+//-----------------------------------------------------------------------------
+bool
+WebInterface::Enabled() const
+{
+    return m_enabled;
+}
+
 //-----------------------------------------------------------------------------
 WebSocket *
 WebInterface::Connection()
@@ -304,6 +311,13 @@ void
 WebInterface::Enable()
 {}
 
+//-----------------------------------------------------------------------------
+bool
+WebInterface::Enabled() const
+{
+    return false;
+}
+
 //-----------------------------------------------------------------------------
 void
 WebInterface::PushMessage(const Node &msg)
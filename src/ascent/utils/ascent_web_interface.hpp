@@ -88,6 +88,9 @@ public:
     void                            SetTimeout(int ms_timeout);
 
     void                            Enable();
+    // true if streaming was enabled, callers can skip building
+    // messages when it wasn't
+    bool                            Enabled() const;
 
     void                            PushMessage(const conduit::Node &msg);
     void                            PushRenders(const conduit::Node &renders);
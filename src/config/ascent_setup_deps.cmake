@@ -70,6 +70,11 @@ find_dependency(Conduit REQUIRED
                 NO_DEFAULT_PATH
                 PATHS ${CONDUIT_DIR}/lib/cmake)
 
+###############################################################################
+# Threads (used by async execute)
+###############################################################################
+find_dependency(Threads)
+
 ###############################################################################
 # Setup VTK-h
 ###############################################################################
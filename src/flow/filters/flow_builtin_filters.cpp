@@ -100,6 +100,8 @@ Alias::declare_interface(Node &i)
     i["type_name"]   = "alias";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    // passes its input through
+    i["fields/reads"] = DataType::list();
 }
 
 
@@ -131,6 +133,8 @@ DependentAlias::declare_interface(Node &i)
     i["port_names"].append() = "in";
     i["port_names"].append() = "dummy";
     i["output_port"] = "true";
+    // passes its input through
+    i["fields/reads"] = DataType::list();
 }
 
 
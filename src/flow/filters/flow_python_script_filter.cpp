@@ -119,6 +119,7 @@ class FLOW_API DataWrapper<PyObject>: public Data
     {
         if(data_ptr() != NULL)
         {
+            PythonInterpreter::GILGuard gil;
             PyObject *py_obj =(PyObject*) data_ptr();
             Py_DECREF(py_obj);
             set_data_ptr(NULL);
@@ -223,6 +224,12 @@ PyObject* execute_python(PyObject *py_input,
                          << "def "<< input_func_name << "():\n"
                          << "    return _flow_input\n"
                          << "\n"
+                         << "def "<< input_func_name << "_view(path):\n"
+                         << "    res = _flow_input[path]\n"
+                         << "    if hasattr(res, 'flags'):\n"
+                         << "        res.flags.writeable = False\n"
+                         << "    return res\n"
+                         << "\n"
                          << "def " << set_output_func_name <<  "(out):\n"
                          << "    global _flow_output\n"
                          << "    _flow_output = out\n"
@@ -238,6 +245,7 @@ PyObject* execute_python(PyObject *py_input,
                          << "from " << module_name
                          << " import "
                          << input_func_name << ", "
+                         << input_func_name << "_view, "
                          << set_output_func_name
                          << "\n";
 
@@ -460,10 +468,20 @@ PythonScript::verify_params(const conduit::Node &params,
 //-----------------------------------------------------------------------------
 void PythonScript::execute_python(conduit::Node *n)
 {
+    // python may be inited by our caller, who can release the GIL
+    // while ascent or flow execute (ex: the ascent python module)
+    if(!Py_IsInitialized())
+    {
+        interpreter();
+    }
+    PythonInterpreter::GILGuard gil;
+
     PythonInterpreter *py_interp = interpreter();
     PyObject * py_input = PyConduit_Node_Python_Wrap(n,0);
 
     PyObject *py_res = detail::execute_python(py_input, py_interp, params());
+    // the module holds a ref to the input until the next execute
+    Py_DECREF(py_input);
     set_output<PyObject>(py_res);
 }
 
@@ -475,6 +493,11 @@ PythonScript::execute()
 {
     // make sure we have our interpreter setup b/c
     // we need the python env ready
+    if(!Py_IsInitialized())
+    {
+        interpreter();
+    }
+    PythonInterpreter::GILGuard gil;
 
     if(input(0).check_type<PyObject>())
     {
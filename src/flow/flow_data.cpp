@@ -66,6 +66,17 @@ using namespace std;
 namespace flow
 {
 
+//-----------------------------------------------------------------------------
+template <>
+void
+memory_footprint<conduit::Node>(const conduit::Node *data,
+                                size_t &host_bytes,
+                                size_t &device_bytes)
+{
+    host_bytes   = (size_t) data->total_bytes_allocated();
+    device_bytes = 0;
+}
+
 //-----------------------------------------------------------------------------
 Data::Data(void *data)
 :m_data_ptr(data)
@@ -99,6 +110,15 @@ Data::data_ptr() const
 {
     return m_data_ptr;
 }
+//-----------------------------------------------------------------------------
+void
+Data::memory_usage(size_t &host_bytes,
+                   size_t &device_bytes) const
+{
+    host_bytes   = 0;
+    device_bytes = 0;
+}
+
 //-----------------------------------------------------------------------------
 void
 Data::info(Node &out) const
@@ -107,6 +127,11 @@ Data::info(Node &out) const
     ostringstream oss;
     oss << m_data_ptr;
     out["data_ptr"] = oss.str();
+    size_t host_bytes = 0;
+    size_t device_bytes = 0;
+    memory_usage(host_bytes, device_bytes);
+    out["host_bytes"]   = (uint64) host_bytes;
+    out["device_bytes"] = (uint64) device_bytes;
 }
 
 
@@ -77,6 +77,10 @@ namespace flow
 ///
 ///
 /// Provides a release() method used by the registry to manage result lifetimes.
+///
+/// Provides a memory_usage() method used by the registry and workspace to
+/// account for the memory held by results. Types report their footprint
+/// by specializing flow::memory_footprint<T>().
 //
 //-----------------------------------------------------------------------------
 
@@ -84,6 +88,27 @@ namespace flow
 template <class T>
 class DataWrapper;
 
+//-----------------------------------------------------------------------------
+/// Size hook for wrapped data: reports the host and device bytes held by
+/// an object. The default reports nothing, specialize for types that
+/// can describe their footprint.
+//-----------------------------------------------------------------------------
+template <class T>
+void memory_footprint(const T * /*data*/,
+                      size_t &host_bytes,
+                      size_t &device_bytes)
+{
+    host_bytes   = 0;
+    device_bytes = 0;
+}
+
+// conduit nodes report the bytes they own (externally described data
+// is not counted)
+template <>
+void FLOW_API memory_footprint<conduit::Node>(const conduit::Node *data,
+                                              size_t &host_bytes,
+                                              size_t &device_bytes);
+
 //-----------------------------------------------------------------------------
 class FLOW_API Data
 {
@@ -97,6 +122,9 @@ public:
     virtual Data  *wrap(void *data)   = 0;
     // actually delete the data
     virtual void            release() = 0;
+    // bytes held by the data, zero if the type does not report them
+    virtual void            memory_usage(size_t &host_bytes,
+                                         size_t &device_bytes) const;
 
     void          *data_ptr();
     const  void   *data_ptr() const;
@@ -166,6 +194,18 @@ class FLOW_API DataWrapper: public Data
             set_data_ptr(NULL);
         }
     }
+
+    virtual void memory_usage(size_t &host_bytes,
+                              size_t &device_bytes) const
+    {
+        host_bytes   = 0;
+        device_bytes = 0;
+        if(data_ptr() != NULL)
+        {
+            const T * t = static_cast<const T*>(data_ptr());
+            memory_footprint<T>(t, host_bytes, device_bytes);
+        }
+    }
 };
 
 
@@ -245,6 +245,60 @@ Filter::params()
 }
 
 
+//-----------------------------------------------------------------------------
+bool
+Filter::declare_fields(std::set<std::string> &reads,
+                       std::set<std::string> &produces)
+{
+    const Node &i = interface();
+    if(!i.has_child("fields"))
+    {
+        return false;
+    }
+
+    const Node &p = params();
+    const std::string entries[2] = {"reads", "produces"};
+    std::set<std::string> *results[2] = {&reads, &produces};
+
+    for(int e = 0; e < 2; e++)
+    {
+        if(!i["fields"].has_child(entries[e]))
+        {
+            continue;
+        }
+
+        NodeConstIterator itr(&i["fields"][entries[e]]);
+        while(itr.has_next())
+        {
+            const std::string param = itr.next().as_string();
+            if(!p.has_path(param))
+            {
+                continue;
+            }
+
+            const Node &value = p[param];
+            if(value.dtype().is_string())
+            {
+                results[e]->insert(value.as_string());
+            }
+            else
+            {
+                NodeConstIterator vitr(&value);
+                while(vitr.has_next())
+                {
+                    const Node &v = vitr.next();
+                    if(v.dtype().is_string())
+                    {
+                        results[e]->insert(v.as_string());
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 bool
 Filter::verify_params(const Node &, // unused: params,
@@ -316,6 +370,36 @@ Filter::verify_interface(const Node &i,
         info["info"].append().set("interface provides 'default_params'");
     }
 
+    if(i.has_child("fields"))
+    {
+        NodeConstIterator itr(&i["fields"]);
+        while(itr.has_next())
+        {
+            const Node &curr = itr.next();
+            const std::string entry = itr.name();
+            if(entry != "reads" && entry != "produces")
+            {
+                info["errors"].append().set("interface 'fields' entry '" +
+                                            entry + "' is not "
+                                            "{\"reads\" | \"produces\"}");
+                res = false;
+                continue;
+            }
+
+            NodeConstIterator param_itr(&curr);
+            while(param_itr.has_next())
+            {
+                if(!param_itr.next().dtype().is_string())
+                {
+                    info["errors"].append().set("interface 'fields/" + entry +
+                                                "' must be a list of param names");
+                    res = false;
+                }
+            }
+        }
+        info["info"].append().set("interface declares 'fields'");
+    }
+
 
     return res;
 }
@@ -130,6 +130,18 @@ class Graph;
 ///
 ///  TODO: talk about optional verify_params()
 ///
+///  Filters can also declare which params name the fields they read
+///  from their inputs and the fields they add to their output, which
+///  lets the graph work out the fields each filter output must carry
+///  (see Graph::fields_needed()):
+///
+///    i["fields/reads"].append() = "field";
+///    i["fields/produces"].append() = "output_name";
+///
+///  A param listed there can hold a field name or a list of field names.
+///  Filters whose field use depends on more than their params can
+///  override declare_fields() instead.
+///
 //-----------------------------------------------------------------------------
 
 
@@ -159,6 +171,13 @@ public:
     virtual bool          verify_params(const conduit::Node &params,
                                         conduit::Node &info);
 
+    /// optionally override to declare the fields this filter instance
+    /// reads from its inputs and adds to its output. Returns false when
+    /// they are not known, and the filter may read any field.
+    /// The default uses the "fields" entry of the interface.
+    virtual bool          declare_fields(std::set<std::string> &reads,
+                                         std::set<std::string> &produces);
+
     //-------------------------------------------------------------------------
     // filter interface properties
     //-------------------------------------------------------------------------
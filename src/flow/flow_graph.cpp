@@ -87,7 +87,8 @@ namespace flow
 //-----------------------------------------------------------------------------
 Graph::Graph(Workspace *w)
 :m_workspace(w),
- m_filter_count(0)
+ m_filter_count(0),
+ m_revision(0)
 {
     init();
 }
@@ -121,6 +122,7 @@ Graph::reset()
     m_filters.clear();
     m_edges.reset();
     init();
+    m_revision++;
 
 }
 
@@ -194,6 +196,7 @@ Graph::add_filter(const std::string &filter_type,
     }
 
     m_filter_count++;
+    m_revision++;
 
     return f;
 }
@@ -257,6 +260,7 @@ Graph::connect(const std::string &src_name,
 
     m_edges["in"][des_name][port_name] = src_name;
     m_edges["out"][src_name].append().set(des_name);
+    m_revision++;
 }
 
 //-----------------------------------------------------------------------------
@@ -310,6 +314,7 @@ Graph::remove_filter(const std::string &name)
 
     m_edges["in"].remove(name);
     m_edges["out"].remove(name);
+    m_revision++;
 }
 
 //-----------------------------------------------------------------------------
@@ -319,6 +324,111 @@ Graph::edges() const
     return m_edges;
 }
 
+//-----------------------------------------------------------------------------
+bool
+Graph::fields_needed(const std::string &f_name,
+                     std::set<std::string> &fields)
+{
+    if(!has_filter(f_name))
+    {
+        CONDUIT_ERROR("Cannot compute fields needed by unknown filter '"
+                      << f_name << "'");
+    }
+
+    std::map<std::string,FieldNeeds> needs;
+    const FieldNeeds &res = fields_needed(f_name, needs);
+    fields = res.fields;
+    return res.known;
+}
+
+//-----------------------------------------------------------------------------
+void
+Graph::upstream(const std::string &f_name,
+                std::set<std::string> &names) const
+{
+    if(names.find(f_name) != names.end())
+    {
+        return;
+    }
+
+    if(m_filters.find(f_name) == m_filters.end())
+    {
+        CONDUIT_ERROR("Cannot find the filters upstream of unknown filter '"
+                      << f_name << "'");
+    }
+
+    names.insert(f_name);
+
+    NodeConstIterator itr(&edges_in(f_name));
+    while(itr.has_next())
+    {
+        const Node &src = itr.next();
+        if(src.dtype().is_string())
+        {
+            upstream(src.as_string(), names);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+const Graph::FieldNeeds &
+Graph::fields_needed(const std::string &f_name,
+                     std::map<std::string,FieldNeeds> &needs)
+{
+    auto it = needs.find(f_name);
+    if(it != needs.end())
+    {
+        return it->second;
+    }
+
+    // the graph is acyclic, so this entry is filled before
+    // anyone can ask for it again
+    FieldNeeds &res = needs[f_name];
+    res.known = true;
+
+    std::set<std::string> consumers;
+    NodeConstIterator itr(&edges_out(f_name));
+    while(itr.has_next())
+    {
+        consumers.insert(itr.next().as_string());
+    }
+
+    for(auto c = consumers.begin(); c != consumers.end() && res.known; ++c)
+    {
+        std::set<std::string> reads;
+        std::set<std::string> produces;
+        if(!m_filters[*c]->declare_fields(reads, produces))
+        {
+            res.known = false;
+            break;
+        }
+
+        // what the consumer passes through to its own consumers
+        const FieldNeeds &down = fields_needed(*c, needs);
+        if(!down.known)
+        {
+            res.known = false;
+            break;
+        }
+
+        res.fields.insert(reads.begin(), reads.end());
+        for(auto f = down.fields.begin(); f != down.fields.end(); ++f)
+        {
+            if(produces.find(*f) == produces.end())
+            {
+                res.fields.insert(*f);
+            }
+        }
+    }
+
+    if(!res.known)
+    {
+        res.fields.clear();
+    }
+
+    return res;
+}
+
 //-----------------------------------------------------------------------------
 const Node &
 Graph::edges_out(const std::string &f_name) const
@@ -341,6 +451,13 @@ Graph::filters()
     return m_filters;
 }
 
+//-----------------------------------------------------------------------------
+int
+Graph::revision() const
+{
+    return m_revision;
+}
+
 
 //-----------------------------------------------------------------------------
 void
@@ -148,6 +148,17 @@ public:
     /// remove all filters
     void reset();
 
+    /// collects the fields the output of the named filter must carry
+    /// for the filters downstream of it, from the fields they declare
+    /// they read and produce (see Filter::declare_fields()).
+    /// Returns false when a downstream filter may read any field.
+    bool fields_needed(const std::string &f_name,
+                       std::set<std::string> &fields);
+
+    /// collects the named filter and all filters it depends on
+    void upstream(const std::string &f_name,
+                  std::set<std::string> &names) const;
+
     /// save graph graph state to a conduit tree,
     /// which can be used to restore the graph with load
     void save(conduit::Node &n);
@@ -213,13 +224,26 @@ private:
     const conduit::Node &edges_in(const std::string &f_name)  const;
     const conduit::Node &edges_out(const std::string &f_name) const;
 
+    // memoized worker for fields_needed()
+    struct FieldNeeds
+    {
+        bool                  known;
+        std::set<std::string> fields;
+    };
+    const FieldNeeds    &fields_needed(const std::string &f_name,
+                                       std::map<std::string,FieldNeeds> &needs);
+
     std::map<std::string,Filter*> &filters();
 
+    // incremented whenever filters or connections change
+    int                  revision() const;
+
 
     Workspace                       *m_workspace;
     conduit::Node                    m_edges;
     std::map<std::string,Filter*>    m_filters;
     int                              m_filter_count;
+    int                              m_revision;
 
 };
 
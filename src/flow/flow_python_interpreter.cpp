@@ -58,6 +58,7 @@
 #include <string.h>
 #include <limits.h>
 #include <cstdlib>
+#include <sys/stat.h>
 
 using namespace std;
 
@@ -461,6 +462,8 @@ PythonInterpreter::shutdown()
 {
     if(m_running)
     {
+        clear_code_cache();
+
         if(m_handled_init)
         {
             Py_Finalize();
@@ -517,6 +520,64 @@ PythonInterpreter::run_script_file(const std::string &fname)
 bool
 PythonInterpreter::run_script(const std::string &script,
                               PyObject *py_dict)
+{
+    return exec_script(script, "<string>", py_dict);
+}
+
+//-----------------------------------------------------------------------------
+///
+/// Executes passed python script in the interpreter
+///
+/// Note: Adapted from VisIt: src/avt/PythonFilters/PythonInterpreter.cpp
+//-----------------------------------------------------------------------------
+bool
+PythonInterpreter::run_script_file(const std::string &fname,
+                                   PyObject *py_dict)
+{
+    struct stat f_stat;
+    if(stat(fname.c_str(), &f_stat) != 0)
+    {
+        CONDUIT_ERROR("PythonInterpreter::run_script_file " 
+                      " failed to open "<< fname);
+        return false;
+    }
+
+    // only re-read the file if it changed since the last run
+    std::map<std::string,ScriptFile>::iterator itr = m_file_cache.find(fname);
+    if(itr == m_file_cache.end() ||
+       itr->second.mtime != (long long) f_stat.st_mtime ||
+       itr->second.size  != (long long) f_stat.st_size)
+    {
+        ifstream ifs(fname.c_str());
+        if(!ifs.is_open())
+        {        
+            CONDUIT_ERROR("PythonInterpreter::run_script_file " 
+                          " failed to open "<< fname);
+            return false;
+        }
+
+        ScriptFile &entry = m_file_cache[fname];
+        entry.mtime  = (long long) f_stat.st_mtime;
+        entry.size   = (long long) f_stat.st_size;
+        entry.source = string((istreambuf_iterator<char>(ifs)),
+                              istreambuf_iterator<char>());
+        ifs.close();
+        itr = m_file_cache.find(fname);
+    }
+
+    return exec_script(itr->second.source, fname, py_dict);
+}
+
+//-----------------------------------------------------------------------------
+///
+/// Compiles and runs the passed script, reusing the code object from
+/// a previous run of the same source
+///
+//-----------------------------------------------------------------------------
+bool
+PythonInterpreter::exec_script(const std::string &script,
+                               const std::string &fname,
+                               PyObject *py_dict)
 {
     bool res = false;
     if(m_running)
@@ -528,10 +589,22 @@ PythonInterpreter::run_script(const std::string &script,
             CONDUIT_INFO("PythonInterpreter::run_script " << script);
         }
 
-        PyRun_String((char*)script.c_str(),
-                     Py_file_input,
-                     py_dict,
-                     py_dict);
+        PyObject *py_code = compile_script(script, fname);
+
+        if(py_code != NULL)
+        {
+#ifdef IS_PY3K
+            PyObject *py_res = PyEval_EvalCode(py_code,
+                                               py_dict,
+                                               py_dict);
+#else
+            PyObject *py_res = PyEval_EvalCode((PyCodeObject*)py_code,
+                                               py_dict,
+                                               py_dict);
+#endif
+            Py_XDECREF(py_res);
+        }
+
         if(!check_error())
             res = true;
     }
@@ -539,26 +612,65 @@ PythonInterpreter::run_script(const std::string &script,
 }
 
 //-----------------------------------------------------------------------------
-///
-/// Executes passed python script in the interpreter
-///
-/// Note: Adapted from VisIt: src/avt/PythonFilters/PythonInterpreter.cpp
+PyObject *
+PythonInterpreter::compile_script(const std::string &script,
+                                  const std::string &fname)
+{
+    // scripts generated on the fly could otherwise grow
+    // the cache without bound
+    const size_t max_cache_size = 256;
+
+    std::string key = fname;
+    key.push_back('\0');
+    key += script;
+
+    std::unordered_map<std::string,PyObject*>::iterator itr;
+    itr = m_code_cache.find(key);
+    if(itr != m_code_cache.end())
+    {
+        return itr->second;
+    }
+
+    PyObject *py_code = Py_CompileString(script.c_str(),
+                                         fname.c_str(),
+                                         Py_file_input);
+    if(py_code == NULL)
+    {
+        return NULL;
+    }
+
+    if(m_code_cache.size() >= max_cache_size)
+    {
+        clear_code_cache();
+    }
+
+    m_code_cache[key] = py_code;
+    return py_code;
+}
+
 //-----------------------------------------------------------------------------
-bool
-PythonInterpreter::run_script_file(const std::string &fname,
-                                   PyObject *py_dict)
+void
+PythonInterpreter::clear_code_cache()
 {
-    ifstream ifs(fname.c_str());
-    if(!ifs.is_open())
-    {        
-        CONDUIT_ERROR("PythonInterpreter::run_script_file " 
-                      " failed to open "<< fname);
-        return false;
+    std::unordered_map<std::string,PyObject*>::iterator itr;
+    for(itr = m_code_cache.begin(); itr != m_code_cache.end(); ++itr)
+    {
+        Py_DECREF(itr->second);
     }
-    string py_script((istreambuf_iterator<char>(ifs)),
-                     istreambuf_iterator<char>());
-    ifs.close();
-    return run_script(py_script, py_dict);
+    m_code_cache.clear();
+    m_file_cache.clear();
+}
+
+//-----------------------------------------------------------------------------
+PythonInterpreter::GILGuard::GILGuard()
+{
+    m_state = PyGILState_Ensure();
+}
+
+//-----------------------------------------------------------------------------
+PythonInterpreter::GILGuard::~GILGuard()
+{
+    PyGILState_Release(m_state);
 }
 
 
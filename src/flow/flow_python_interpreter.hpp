@@ -56,6 +56,8 @@
 
 #include <flow_exports.h>
 #include <string>
+#include <map>
+#include <unordered_map>
 #include <conduit.hpp>
 
 //-----------------------------------------------------------------------------
@@ -111,6 +113,11 @@ public:
     bool         run_script_file(const std::string &fname,
                                  PyObject *py_dict);
 
+    /// compiled code objects are cached by source, and file contents
+    /// are cached until the file's size or modification time changes
+    size_t       code_cache_size() const { return m_code_cache.size(); }
+    void         clear_code_cache();
+
     /// set into global dict
     bool         set_global_object(PyObject *py_obj,
                                    const std::string &name);
@@ -142,7 +149,25 @@ public:
     static bool  PyObject_to_int(PyObject *py_obj,
                                  int &res);
 
+    /// holds the GIL for the calling thread while in scope,
+    /// for use when python was inited by someone else
+    class FLOW_API GILGuard
+    {
+    public:
+         GILGuard();
+        ~GILGuard();
+    private:
+        PyGILState_STATE m_state;
+    };
+
 private:
+    /// returns a borrowed ref to the cached code object for script
+    PyObject    *compile_script(const std::string &script,
+                                const std::string &fname);
+    bool         exec_script(const std::string &script,
+                             const std::string &fname,
+                             PyObject *py_dict);
+
     bool         PyTraceback_to_string(PyObject *py_etype,
                                        PyObject *py_eval,
                                        PyObject *py_etrace,
@@ -162,6 +187,16 @@ private:
     PyObject    *m_py_trace_print_exception_func;
     PyObject    *m_py_sio_class;
 
+    struct ScriptFile
+    {
+        long long    mtime;
+        long long    size;
+        std::string  source;
+    };
+
+    std::unordered_map<std::string,PyObject*>  m_code_cache;
+    std::map<std::string,ScriptFile>           m_file_cache;
+
 };
 
 
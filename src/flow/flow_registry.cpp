@@ -112,22 +112,32 @@ public:
 
             void          *data_ptr();
 
+            size_t         host_bytes() const;
+            size_t         device_bytes() const;
+            void           sample_memory_usage();
+
         private:
             Ref            m_ref;
             Data *m_data;
+            size_t         m_host_bytes;
+            size_t         m_device_bytes;
     };
 
     class Entry
     {
         public:
-                 Entry(Value *, int refs_needed);
+                 Entry(const std::string &key,
+                       Value *,
+                       int refs_needed);
                  ~Entry();
 
+                 const std::string &key() const;
                  Value          *value();
                  Data  *data();
                  Ref            *ref();
 
         private:
+            std::string m_key;
             Ref    m_ref;
             Value *m_value;
 
@@ -150,9 +160,15 @@ public:
     Value *fetch_value(void *data_ptr);
 
     void   dec(const std::string &key);
+    void   dec(Entry *ent);
 
     void   detach(const std::string &key);
 
+    void   memory_usage(size_t &host_bytes,
+                        size_t &device_bytes) const;
+
+    void   sample_memory_usage();
+
     void   info(Node &out) const;
 
     void   reset();
@@ -251,9 +267,12 @@ Registry::Map::Ref::inc(int amt)
 Registry::Map::Value::Value(Data &data,
                             int refs_needed)
 :m_ref(refs_needed),
- m_data(NULL)
+ m_data(NULL),
+ m_host_bytes(0),
+ m_device_bytes(0)
 {
     m_data = data.wrap(data.data_ptr());
+    sample_memory_usage();
 }
 
 //-----------------------------------------------------------------------------
@@ -288,6 +307,27 @@ Registry::Map::Value::ref()
     return &m_ref;
 }
 
+//-----------------------------------------------------------------------------
+size_t
+Registry::Map::Value::host_bytes() const
+{
+    return m_host_bytes;
+}
+
+//-----------------------------------------------------------------------------
+size_t
+Registry::Map::Value::device_bytes() const
+{
+    return m_device_bytes;
+}
+
+//-----------------------------------------------------------------------------
+void
+Registry::Map::Value::sample_memory_usage()
+{
+    m_data->memory_usage(m_host_bytes, m_device_bytes);
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 //
@@ -299,8 +339,11 @@ Registry::Map::Value::ref()
 
 //-----------------------------------------------------------------------------
 
-Registry::Map::Entry::Entry(Value *value, int refs_needed)
-: m_ref(refs_needed),
+Registry::Map::Entry::Entry(const std::string &key,
+                            Value *value,
+                            int refs_needed)
+: m_key(key),
+  m_ref(refs_needed),
   m_value(value)
 {
     // empty
@@ -312,6 +355,13 @@ Registry::Map::Entry::~Entry()
     // empty
 }
 
+//-----------------------------------------------------------------------------
+const std::string &
+Registry::Map::Entry::key() const
+{
+    return m_key;
+}
+
 //-----------------------------------------------------------------------------
 Registry::Map::Value *
 Registry::Map::Entry::value()
@@ -379,7 +429,7 @@ Registry::Map::add(const std::string &key,
         val->ref()->inc(refs_needed);
 
         // create a new entry assoced with this pointer
-        Entry *ent = new Entry(val,refs_needed);
+        Entry *ent = new Entry(key,val,refs_needed);
         // add to our entries
         m_entries[key] = ent;
     }
@@ -391,7 +441,7 @@ Registry::Map::add(const std::string &key,
         Value *val = new Value(data,refs_needed);
         m_values[data_ptr] = val;
 
-        Entry *ent = new Entry(val,refs_needed);
+        Entry *ent = new Entry(key,val,refs_needed);
         m_entries[key] = ent;
     }
 }
@@ -434,8 +484,13 @@ Registry::Map::has_value(void *data_ptr)
 void
 Registry::Map::dec(const std::string &key)
 {
+    dec(fetch_entry(key));
+}
 
-    Entry *ent   = fetch_entry(key);
+//-----------------------------------------------------------------------------
+void
+Registry::Map::dec(Entry *ent)
+{
     Value *value = ent->value();
 
     int ent_refs = ent->ref()->dec();
@@ -443,8 +498,8 @@ Registry::Map::dec(const std::string &key)
     if(ent_refs == 0)
     {
         // clean up bookkeeping obj
+        m_entries.erase(ent->key());
         delete ent;
-        m_entries.erase(key);
     }
 
     int val_refs = value->ref()->dec();
@@ -485,6 +540,41 @@ Registry::Map::detach(const std::string &key)
 }
 
 
+//-----------------------------------------------------------------------------
+void
+Registry::Map::memory_usage(size_t &host_bytes,
+                            size_t &device_bytes) const
+{
+    host_bytes   = 0;
+    device_bytes = 0;
+
+    std::map<void*,Value*>::const_iterator vitr;
+    for(vitr = m_values.begin(); vitr != m_values.end(); vitr++)
+    {
+        Value *v = vitr->second;
+        if(v->ref()->tracked())
+        {
+            host_bytes   += v->host_bytes();
+            device_bytes += v->device_bytes();
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+Registry::Map::sample_memory_usage()
+{
+    std::map<void*,Value*>::iterator vitr;
+    for(vitr = m_values.begin(); vitr != m_values.end(); vitr++)
+    {
+        Value *v = vitr->second;
+        if(v->ref()->tracked())
+        {
+            v->sample_memory_usage();
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 void
 Registry::Map::info(Node &out) const
@@ -511,6 +601,8 @@ Registry::Map::info(Node &out) const
         oss << vitr->first;
         Value *v= vitr->second;
         ptrs[oss.str()]["pending"] = v->ref()->pending();
+        ptrs[oss.str()]["host_bytes"]   = (uint64) v->host_bytes();
+        ptrs[oss.str()]["device_bytes"] = (uint64) v->device_bytes();
         oss.str("");
     }
 
@@ -579,6 +671,33 @@ Registry::has_entry(const std::string &key)
     return m_map->has_entry(key);
 }
 
+//-----------------------------------------------------------------------------
+Registry::Handle
+Registry::handle(const std::string &key)
+{
+    if(!m_map->has_entry(key))
+    {
+        print();
+        CONDUIT_ERROR("Attempt to fetch unknown key: " << key);
+    }
+
+    return m_map->fetch_entry(key);
+}
+
+//-----------------------------------------------------------------------------
+Data &
+Registry::fetch(Handle h)
+{
+    return *static_cast<Map::Entry*>(h)->data();
+}
+
+//-----------------------------------------------------------------------------
+void
+Registry::consume(Handle h)
+{
+    m_map->dec(static_cast<Map::Entry*>(h));
+}
+
 //-----------------------------------------------------------------------------
 void
 Registry::consume(const std::string &key)
@@ -607,6 +726,37 @@ Registry::reset()
     m_map->reset();
 }
 
+//-----------------------------------------------------------------------------
+void
+Registry::memory_usage(const std::string &key,
+                       size_t &host_bytes,
+                       size_t &device_bytes)
+{
+    host_bytes   = 0;
+    device_bytes = 0;
+    if(m_map->has_entry(key))
+    {
+        Map::Value *value = m_map->fetch_entry(key)->value();
+        host_bytes   = value->host_bytes();
+        device_bytes = value->device_bytes();
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+Registry::memory_usage(size_t &host_bytes,
+                       size_t &device_bytes) const
+{
+    m_map->memory_usage(host_bytes, device_bytes);
+}
+
+//-----------------------------------------------------------------------------
+void
+Registry::sample_memory_usage()
+{
+    m_map->sample_memory_usage();
+}
+
 
 //-----------------------------------------------------------------------------
 void
@@ -159,6 +159,18 @@ public:
     /// check if the registry contains entry with given name
     bool           has_entry(const std::string &key);
 
+    /// opaque handle to an entry, used to access it repeatedly without
+    /// key lookups. A handle is valid until its entry is consumed for the
+    /// last time, detached, or the registry is reset.
+    typedef void *Handle;
+
+    /// returns a handle for the entry with the given key
+    Handle         handle(const std::string &key);
+    /// fetch entry by handle, does not decrement refs_needed
+    Data          &fetch(Handle h);
+    /// consume() by handle
+    void           consume(Handle h);
+
     /// decrement refs needed if entry is tracked,
     ///  if refs_needed = 0 releases the data held by the entry.
     void           consume(const std::string &key);
@@ -170,6 +182,21 @@ public:
     /// tracked data refs.
     void           reset();
 
+    /// bytes held by the data of the entry with the given key.
+    /// footprints are sampled when the data is added and when
+    /// sample_memory_usage() is called.
+    void           memory_usage(const std::string &key,
+                                size_t &host_bytes,
+                                size_t &device_bytes);
+
+    /// bytes held by all tracked data (each pointer is counted once)
+    void           memory_usage(size_t &host_bytes,
+                                size_t &device_bytes) const;
+
+    /// re-samples the footprints of all tracked data, for data that
+    /// changed after it was added (e.g., cached conversions)
+    void           sample_memory_usage();
+
     /// create human understandable tree that describes the state
     /// of the registry
     void           info(conduit::Node &out) const;
@@ -57,6 +57,9 @@
 #include <string.h>
 #include <limits.h>
 #include <cstdlib>
+#include <mutex>
+#include <set>
+#include <vector>
 
 using namespace conduit;
 using namespace std;
@@ -72,6 +75,8 @@ namespace flow
 // pick a safe non-inited value w/o the mpi headers, but
 // we will try this strategy.
 int Workspace::m_default_mpi_comm = -1;
+Workspace::FilterExecuteCallback Workspace::m_before_execute = NULL;
+Workspace::FilterExecuteCallback Workspace::m_after_execute  = NULL;
 static int g_timing_exec_count = 0;
 
 //-----------------------------------------------------------------------------
@@ -82,6 +87,13 @@ class Workspace::ExecutionPlan
         static void generate(Graph &g,
                              conduit::Node &traversals);
 
+        // reorders the filters into a single traversal that runs the
+        // filter releasing the most memory first, using the given
+        // output sizes (sizes[filter_name] = bytes)
+        static void generate_memory_aware(Graph &g,
+                                          const conduit::Node &sizes,
+                                          conduit::Node &traversals);
+
     private:
         ExecutionPlan();
         ~ExecutionPlan();
@@ -92,6 +104,47 @@ class Workspace::ExecutionPlan
                                        conduit::Node &tarv);
 };
 
+//-----------------------------------------------------------------------------
+// Flat form of the traversals: filters in execution order with their
+// inputs resolved to the index of the step that produces them.
+// Compiled once and reused until the graph changes.
+//-----------------------------------------------------------------------------
+class Workspace::CompiledPlan
+{
+    public:
+
+        struct Step
+        {
+            Filter                   *m_filter;
+            std::string               m_name;
+            int                       m_uref;
+            bool                      m_has_output;
+            std::vector<std::string>  m_port_names;
+            // index of the step that produces each port's input
+            std::vector<int>          m_input_steps;
+        };
+
+        CompiledPlan();
+        ~CompiledPlan();
+
+        void compile(Graph &graph,
+                     const conduit::Node &traversals);
+
+        // true if the traversals run the same filters in the same order
+        bool matches(const conduit::Node &traversals) const;
+
+        // forces the next execute to compile again
+        void invalidate();
+
+        // graph revision this plan was compiled from, -1 if never
+        int                       revision() const;
+        const std::vector<Step>  &steps() const;
+
+    private:
+        std::vector<Step>  m_steps;
+        int                m_revision;
+};
+
 //-----------------------------------------------------------------------------
 class Workspace::FilterFactory
 {
@@ -102,13 +155,130 @@ public:
         return m_filter_types;
     }
 
+    // workspaces in different threads can create filters while others
+    // register new types
+    static std::mutex &types_mutex()
+    {
+        return m_types_mutex;
+    }
+
 private:
     static std::map<std::string,FilterFactoryMethod> m_filter_types;
+    static std::mutex m_types_mutex;
 };
 
 //-----------------------------------------------------------------------------
 std::map<std::string,FilterFactoryMethod> Workspace::FilterFactory::m_filter_types;
+std::mutex Workspace::FilterFactory::m_types_mutex;
+
 
+//-----------------------------------------------------------------------------
+Workspace::CompiledPlan::CompiledPlan()
+: m_revision(-1)
+{
+    // empty
+}
+
+//-----------------------------------------------------------------------------
+Workspace::CompiledPlan::~CompiledPlan()
+{
+    // empty
+}
+
+//-----------------------------------------------------------------------------
+int
+Workspace::CompiledPlan::revision() const
+{
+    return m_revision;
+}
+
+//-----------------------------------------------------------------------------
+const std::vector<Workspace::CompiledPlan::Step> &
+Workspace::CompiledPlan::steps() const
+{
+    return m_steps;
+}
+
+//-----------------------------------------------------------------------------
+bool
+Workspace::CompiledPlan::matches(const conduit::Node &traversals) const
+{
+    size_t s_idx = 0;
+    NodeConstIterator travs_itr = traversals.children();
+    while(travs_itr.has_next())
+    {
+        NodeConstIterator trav_itr(&travs_itr.next());
+        while(trav_itr.has_next())
+        {
+            const Node &t = trav_itr.next();
+            if(s_idx >= m_steps.size() ||
+               m_steps[s_idx].m_name != trav_itr.name() ||
+               m_steps[s_idx].m_uref != t.to_int32())
+            {
+                return false;
+            }
+            s_idx++;
+        }
+    }
+    return s_idx == m_steps.size();
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::CompiledPlan::invalidate()
+{
+    m_revision = -1;
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::CompiledPlan::compile(Graph &graph,
+                                 const conduit::Node &traversals)
+{
+    m_steps.clear();
+
+    std::map<std::string,int> step_index;
+
+    NodeConstIterator travs_itr = traversals.children();
+    while(travs_itr.has_next())
+    {
+        NodeConstIterator trav_itr(&travs_itr.next());
+        while(trav_itr.has_next())
+        {
+            const Node &t = trav_itr.next();
+
+            Step step;
+            step.m_name       = trav_itr.name();
+            step.m_uref       = t.to_int32();
+            step.m_filter     = graph.m_filters[step.m_name];
+            step.m_has_output = step.m_filter->output_port();
+
+            // traversals are topologically sorted, so every input
+            // has already been assigned a step
+            NodeConstIterator ports_itr(&step.m_filter->port_names());
+            while(ports_itr.has_next())
+            {
+                std::string port_name = ports_itr.next().as_string();
+                std::string f_input_name = graph.edges_in(step.m_name)[port_name].as_string();
+                std::map<std::string,int>::const_iterator s_itr;
+                s_itr = step_index.find(f_input_name);
+                if(s_itr == step_index.end())
+                {
+                    CONDUIT_ERROR("Filter " << step.m_filter->detailed_name()
+                                  << " input " << f_input_name
+                                  << " is not scheduled before it");
+                }
+                step.m_port_names.push_back(port_name);
+                step.m_input_steps.push_back(s_itr->second);
+            }
+
+            step_index[step.m_name] = (int)m_steps.size();
+            m_steps.push_back(step);
+        }
+    }
+
+    m_revision = graph.revision();
+}
 
 //-----------------------------------------------------------------------------
 Workspace::ExecutionPlan::ExecutionPlan()
@@ -186,6 +356,156 @@ Workspace::ExecutionPlan::generate(Graph &graph,
 }
 
 
+//-----------------------------------------------------------------------------
+void
+Workspace::ExecutionPlan::generate_memory_aware(Graph &graph,
+                                                const conduit::Node &sizes,
+                                                conduit::Node &traversals)
+{
+    // the default plan determines which filters run, their refs
+    // and the order used to break ties
+    Node base_travs;
+    generate(graph, base_travs);
+
+    std::vector<std::string> names;
+    std::map<std::string,int> urefs;
+    std::map<std::string,int> order;
+
+    NodeIterator travs_itr = base_travs.children();
+    while(travs_itr.has_next())
+    {
+        NodeIterator trav_itr(&travs_itr.next());
+        while(trav_itr.has_next())
+        {
+            Node &t = trav_itr.next();
+            std::string f_name = trav_itr.name();
+            order[f_name] = (int)names.size();
+            urefs[f_name] = t.to_int32();
+            names.push_back(f_name);
+        }
+    }
+
+    // inputs of each filter (one per port) and refs left on each output
+    std::map<std::string,std::vector<std::string> > inputs;
+    std::map<std::string,int> refs_left;
+    std::map<std::string,int> inputs_left;
+
+    for(size_t i = 0; i < names.size(); ++i)
+    {
+        const std::string &f_name = names[i];
+        Filter *f = graph.m_filters[f_name];
+        refs_left[f_name] = 0;
+        if(f->output_port())
+        {
+            refs_left[f_name] = graph.edges_out(f_name).number_of_children();
+        }
+
+        NodeConstIterator ports_itr(&f->port_names());
+        while(ports_itr.has_next())
+        {
+            std::string port_name = ports_itr.next().as_string();
+            inputs[f_name].push_back(graph.edges_in(f_name)[port_name].as_string());
+        }
+        inputs_left[f_name] = (int)inputs[f_name].size();
+    }
+
+    // sizes we haven't seen yet count as a single byte, so that
+    // consumers that release their inputs still run first
+    std::map<std::string,double> f_sizes;
+    for(size_t i = 0; i < names.size(); ++i)
+    {
+        const std::string &f_name = names[i];
+        f_sizes[f_name] = 1.0;
+        if(sizes.has_child(f_name) && sizes[f_name].to_float64() > 0.0)
+        {
+            f_sizes[f_name] = sizes[f_name].to_float64();
+        }
+    }
+
+    std::set<std::string> ready;
+    for(size_t i = 0; i < names.size(); ++i)
+    {
+        if(inputs_left[names[i]] == 0)
+        {
+            ready.insert(names[i]);
+        }
+    }
+
+    Node &trav = traversals.append();
+
+    while(!ready.empty())
+    {
+        std::string best;
+        double best_score = 0.0;
+
+        std::set<std::string>::const_iterator r_itr;
+        for(r_itr = ready.begin(); r_itr != ready.end(); r_itr++)
+        {
+            const std::string &f_name = *r_itr;
+            const std::vector<std::string> &f_inputs = inputs[f_name];
+
+            // bytes released by running this filter
+            std::map<std::string,int> uses;
+            for(size_t i = 0; i < f_inputs.size(); ++i)
+            {
+                uses[f_inputs[i]]++;
+            }
+
+            double score = 0.0;
+            std::map<std::string,int>::const_iterator u_itr;
+            for(u_itr = uses.begin(); u_itr != uses.end(); u_itr++)
+            {
+                if(refs_left[u_itr->first] == u_itr->second)
+                {
+                    score += f_sizes[u_itr->first];
+                }
+            }
+
+            // minus the bytes it creates
+            if(graph.m_filters[f_name]->output_port())
+            {
+                score -= f_sizes[f_name];
+            }
+
+            if(best.empty() ||
+               score > best_score ||
+               (score == best_score && order[f_name] < order[best]))
+            {
+                best = f_name;
+                best_score = score;
+            }
+        }
+
+        ready.erase(best);
+        trav[best] = urefs[best];
+
+        const std::vector<std::string> &b_inputs = inputs[best];
+        for(size_t i = 0; i < b_inputs.size(); ++i)
+        {
+            refs_left[b_inputs[i]]--;
+        }
+
+        if(!graph.m_filters[best]->output_port())
+        {
+            continue;
+        }
+
+        NodeConstIterator outs_itr(&graph.edges_out(best));
+        while(outs_itr.has_next())
+        {
+            std::string consumer = outs_itr.next().as_string();
+            if(inputs_left.find(consumer) != inputs_left.end())
+            {
+                inputs_left[consumer]--;
+                if(inputs_left[consumer] == 0)
+                {
+                    ready.insert(consumer);
+                }
+            }
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 void
 Workspace::ExecutionPlan::bf_topo_sort_visit(Graph &graph,
@@ -253,14 +573,23 @@ Workspace::Workspace()
 :m_graph(this),
  m_registry(),
  m_timing_info(),
- m_enable_timings(false)
+ m_enable_timings(false),
+ m_record_filter_times(false),
+ m_enable_memory_accounting(false),
+ m_memory_aware_scheduling(false),
+ m_output_sizes_changed(false),
+ m_sample_memory(false),
+ m_memory_budget(0),
+ m_plan(NULL)
 {
-
+    m_plan = new CompiledPlan();
+    reset_memory_info();
 }
 
 //-----------------------------------------------------------------------------
 Workspace::~Workspace()
 {
+    delete m_plan;
 
 }
 
@@ -298,7 +627,15 @@ void
 Workspace::traversals(Node &traversals)
 {
     traversals.reset();
-    ExecutionPlan::generate(graph(),traversals);
+    if(m_memory_aware_scheduling)
+    {
+        // use output sizes recorded during previous executions
+        ExecutionPlan::generate_memory_aware(graph(),m_output_sizes,traversals);
+    }
+    else
+    {
+        ExecutionPlan::generate(graph(),traversals);
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -306,70 +643,190 @@ void
 Workspace::execute()
 {
     Timer t_total_exec;
-    Node traversals;
-    ExecutionPlan::generate(graph(),traversals);
-    // execute traversals
-    NodeIterator travs_itr = traversals.children();
+    m_filter_times.clear();
 
-    while(travs_itr.has_next())
+    if(m_enable_memory_accounting)
     {
-        NodeIterator trav_itr(&travs_itr.next());
+        // memory info describes the last execution
+        reset_memory_info();
+    }
 
-        while(trav_itr.has_next())
+    // the plan only changes with the graph, unless we are scheduling
+    // with sizes that changed since it was compiled
+    if(m_plan->revision() != graph().revision())
+    {
+        Node traversals;
+        this->traversals(traversals);
+        m_plan->compile(graph(), traversals);
+    }
+    else if(m_memory_aware_scheduling && m_output_sizes_changed)
+    {
+        Node traversals;
+        this->traversals(traversals);
+        if(!m_plan->matches(traversals))
         {
-            Node &t = trav_itr.next();
+            m_plan->compile(graph(), traversals);
+        }
+    }
+    m_output_sizes_changed = false;
 
-            std::string  f_name = trav_itr.name();
-            int          uref   = t.to_int32();
-            Filter      *f      = graph().filters()[f_name];
+    const std::vector<CompiledPlan::Step> &steps = m_plan->steps();
+    const size_t num_steps = steps.size();
 
-            f->reset_inputs_and_output();
+    // registry handles and pending refs of each step's output
+    std::vector<Registry::Handle> handles(num_steps, NULL);
+    std::vector<int>              pending(num_steps, 0);
 
-            // fetch inputs from reg, attach to filter's ports
-            NodeConstIterator ports_itr = NodeConstIterator(&f->port_names());
-            //registry().print();
-            std::vector<std::string> f_i_names;
-            while(ports_itr.has_next())
+    // which steps run, and the refs their outputs get from steps that run
+    std::vector<bool> run(num_steps, true);
+    std::vector<int>  urefs(num_steps, 0);
+    for(size_t s_idx = 0; s_idx < num_steps; ++s_idx)
+    {
+        urefs[s_idx] = steps[s_idx].m_uref;
+    }
+
+    if(!m_gated_filters.empty())
+    {
+        // skip gated steps and the steps that need their output
+        std::vector<int> uses(num_steps, 0);
+        for(size_t s_idx = 0; s_idx < num_steps; ++s_idx)
+        {
+            const CompiledPlan::Step &step = steps[s_idx];
+            run[s_idx] = m_gated_filters.find(step.m_name) ==
+                         m_gated_filters.end();
+            for(size_t p = 0; p < step.m_input_steps.size(); ++p)
             {
-                std::string port_name = ports_itr.next().as_string();
-                std::string f_input_name = graph().edges_in(f_name)[port_name].as_string();
-                f->set_input(port_name,&registry().fetch(f_input_name));
+                const int src = step.m_input_steps[p];
+                uses[src]++;
+                run[s_idx] = run[s_idx] && run[src];
             }
+        }
 
-            Timer t_flt_exec;
-            // execute
-            f->execute();
+        // then the steps whose output is only used by skipped steps.
+        // consumers come after their inputs, so walking backwards
+        // counts every consumer that runs before we reach the input
+        for(size_t s_idx = 0; s_idx < num_steps; ++s_idx)
+        {
+            if(uses[s_idx] > 0)
+            {
+                urefs[s_idx] = 0;
+            }
+        }
 
-            if(m_enable_timings)
+        for(size_t s_idx = num_steps; s_idx-- > 0;)
+        {
+            if(uses[s_idx] > 0 && urefs[s_idx] == 0)
             {
-                m_timing_info << g_timing_exec_count
-                              << " " << f->name()
-                              << " " << std::fixed << t_flt_exec.elapsed()
-                              <<"\n";
+                run[s_idx] = false;
             }
 
-            // if has output, set output
-            if(f->output_port())
+            if(run[s_idx])
             {
-                if(f->output().data_ptr() == NULL)
+                const CompiledPlan::Step &step = steps[s_idx];
+                for(size_t p = 0; p < step.m_input_steps.size(); ++p)
                 {
-                    CONDUIT_ERROR("filter output is NULL, was set_output() called?");
+                    urefs[step.m_input_steps[p]]++;
                 }
+            }
+        }
+    }
+
+    for(size_t s_idx = 0; s_idx < num_steps; ++s_idx)
+    {
+        if(!run[s_idx])
+        {
+            continue;
+        }
+
+        const CompiledPlan::Step &step = steps[s_idx];
+        Filter *f = step.m_filter;
+        const size_t num_ports = step.m_port_names.size();
+
+        f->reset_inputs_and_output();
 
-                registry().add(f_name,
-                               f->output(),
-                               uref);
+        // attach inputs to filter's ports
+        for(size_t p = 0; p < num_ports; ++p)
+        {
+            const int src = step.m_input_steps[p];
+            if(handles[src] == NULL)
+            {
+                handles[src] = registry().handle(steps[src].m_name);
             }
 
-            f->reset_inputs_and_output();
+            f->set_input(step.m_port_names[p], &registry().fetch(handles[src]));
+        }
 
-            // consume inputs
-            ports_itr.to_front();
-            while(ports_itr.has_next())
+        if(m_before_execute != NULL)
+        {
+            m_before_execute(step.m_name);
+        }
+
+        Timer t_flt_exec;
+        // execute
+        try
+        {
+            f->execute();
+        }
+        catch(...)
+        {
+            // callbacks always come in pairs
+            if(m_after_execute != NULL)
             {
-                std::string port_name = ports_itr.next().as_string();
-                std::string f_input_name = graph().edges_in(f_name)[port_name].as_string();
-                registry().consume(f_input_name);
+                m_after_execute(step.m_name);
+            }
+            throw;
+        }
+
+        if(m_after_execute != NULL)
+        {
+            m_after_execute(step.m_name);
+        }
+
+        if(m_enable_timings)
+        {
+            m_timing_info << g_timing_exec_count
+                          << " " << step.m_name
+                          << " " << std::fixed << t_flt_exec.elapsed()
+                          <<"\n";
+        }
+
+        if(m_record_filter_times)
+        {
+            m_filter_times[step.m_name] = t_flt_exec.elapsed();
+        }
+
+        // if has output, set output
+        if(step.m_has_output)
+        {
+            if(f->output().data_ptr() == NULL)
+            {
+                CONDUIT_ERROR("filter output is NULL, was set_output() called?");
+            }
+
+            registry().add(step.m_name,
+                           f->output(),
+                           urefs[s_idx]);
+            handles[s_idx] = registry().handle(step.m_name);
+            pending[s_idx] = urefs[s_idx];
+        }
+
+        if(m_enable_memory_accounting)
+        {
+            record_memory(step.m_name);
+        }
+
+        f->reset_inputs_and_output();
+
+        // consume inputs
+        for(size_t p = 0; p < num_ports; ++p)
+        {
+            const int src = step.m_input_steps[p];
+            registry().consume(handles[src]);
+            pending[src]--;
+            if(pending[src] <= 0)
+            {
+                // the entry is gone
+                handles[src] = NULL;
             }
         }
     }
@@ -382,15 +839,175 @@ Workspace::execute()
                       <<"\n";
         g_timing_exec_count++;
     }
+}
 
+//-----------------------------------------------------------------------------
 
+void Workspace::enable_timings(bool enabled)
+{
+  m_enable_timings = enabled;
+}
 
+//-----------------------------------------------------------------------------
+void Workspace::record_filter_times(bool enabled)
+{
+  m_record_filter_times = enabled;
+  m_filter_times.clear();
 }
+
 //-----------------------------------------------------------------------------
+const std::map<std::string,double> &
+Workspace::filter_times() const
+{
+  return m_filter_times;
+}
 
-void Workspace::enable_timings(bool enabled)
+//-----------------------------------------------------------------------------
+void
+Workspace::enable_memory_accounting(bool enabled)
 {
-  m_enable_timings = enabled;
+    m_enable_memory_accounting = enabled;
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::enable_memory_aware_scheduling(bool enabled)
+{
+    if(m_memory_aware_scheduling != enabled)
+    {
+        m_plan->invalidate();
+    }
+    m_memory_aware_scheduling = enabled;
+    if(enabled)
+    {
+        m_enable_memory_accounting = true;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::enable_memory_sampling(bool enabled)
+{
+    m_sample_memory = enabled;
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::set_memory_budget(conduit::uint64 bytes)
+{
+    m_memory_budget = bytes;
+    if(m_memory_budget > 0)
+    {
+        m_enable_memory_accounting = true;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::gate_filters(const std::set<std::string> &names)
+{
+    m_gated_filters = names;
+}
+
+//-----------------------------------------------------------------------------
+const std::set<std::string> &
+Workspace::gated_filters() const
+{
+    return m_gated_filters;
+}
+
+//-----------------------------------------------------------------------------
+conduit::uint64
+Workspace::memory_budget() const
+{
+    return m_memory_budget;
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::reset_memory_info()
+{
+    m_memory_info.reset();
+    m_memory_info["peak/host_bytes"]   = (uint64) 0;
+    m_memory_info["peak/device_bytes"] = (uint64) 0;
+    m_memory_info["peak/filter"]       = "";
+    m_memory_info["over_budget"]       = (uint64) 0;
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::memory_info(conduit::Node &out) const
+{
+    out.set(m_memory_info);
+    out["budget"] = m_memory_budget;
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::record_memory(const std::string &f_name)
+{
+    // filters may grow data they did not create (e.g., cached
+    // conversions of their inputs), sampling everything again walks
+    // all tracked data so it is only done when asked for
+    if(m_memory_budget > 0 || m_sample_memory)
+    {
+        registry().sample_memory_usage();
+    }
+
+    size_t out_host = 0, out_device = 0;
+    registry().memory_usage(f_name, out_host, out_device);
+
+    // everything the registry holds while this filter's inputs and
+    // output are both alive
+    size_t res_host = 0, res_device = 0;
+    registry().memory_usage(res_host, res_device);
+
+    // kept across reset_memory_info() to guide scheduling
+    const uint64 out_bytes = (uint64) (out_host + out_device);
+    if(!m_output_sizes.has_child(f_name) ||
+       m_output_sizes[f_name].to_uint64() != out_bytes)
+    {
+        m_output_sizes[f_name] = out_bytes;
+        m_output_sizes_changed = true;
+    }
+
+    Node &f_info = m_memory_info["filters"][f_name];
+    f_info["output/host_bytes"]   = (uint64) out_host;
+    f_info["output/device_bytes"] = (uint64) out_device;
+
+    if(!f_info.has_path("peak") ||
+       res_host + res_device > f_info["peak/host_bytes"].to_uint64() +
+                               f_info["peak/device_bytes"].to_uint64())
+    {
+        f_info["peak/host_bytes"]   = (uint64) res_host;
+        f_info["peak/device_bytes"] = (uint64) res_device;
+    }
+
+    Node &peak = m_memory_info["peak"];
+    if(res_host + res_device > peak["host_bytes"].to_uint64() +
+                               peak["device_bytes"].to_uint64())
+    {
+        peak["host_bytes"]   = (uint64) res_host;
+        peak["device_bytes"] = (uint64) res_device;
+        peak["filter"]       = f_name;
+    }
+
+    // filters are never re-executed to honor the budget (they may run
+    // collectives or have side effects), it is only reported
+    if(m_memory_budget > 0 && res_host + res_device > m_memory_budget)
+    {
+        m_memory_info["over_budget"] = m_memory_info["over_budget"].to_uint64() + 1;
+        f_info["over_budget"] = "true";
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::set_filter_execute_callbacks(FilterExecuteCallback before,
+                                        FilterExecuteCallback after)
+{
+    m_before_execute = before;
+    m_after_execute  = after;
 }
 
 //-----------------------------------------------------------------------------
@@ -399,6 +1016,9 @@ Workspace::reset()
 {
     graph().reset();
     registry().reset();
+    m_output_sizes.reset();
+    m_output_sizes_changed = false;
+    m_gated_filters.clear();
 }
 
 
@@ -411,6 +1031,10 @@ Workspace::info(Node &out) const
     graph().info(out["graph"]);
     registry().info(out["registry"]);
     out["timings"] = timing_info();
+    if(m_enable_memory_accounting)
+    {
+        memory_info(out["memory"]);
+    }
 }
 
 
@@ -450,14 +1074,25 @@ Workspace::timing_info() const
 Filter *
 Workspace::create_filter(const std::string &filter_type_name)
 {
-    if(!supports_filter_type(filter_type_name))
+    FilterFactoryMethod fr = NULL;
+    {
+        std::lock_guard<std::mutex> lock(FilterFactory::types_mutex());
+        std::map<std::string,FilterFactoryMethod>::const_iterator itr;
+        itr = FilterFactory::registered_types().find(filter_type_name);
+        if(itr != FilterFactory::registered_types().end())
+        {
+            fr = itr->second;
+        }
+    }
+
+    if(fr == NULL)
     {
         CONDUIT_WARN("Cannot create unknown filter type: "
                     << filter_type_name);
         return NULL;
     }
 
-    return FilterFactory::registered_types()[filter_type_name](filter_type_name.c_str());
+    return fr(filter_type_name.c_str());
 }
 
 //-----------------------------------------------------------------------------
@@ -487,6 +1122,7 @@ Workspace::default_mpi_comm()
 bool
 Workspace::supports_filter_type(const std::string &filter_type_name)
 {
+    std::lock_guard<std::mutex> lock(FilterFactory::types_mutex());
     std::map<std::string,FilterFactoryMethod>::const_iterator itr;
     itr = FilterFactory::registered_types().find(filter_type_name);
     return (itr != FilterFactory::registered_types().end());
@@ -517,6 +1153,7 @@ Workspace::supports_filter_type(FilterFactoryMethod fr)
 void
 Workspace::remove_filter_type(const std::string &filter_type_name)
 {
+    std::lock_guard<std::mutex> lock(FilterFactory::types_mutex());
     std::map<std::string,FilterFactoryMethod>::const_iterator itr;
     itr = FilterFactory::registered_types().find(filter_type_name);
     if(itr != FilterFactory::registered_types().end())
@@ -630,6 +1267,7 @@ Workspace::register_filter_type(const std::string &filter_type_name,
                     << " is already registered");
     }
 
+    std::lock_guard<std::mutex> lock(FilterFactory::types_mutex());
     FilterFactory::registered_types()[filter_type_name] = fr;
 }
 
@@ -664,6 +1302,7 @@ Workspace::filter_type_name(FilterFactoryMethod fr)
 void
 Workspace::clear_supported_filter_types()
 {
+    std::lock_guard<std::mutex> lock(FilterFactory::types_mutex());
     FilterFactory::registered_types().clear();
 }
 
@@ -60,6 +60,8 @@
 #include <flow_registry.hpp>
 #include <flow_graph.hpp>
 #include <sstream>
+#include <map>
+#include <set>
 
 
 //-----------------------------------------------------------------------------
@@ -181,19 +183,98 @@ public:
 
     void enable_timings(bool enabled);
 
+    /// when enabled, the time (in seconds) each filter took in the
+    /// last call to execute() is kept, keyed by filter name
+    void record_filter_times(bool enabled);
+    const std::map<std::string,double> &filter_times() const;
+
+    /// gated filters are skipped by execute(), together with the filters
+    /// that need their output and the filters only they need. The graph
+    /// (and its compiled plan) is kept. Pass an empty set to run every
+    /// filter. reset() clears the gates.
+    void gate_filters(const std::set<std::string> &names);
+    const std::set<std::string> &gated_filters() const;
+
+    // ------------------------------------------------------------------------
+    /// memory accounting
+    ///
+    /// when enabled, the footprint of each filter's output and of all
+    /// tracked registry data after each filter executes are recorded.
+    ///
+    /// a budget (in bytes, host + device, 0 == no budget) for the memory
+    /// held by tracked registry data. Filters that leave more than the
+    /// budget resident are reported. Results are never evicted and
+    /// recomputed to honor it: filters may run collectives or have side
+    /// effects. Use memory aware scheduling to release results early.
+    /// Enabling a budget also enables accounting.
+    // ------------------------------------------------------------------------
+    void           enable_memory_accounting(bool enabled);
+
+    /// when enabled, filters run in a single traversal that prefers
+    /// filters that release their inputs (earliest release), weighted by
+    /// the output sizes recorded in previous executions. The plan is only
+    /// rebuilt when new sizes change the order. Sizes are per process, so
+    /// callers whose filters run collectives must not enable it with more
+    /// than one rank. Enabling scheduling also enables accounting.
+    void           enable_memory_aware_scheduling(bool enabled);
+    /// when enabled, accounting re-samples all tracked data after each
+    /// filter, so data that grows after it is added (e.g., cached
+    /// conversions) is counted. Otherwise only a budget does this.
+    void           enable_memory_sampling(bool enabled);
+    void           set_memory_budget(conduit::uint64 bytes);
+    conduit::uint64 memory_budget() const;
+
+    /// resets recorded memory info, execute() does this before it runs
+    void           reset_memory_info();
+    /// returns memory info recorded during the last execute():
+    ///  filters/{name}/output/{host_bytes,device_bytes}
+    ///  filters/{name}/peak/{host_bytes,device_bytes}
+    ///  filters/{name}/over_budget (only present when true)
+    ///  peak/{host_bytes,device_bytes,filter}
+    ///  over_budget (number of filters that exceeded the budget)
+    void           memory_info(conduit::Node &out) const;
+
+    // ------------------------------------------------------------------------
+    /// optional callbacks invoked with the filter name before and after
+    /// each filter executes, used to build filter level timelines.
+    /// after is also invoked when the filter throws. pass NULL to disable.
+    // ------------------------------------------------------------------------
+    typedef void (*FilterExecuteCallback)(const std::string &filter_name);
+
+    static void set_filter_execute_callbacks(FilterExecuteCallback before,
+                                             FilterExecuteCallback after);
+
 private:
 
     static Filter *create_filter(const std::string &filter_type);
 
+    // helper for memory accounting
+    void record_memory(const std::string &f_name);
+
     static int  m_default_mpi_comm;
+    static FilterExecuteCallback m_before_execute;
+    static FilterExecuteCallback m_after_execute;
 
     class ExecutionPlan;
+    class CompiledPlan;
     class FilterFactory;
 
     Graph             m_graph;
     Registry          m_registry;
     std::stringstream m_timing_info;
     bool              m_enable_timings;
+    bool              m_record_filter_times;
+    std::map<std::string,double> m_filter_times;
+    std::set<std::string> m_gated_filters;
+    bool              m_enable_memory_accounting;
+    bool              m_memory_aware_scheduling;
+    bool              m_output_sizes_changed;
+    bool              m_sample_memory;
+    conduit::uint64   m_memory_budget;
+    conduit::Node     m_memory_info;
+    // last recorded output size of each filter
+    conduit::Node     m_output_sizes;
+    CompiledPlan     *m_plan;
 
 };
 
@@ -51,6 +51,7 @@
 #include "gtest/gtest.h"
 
 #include <ascent_expression_eval.hpp>
+#include <expressions/ascent_derived_jit.hpp>
 #include <ascent_hola.hpp>
 
 #include <cmath>
@@ -580,6 +581,234 @@ TEST(ascent_expressions, multi_topos)
 
   EXPECT_TRUE(check_test_image(output_image, 0.1));
 }
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, derived_interpreter)
+{
+  // the interpreter does not need OCCA, so this runs in every build
+  Node data;
+  conduit::blueprint::mesh::examples::braid("uniform",
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            data);
+
+  // ascent normally adds this but we are doing an end around
+  data["state/domain_id"] = 0;
+  Node multi_dom;
+  blueprint::mesh::to_multi_domain(data, multi_dom);
+
+  runtime::expressions::register_builtin();
+  runtime::expressions::ExpressionEval eval(&multi_dom);
+  runtime::expressions::Jitable::set_engine("interpret");
+
+  conduit::Node res;
+  std::string expr;
+
+  const double num_points = EXAMPLE_MESH_SIDE_DIM * EXAMPLE_MESH_SIDE_DIM *
+                            EXAMPLE_MESH_SIDE_DIM;
+  const double num_cells = (EXAMPLE_MESH_SIDE_DIM - 1) *
+                           (EXAMPLE_MESH_SIDE_DIM - 1) *
+                           (EXAMPLE_MESH_SIDE_DIM - 1);
+
+  // constants
+  expr = "sum(derived_field(1.0, 'mesh', 'element'))";
+  res = eval.evaluate(expr);
+  EXPECT_NEAR(res["value"].to_float64(), num_cells, 1e-8);
+
+  // arithmetic
+  expr = "avg(field('braid') * 2.0 + 1.0) - (avg(field('braid')) * 2.0 + 1.0)";
+  res = eval.evaluate(expr);
+  EXPECT_NEAR(res["value"].to_float64(), 0.0, 1e-8);
+
+  // comparisons and logic
+  expr = "min_val = min(field('braid')).value\n"
+         "max_val = max(field('braid')).value\n"
+         "norm_field = (field('braid') - min_val) / (max_val - min_val)\n"
+         "not_between_0_1 = not (norm_field >= 0 and norm_field <= 1)\n"
+         "sum(not_between_0_1)";
+  res = eval.evaluate(expr);
+  EXPECT_EQ(res["value"].to_float64(), 0);
+
+  // conditionals
+  expr = "sum(if field('braid') > 0 then 1.0 else 0.0) + "
+         "sum(if field('braid') <= 0 then 1.0 else 0.0)";
+  res = eval.evaluate(expr);
+  EXPECT_NEAR(res["value"].to_float64(), num_points, 1e-8);
+
+  // built-in functions and vectors
+  expr = "max(magnitude(vector(field('braid'), field('braid'), field('braid'))))"
+         " - sqrt(3.0) * max(abs(field('braid')))";
+  res = eval.evaluate(expr);
+  EXPECT_NEAR(res["value"].to_float64(), 0.0, 1e-8);
+
+  runtime::expressions::Jitable::set_engine("auto");
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_jit_expressions, derived_interpret_vs_compile)
+{
+  Node n;
+  ascent::about(n);
+  // only run this test if ascent was built with jit support
+  if(n["runtimes/ascent/jit/status"].as_string() == "disabled")
+  {
+      ASCENT_INFO("Ascent JIT support disabled, skipping test\n");
+      return;
+  }
+
+  Node data;
+  conduit::blueprint::mesh::examples::braid("uniform",
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            data);
+  // an integer field, dividing it must not be integer division
+  const int num_points = EXAMPLE_MESH_SIDE_DIM * EXAMPLE_MESH_SIDE_DIM *
+                         EXAMPLE_MESH_SIDE_DIM;
+  data["fields/ids/association"] = "vertex";
+  data["fields/ids/topology"] = "mesh";
+  data["fields/ids/values"].set(DataType::int32(num_points));
+  int32_array ids = data["fields/ids/values"].value();
+  for(int i = 0; i < num_points; ++i)
+  {
+    ids[i] = i % 7;
+  }
+
+  // ascent normally adds this but we are doing an end around
+  data["state/domain_id"] = 0;
+  Node multi_dom;
+  blueprint::mesh::to_multi_domain(data, multi_dom);
+
+  runtime::expressions::register_builtin();
+  runtime::expressions::ExpressionEval eval(&multi_dom);
+
+  std::vector<std::string> exprs;
+  exprs.push_back("sum(field('ids') / 2)");
+  exprs.push_back("sum(field('ids') * field('braid') / (field('ids') + 1))");
+  exprs.push_back("sum(if field('braid') > 0 then log(field('braid')) "
+                  "else field('ids') / 4)");
+  exprs.push_back("sum(if field('ids') > 100 then field('braid') else 1.0)");
+  exprs.push_back("sum(field('ids') % 3)");
+  exprs.push_back("sum(field('braid') % (field('ids') + 1.5))");
+
+  for(size_t i = 0; i < exprs.size(); ++i)
+  {
+    runtime::expressions::Jitable::set_engine("interpret");
+    const double interpreted = eval.evaluate(exprs[i])["value"].to_float64();
+    runtime::expressions::Jitable::set_engine("compile");
+    const double compiled = eval.evaluate(exprs[i])["value"].to_float64();
+    EXPECT_NEAR(interpreted, compiled, 1e-8 * (1.0 + std::abs(compiled)))
+      << exprs[i];
+  }
+
+  runtime::expressions::Jitable::set_engine("auto");
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, derived_precision)
+{
+  Node data;
+  conduit::blueprint::mesh::examples::braid("uniform",
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            data);
+  // a single precision copy of braid
+  data["fields/braid32/association"] = "vertex";
+  data["fields/braid32/topology"] = "mesh";
+  data["fields/braid/values"].to_float32_array(
+      data["fields/braid32/values"]);
+
+  // ascent normally adds this but we are doing an end around
+  data["state/domain_id"] = 0;
+  Node multi_dom;
+  blueprint::mesh::to_multi_domain(data, multi_dom);
+
+  runtime::expressions::register_builtin();
+  runtime::expressions::ExpressionEval eval(&multi_dom);
+  runtime::expressions::Jitable::set_engine("interpret");
+
+  const std::string expr =
+      "avg(magnitude(vector(field('braid32'), field('braid32'), "
+      "field('braid32'))) * 2.0 + 1.0)";
+
+  // computed in single precision
+  conduit::Node res = eval.evaluate(expr);
+  const double single_res = res["value"].to_float64();
+
+  runtime::expressions::Jitable::set_precision("double");
+  res = eval.evaluate(expr);
+  const double double_res = res["value"].to_float64();
+  runtime::expressions::Jitable::set_precision("auto");
+
+  EXPECT_NEAR(single_res, double_res, 1e-4 * std::abs(double_res));
+
+  runtime::expressions::Jitable::set_engine("auto");
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_jit_expressions, derived_precision_compiled)
+{
+  Node n;
+  ascent::about(n);
+  // only run this test if ascent was built with jit support
+  if(n["runtimes/ascent/jit/status"].as_string() == "disabled")
+  {
+      ASCENT_INFO("Ascent JIT support disabled, skipping test\n");
+      return;
+  }
+
+  Node data;
+  conduit::blueprint::mesh::examples::braid("uniform",
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            data);
+  // a single precision copy of braid
+  data["fields/braid32/association"] = "vertex";
+  data["fields/braid32/topology"] = "mesh";
+  data["fields/braid/values"].to_float32_array(
+      data["fields/braid32/values"]);
+
+  // ascent normally adds this but we are doing an end around
+  data["state/domain_id"] = 0;
+  Node *multi_dom = new Node();
+  blueprint::mesh::to_multi_domain(data, *multi_dom);
+
+  runtime::expressions::register_builtin();
+  // derived fields are added to the data object, which owns the mesh
+  DataObject data_object(multi_dom);
+  runtime::expressions::ExpressionEval eval(data_object);
+  const Node &dom = data_object.as_low_order_bp()->child(0);
+
+  const std::string expr = "field('braid32') * 2.0 + sin(field('braid32'))";
+
+  // the compiled kernel stores a float32 field
+  runtime::expressions::Jitable::set_engine("compile");
+  eval.evaluate(expr, "compiled32");
+  const Node &compiled = dom["fields/compiled32/values"];
+  EXPECT_TRUE(compiled.dtype().is_float32());
+
+  // and agrees with the interpreter, which computes in float too
+  runtime::expressions::Jitable::set_engine("interpret");
+  eval.evaluate(expr, "interpreted32");
+  const Node &interpreted = dom["fields/interpreted32/values"];
+  EXPECT_TRUE(interpreted.dtype().is_float32());
+
+  float32_array c_vals = compiled.value();
+  float32_array i_vals = interpreted.value();
+  float64_array d_vals = dom["fields/braid/values"].value();
+  ASSERT_EQ(c_vals.number_of_elements(), d_vals.number_of_elements());
+  for(index_t i = 0; i < c_vals.number_of_elements(); ++i)
+  {
+    const double expected = d_vals[i] * 2.0 + std::sin(d_vals[i]);
+    EXPECT_NEAR(c_vals[i], expected, 1e-5 * (1.0 + std::abs(expected)));
+    EXPECT_NEAR(c_vals[i], i_vals[i], 1e-6 * (1.0 + std::abs(expected)));
+  }
+
+  runtime::expressions::Jitable::set_engine("auto");
+}
+
 //-----------------------------------------------------------------------------
 
 int
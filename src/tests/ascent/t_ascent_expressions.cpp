@@ -52,9 +52,15 @@
 
 #include <ascent_expression_eval.hpp>
 #include <expressions/ascent_blueprint_architect.hpp>
+#include <expressions/ascent_blueprint_locator.hpp>
+#include <flow_filters/ascent_runtime_param_check.hpp>
 
 #include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 #include <conduit_blueprint.hpp>
 
@@ -1156,7 +1162,99 @@ TEST(ascent_expressions, if_expressions)
   EXPECT_EQ(threw, true);
 }
 //-----------------------------------------------------------------------------
+TEST(ascent_expressions, param_expressions)
+{
+  Node n;
+  ascent::about(n);
+
+  //
+  // Create an example mesh.
+  //
+  Node data, verify_info;
+  conduit::blueprint::mesh::examples::braid("hexs",
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            data);
+  // ascent normally adds this but we are doing an end around
+  data["state/domain_id"] = 0;
+  data["state/cycle"] = 100;
+  Node *multi_dom = new Node();
+  blueprint::mesh::to_multi_domain(data, *multi_dom);
+
+  runtime::expressions::register_builtin();
+  // the data object takes ownership
+  DataObject data_object(multi_dom);
+
+  conduit::Node params;
+  params["a"] = "cycle() + 1";
+  params["b"] = "max(field('braid'))";
+  params["c"] = 2.5;
+  params["field"] = "braid";
+
+  std::vector<std::string> paths = {"a", "b", "c"};
+  runtime::filters::eval_param_expressions(params, paths, &data_object);
+
+  EXPECT_TRUE(data_object.has_param_value("cycle() + 1"));
+  EXPECT_TRUE(data_object.has_param_value("max(field('braid'))"));
+  // only the requested paths are evaluated
+  EXPECT_FALSE(data_object.has_param_value("braid"));
+
+  EXPECT_EQ(runtime::filters::get_int32(params["a"], &data_object), 101);
+  EXPECT_EQ(runtime::filters::get_float64(params["c"], &data_object), 2.5);
+
+  // direct evaluation and the memoized value agree
+  runtime::expressions::ExpressionEval eval(multi_dom);
+  conduit::Node res = eval.evaluate("max(field('braid'))");
+  EXPECT_EQ(runtime::filters::get_float64(params["b"], &data_object),
+            res["value"].to_float64());
+
+  // new data invalidates memoized values
+  Node *other = new Node();
+  other->set(*multi_dom);
+  data_object.reset(other);
+  EXPECT_FALSE(data_object.has_param_value("cycle() + 1"));
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, mesh_locations)
+{
+  const std::string mesh_types[4] = {"uniform",
+                                     "rectilinear",
+                                     "structured",
+                                     "hexs"};
+  for(int m = 0; m < 4; ++m)
+  {
+    Node data, multi_dom;
+    conduit::blueprint::mesh::examples::basic(mesh_types[m], 3, 4, 5, data);
+    blueprint::mesh::to_multi_domain(data, multi_dom);
+
+    // the basic examples span [-10, 10] along each axis
+    Node bounds = runtime::expressions::global_bounds(multi_dom, "mesh");
+    const double *min_coords = bounds["min_coords"].value();
+    const double *max_coords = bounds["max_coords"].value();
+    for(int i = 0; i < 3; ++i)
+    {
+      EXPECT_NEAR(min_coords[i], -10.0, 1e-12) << mesh_types[m];
+      EXPECT_NEAR(max_coords[i], 10.0, 1e-12) << mesh_types[m];
+    }
+
+    Node loc = runtime::expressions::vert_location(data, 59, "mesh");
+    const double *vert = loc.value();
+    EXPECT_NEAR(vert[0], 10.0, 1e-12) << mesh_types[m];
+    EXPECT_NEAR(vert[1], 10.0, 1e-12) << mesh_types[m];
+    EXPECT_NEAR(vert[2], 10.0, 1e-12) << mesh_types[m];
+
+    // element (1, 2, 0) of the 2 x 3 x 4 elements
+    loc = runtime::expressions::element_location(data, 5, "mesh");
+    const double *center = loc.value();
+    EXPECT_NEAR(center[0], 5.0, 1e-12) << mesh_types[m];
+    EXPECT_NEAR(center[1], -10.0 + 2.5 * 20.0 / 3.0, 1e-12) << mesh_types[m];
+    EXPECT_NEAR(center[2], -7.5, 1e-12) << mesh_types[m];
+  }
+}
 
+//-----------------------------------------------------------------------------
 TEST(ascent_binning, binning_basic_meshes)
 {
   // the vtkm runtime is currently our only rendering runtime
@@ -1527,6 +1625,268 @@ TEST(ascent_expressions, lineout)
   res = eval.evaluate(expr);
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, probe)
+{
+  const std::string mesh_types[5] = {"uniform",
+                                     "rectilinear",
+                                     "structured",
+                                     "hexs",
+                                     "tets"};
+  for(int m = 0; m < 5; ++m)
+  {
+    Node data;
+    conduit::blueprint::mesh::examples::braid(mesh_types[m],
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+    // ascent normally adds this but we are doing an end around
+    data["state/domain_id"] = 0;
+    Node multi_dom;
+    blueprint::mesh::to_multi_domain(data, multi_dom);
+
+    runtime::expressions::register_builtin();
+    runtime::expressions::CellLocator::clear_cache();
+    runtime::expressions::ExpressionEval eval(&multi_dom);
+
+    // a vertex, an element center and a point outside the mesh
+    const int vert_id = 37;
+    const int ele_id = 11;
+    Node vert = runtime::expressions::vert_location(data, vert_id, "mesh");
+    Node center = runtime::expressions::element_location(data, ele_id, "mesh");
+    const double *p_vert = vert.value();
+    const double *p_center = center.value();
+
+    std::stringstream points;
+    points << std::setprecision(17) << "["
+           << "vector(" << p_vert[0] << ", " << p_vert[1] << ", "
+           << p_vert[2] << "), "
+           << "vector(" << p_center[0] << ", " << p_center[1] << ", "
+           << p_center[2] << "), "
+           << "vector(100, 100, 100)]";
+
+    conduit::Node res;
+    res = eval.evaluate("probe(" + points.str() +
+                        ", field('braid'), empty_val=-1.0)");
+    EXPECT_EQ(res["type"].as_string(), "probe");
+    float64_array values = res["attrs/value/value"].value();
+    float64_array found = res["attrs/found/value"].value();
+    ASSERT_EQ(values.number_of_elements(), 3);
+    const double braid = data["fields/braid/values"].as_float64_ptr()[vert_id];
+    EXPECT_NEAR(values[0], braid, 1e-6) << mesh_types[m];
+    EXPECT_EQ(values[2], -1.0) << mesh_types[m];
+    EXPECT_EQ(found[0], 1.0) << mesh_types[m];
+    EXPECT_EQ(found[1], 1.0) << mesh_types[m];
+    EXPECT_EQ(found[2], 0.0) << mesh_types[m];
+
+    // element fields take the value of the containing cell
+    res = eval.evaluate("probe(" + points.str() + ", field('radial'))");
+    float64_array ele_values = res["attrs/value/value"].value();
+    const double radial = data["fields/radial/values"].as_float64_ptr()[ele_id];
+    EXPECT_NEAR(ele_values[1], radial, 1e-12) << mesh_types[m];
+    EXPECT_EQ(ele_values[2], 0.0) << mesh_types[m];
+
+    res = eval.evaluate("probe(" + points.str() + ", field('braid')).value[0]");
+    EXPECT_NEAR(res["value"].to_float64(), braid, 1e-6) << mesh_types[m];
+
+    // lineouts share the locator
+    res = eval.evaluate("lineout(10, vector(-10, -10, -10), vector(10, 10, 10),"
+                        " fields=['braid'])");
+    EXPECT_EQ(res["attrs/samples/value"].to_int32(), 10);
+    EXPECT_EQ(res["attrs/vars/braid/value"].dtype().number_of_elements(), 10);
+
+    EXPECT_EQ(runtime::expressions::CellLocator::num_builds(), 1)
+        << mesh_types[m];
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, probe_mesh_changed_in_place)
+{
+  Node data;
+  conduit::blueprint::mesh::examples::braid("hexs",
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            data);
+  // ascent normally adds this but we are doing an end around
+  data["state/domain_id"] = 0;
+  Node multi_dom;
+  blueprint::mesh::to_multi_domain(data, multi_dom);
+
+  runtime::expressions::register_builtin();
+  runtime::expressions::CellLocator::clear_cache();
+  runtime::expressions::ExpressionEval eval(&multi_dom);
+
+  const std::string expr = "probe([vector(0, 0, 0)], field('braid'),"
+                           " empty_val=-1.0)";
+  conduit::Node res = eval.evaluate(expr);
+  float64_array found = res["attrs/found/value"].value();
+  EXPECT_EQ(found[0], 1.0);
+
+  // same arrays, same addresses and sizes, different values: the
+  // cached locator must not be reused
+  float64_array x = multi_dom.child(0)["coordsets/coords/values/x"].value();
+  for(index_t i = 0; i < x.number_of_elements(); ++i)
+  {
+    x[i] += 100.0;
+  }
+  runtime::expressions::ExpressionEval::reset_cache();
+  res = eval.evaluate(expr);
+  found = res["attrs/found/value"].value();
+  EXPECT_EQ(found[0], 0.0);
+  EXPECT_EQ(runtime::expressions::CellLocator::num_builds(), 2);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, lineout_values)
+{
+  const std::string mesh_types[5] = {"uniform",
+                                     "rectilinear",
+                                     "structured",
+                                     "hexs",
+                                     "tets"};
+  for(int m = 0; m < 5; ++m)
+  {
+    Node data;
+    conduit::blueprint::mesh::examples::braid(mesh_types[m],
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+    // a linear field is reproduced exactly by the cell interpolants
+    const int num_verts =
+        data["fields/braid/values"].dtype().number_of_elements();
+    data["fields/linear/association"] = "vertex";
+    data["fields/linear/topology"] = "mesh";
+    data["fields/linear/values"].set(conduit::DataType::float64(num_verts));
+    float64_array linear = data["fields/linear/values"].value();
+    for(int i = 0; i < num_verts; ++i)
+    {
+      Node vert = runtime::expressions::vert_location(data, i, "mesh");
+      const double *p = vert.value();
+      linear[i] = p[0] + 2. * p[1] + 3. * p[2];
+    }
+    // ascent normally adds this but we are doing an end around
+    data["state/domain_id"] = 0;
+    Node multi_dom;
+    blueprint::mesh::to_multi_domain(data, multi_dom);
+
+    runtime::expressions::register_builtin();
+    runtime::expressions::CellLocator::clear_cache();
+    runtime::expressions::ExpressionEval eval(&multi_dom);
+
+    // the first two samples fall outside the [-10, 10] braid extents
+    conduit::Node res;
+    res = eval.evaluate("lineout(11, vector(-13, -9, -6), vector(7, 6, 9),"
+                        " fields=['linear'], empty_val=-100.0)");
+    ASSERT_EQ(res["attrs/samples/value"].to_int32(), 11);
+    float64_array x = res["attrs/coordinates/x/value"].value();
+    float64_array y = res["attrs/coordinates/y/value"].value();
+    float64_array z = res["attrs/coordinates/z/value"].value();
+    float64_array values = res["attrs/vars/linear/value"].value();
+    ASSERT_EQ(values.number_of_elements(), 11);
+    for(int i = 0; i < 11; ++i)
+    {
+      EXPECT_NEAR(x[i], -13. + 2. * i, 1e-12) << mesh_types[m];
+      if(i < 2)
+      {
+        EXPECT_EQ(values[i], -100.0) << mesh_types[m];
+      }
+      else
+      {
+        EXPECT_NEAR(values[i], x[i] + 2. * y[i] + 3. * z[i], 1e-8)
+            << mesh_types[m] << " sample " << i;
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, concurrent_evaluation)
+{
+  Node data;
+  conduit::blueprint::mesh::examples::braid("hexs",
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            data);
+  // ascent normally adds this but we are doing an end around
+  data["state/domain_id"] = 0;
+  Node multi_dom;
+  blueprint::mesh::to_multi_domain(data, multi_dom);
+
+  runtime::expressions::register_builtin();
+  runtime::expressions::ExpressionEval::reset_cache();
+
+  const std::vector<std::string> exprs = {
+      "max(field('braid')).value - min(field('braid')).value",
+      "avg(field('radial')) * 2",
+      "sum(histogram(field('braid'), num_bins=32).value)",
+      "if max(field('braid')).value > 0 then 1 else 0"};
+
+  // serial results
+  std::vector<double> expected(exprs.size());
+  for(size_t i = 0; i < exprs.size(); ++i)
+  {
+    runtime::expressions::ExpressionEval eval(&multi_dom);
+    expected[i] = eval.evaluate(exprs[i])["value"].to_float64();
+  }
+
+  // every thread evaluates every expression, sharing the cache and the
+  // function tables, under its own names
+  const int num_threads = 4;
+  const int num_iterations = 5;
+  std::vector<std::vector<double>> results(num_threads);
+  std::vector<std::string> errors(num_threads);
+  std::vector<std::thread> threads;
+  for(int t = 0; t < num_threads; ++t)
+  {
+    threads.emplace_back([&, t]() {
+      try
+      {
+        runtime::expressions::ExpressionEval eval(&multi_dom);
+        for(int it = 0; it < num_iterations; ++it)
+        {
+          for(size_t i = 0; i < exprs.size(); ++i)
+          {
+            const std::string name = "expr_" + std::to_string(t) + "_" +
+                                     std::to_string(i);
+            results[t].push_back(
+                eval.evaluate(exprs[i], name)["value"].to_float64());
+          }
+        }
+      }
+      catch(conduit::Error &e)
+      {
+        errors[t] = e.message();
+      }
+    });
+  }
+  for(auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  const conduit::Node &cache =
+      runtime::expressions::ExpressionEval::get_cache();
+  for(int t = 0; t < num_threads; ++t)
+  {
+    EXPECT_EQ(errors[t], "");
+    ASSERT_EQ(results[t].size(), num_iterations * exprs.size());
+    for(size_t r = 0; r < results[t].size(); ++r)
+    {
+      EXPECT_NEAR(results[t][r], expected[r % exprs.size()], 1e-8);
+    }
+    for(size_t i = 0; i < exprs.size(); ++i)
+    {
+      EXPECT_TRUE(cache.has_child("expr_" + std::to_string(t) + "_" +
+                                  std::to_string(i)));
+    }
+  }
+}
+
 //-----------------------------------------------------------------------------
 int
 main(int argc, char *argv[])
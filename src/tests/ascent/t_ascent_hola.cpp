@@ -52,6 +52,8 @@
 
 #include <ascent.hpp>
 #include <ascent_hola.hpp>
+#include <cmath>
+#include <conduit_relay.hpp>
 
 #include "t_config.hpp"
 #include "t_utils.hpp"
@@ -158,3 +160,211 @@ TEST(ascent_hola, test_hola_relay_blueprint_mesh)
     ASCENT_ACTIONS_DUMP(actions,output_file, msg);
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_hola, test_hola_relay_blueprint_mesh_selection)
+{
+    //
+    // Create example data
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              10,
+                                              10,
+                                              10,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+    int cycle = 102;
+    data["state/cycle"] = cycle;
+
+    // make sure the _output dir exists
+    string output_path =  prepare_output_dir();
+
+    string output_file = conduit::utils::join_file_path(output_path,
+                                            "tout_hola_relay_blueprint_mesh_selection");
+
+    conduit::Node actions;
+    // add the extracts
+    conduit::Node &add_extract = actions.append();
+    add_extract["action"] = "add_extracts";
+    add_extract["extracts/e1/type"]  = "relay";
+    add_extract["extracts/e1/params/path"] = output_file;
+    add_extract["extracts/e1/params/protocol"] = "blueprint/mesh/hdf5";
+
+    Ascent ascent;
+    Node ascent_opts;
+    ascent_opts["messages"] = "verbose";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+
+    char cyc_fmt_buff[64];
+    snprintf(cyc_fmt_buff, sizeof(cyc_fmt_buff), "%06d",cycle);
+
+    ostringstream oss;
+    oss << output_file << ".cycle_" << cyc_fmt_buff << ".root";
+    std::string output_root = oss.str();
+
+    // only read the braid field
+    Node hola_data, hola_opts;
+    hola_opts["root_file"] = output_root;
+    hola_opts["fields"].append() = "braid";
+    hola_opts["threads"] = 2;
+    ascent::hola("relay/blueprint/mesh", hola_opts, hola_data);
+
+    EXPECT_EQ(hola_data.number_of_children(), 1);
+    const Node &dom = hola_data.child(0);
+    EXPECT_TRUE(dom.has_path("fields/braid"));
+    EXPECT_FALSE(dom.has_path("fields/radial"));
+    EXPECT_FALSE(dom.has_path("fields/vel"));
+    EXPECT_TRUE(dom.has_path("topologies/mesh"));
+    EXPECT_TRUE(dom.has_path("coordsets/coords"));
+    EXPECT_EQ(dom["state/cycle"].to_int(), cycle);
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(dom,verify_info));
+
+    // without a selection everything is read
+    hola_opts.remove("fields");
+    hola_data.reset();
+    ascent::hola("relay/blueprint/mesh", hola_opts, hola_data);
+    EXPECT_EQ(hola_data.number_of_children(), 1);
+    EXPECT_TRUE(hola_data.child(0).has_path("fields/radial"));
+    EXPECT_TRUE(hola_data.child(0).has_path("fields/vel"));
+
+    // so is a selection that only names fields missing from the index
+    hola_opts["fields"].append() = "not_a_field";
+    hola_data.reset();
+    ascent::hola("relay/blueprint/mesh", hola_opts, hola_data);
+    EXPECT_EQ(hola_data.number_of_children(), 1);
+    EXPECT_TRUE(hola_data.child(0).has_path("fields/braid"));
+    EXPECT_TRUE(hola_data.child(0).has_path("fields/radial"));
+    EXPECT_TRUE(hola_data.child(0).has_path("topologies/mesh"));
+}
+
+
+//-----------------------------------------------------------------------------
+TEST(ascent_hola, test_hola_relay_blueprint_mesh_compression)
+{
+    //
+    // Create example data
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              10,
+                                              10,
+                                              10,
+                                              data);
+
+    // a large magnitude float32 field, where rounding the reconstructed
+    // values to float32 is a sizable part of the error bound
+    data["fields/big32/association"] = data["fields/braid/association"];
+    data["fields/big32/topology"] = data["fields/braid/topology"];
+    float64_array braid_vals = data["fields/braid/values"].value();
+    data["fields/big32/values"].set(DataType::float32(braid_vals.number_of_elements()));
+    float32_array big32_vals = data["fields/big32/values"].value();
+    for(index_t i = 0; i < braid_vals.number_of_elements(); ++i)
+    {
+        big32_vals[i] = static_cast<float32>(1e5 + 10.0 * braid_vals[i]);
+    }
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+    int cycle = 103;
+    data["state/cycle"] = cycle;
+
+    // make sure the _output dir exists
+    string output_path =  prepare_output_dir();
+
+    string output_file = conduit::utils::join_file_path(output_path,
+                                            "tout_hola_relay_blueprint_mesh_compression");
+
+    const double error_bound = 1e-3;
+    // about six float32 ulps at 1e5
+    const double error_bound32 = 0.05;
+
+    conduit::Node actions;
+    // add the extracts
+    conduit::Node &add_extract = actions.append();
+    add_extract["action"] = "add_extracts";
+    add_extract["extracts/e1/type"]  = "relay";
+    add_extract["extracts/e1/params/path"] = output_file;
+    add_extract["extracts/e1/params/protocol"] = "blueprint/mesh/hdf5";
+    // lossless by default, quantize braid and leave radial alone
+    conduit::Node &comp = add_extract["extracts/e1/params/compression"];
+    comp["mode"] = "lossless";
+    comp["fields/braid/mode"] = "quantize";
+    comp["fields/braid/error_bound"] = error_bound;
+    comp["fields/radial/mode"] = "none";
+    comp["fields/big32/mode"] = "quantize";
+    comp["fields/big32/error_bound"] = error_bound32;
+    // too many levels to quantize, vel falls back to lossless
+    comp["fields/vel/mode"] = "quantize";
+    comp["fields/vel/error_bound"] = 1e-30;
+
+    Ascent ascent;
+    Node ascent_opts;
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+
+    char cyc_fmt_buff[64];
+    snprintf(cyc_fmt_buff, sizeof(cyc_fmt_buff), "%06d",cycle);
+
+    ostringstream oss;
+    oss << output_file << ".cycle_" << cyc_fmt_buff << ".root";
+    std::string output_root = oss.str();
+
+    // the index records how each field was stored
+    Node root;
+    conduit::relay::io::load(output_root, "hdf5", root);
+    const Node &f_idx = root["blueprint_index/mesh/fields"];
+    EXPECT_EQ(f_idx["braid/compression/mode"].as_string(), "quantize");
+    EXPECT_EQ(f_idx["big32/compression/mode"].as_string(), "quantize");
+    EXPECT_EQ(f_idx["vel/compression/mode"].as_string(), "lossless");
+    EXPECT_FALSE(f_idx.has_path("vel/compression/error_bound"));
+    EXPECT_FALSE(f_idx.has_path("radial/compression"));
+
+    Node hola_data, hola_opts;
+    hola_opts["root_file"] = output_root;
+    ascent::hola("relay/blueprint/mesh", hola_opts, hola_data);
+
+    EXPECT_EQ(hola_data.number_of_children(), 1);
+    Node &dom = hola_data.child(0);
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(dom,verify_info));
+
+    // lossless and uncompressed fields are exact
+    const char *exact_paths[4] = {"fields/vel/values/u",
+                                  "fields/vel/values/v",
+                                  "fields/vel/values/w",
+                                  "fields/radial/values"};
+    for(int p = 0; p < 4; ++p)
+    {
+        float64_array expected = data[exact_paths[p]].value();
+        float64_array actual = dom[exact_paths[p]].value();
+        ASSERT_EQ(expected.number_of_elements(), actual.number_of_elements());
+        for(index_t i = 0; i < expected.number_of_elements(); ++i)
+        {
+            EXPECT_EQ(expected[i], actual[i]);
+        }
+    }
+
+    // quantized values stay within the error bound
+    float64_array orig = data["fields/braid/values"].value();
+    float64_array read = dom["fields/braid/values"].value();
+    ASSERT_EQ(orig.number_of_elements(), read.number_of_elements());
+    for(index_t i = 0; i < orig.number_of_elements(); ++i)
+    {
+        EXPECT_NEAR(orig[i], read[i], error_bound * (1.0 + 1e-6));
+    }
+
+    // including after rounding to float32
+    float32_array orig32 = data["fields/big32/values"].value();
+    float32_array read32 = dom["fields/big32/values"].value();
+    ASSERT_EQ(orig32.number_of_elements(), read32.number_of_elements());
+    for(index_t i = 0; i < orig32.number_of_elements(); ++i)
+    {
+        EXPECT_LE(std::abs(static_cast<double>(orig32[i]) -
+                           static_cast<double>(read32[i])),
+                  error_bound32);
+    }
+}
@@ -202,6 +202,98 @@ TEST(ascent_hola_mpi, test_hola_mpi_helpers)
         EXPECT_EQ(data.number_of_children(),9);
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_hola_mpi, test_hola_mpi_staging)
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    int rank = relay::mpi::rank(comm);
+    int rank_split = 5;
+    int num_cycles = 3;
+
+    HolaMPIStage stage(comm, rank_split);
+
+    if(rank < rank_split)
+    {
+        EXPECT_TRUE(stage.is_source());
+        Node data;
+        hola_mpi_helpers_test_setup_src_data(rank,data);
+        for(int cycle = 0; cycle < num_cycles; cycle++)
+        {
+            NodeIterator itr = data.children();
+            while(itr.has_next())
+            {
+                itr.next()["cycle"] = cycle;
+            }
+            // returns once the sends are posted
+            stage.send(data);
+        }
+        stage.close();
+    }
+    else
+    {
+        EXPECT_FALSE(stage.is_source());
+        Node data;
+        int cycle = 0;
+        while(stage.recv(data))
+        {
+            if(rank == 5)
+                EXPECT_EQ(data.number_of_children(),7);
+            if(rank == 6)
+                EXPECT_EQ(data.number_of_children(),7);
+            if(rank == 7)
+                EXPECT_EQ(data.number_of_children(),9);
+
+            NodeConstIterator itr = data.children();
+            while(itr.has_next())
+            {
+                EXPECT_EQ(itr.next()["cycle"].to_int(),cycle);
+            }
+            cycle++;
+        }
+        EXPECT_EQ(cycle,num_cycles);
+        EXPECT_EQ(data.number_of_children(),0);
+    }
+
+    MPI_Barrier(comm);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_hola_mpi, test_hola_mpi_staged_after_close)
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    int rank = relay::mpi::rank(comm);
+    int rank_split = 5;
+
+    Node opts;
+    opts["mpi_comm"] = MPI_Comm_c2f(comm);
+    opts["rank_split"] = rank_split;
+    opts["staging"] = "async";
+
+    if(rank < rank_split)
+    {
+        Node data;
+        hola_mpi_helpers_test_setup_src_data(rank,data);
+        hola_mpi(opts, data);
+        hola_mpi_close_staging(opts);
+    }
+    else
+    {
+        Node data;
+        hola_mpi(opts, data);
+        EXPECT_TRUE(data.number_of_children() > 0);
+        // the sources are done
+        hola_mpi(opts, data);
+        EXPECT_EQ(data.number_of_children(),0);
+        // later calls keep returning empty data instead of waiting
+        hola_mpi(opts, data);
+        EXPECT_EQ(data.number_of_children(),0);
+    }
+
+    MPI_Barrier(comm);
+}
+
 //-----------------------------------------------------------------------------
 TEST(ascent_hola_mpi, test_hola_mpi)
 {
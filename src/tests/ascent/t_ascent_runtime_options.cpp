@@ -51,7 +51,9 @@
 #include "gtest/gtest.h"
 
 #include <ascent.hpp>
+#include <ascent_tracer.hpp>
 
+#include <cstdlib>
 #include <iostream>
 #include <math.h>
 #include <sstream>
@@ -690,6 +692,224 @@ TEST(ascent_runtime_options, test_actions_yaml_file)
     EXPECT_TRUE(check_test_file(output_actions));
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_runtime_options, test_actions_file_changes)
+{
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing changes to an actions file between executes");
+
+    string output_path = prepare_output_dir();
+    string output_actions = conduit::utils::join_file_path(output_path,
+                                                           "tout_actions_changes.yaml");
+    remove_test_file(output_actions);
+
+    std::string max_actions = ""
+                              "-\n"
+                              "  action: add_queries\n"
+                              "  queries:\n"
+                              "    q1:\n"
+                              "      params:\n"
+                              "        expression: \"max(field('braid'))\"\n"
+                              "        name: max_braid\n";
+
+    std::ofstream file(output_actions);
+    file<<max_actions;
+    file.close();
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent_opts["actions_file"] = output_actions;
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+
+    conduit::Node blank_actions, info;
+    // the second execute reuses the parsed file
+    ascent.execute(blank_actions);
+    ascent.execute(blank_actions);
+    ascent.info(info);
+    EXPECT_TRUE(info.has_path("expressions/max_braid"));
+    EXPECT_FALSE(info.has_path("expressions/min_braid_value"));
+
+    // a changed file is picked up
+    std::string min_actions = ""
+                              "-\n"
+                              "  action: add_queries\n"
+                              "  queries:\n"
+                              "    q1:\n"
+                              "      params:\n"
+                              "        expression: \"min(field('braid'))\"\n"
+                              "        name: min_braid_value\n";
+    file.open(output_actions);
+    file<<min_actions;
+    file.close();
+
+    ascent.execute(blank_actions);
+    ascent.info(info);
+    EXPECT_TRUE(info.has_path("expressions/min_braid_value"));
+    EXPECT_EQ(info["actions"].child(0)["queries/q1/params/name"].as_string(),
+              "min_braid_value");
+    ascent.close();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_runtime_options, test_async)
+{
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing async execute");
+
+    conduit::Node actions;
+    conduit::Node &add_queries = actions.append();
+    add_queries["action"] = "add_queries";
+    add_queries["queries/q1/params/expression"] = "max(field('braid'))";
+    add_queries["queries/q1/params/name"] = "max_braid";
+
+    Ascent ascent;
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent_opts["async"] = "true";
+    ascent_opts["async_snapshot"] = "fields";
+    ascent_opts["exceptions"] = "forward";
+    ascent.open(ascent_opts);
+
+    conduit::Node status;
+    ascent.status(status);
+    EXPECT_EQ(status["async"].as_string(), "true");
+
+    const int num_cycles = 3;
+    for(int c = 0; c < num_cycles; ++c)
+    {
+        data["state/cycle"] = 100 + c;
+        float64_array vals = data["fields/braid/values"].value();
+        for(index_t i = 0; i < vals.number_of_elements(); ++i)
+        {
+            vals[i] = c + 1.0;
+        }
+        ascent.publish(data);
+        ascent.execute(actions);
+        // the simulation moves on, the queued execute sees the snapshot
+        for(index_t i = 0; i < vals.number_of_elements(); ++i)
+        {
+            vals[i] = -1.0;
+        }
+    }
+
+    ascent.wait();
+    ascent.status(status);
+    EXPECT_EQ(status["pending"].to_int(), 0);
+
+    conduit::Node info;
+    ascent.info(info);
+    for(int c = 0; c < num_cycles; ++c)
+    {
+        std::ostringstream oss;
+        oss << "expressions/max_braid/" << 100 + c << "/attrs/value/value";
+        EXPECT_EQ(info[oss.str()].to_float64(), c + 1.0);
+    }
+    ascent.close();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_runtime_options, test_async_publish_error)
+{
+    Node data;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    // only one domain has an id, so publish throws
+    Node bad_data;
+    bad_data.append().set(data);
+    bad_data.append().set(data);
+    bad_data.child(0)["state/domain_id"] = 0;
+
+    ASCENT_INFO("Testing async execute with a failing publish");
+
+    conduit::Node actions;
+    conduit::Node &add_queries = actions.append();
+    add_queries["action"] = "add_queries";
+    add_queries["queries/q1/params/expression"] = "max(field('braid'))";
+    add_queries["queries/q1/params/name"] = "max_braid";
+
+    Ascent ascent;
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent_opts["async"] = "true";
+    ascent_opts["exceptions"] = "forward";
+    ascent.open(ascent_opts);
+
+    // the failed publish must free its snapshot, otherwise the cycle
+    // that reuses it waits forever instead of reporting the error
+    bool raised = false;
+    ascent.publish(bad_data);
+    ascent.execute(actions);
+    for(int c = 0; c < 4 && !raised; ++c)
+    {
+        data["state/cycle"] = 100 + c;
+        ascent.publish(data);
+        try
+        {
+            ascent.execute(actions);
+        }
+        catch(conduit::Error &e)
+        {
+            raised = true;
+        }
+    }
+
+    if(!raised)
+    {
+        ascent.wait();
+        ascent.publish(data);
+        EXPECT_THROW(ascent.execute(actions), conduit::Error);
+    }
+
+    // report anything left from cycles queued with the bad data
+    ascent.wait();
+    try
+    {
+        ascent.publish(data);
+        ascent.execute(actions);
+    }
+    catch(conduit::Error &e)
+    {
+        // expected when the error was reported late
+    }
+    ascent.wait();
+
+    // later cycles run normally
+    data["state/cycle"] = 200;
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.wait();
+    conduit::Node info;
+    ascent.info(info);
+    EXPECT_TRUE(info.has_path("expressions/max_braid/200"));
+    ascent.close();
+}
+
 //-----------------------------------------------------------------------------
 TEST(ascent_runtime_options, test_field_filtering)
 {
@@ -951,3 +1171,338 @@ TEST(ascent_runtime_options, test_field_filtering_lineout)
     ascent.publish(data);
     ascent.execute(actions);
 }
+
+//-----------------------------------------------------------------------------
+TEST(ascent_runtime_options, test_field_filtering_auto)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    const int num_elements = data["topologies/mesh/elements/connectivity"].
+                               dtype().number_of_elements() / 8;
+
+    // half of the elements are garbage, which ascent strips before
+    // any pipeline runs, as long as the ghost field is not pruned
+    std::vector<conduit::int32> ghosts(num_elements, 0);
+    std::vector<conduit::float64> ones(num_elements, 1.0);
+    for(int i = 0; i < num_elements / 2; ++i)
+    {
+      ghosts[i] = 2;
+    }
+    data["fields/ascent_ghosts/association"] = "element";
+    data["fields/ascent_ghosts/topology"] = "mesh";
+    data["fields/ascent_ghosts/values"].set(ghosts);
+    data["fields/ones/association"] = "element";
+    data["fields/ones/topology"] = "mesh";
+    data["fields/ones/values"].set(ones);
+    data["fields/bananas"] = data["fields/braid"];
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    data["state/cycle"] = 100;
+    data["state/domain_id"] = 0;
+
+    ASCENT_INFO("Testing automatic field filtering");
+
+    //
+    // Create the actions.
+    //
+
+    // radial is only used by a filter, braid only by expressions in
+    // filter params and vel only by a filter in the middle of the pipeline
+    conduit::Node pipelines;
+    pipelines["pl1/f1/type"] = "threshold";
+    conduit::Node &thresh_params = pipelines["pl1/f1/params"];
+    thresh_params["field"] = "radial";
+    thresh_params["min_value"] = "min(field('braid')).value - 1e10";
+    thresh_params["max_value"] = "max(field('braid')).value + 1e10";
+
+    pipelines["pl1/f2/type"] = "vector_magnitude";
+    pipelines["pl1/f2/params/field"] = "vel";
+    pipelines["pl1/f2/params/output_name"] = "vel_mag";
+
+    conduit::Node queries;
+    queries["q1/params/expression"] = "sum(field('ones'))";
+    queries["q1/params/name"] = "num_elements";
+    queries["q1/pipeline"] = "pl1";
+    queries["q2/params/expression"] = "max(field('vel_mag'))";
+    queries["q2/params/name"] = "max_vel_mag";
+    queries["q2/pipeline"] = "pl1";
+
+    conduit::Node actions;
+    conduit::Node &add_pipelines = actions.append();
+    add_pipelines["action"] = "add_pipelines";
+    add_pipelines["pipelines"] = pipelines;
+    conduit::Node &add_queries = actions.append();
+    add_queries["action"] = "add_queries";
+    add_queries["queries"] = queries;
+
+    //
+    // Run Ascent
+    //
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent_opts["exceptions"] = "forward";
+    ascent_opts["field_filtering"] = "auto";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+
+    conduit::Node info;
+    ascent.info(info);
+    ascent.close();
+
+    EXPECT_TRUE(info.has_path("expressions/max_vel_mag/100/attrs/value"));
+    EXPECT_EQ(info["expressions/num_elements/100/value"].to_float64(),
+              (double)(num_elements - num_elements / 2));
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_runtime_options, test_trace)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent support disabled, skipping trace test");
+        return;
+    }
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    string output_path = prepare_output_dir();
+    string trace_file = conduit::utils::join_file_path(output_path,
+                                                       "ascent_trace_000000.json");
+    remove_test_file(trace_file);
+
+    conduit::Node actions;
+    conduit::Node &add_pipelines = actions.append();
+    add_pipelines["action"] = "add_pipelines";
+    conduit::Node &pipelines = add_pipelines["pipelines"];
+    pipelines["pl1/f1/type"] = "contour";
+    pipelines["pl1/f1/params/field"] = "braid";
+    pipelines["pl1/f1/params/iso_values"] = 0.0;
+
+    conduit::Node &add_queries = actions.append();
+    add_queries["action"] = "add_queries";
+    add_queries["queries/q1/params/expression"] = "max(field('braid'))";
+    add_queries["queries/q1/params/name"] = "max_braid";
+
+    //
+    // Run Ascent
+    //
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent_opts["trace"] = "true";
+    ascent_opts["default_dir"] = output_path;
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+
+    // check to see if we created the trace
+    EXPECT_TRUE(check_test_file(trace_file));
+
+    conduit::Node trace;
+    trace.load(trace_file, "json");
+    EXPECT_TRUE(trace.has_path("traceEvents"));
+
+    // we should see begin events for the cycle and the filters,
+    // and every begin should be ended
+    bool found_filter = false;
+    int open_spans = 0;
+    const int num_events = trace["traceEvents"].number_of_children();
+    for(int i = 0; i < num_events; ++i)
+    {
+      const conduit::Node &event = trace["traceEvents"].child(i);
+      if(event["ph"].as_string() == "B")
+      {
+        open_spans++;
+        if(event["name"].as_string() == "pl1_f1_contour")
+        {
+          found_filter = true;
+        }
+      }
+      else if(event["ph"].as_string() == "E")
+      {
+        open_spans--;
+      }
+    }
+    EXPECT_TRUE(found_filter);
+    EXPECT_EQ(open_spans, 0);
+
+    // tracing is process wide, an instance without the option resets it
+    Ascent ascent_no_trace;
+    Node no_trace_opts;
+    no_trace_opts["runtime/type"] = "ascent";
+    ascent_no_trace.open(no_trace_opts);
+    if(std::getenv("ASCENT_TRACE") == NULL)
+    {
+      EXPECT_FALSE(ascent::Tracer::enabled());
+    }
+    ascent_no_trace.close();
+
+    // don't trace the tests that follow
+    ascent::Tracer::instance()->enable(false);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_runtime_options, test_schedule)
+{
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    string output_path = prepare_output_dir();
+
+    conduit::Node extracts;
+    extracts["e1/type"]  = "relay";
+    extracts["e1/params/path"] =
+      conduit::utils::join_file_path(output_path,"tout_schedule_e1");
+    extracts["e1/params/protocol"] = "blueprint/mesh/hdf5";
+    // e1 must run every execute
+    extracts["e1/schedule/min_frequency"] = 1;
+
+    extracts["e2/type"]  = "relay";
+    extracts["e2/pipeline"] = "pl1";
+    extracts["e2/params/path"] =
+      conduit::utils::join_file_path(output_path,"tout_schedule_e2");
+    extracts["e2/params/protocol"] = "blueprint/mesh/hdf5";
+    extracts["e2/schedule/priority"] = 2.0;
+
+    conduit::Node actions;
+    conduit::Node &add_pipelines = actions.append();
+    add_pipelines["action"] = "add_pipelines";
+    add_pipelines["pipelines/pl1/f1/type"] = "slice";
+    add_pipelines["pipelines/pl1/f1/params/point/x"] = 0.0;
+    add_pipelines["pipelines/pl1/f1/params/point/y"] = 0.0;
+    add_pipelines["pipelines/pl1/f1/params/point/z"] = 0.0;
+    add_pipelines["pipelines/pl1/f1/params/normal/x"] = 0.0;
+    add_pipelines["pipelines/pl1/f1/params/normal/y"] = 0.0;
+    add_pipelines["pipelines/pl1/f1/params/normal/z"] = 1.0;
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts"] = extracts;
+
+    Node n;
+    ascent::about(n);
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        // no slice filter without vtkm
+        add_extracts.remove("extracts/e2/pipeline");
+        actions.remove(0);
+    }
+
+    Ascent ascent;
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    // nothing fits in this budget
+    ascent_opts["schedule/budget"] = 1e-9;
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+
+    conduit::Node info;
+    // the first execute runs everything to measure it
+    ascent.execute(actions);
+    ascent.info(info);
+    EXPECT_EQ(info["schedule/items/extracts/e1/state"].as_string(), "run");
+    EXPECT_EQ(info["schedule/items/extracts/e2/state"].as_string(), "run");
+
+    // then only what is due runs
+    ascent.execute(actions);
+    ascent.execute(actions);
+    ascent.info(info);
+    EXPECT_EQ(info["schedule/items/extracts/e1/state"].as_string(), "run");
+    EXPECT_EQ(info["schedule/items/extracts/e2/state"].as_string(), "deferred");
+    EXPECT_EQ(info["schedule/items/extracts/e2/waited"].to_int32(), 2);
+    ascent.close();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_runtime_options, test_introspection)
+{
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    // graphs are written to the current dir
+    string graph_file = "ascent_flow_graph.html";
+    remove_test_file(graph_file);
+
+    conduit::Node actions;
+    conduit::Node &add_queries = actions.append();
+    add_queries["action"] = "add_queries";
+    add_queries["queries/q1/params/expression"] = "max(field('braid'))";
+    add_queries["queries/q1/params/name"] = "max_braid";
+
+    // lazy (default): nothing is written, info still reports everything
+    Ascent ascent;
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+
+    EXPECT_FALSE(check_test_file(graph_file));
+
+    conduit::Node info;
+    ascent.info(info);
+    EXPECT_TRUE(info.has_child("flow_graph"));
+    EXPECT_TRUE(info.has_child("flow_graph_dot"));
+    EXPECT_TRUE(info.has_child("flow_graph_dot_html"));
+    EXPECT_TRUE(info.has_path("expressions/max_braid"));
+    EXPECT_EQ(info["actions"].child(0)["queries/q1/params/name"].as_string(),
+              "max_braid");
+    ascent.close();
+
+    // eager: the graph is written every execute
+    ascent_opts["introspection"] = "eager";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+
+    EXPECT_TRUE(check_test_file(graph_file));
+}
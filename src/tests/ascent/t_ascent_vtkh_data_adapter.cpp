@@ -53,6 +53,7 @@
 
 #include <ascent.hpp>
 #include <runtimes/ascent_vtkh_data_adapter.hpp>
+#include <runtimes/ascent_data_object.hpp>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <iostream>
 #include <math.h>
@@ -432,6 +433,134 @@ TEST(ascent_multi_topo, adapter_test)
     delete collection;
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_multi_topo, lazy_views)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    ASCENT_INFO("Testing lazy blueprint views of a vtkh collection");
+    Node data;
+    build_multi_topo(data, EXAMPLE_MESH_SIDE_DIM);
+
+    DataObject data_object(VTKHDataAdapter::BlueprintToVTKHCollection(data,true));
+
+    // only the point topology and the requested field are converted
+    std::shared_ptr<Node> view = data_object.as_field_bp("point_braid");
+    EXPECT_EQ(view->number_of_children(), 1);
+    const Node &dom = view->child(0);
+    EXPECT_TRUE(dom.has_path("fields/point_braid"));
+    EXPECT_TRUE(dom.has_path("topologies/point_mesh"));
+    EXPECT_TRUE(dom.has_path("coordsets/point_coords"));
+    EXPECT_FALSE(dom.has_path("fields/point_radial"));
+    EXPECT_FALSE(dom.has_path("topologies/mesh"));
+
+    // later requests add to the same view
+    std::shared_ptr<Node> topo_view = data_object.as_topology_bp("mesh");
+    EXPECT_EQ(topo_view.get(), view.get());
+    EXPECT_TRUE(dom.has_path("topologies/mesh"));
+    EXPECT_FALSE(dom.has_path("fields/braid"));
+    EXPECT_EQ(data_object.as_field_bp("braid").get(), view.get());
+    EXPECT_TRUE(dom.has_path("fields/braid"));
+
+    Node verify_info;
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(*view, verify_info));
+
+    // a full conversion takes over from the view
+    std::shared_ptr<Node> full = data_object.as_low_order_bp();
+    EXPECT_TRUE(full->child(0).has_path("fields/point_radial"));
+    EXPECT_EQ(data_object.as_field_bp("point_radial").get(), full.get());
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_data_adapter, mesh_cache)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    ASCENT_INFO("Testing reuse of unchanged meshes across conversions");
+    Node data;
+    Node &dom = data.append();
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              dom);
+    dom["state/domain_id"] = 0;
+
+    VTKHMeshCache cache;
+    VTKHCollection *collection = VTKHDataAdapter::BlueprintToVTKHCollection(data,true,&cache);
+    delete collection;
+    EXPECT_EQ(cache.hits(), 0);
+    EXPECT_EQ(cache.misses(), 1);
+
+    // new field values, same mesh
+    float64_array vals = dom["fields/braid/values"].value();
+    vals[0] = 42.0;
+    collection = VTKHDataAdapter::BlueprintToVTKHCollection(data,true,&cache);
+    EXPECT_EQ(cache.hits(), 1);
+
+    Node out_data;
+    VTKHDataAdapter::VTKHCollectionToBlueprintDataSet(collection, out_data);
+    float64_array out_vals = out_data.child(0)["fields/braid/values"].value();
+    EXPECT_EQ(out_vals[0], 42.0);
+    delete collection;
+
+    // the simulation says the mesh changed
+    dom["state/mesh_generation"] = 1;
+    collection = VTKHDataAdapter::BlueprintToVTKHCollection(data,true,&cache);
+    delete collection;
+    EXPECT_EQ(cache.hits(), 1);
+    EXPECT_EQ(cache.misses(), 2);
+
+    // new coordinate arrays
+    Node coords;
+    coords.set(dom["coordsets/coords"]);
+    dom["coordsets/coords"].set_external(coords);
+    collection = VTKHDataAdapter::BlueprintToVTKHCollection(data,true,&cache);
+    delete collection;
+    EXPECT_EQ(cache.hits(), 1);
+    EXPECT_EQ(cache.misses(), 3);
+
+    // with hashed values, changes in place are found without a new
+    // mesh_generation
+    collection = VTKHDataAdapter::BlueprintToVTKHCollection(data,true,&cache,true);
+    delete collection;
+    collection = VTKHDataAdapter::BlueprintToVTKHCollection(data,true,&cache,true);
+    delete collection;
+    EXPECT_EQ(cache.hits(), 2);
+    EXPECT_EQ(cache.misses(), 4);
+
+    float64_array x_vals = coords["values/x"].value();
+    x_vals[0] += 1.0;
+    collection = VTKHDataAdapter::BlueprintToVTKHCollection(data,true,&cache,true);
+    delete collection;
+    EXPECT_EQ(cache.hits(), 2);
+    EXPECT_EQ(cache.misses(), 5);
+
+    // copied meshes match by value, at any address
+    collection = VTKHDataAdapter::BlueprintToVTKHCollection(data,false,&cache);
+    delete collection;
+    Node data_copy;
+    data_copy.set(data);
+    collection = VTKHDataAdapter::BlueprintToVTKHCollection(data_copy,false,&cache);
+    delete collection;
+    EXPECT_EQ(cache.hits(), 3);
+    EXPECT_EQ(cache.misses(), 6);
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
 {
@@ -59,6 +59,8 @@
 
 #include "t_config.hpp"
 
+#include <fstream>
+
 using namespace std;
 using namespace flow;
 
@@ -122,6 +124,59 @@ TEST(flow_py_interp_exe, flow_python_interpreter)
 
 }
 
+//-----------------------------------------------------------------------------
+TEST(flow_py_interp_exe, flow_python_interpreter_code_cache)
+{
+    PythonInterpreter py_interp;
+
+    EXPECT_TRUE(py_interp.initialize());
+    EXPECT_EQ(py_interp.code_cache_size(), 0);
+
+    // the same source is only compiled once
+    EXPECT_TRUE(py_interp.run_script("a = 1"));
+    EXPECT_TRUE(py_interp.run_script("a = a + 1"));
+    EXPECT_TRUE(py_interp.run_script("a = a + 1"));
+    EXPECT_EQ(py_interp.code_cache_size(), 2);
+
+    int a_cpp = 0;
+    EXPECT_TRUE(PythonInterpreter::PyObject_to_int(py_interp.get_global_object("a"),
+                                                   a_cpp));
+    EXPECT_EQ(a_cpp, 3);
+
+    // bad source is not cached
+    EXPECT_FALSE(py_interp.run_script("badbad bad"));
+    py_interp.clear_error();
+    EXPECT_EQ(py_interp.code_cache_size(), 2);
+
+    // files are re-read when they change
+    string script_fname = "tout_flow_python_interpreter_code_cache.py";
+    ofstream ofs;
+    ofs.open(script_fname.c_str());
+    ofs << "b = 10\n";
+    ofs.close();
+
+    EXPECT_TRUE(py_interp.run_script_file(script_fname));
+    EXPECT_TRUE(py_interp.run_script_file(script_fname));
+    EXPECT_EQ(py_interp.code_cache_size(), 3);
+
+    ofs.open(script_fname.c_str());
+    ofs << "b = 200\n";
+    ofs.close();
+
+    EXPECT_TRUE(py_interp.run_script_file(script_fname));
+    EXPECT_EQ(py_interp.code_cache_size(), 4);
+
+    int b_cpp = 0;
+    EXPECT_TRUE(PythonInterpreter::PyObject_to_int(py_interp.get_global_object("b"),
+                                                   b_cpp));
+    EXPECT_EQ(b_cpp, 200);
+
+    py_interp.clear_code_cache();
+    EXPECT_EQ(py_interp.code_cache_size(), 0);
+
+    py_interp.shutdown();
+}
+
 //-----------------------------------------------------------------------------
 TEST(flow_py_interp_exe, flow_python_interpreter_bad_file)
 {
@@ -106,6 +106,40 @@ public:
 };
 
 
+//-----------------------------------------------------------------------------
+class ArraySrcFilter: public Filter
+{
+public:
+    ArraySrcFilter()
+    : Filter()
+    {}
+
+    virtual ~ArraySrcFilter()
+    {}
+
+
+    virtual void declare_interface(Node &i)
+    {
+        i["type_name"]   = "array_src";
+        i["output_port"] = "true";
+        i["port_names"] = DataType::empty();
+    }
+
+
+    virtual void execute()
+    {
+        Node *res = new Node();
+        res->fetch("values").set(DataType::float64(4));
+        float64_array vals = res->fetch("values").value();
+        for(int i = 0; i < 4; i++)
+        {
+            vals[i] = i;
+        }
+        set_output<Node>(res);
+    }
+};
+
+
 //-----------------------------------------------------------------------------
 TEST(flow_python_script_filter, simple_execute)
 {
@@ -140,6 +174,34 @@ TEST(flow_python_script_filter, simple_execute)
 
 
 
+//-----------------------------------------------------------------------------
+TEST(flow_python_script_filter, execute_input_view)
+{
+    flow::filters::register_builtin();
+
+    Workspace::register_filter_type<ArraySrcFilter>();
+
+    Workspace w;
+
+    w.graph().add_filter("array_src","v");
+
+    // views are read only numpy arrays over the input's memory
+    Node py_params;
+    py_params["source"] = "vals = flow_input_view('values')\n"
+                          "assert not vals.flags.writeable\n"
+                          "assert not vals.flags.owndata\n"
+                          "assert vals[3] == 3.0\n"
+                          "flow_set_output(vals.sum())\n";
+
+    w.graph().add_filter("python_script","py", py_params);
+
+    w.graph().connect("v","py","in");
+
+    w.execute();
+
+    Workspace::clear_supported_filter_types();
+}
+
 //-----------------------------------------------------------------------------
 TEST(flow_python_script_filter, simple_execute_mock_file_source)
 {
@@ -212,3 +212,54 @@ TEST(ascent_flow_registry, detach_tracked)
 
 
 
+
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_registry, memory_usage)
+{
+    Node *n = new Node();
+    n->set(DataType::float64(100));
+
+    Node *n_untracked = new Node();
+    n_untracked->set(DataType::float64(50));
+
+    Registry r;
+    r.add<Node>("d1",n,2);
+    r.add<Node>("d2",n,1);
+    r.add<Node>("u",n_untracked,-1);
+    r.print();
+
+    size_t host_bytes = 0, device_bytes = 0;
+    r.memory_usage("d1", host_bytes, device_bytes);
+    EXPECT_EQ(host_bytes, 100 * sizeof(float64));
+    EXPECT_EQ(device_bytes, (size_t) 0);
+
+    // only tracked data is counted, and aliases count once
+    r.memory_usage(host_bytes, device_bytes);
+    EXPECT_EQ(host_bytes, 100 * sizeof(float64));
+
+    r.reset();
+    delete n_untracked;
+}
+
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_registry, handles)
+{
+    Node *n = new Node();
+    n->set(10);
+
+    Registry r;
+    r.add<Node>("d",n,2);
+
+    Registry::Handle h = r.handle("d");
+    EXPECT_EQ(r.fetch(h).value<Node>(),n);
+
+    r.consume(h);
+    EXPECT_TRUE(r.has_entry("d"));
+
+    r.consume(h);
+    EXPECT_FALSE(r.has_entry("d"));
+
+    EXPECT_THROW(r.handle("d"),conduit::Error);
+}
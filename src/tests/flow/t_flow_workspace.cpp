@@ -198,6 +198,106 @@ public:
 
 
 
+//-----------------------------------------------------------------------------
+class BigFilter: public Filter
+{
+public:
+    BigFilter()
+    : Filter()
+    {}
+
+    virtual ~BigFilter()
+    {}
+
+    virtual void declare_interface(Node &i)
+    {
+        i["type_name"]   = "big";
+        i["output_port"] = "true";
+        i["port_names"].append().set("in");
+        i["default_params"]["size"].set((int)1000);
+    }
+
+    virtual void execute()
+    {
+        int size = params()["size"].value();
+        int val  = input<Node>("in")->to_int();
+
+        // a large result that fills an array with the input value
+        Node *res = new Node();
+        res->set(DataType::float64(size));
+        float64_array vals = res->value();
+        vals.fill(val);
+
+        set_output<Node>(res);
+    }
+};
+
+//-----------------------------------------------------------------------------
+class SumFilter: public Filter
+{
+public:
+    SumFilter()
+    : Filter()
+    {}
+
+    virtual ~SumFilter()
+    {}
+
+    virtual void declare_interface(Node &i)
+    {
+        i["type_name"]   = "sum";
+        i["output_port"] = "true";
+        i["port_names"].append().set("in");
+    }
+
+    virtual void execute()
+    {
+        Node *in = input<Node>("in");
+        float64_array vals = in->value();
+        float64 sum = 0;
+        for(index_t i = 0; i < vals.number_of_elements(); ++i)
+        {
+            sum += vals[i];
+        }
+
+        Node *res = new Node();
+        (*res)["sum"] = sum;
+
+        set_output<Node>(res);
+    }
+};
+
+
+//-----------------------------------------------------------------------------
+class FieldUseFilter: public Filter
+{
+public:
+    FieldUseFilter()
+    : Filter()
+    {}
+
+    virtual ~FieldUseFilter()
+    {}
+
+    virtual void declare_interface(Node &i)
+    {
+        i["type_name"]   = "field_use";
+        i["output_port"] = "true";
+        i["port_names"].append().set("in");
+        i["fields/reads"].append() = "field";
+        i["fields/reads"].append() = "extra_fields";
+        i["fields/produces"].append() = "output_name";
+    }
+
+    virtual void execute()
+    {
+        Node *res = new Node();
+        res->set(*input<Node>("in"));
+        set_output<Node>(res);
+    }
+};
+
+
 //-----------------------------------------------------------------------------
 TEST(ascent_flow_workspace, linear_graph)
 {
@@ -751,6 +851,193 @@ TEST(ascent_flow_workspace, dag_graph_save_and_load)
 
 
 
+//-----------------------------------------------------------------------------
+static int filter_exec_count = 0;
+
+void
+count_filter_exec(const std::string &)
+{
+    filter_exec_count++;
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, memory_budget)
+{
+    Workspace::register_filter_type<SrcFilter>();
+    Workspace::register_filter_type<AddFilter>();
+
+    Workspace w;
+
+    Node p_vs;
+    p_vs["value"].set(int(10));
+
+    w.graph().add_filter("src","s",p_vs);
+    w.graph().add_filter("src","v",p_vs);
+
+    w.graph().add_filter("add","a1");
+    w.graph().add_filter("add","a2");
+
+    // s and v are both used by a1 and a2
+    w.graph().connect("s","a1","a");
+    w.graph().connect("v","a1","b");
+    w.graph().connect("s","a2","a");
+    w.graph().connect("v","a2","b");
+
+    // accounting only
+    w.enable_memory_accounting(true);
+    w.execute();
+
+    Node info;
+    w.memory_info(info);
+    info.print();
+
+    EXPECT_TRUE(info.has_path("filters/s/output/host_bytes"));
+    EXPECT_TRUE(info["filters/s/output/host_bytes"].to_uint64() > 0);
+    EXPECT_TRUE(info["peak/host_bytes"].to_uint64() > 0);
+    EXPECT_EQ(info["over_budget"].to_uint64(), (uint64) 0);
+    uint64 peak = info["peak/host_bytes"].to_uint64();
+
+    EXPECT_EQ(w.registry().fetch<Node>("a1")->to_int(),20);
+    EXPECT_EQ(w.registry().fetch<Node>("a2")->to_int(),20);
+    w.registry().reset();
+
+    // a budget too small to hold anything is reported, but every
+    // filter still runs exactly once
+    filter_exec_count = 0;
+    Workspace::set_filter_execute_callbacks(count_filter_exec, NULL);
+    w.set_memory_budget(1);
+    w.execute();
+    Workspace::set_filter_execute_callbacks(NULL, NULL);
+
+    EXPECT_EQ(filter_exec_count, 4);
+
+    w.memory_info(info);
+    info.print();
+
+    EXPECT_EQ(info["over_budget"].to_uint64(), (uint64) 4);
+    EXPECT_TRUE(info.has_path("filters/a1/over_budget"));
+    // info describes the last execution only
+    EXPECT_EQ(info["peak/host_bytes"].to_uint64(), peak);
+
+    EXPECT_EQ(w.registry().fetch<Node>("a1")->to_int(),20);
+    EXPECT_EQ(w.registry().fetch<Node>("a2")->to_int(),20);
+    w.registry().reset();
+
+    Workspace::clear_supported_filter_types();
+}
+
+//-----------------------------------------------------------------------------
+void
+build_wide_graph(Workspace &w)
+{
+    Node p_vs;
+    p_vs["value"].set(int(1));
+    w.graph().add_filter("src","s",p_vs);
+
+    // big is used by sinks k1 and z, big2 by sink m. The default
+    // traversals visit sinks in order (k1, m, z) so big stays alive
+    // while big2 is computed
+    w.graph().add_filter("big","big");
+    w.graph().add_filter("big","big2");
+    w.graph().add_filter("sum","k1");
+    w.graph().add_filter("sum","m");
+    w.graph().add_filter("sum","z");
+
+    w.graph().connect("s","big","in");
+    w.graph().connect("s","big2","in");
+    w.graph().connect("big","k1","in");
+    w.graph().connect("big","z","in");
+    w.graph().connect("big2","m","in");
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, memory_aware_scheduling)
+{
+    Workspace::register_filter_type<SrcFilter>();
+    Workspace::register_filter_type<BigFilter>();
+    Workspace::register_filter_type<SumFilter>();
+
+    Workspace w_default;
+    build_wide_graph(w_default);
+    w_default.enable_memory_accounting(true);
+    w_default.execute();
+
+    Node info_default;
+    w_default.memory_info(info_default);
+    uint64 peak_default = info_default["peak/host_bytes"].to_uint64();
+    w_default.registry().reset();
+
+    Workspace w;
+    build_wide_graph(w);
+    w.enable_memory_aware_scheduling(true);
+
+    Node travs;
+    w.traversals(travs);
+    travs.print();
+    EXPECT_EQ(travs.number_of_children(),1);
+    EXPECT_EQ(travs[0].number_of_children(),6);
+
+    // the first execution records sizes, the second uses them
+    w.execute();
+    w.registry().reset();
+    w.reset_memory_info();
+    w.execute();
+
+    Node info;
+    w.memory_info(info);
+    info.print();
+    uint64 peak = info["peak/host_bytes"].to_uint64();
+
+    EXPECT_LT(peak, peak_default);
+
+    EXPECT_EQ(w.registry().fetch<Node>("k1")->fetch("sum").to_float64(),1000.0);
+    EXPECT_EQ(w.registry().fetch<Node>("m")->fetch("sum").to_float64(),1000.0);
+    EXPECT_EQ(w.registry().fetch<Node>("z")->fetch("sum").to_float64(),1000.0);
+    w.registry().reset();
+
+    // sizes are unchanged, the plan is reused with the same peak
+    w.reset_memory_info();
+    w.execute();
+    w.memory_info(info);
+    EXPECT_EQ(info["peak/host_bytes"].to_uint64(), peak);
+    EXPECT_EQ(w.registry().fetch<Node>("z")->fetch("sum").to_float64(),1000.0);
+    w.registry().reset();
+
+    Workspace::clear_supported_filter_types();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, reexecute_after_graph_change)
+{
+    Workspace::register_filter_type<SrcFilter>();
+    Workspace::register_filter_type<IncFilter>();
+
+    Workspace w;
+
+    w.graph().add_filter("src","s");
+    w.graph().add_filter("inc","a");
+    w.graph().connect("s","a","in");
+
+    // the second execute reuses the compiled plan
+    for(int i = 0; i < 2; ++i)
+    {
+        w.execute();
+        EXPECT_EQ(w.registry().fetch<Node>("a")->to_int(),1);
+        w.registry().reset();
+    }
+
+    // changing the graph recompiles it
+    w.graph().add_filter("inc","b");
+    w.graph().connect("a","b","in");
+    w.execute();
+
+    EXPECT_FALSE(w.registry().has_entry("a"));
+    EXPECT_EQ(w.registry().fetch<Node>("b")->to_int(),2);
+    w.registry().reset();
+
+    Workspace::clear_supported_filter_types();
+}
+
 //-----------------------------------------------------------------------------
 TEST(ascent_flow_workspace, dag_graph_missing_input_error)
 {
@@ -790,3 +1077,172 @@ TEST(ascent_flow_workspace, dag_graph_missing_input_error)
 
     Workspace::clear_supported_filter_types();
 }
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, fields_needed)
+{
+    Workspace::register_filter_type<SrcFilter>();
+    Workspace::register_filter_type<IncFilter>();
+    Workspace::register_filter_type<FieldUseFilter>();
+
+    Workspace w;
+
+    Node p_a, p_b, p_c;
+    p_a["field"] = "pressure";
+    p_a["output_name"] = "grad";
+    p_b["field"] = "grad";
+    p_b["extra_fields"].append() = "density";
+    p_b["extra_fields"].append() = "energy";
+    p_c["field"] = "velocity";
+
+    w.graph().add_filter("src","s");
+    w.graph().add_filter("field_use","a",p_a);
+    w.graph().add_filter("field_use","b",p_b);
+    w.graph().add_filter("field_use","c",p_c);
+
+    // s -> a -> b, s -> c
+    w.graph().connect("s","a","in");
+    w.graph().connect("a","b","in");
+    w.graph().connect("s","c","in");
+
+    std::set<std::string> fields;
+    EXPECT_TRUE(w.graph().fields_needed("s",fields));
+
+    // 'grad' is produced by 'a', so the source does not need it
+    std::set<std::string> expected = {"pressure",
+                                      "density",
+                                      "energy",
+                                      "velocity"};
+    EXPECT_EQ(fields, expected);
+
+    EXPECT_TRUE(w.graph().fields_needed("a",fields));
+    expected = {"grad", "density", "energy"};
+    EXPECT_EQ(fields, expected);
+
+    // nothing consumes 'b'
+    EXPECT_TRUE(w.graph().fields_needed("b",fields));
+    EXPECT_TRUE(fields.empty());
+
+    // a consumer that does not declare its fields may read anything
+    w.graph().add_filter("inc","i");
+    w.graph().connect("b","i","in");
+
+    EXPECT_FALSE(w.graph().fields_needed("s",fields));
+    EXPECT_TRUE(fields.empty());
+
+    // the branch through 'c' is unaffected
+    EXPECT_TRUE(w.graph().fields_needed("c",fields));
+
+    EXPECT_THROW(w.graph().fields_needed("bananas",fields),conduit::Error);
+
+    Workspace::clear_supported_filter_types();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, upstream_and_filter_times)
+{
+    Workspace::register_filter_type<SrcFilter>();
+    Workspace::register_filter_type<IncFilter>();
+    Workspace::register_filter_type<AddFilter>();
+
+    Workspace w;
+
+    // s -> a -> c
+    // t -------/
+    // s -> b
+    w.graph().add_filter("src","s");
+    w.graph().add_filter("src","t");
+    w.graph().add_filter("inc","a");
+    w.graph().add_filter("inc","b");
+    w.graph().add_filter("add","c");
+    w.graph().connect("s","a","in");
+    w.graph().connect("s","b","in");
+    w.graph().connect("a","c","a");
+    w.graph().connect("t","c","b");
+
+    std::set<std::string> names;
+    w.graph().upstream("c",names);
+    std::set<std::string> expected = {"a","c","s","t"};
+    EXPECT_EQ(names, expected);
+
+    names.clear();
+    w.graph().upstream("b",names);
+    expected = {"b","s"};
+    EXPECT_EQ(names, expected);
+
+    EXPECT_THROW(w.graph().upstream("bananas",names),conduit::Error);
+
+    // times are only kept when asked for
+    w.execute();
+    w.registry().reset();
+    EXPECT_TRUE(w.filter_times().empty());
+
+    w.record_filter_times(true);
+    w.execute();
+    w.registry().reset();
+    EXPECT_EQ(w.filter_times().size(), 5);
+    EXPECT_TRUE(w.filter_times().find("c") != w.filter_times().end());
+    EXPECT_GE(w.filter_times().at("c"), 0.0);
+
+    Workspace::clear_supported_filter_types();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, gate_filters)
+{
+    Workspace::register_filter_type<SrcFilter>();
+    Workspace::register_filter_type<IncFilter>();
+    Workspace::register_filter_type<AddFilter>();
+
+    Workspace w;
+
+    // s -> a -> c
+    // t -------/
+    // s -> b
+    w.graph().add_filter("src","s");
+    w.graph().add_filter("src","t");
+    w.graph().add_filter("inc","a");
+    w.graph().add_filter("inc","b");
+    w.graph().add_filter("add","c");
+    w.graph().connect("s","a","in");
+    w.graph().connect("s","b","in");
+    w.graph().connect("a","c","a");
+    w.graph().connect("t","c","b");
+
+    // gating c skips a and t (only c needs them), s still feeds b
+    std::set<std::string> gated = {"c"};
+    w.gate_filters(gated);
+    w.record_filter_times(true);
+    w.execute();
+
+    std::set<std::string> ran;
+    std::map<std::string,double>::const_iterator itr;
+    for(itr = w.filter_times().begin(); itr != w.filter_times().end(); ++itr)
+    {
+        ran.insert(itr->first);
+    }
+    std::set<std::string> expected = {"b","s"};
+    EXPECT_EQ(ran, expected);
+    EXPECT_EQ(w.registry().fetch<Node>("b")->to_int(),1);
+    // s was only held for the filters that ran
+    EXPECT_FALSE(w.registry().has_entry("s"));
+    w.registry().reset();
+
+    // gating a also skips c, which needs it, and so t
+    gated = {"a"};
+    w.gate_filters(gated);
+    w.execute();
+    EXPECT_EQ(w.filter_times().size(), 2);
+    EXPECT_TRUE(w.filter_times().find("c") == w.filter_times().end());
+    EXPECT_TRUE(w.filter_times().find("t") == w.filter_times().end());
+    w.registry().reset();
+
+    // no gates runs everything again
+    w.gate_filters(std::set<std::string>());
+    w.execute();
+    EXPECT_EQ(w.filter_times().size(), 5);
+    EXPECT_EQ(w.registry().fetch<Node>("c")->to_int(),1);
+    w.registry().reset();
+
+    Workspace::clear_supported_filter_types();
+}
@@ -0,0 +1,476 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_benchmarks.cpp
+///
+/// Micro benchmarks for Ascent hot paths on synthetic data.
+/// Results are written as json so they can be tracked across releases.
+///
+//-----------------------------------------------------------------------------
+
+#include <ascent.hpp>
+#include <ascent_config.h>
+#include <ascent_expression_eval.hpp>
+#include <ascent_png_encoder.hpp>
+#include <flow_filters/ascent_runtime_relay_filters.hpp>
+
+#include <flow.hpp>
+#include <flow_timer.hpp>
+
+#if defined(ASCENT_VTKM_ENABLED)
+#include <ascent_vtkh_collection.hpp>
+#include <ascent_vtkh_data_adapter.hpp>
+#endif
+
+#include <conduit_blueprint.hpp>
+
+#include "open_simplex_noise.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace conduit;
+using namespace ascent;
+
+//-----------------------------------------------------------------------------
+struct Options
+{
+  std::vector<int> m_sizes = {16, 32, 64};
+  std::vector<int> m_domains = {1, 8};
+  std::vector<std::string> m_mesh_types = {"uniform", "hexs"};
+  int m_reps = 5;
+  std::string m_output_name = "ascent_benchmarks.json";
+  std::string m_filter = "";
+
+  void parse(int argc, char** argv)
+  {
+    for(int i = 1; i < argc; ++i)
+    {
+      std::string arg(argv[i]);
+      if(arg.find("--sizes=") == 0)
+      {
+        m_sizes = to_ints(arg.substr(8));
+      }
+      else if(arg.find("--domains=") == 0)
+      {
+        m_domains = to_ints(arg.substr(10));
+      }
+      else if(arg.find("--mesh_types=") == 0)
+      {
+        m_mesh_types = to_strings(arg.substr(13));
+      }
+      else if(arg.find("--reps=") == 0)
+      {
+        m_reps = std::max(1, atoi(arg.substr(7).c_str()));
+      }
+      else if(arg.find("--output=") == 0)
+      {
+        m_output_name = arg.substr(9);
+      }
+      else if(arg.find("--filter=") == 0)
+      {
+        m_filter = arg.substr(9);
+      }
+      else
+      {
+        std::cerr<<"Invalid argument \""<<arg<<"\"\n";
+        usage();
+        exit(1);
+      }
+    }
+  }
+
+  static std::vector<std::string> to_strings(const std::string &s)
+  {
+    std::vector<std::string> res;
+    std::stringstream ss(s);
+    std::string item;
+    while(std::getline(ss, item, ','))
+    {
+      res.push_back(item);
+    }
+    return res;
+  }
+
+  static std::vector<int> to_ints(const std::string &s)
+  {
+    std::vector<int> res;
+    for(auto &item : to_strings(s))
+    {
+      res.push_back(atoi(item.c_str()));
+    }
+    return res;
+  }
+
+  static void usage()
+  {
+    std::cout<<"usage   : ascent_benchmarks [--sizes=16,32,64] [--domains=1,8]\n"
+             <<"                          [--mesh_types=uniform,hexs] [--reps=5]\n"
+             <<"                          [--filter=name] [--output=ascent_benchmarks.json]\n";
+    std::cout<<"  --sizes      points per side of each domain\n";
+    std::cout<<"  --domains    number of domains in the data set\n";
+    std::cout<<"  --filter     only run benchmarks whose name contains this string\n";
+    std::cout<<"\n\n";
+  }
+};
+
+//-----------------------------------------------------------------------------
+// braid domains, shifted along x, with an added noise field
+//-----------------------------------------------------------------------------
+void
+create_dataset(const std::string &mesh_type,
+               const int size,
+               const int num_domains,
+               Node &dataset)
+{
+  dataset.reset();
+
+  struct osn_context *ctx;
+  open_simplex_noise(77374, &ctx);
+
+  for(int d = 0; d < num_domains; ++d)
+  {
+    Node &dom = dataset.append();
+    conduit::blueprint::mesh::examples::braid(mesh_type,
+                                              size,
+                                              size,
+                                              size,
+                                              dom);
+    dom["state/domain_id"] = d;
+    dom["state/cycle"] = 100;
+    dom["state/time"] = 1.0;
+
+    // shift the domains so they don't overlap
+    Node &coords = dom["coordsets/coords"];
+    if(coords["type"].as_string() == "uniform")
+    {
+      const double dx = coords["spacing/dx"].to_float64();
+      coords["origin/x"] = coords["origin/x"].to_float64() + d * (size - 1) * dx;
+    }
+    else
+    {
+      float64_array x = coords["values/x"].value();
+      const double width = 20.0;
+      for(index_t i = 0; i < x.number_of_elements(); ++i)
+      {
+        x[i] += d * width;
+      }
+    }
+
+    // point centered noise on the logical point grid
+    const index_t num_points = size * size * size;
+    Node &noise = dom["fields/noise"];
+    noise["association"] = "vertex";
+    noise["topology"] = "mesh";
+    noise["values"].set(DataType::float64(num_points));
+    float64_array vals = noise["values"].value();
+    const double scale = 0.1;
+    for(index_t idx = 0; idx < num_points; ++idx)
+    {
+      const index_t i = idx % size;
+      const index_t j = (idx / size) % size;
+      const index_t k = idx / (size * size);
+      vals[idx] = open_simplex_noise3(ctx,
+                                      (i + d * (size - 1)) * scale,
+                                      j * scale,
+                                      k * scale);
+    }
+  }
+
+  open_simplex_noise_free(ctx);
+}
+
+//-----------------------------------------------------------------------------
+class Benchmarks
+{
+public:
+  Benchmarks(const Options &options)
+    : m_options(options)
+  {}
+
+  // times 'func' m_reps times and records the stats under
+  // results/<name>/<config>
+  template<typename Func>
+  void run(const std::string &name,
+           const std::string &config,
+           const Node &config_info,
+           Func func)
+  {
+    if(m_options.m_filter != "" &&
+       name.find(m_options.m_filter) == std::string::npos)
+    {
+      return;
+    }
+
+    std::vector<double> times;
+    for(int r = 0; r < m_options.m_reps; ++r)
+    {
+      flow::Timer timer;
+      func();
+      times.push_back(timer.elapsed());
+    }
+
+    std::sort(times.begin(), times.end());
+    double sum = 0.;
+    for(auto t : times)
+    {
+      sum += t;
+    }
+
+    Node &entry = m_results["benchmarks/" + name + "/" + config];
+    entry["config"] = config_info;
+    entry["reps"] = (int) times.size();
+    entry["min"] = times.front();
+    entry["max"] = times.back();
+    entry["median"] = times[times.size() / 2];
+    entry["mean"] = sum / double(times.size());
+
+    std::cout<<name<<" ["<<config<<"] min "<<times.front()
+             <<" median "<<times[times.size() / 2]<<"\n";
+  }
+
+  Node &results() { return m_results; }
+
+protected:
+  const Options &m_options;
+  Node m_results;
+};
+
+//-----------------------------------------------------------------------------
+void
+bench_workspace(Benchmarks &bench)
+{
+  // a long chain of cheap filters measures the per filter overhead
+  // of the flow runtime
+  const std::vector<int> lengths = {10, 100, 1000};
+  for(auto length : lengths)
+  {
+    flow::Workspace w;
+    Node data;
+    data.set(1.0);
+
+    Node p;
+    p["entry"] = "bench_data";
+    w.graph().add_filter("registry_source", "source", p);
+    std::string prev = "source";
+    for(int i = 0; i < length; ++i)
+    {
+      std::string name = "alias_" + std::to_string(i);
+      w.graph().add_filter("alias", name);
+      w.graph().connect(prev, name, 0);
+      prev = name;
+    }
+
+    Node info;
+    info["filters"] = length;
+    bench.run("workspace_execute",
+              "filters_" + std::to_string(length),
+              info,
+              [&]()
+              {
+                w.registry().add<Node>("bench_data", &data, -1);
+                w.execute();
+                w.registry().reset();
+              });
+  }
+}
+
+//-----------------------------------------------------------------------------
+void
+bench_dataset(Benchmarks &bench,
+              const std::string &mesh_type,
+              const int size,
+              const int num_domains,
+              const std::string &output_dir)
+{
+  Node dataset;
+  create_dataset(mesh_type, size, num_domains, dataset);
+
+  std::stringstream ss;
+  ss<<mesh_type<<"_"<<size<<"_d"<<num_domains;
+  const std::string config = ss.str();
+
+  Node info;
+  info["mesh_type"] = mesh_type;
+  info["size"] = size;
+  info["domains"] = num_domains;
+  info["points"] = (int64) size * size * size * num_domains;
+
+  runtime::expressions::ExpressionEval eval(&dataset);
+
+  bench.run("expression_scalar", config, info,
+            [&]()
+            {
+              eval.evaluate("(2.0 + 1) / 0.5");
+            });
+
+  bench.run("expression_field_max", config, info,
+            [&]()
+            {
+              eval.evaluate("max(field('noise'))");
+            });
+
+  bench.run("binning", config, info,
+            [&]()
+            {
+              eval.evaluate("binning('noise','sum',"
+                            "[axis('x',num_bins=16), axis('y',num_bins=16)])");
+            });
+
+#if defined(ASCENT_VTKM_ENABLED)
+  bench.run("blueprint_to_vtkh_collection", config, info,
+            [&]()
+            {
+              VTKHCollection *coll =
+                VTKHDataAdapter::BlueprintToVTKHCollection(dataset, true);
+              delete coll;
+            });
+
+  std::vector<vtkm::cont::DataSet*> vtkm_doms;
+  for(int d = 0; d < num_domains; ++d)
+  {
+    vtkm_doms.push_back(
+      VTKHDataAdapter::BlueprintToVTKmDataSet(dataset.child(d), false, "mesh"));
+  }
+
+  bench.run("vtkm_to_blueprint", config, info,
+            [&]()
+            {
+              for(auto dom : vtkm_doms)
+              {
+                Node n_dom;
+                VTKHDataAdapter::VTKmToBlueprintDataSet(dom, n_dom, "mesh", true);
+              }
+            });
+
+  for(auto dom : vtkm_doms)
+  {
+    delete dom;
+  }
+#endif
+
+  const std::string save_path = conduit::utils::join_file_path(output_dir,
+                                                               "bench_" + config);
+  bench.run("mesh_blueprint_save", config, info,
+            [&]()
+            {
+              std::string root_file;
+              runtime::filters::mesh_blueprint_save(dataset,
+                                                    save_path,
+                                                    "hdf5",
+                                                    -1,
+                                                    root_file);
+            });
+}
+
+//-----------------------------------------------------------------------------
+void
+bench_png(Benchmarks &bench)
+{
+  const std::vector<int> sizes = {512, 1024, 2048};
+  for(auto size : sizes)
+  {
+    std::vector<unsigned char> rgba(size * size * 4);
+    for(size_t i = 0; i < rgba.size(); ++i)
+    {
+      rgba[i] = static_cast<unsigned char>((i * 31) % 255);
+    }
+
+    Node info;
+    info["width"] = size;
+    info["height"] = size;
+    bench.run("png_encode",
+              std::to_string(size) + "x" + std::to_string(size),
+              info,
+              [&]()
+              {
+                PNGEncoder encoder;
+                encoder.Encode(&rgba[0], size, size);
+              });
+  }
+}
+
+//-----------------------------------------------------------------------------
+int
+main(int argc, char *argv[])
+{
+  Options options;
+  options.parse(argc, argv);
+
+  Node about;
+  ascent::about(about);
+
+  flow::filters::register_builtin();
+  runtime::expressions::register_builtin();
+
+  Benchmarks bench(options);
+  bench.results()["about/version"] = about["version"];
+  bench.results()["reps"] = options.m_reps;
+
+  bench_workspace(bench);
+  bench_png(bench);
+
+  std::string output_dir = ".";
+  for(auto &mesh_type : options.m_mesh_types)
+  {
+    for(auto size : options.m_sizes)
+    {
+      for(auto num_domains : options.m_domains)
+      {
+        bench_dataset(bench, mesh_type, size, num_domains, output_dir);
+      }
+    }
+  }
+
+  bench.results().save(options.m_output_name, "json");
+  std::cout<<"results written to '"<<options.m_output_name<<"'\n";
+  return 0;
+}
@@ -51,8 +51,11 @@
 #include <ascent.hpp>
 #include <flow_timer.hpp>
 #include <ascent_hola.hpp>
+#include <ascent_actions_utils.hpp>
 
 #include <fstream>
+#include <set>
+#include <thread>
 #include <vector>
 #ifdef REPLAY_MPI
 #include <mpi.h>
@@ -69,7 +72,20 @@ void usage()
   std::cout<<"  --cycles  : a text file containing a list of root files, one per line.\n";
   std::cout<<"              Each file will be loaded and sent to Ascent in order.\n";
   std::cout<<"  --actions : a json file containing ascent actions. Default value\n";
-  std::cout<<"              is 'ascent_actions.json'.\n\n";
+  std::cout<<"              is 'ascent_actions.json'.\n";
+  std::cout<<"  --select_fields : only read the fields used by the actions, when\n";
+  std::cout<<"              they can be determined from the actions file.\n";
+  std::cout<<"  --threads : number of threads used to read domains. Default\n";
+  std::cout<<"              value is 4.\n";
+  std::cout<<"  --no_read_ahead : read each cycle after the previous one executes.\n";
+  std::cout<<"              By default the next cycle is read while the current\n";
+  std::cout<<"              one executes.\n";
+  std::cout<<"  --memory_cap : only read ahead when the current and the next cycle\n";
+  std::cout<<"              fit in this many MB per rank. The next cycle is\n";
+  std::cout<<"              estimated from its size on disk. Default value\n";
+  std::cout<<"              is 0 (no cap).\n";
+  std::cout<<"  --timings : a csv file that receives per cycle read, wait,\n";
+  std::cout<<"              publish and execute times (seconds).\n\n";
   std::cout<<"======================== Examples =========================\n";
   std::cout<<"./relay_ser --root=clover.cycle_000060.root\n";
   std::cout<<"./relay_ser --root=clover.cycle_000060.root --actions=my_actions.json\n";
@@ -82,6 +98,11 @@ struct Options
   std::string m_actions_file = "ascent_actions.json";
   std::string m_root_file;
   std::string m_cycles_file;
+  std::string m_timings_file;
+  bool m_select_fields = false;
+  bool m_read_ahead = true;
+  int m_threads = 4;
+  int m_memory_cap = 0;
 
   void parse(int argc, char** argv)
   {
@@ -99,6 +120,26 @@ struct Options
       {
         m_actions_file = get_arg(argv[i]);
       }
+      else if(contains(argv[i], "--select_fields"))
+      {
+        m_select_fields = true;
+      }
+      else if(contains(argv[i], "--threads="))
+      {
+        m_threads = atoi(get_arg(argv[i]).c_str());
+      }
+      else if(contains(argv[i], "--no_read_ahead"))
+      {
+        m_read_ahead = false;
+      }
+      else if(contains(argv[i], "--memory_cap="))
+      {
+        m_memory_cap = atoi(get_arg(argv[i]).c_str());
+      }
+      else if(contains(argv[i], "--timings="))
+      {
+        m_timings_file = get_arg(argv[i]);
+      }
       else
       {
         bad_arg(argv[i]);
@@ -171,6 +212,65 @@ bool contains(const std::string haystack, std::string needle)
   }
 };
 
+//-----------------------------------------------------------------------------
+// one loaded cycle
+//-----------------------------------------------------------------------------
+struct CycleData
+{
+  conduit::Node m_data;
+  float m_read_time = 0.f;
+};
+
+void load_cycle(const conduit::Node &replay_opts,
+                const std::string &root_file,
+                CycleData *cycle)
+{
+  conduit::Node opts(replay_opts);
+  opts["root_file"] = root_file;
+
+  flow::Timer read;
+  ascent::hola("relay/blueprint/mesh", opts, cycle->m_data);
+  cycle->m_read_time = read.elapsed();
+}
+
+//-----------------------------------------------------------------------------
+// ghost fields ascent strips from the data. They are not named in the
+// actions, so they are added to the selected fields. Like Ascent::open,
+// honor the ghost_field_name in ascent_options.json (or .yaml)
+//-----------------------------------------------------------------------------
+void ghost_fields(std::set<std::string> &fields)
+{
+  conduit::Node opts;
+  if(conduit::utils::is_file("ascent_options.json"))
+  {
+    opts.load("ascent_options.json", "json");
+  }
+  else if(conduit::utils::is_file("ascent_options.yaml"))
+  {
+    opts.load("ascent_options.yaml", "yaml");
+  }
+
+  if(!opts.has_path("ghost_field_name"))
+  {
+    fields.insert("ascent_ghosts");
+    return;
+  }
+
+  const conduit::Node &ghosts = opts["ghost_field_name"];
+  if(ghosts.dtype().is_string())
+  {
+    fields.insert(ghosts.as_string());
+  }
+  else
+  {
+    const int num_children = ghosts.number_of_children();
+    for(int i = 0; i < num_children; ++i)
+    {
+      fields.insert(ghosts.child(i).as_string());
+    }
+  }
+}
+
 int main (int argc, char *argv[])
 {
   Options options;
@@ -195,17 +295,78 @@ int main (int argc, char *argv[])
 
   int comm_size = 1;
   int rank = 0;
+  bool read_ahead = options.m_read_ahead;
 
 #ifdef REPLAY_MPI
-  MPI_Init(NULL,NULL);
+  // reads on the background thread are collective, so they need
+  // full thread support and their own communicator
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Init_thread(NULL,NULL, MPI_THREAD_MULTIPLE, &provided);
   MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  if(read_ahead && provided < MPI_THREAD_MULTIPLE)
+  {
+    if(rank == 0)
+    {
+      std::cout<<"MPI_THREAD_MULTIPLE is not supported, disabling read ahead\n";
+    }
+    read_ahead = false;
+  }
+
+  MPI_Comm read_comm;
+  MPI_Comm_dup(MPI_COMM_WORLD, &read_comm);
 #endif
 
-  conduit::Node replay_data, replay_opts;
+  // relay extracts write hdf5 while the next cycle is read
+  if(read_ahead && !ascent::hola_hdf5_thread_safe())
+  {
+    if(rank == 0)
+    {
+      std::cout<<"HDF5 is not thread safe, disabling read ahead\n";
+    }
+    read_ahead = false;
+  }
+
+  conduit::Node replay_opts;
 #ifdef REPLAY_MPI
-  replay_opts["mpi_comm"] = MPI_Comm_c2f(MPI_COMM_WORLD);
+  replay_opts["mpi_comm"] = MPI_Comm_c2f(read_comm);
 #endif
+  replay_opts["threads"] = options.m_threads;
+
+  if(options.m_select_fields)
+  {
+    // only read what the actions need
+    std::string protocol = "json";
+    std::string curr, next;
+    conduit::utils::rsplit_string(options.m_actions_file, ".", curr, next);
+    if(curr == "yaml")
+    {
+      protocol = "yaml";
+    }
+
+    conduit::Node file_actions, info;
+    file_actions.load(options.m_actions_file, protocol);
+
+    std::set<std::string> fields;
+    if(ascent::field_list(file_actions, fields, info))
+    {
+      ghost_fields(fields);
+      conduit::Node &sel = replay_opts["fields"];
+      sel.set(conduit::DataType::list());
+      for(const std::string &field : fields)
+      {
+        sel.append().set(field);
+      }
+    }
+    else if(rank == 0)
+    {
+      std::cout<<"Unable to determine the fields used by the actions, ";
+      std::cout<<"reading all fields:\n";
+      info.print();
+    }
+  }
+
   //replay_data.print();
   conduit::Node ascent_opts;
   ascent_opts["actions_file"] = options.m_actions_file;
@@ -222,27 +383,118 @@ int main (int argc, char *argv[])
   ascent::Ascent ascent;
   ascent.open(ascent_opts);
 
-  for(int i = 0; i < time_steps.size(); ++i)
+  std::ofstream timings;
+  if(rank == 0 && options.m_timings_file != "")
   {
-    replay_opts["root_file"] = time_steps[i];
+    timings.open(options.m_timings_file);
+    timings<<"cycle,root_file,read_ahead,bytes,read,wait,publish,execute\n";
+  }
+
+  const long long memory_cap = (long long)options.m_memory_cap * 1024 * 1024;
+
+  // on disk bytes of each cycle (rank 0 asks the file system), used to
+  // scale the in memory size of the current cycle to the next one
+  std::vector<long long> file_bytes(time_steps.size(), -1);
+  auto cycle_file_bytes = [&](int idx)
+  {
+    if(file_bytes[idx] < 0)
+    {
+      long long bytes = 0;
+      if(rank == 0)
+      {
+        try
+        {
+          bytes = (long long)ascent::hola_file_bytes(time_steps[idx]);
+        }
+        catch(conduit::Error &e)
+        {
+          // unknown, the read reports the error
+          bytes = 0;
+        }
+      }
+#ifdef REPLAY_MPI
+      MPI_Bcast(&bytes, 1, MPI_LONG_LONG, 0, MPI_COMM_WORLD);
+#endif
+      file_bytes[idx] = bytes;
+    }
+    return file_bytes[idx];
+  };
+
+  // two slots: the cycle being executed and the one being read
+  CycleData cycles[2];
+  std::thread reader;
+  bool reading = false;
+
+  const int num_steps = (int)time_steps.size();
+
+  for(int i = 0; i < num_steps; ++i)
+  {
+    CycleData &current = cycles[i % 2];
+    CycleData &next = cycles[(i + 1) % 2];
+
     if(rank == 0)
     {
       std::cout<<"Root file "<<time_steps[i]<<"\n";
     }
-    flow::Timer load;
-    ascent::hola("relay/blueprint/mesh", replay_opts, replay_data);
+
+    // wait for the cycle, or read it now if it was not read ahead
+    bool was_read_ahead = reading;
+    flow::Timer wait;
+    if(reading)
+    {
+      reader.join();
+      reading = false;
+    }
+    else
+    {
+      // keep one cycle in memory: drop the previous one before reading
+      next.m_data.reset();
+      load_cycle(replay_opts, time_steps[i], &current);
+    }
 #ifdef REPLAY_MPI
     MPI_Barrier(MPI_COMM_WORLD);
 #endif
-    float load_time = load.elapsed();
-      
+    float wait_time = wait.elapsed();
+
+    long long bytes = (long long)current.m_data.total_bytes_allocated();
+#ifdef REPLAY_MPI
+    long long local_bytes = bytes;
+    MPI_Allreduce(&local_bytes, &bytes, 1, MPI_LONG_LONG, MPI_MAX, MPI_COMM_WORLD);
+#endif
+
     flow::Timer publish;
-    ascent.publish(replay_data);
+    ascent.publish(current.m_data);
 #ifdef REPLAY_MPI
     MPI_Barrier(MPI_COMM_WORLD);
 #endif
     float publish_time = publish.elapsed();
 
+    // the previous cycle is no longer published, read the next cycle
+    // into its slot while this one executes, if both fit under the cap.
+    // The next cycle is assumed to grow in memory like it does on disk
+    next.m_data.reset();
+    bool fits = true;
+    if(read_ahead && i + 1 < num_steps && memory_cap > 0)
+    {
+      long long next_bytes = bytes;
+      long long curr_file = cycle_file_bytes(i);
+      long long next_file = cycle_file_bytes(i + 1);
+      if(curr_file > 0 && next_file > curr_file)
+      {
+        next_bytes = (long long)((double)bytes * next_file / curr_file);
+      }
+      fits = bytes + next_bytes <= memory_cap;
+    }
+
+    if(read_ahead && i + 1 < num_steps && fits)
+    {
+      reader = std::thread(load_cycle,
+                           std::cref(replay_opts),
+                           time_steps[i + 1],
+                           &next);
+      reading = true;
+    }
+
     flow::Timer execute;
     ascent.execute(actions);
 #ifdef REPLAY_MPI
@@ -251,15 +503,39 @@ int main (int argc, char *argv[])
     float execute_time = execute.elapsed();
     if(rank == 0)
     {
-      std::cout<<" Load -----: "<<load_time<<"\n";
+      std::cout<<" Read -----: "<<current.m_read_time<<"\n";
+      std::cout<<" Load -----: "<<wait_time<<"\n";
       std::cout<<" Publish --: "<<publish_time<<"\n";
       std::cout<<" Execute --: "<<execute_time<<"\n";
+
+      if(timings.is_open())
+      {
+        timings<<i<<","
+               <<time_steps[i]<<","
+               <<(was_read_ahead ? 1 : 0)<<","
+               <<bytes<<","
+               <<current.m_read_time<<","
+               <<wait_time<<","
+               <<publish_time<<","
+               <<execute_time<<"\n";
+      }
     }
   }
 
+  if(reading)
+  {
+    reader.join();
+  }
+
   ascent.close();
 
+  if(timings.is_open())
+  {
+    timings.close();
+  }
+
 #ifdef REPLAY_MPI
+  MPI_Comm_free(&read_comm);
   MPI_Finalize();
 #endif
   return 0;
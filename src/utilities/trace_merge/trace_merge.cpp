@@ -0,0 +1,153 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: trace_merge.cpp
+///
+//-----------------------------------------------------------------------------
+#include <conduit.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+void usage()
+{
+  std::cout<<"usage   : trace_merge [--output=merged.json] trace_0.json trace_1.json ...\n";
+  std::cout<<"Merges per-rank Ascent traces into a single Chrome/Perfetto trace.\n";
+  std::cout<<"Timestamps are shifted so the earliest event across all ranks is 0.\n";
+  std::cout<<"Examples:\n";
+  std::cout<<"  ./trace_merge ascent_trace_*.json\n";
+  std::cout<<"  ./trace_merge --output=run.json ascent_trace_000000.json ascent_trace_000001.json\n";
+  std::cout<<"\n\n";
+}
+
+struct Options
+{
+  std::string m_output_name = "ascent_trace.json";
+  std::vector<std::string> m_input_names;
+
+  void parse(int argc, char** argv)
+  {
+    for(int i = 1; i < argc; ++i)
+    {
+      std::string arg(argv[i]);
+      if(arg.find("--output=") == 0)
+      {
+        m_output_name = arg.substr(9);
+      }
+      else if(arg.find("--") == 0)
+      {
+        std::cerr<<"Invalid argument \""<<arg<<"\"\n";
+        usage();
+        exit(1);
+      }
+      else
+      {
+        m_input_names.push_back(arg);
+      }
+    }
+
+    if(m_input_names.size() == 0)
+    {
+      std::cerr<<"You must specify at least one input trace. Bailing...\n";
+      usage();
+      exit(1);
+    }
+  }
+};
+
+int main (int argc, char *argv[])
+{
+  Options options;
+  options.parse(argc, argv);
+
+  const int num_inputs = static_cast<int>(options.m_input_names.size());
+  std::vector<conduit::Node> traces(num_inputs);
+
+  double min_ts = std::numeric_limits<double>::max();
+  for(int i = 0; i < num_inputs; ++i)
+  {
+    traces[i].load(options.m_input_names[i], "json");
+    if(!traces[i].has_path("traceEvents"))
+    {
+      std::cerr<<"'"<<options.m_input_names[i]<<"' is not a trace. Bailing...\n";
+      exit(1);
+    }
+    const conduit::Node &events = traces[i]["traceEvents"];
+    const int num_events = events.number_of_children();
+    for(int e = 0; e < num_events; ++e)
+    {
+      if(events.child(e).has_path("ts"))
+      {
+        min_ts = std::min(min_ts, events.child(e)["ts"].to_float64());
+      }
+    }
+  }
+
+  conduit::Node merged;
+  conduit::Node &merged_events = merged["traceEvents"];
+  merged_events.set(conduit::DataType::list());
+  for(int i = 0; i < num_inputs; ++i)
+  {
+    conduit::Node &events = traces[i]["traceEvents"];
+    const int num_events = events.number_of_children();
+    for(int e = 0; e < num_events; ++e)
+    {
+      conduit::Node &event = merged_events.append();
+      event.set(events.child(e));
+      if(event.has_path("ts"))
+      {
+        event["ts"] = event["ts"].to_float64() - min_ts;
+      }
+    }
+  }
+
+  merged.save(options.m_output_name, "json");
+  return 0;
+}